@@ -14,7 +14,6 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
-#include <thread>
 #include <string>
 #include "runtime/device/cpu/cpu_device_address.h"
 
@@ -139,27 +138,18 @@ void ArithmeticCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, co
   T *output = reinterpret_cast<T *>(outputs[0]->addr);
   auto lens = outputs[0]->size / sizeof(T);
   MS_LOG(INFO) << "lens=" << lens;
-  const size_t thread_num = 24;
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
+  auto task = [this, input1, input2, output](size_t start, size_t end) {
     if (operate_type_ == ADD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Add<T>, this, input1, input2, output, start, end));
+      Add<T>(input1, input2, output, start, end);
     } else if (operate_type_ == SUB) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Sub<T>, this, input1, input2, output, start, end));
+      Sub<T>(input1, input2, output, start, end);
     } else if (operate_type_ == MUL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Mul<T>, this, input1, input2, output, start, end));
+      Mul<T>(input1, input2, output, start, end);
     } else if (operate_type_ == DIV) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Div<T>, this, input1, input2, output, start, end));
+      Div<T>(input1, input2, output, start, end);
     }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  };
+  CPUKernelUtils::ParallelFor(task, lens);
 }
 }  // namespace kernel
 }  // namespace mindspore
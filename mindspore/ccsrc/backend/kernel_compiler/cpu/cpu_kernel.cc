@@ -76,5 +76,11 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
   }
   std::reverse(element_num->begin(), element_num->end());
 }
+
+void CPUKernelUtils::ParallelFor(const ParallelTask &task, size_t count, size_t grain_size) {
+  if (!ThreadPool::GetInstance()->ParallelFor(count, task, grain_size)) {
+    MS_LOG(EXCEPTION) << "Parallel launch failed, count: " << count << ", grain size: " << grain_size;
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
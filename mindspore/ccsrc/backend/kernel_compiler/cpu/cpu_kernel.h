@@ -24,6 +24,7 @@
 #include "backend/kernel_compiler/kernel.h"
 #include "ir/anf.h"
 #include "backend/session/anf_runtime_algorithm.h"
+#include "common/thread_pool.h"
 
 using mindspore::kernel::Address;
 using mindspore::kernel::AddressPtr;
@@ -83,6 +84,8 @@ class CPUKernelUtils {
   static size_t CalcOffset(const std::vector<size_t> &shape, size_t dim0, size_t dim1, size_t dim2, size_t dim3);
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
+  // Run task(start, end) over [0, count) on the shared cpu thread pool, inline when count is below grain_size.
+  static void ParallelFor(const ParallelTask &task, size_t count, size_t grain_size = kDefaultGrainSize);
 };
 }  // namespace kernel
 }  // namespace mindspore
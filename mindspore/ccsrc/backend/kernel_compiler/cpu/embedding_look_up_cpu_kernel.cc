@@ -13,8 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <thread>
 #include <string>
+#include <algorithm>
 #include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "ir/primitive.h"
@@ -72,28 +72,19 @@ void EmbeddingLookUpCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr
   auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
   auto indices_addr = reinterpret_cast<T *>(inputs[1]->addr);
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
-  const size_t thread_num = 16;
-  std::thread threads[16];
-  size_t task_proc_lens = (indices_lens_ + thread_num - 1) / thread_num;
-  size_t i;
-  size_t task_offset = 0;
-  MS_LOG(DEBUG) << "indices_lens_: " << indices_lens_ << " one task proc lens:" << task_proc_lens;
-  for (i = 0; i < thread_num; i++) {
-    if (task_offset >= indices_lens_) {
-      break;
-    }
-    MS_LOG(DEBUG) << "task_offset: " << task_offset << " task_proc_lenss:" << task_proc_lens;
-    threads[i] = std::thread(LookUpTableTask<T>, input_addr, indices_addr + task_offset,
-                             output_addr + task_offset * outer_dim_size_, task_proc_lens, outer_dim_size_, offset_,
-                             first_dim_size_);
-    task_offset += task_proc_lens;
-    if (task_offset + task_proc_lens > indices_lens_) {
-      task_proc_lens = indices_lens_ - task_offset;
-    }
-  }
-  for (size_t j = 0; j < i; j++) {
-    threads[j].join();
-  }
+  size_t outer_dim_size = outer_dim_size_;
+  T offset = offset_;
+  size_t first_dim_size = first_dim_size_;
+  auto task = [input_addr, indices_addr, output_addr, outer_dim_size, offset, first_dim_size](size_t start,
+                                                                                            size_t end) {
+    LookUpTableTask<T>(input_addr, indices_addr + start, output_addr + start * outer_dim_size, end - start,
+                       outer_dim_size, offset, first_dim_size);
+  };
+  MS_LOG(DEBUG) << "indices_lens_: " << indices_lens_;
+  // Each index copies a whole row, so split by rows while keeping enough elements in every task.
+  size_t grain_size = std::max(kDefaultGrainSize / std::max(outer_dim_size_, static_cast<size_t>(1)),
+                               static_cast<size_t>(1));
+  CPUKernelUtils::ParallelFor(task, indices_lens_, grain_size);
 }
 
 bool EmbeddingLookUpCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -22,8 +22,14 @@ namespace kernel {
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
-  primitive->execute(stream_, arguments);
-  (void)stream_.wait();
+  auto &cur_stream = stream();
+  primitive->execute(cur_stream, arguments);
+  (void)cur_stream.wait();
+}
+
+dnnl::stream &MKLKernelEngine::stream() {
+  thread_local dnnl::stream thread_stream(engine_);
+  return thread_stream;
 }
 
 dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc) {
@@ -34,7 +40,9 @@ dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, b
   }
 }
 void MKLKernelEngine::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
-  dnnl::reorder(*src_mem, *dst_mem).execute(stream_, *src_mem, *dst_mem);
+  auto &cur_stream = stream();
+  dnnl::reorder(*src_mem, *dst_mem).execute(cur_stream, *src_mem, *dst_mem);
+  (void)cur_stream.wait();
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -44,10 +44,11 @@ class MKLKernelEngine {
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
 
  private:
-  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
+  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0) {}
   ~MKLKernelEngine() = default;
+  // Kernels may be launched from several threads at once, each of them executes on its own stream.
+  dnnl::stream &stream();
   dnnl::engine engine_;
-  dnnl::stream stream_;
 };
 }  // namespace kernel
 }  // namespace mindspore
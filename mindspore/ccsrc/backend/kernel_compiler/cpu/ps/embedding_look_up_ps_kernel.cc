@@ -18,6 +18,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <algorithm>
 #include "backend/kernel_compiler/common_utils.h"
 #include "ps/util.h"
 
@@ -72,6 +73,35 @@ bool EmbeddingLookUpPSKernel::Execute(const std::vector<AddressPtr> &inputs, con
   return Launch(inputs, workspace, outputs);
 }
 
+void EmbeddingLookUpPSKernel::Lookup(const float *table, const int *ids, size_t ids_num, float *output) const {
+  MS_EXCEPTION_IF_NULL(table);
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(output);
+  size_t outer_dim_size = outer_dim_size_;
+  size_t row_num = input_shape_[kAxis];
+  int offset = offset_;
+  size_t row_bytes = outer_dim_size * sizeof(float);
+  auto task = [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      int index = ids[i] - offset;
+      float *dst = output + i * outer_dim_size;
+      if (index >= 0 && index < SizeToInt(row_num)) {
+        auto ret = memcpy_s(dst, row_bytes, table + IntToSize(index) * outer_dim_size, row_bytes);
+        if (ret != EOK) {
+          MS_LOG(EXCEPTION) << "Lookup memcpy failed.";
+        }
+      } else {
+        auto ret = memset_s(dst, row_bytes, 0, row_bytes);
+        if (ret != EOK) {
+          MS_LOG(EXCEPTION) << "Lookup memset failed.";
+        }
+      }
+    }
+  };
+  size_t grain_size = std::max(kDefaultGrainSize / std::max(outer_dim_size, size_t(1)), size_t(1));
+  CPUKernelUtils::ParallelFor(task, ids_num, grain_size);
+}
+
 const std::vector<size_t> &EmbeddingLookUpPSKernel::input_sizes() const { return input_shape_; }
 
 const std::vector<size_t> &EmbeddingLookUpPSKernel::output_sizes() const { return GetOutputSizeList(); }
@@ -40,6 +40,13 @@ class EmbeddingLookUpPSKernel : public EmbeddingLookUpCPUKernel, public PServerK
   const std::vector<size_t> &output_sizes() const override;
   const std::vector<size_t> &workspace_sizes() const override;
 
+  // Look up the rows of ids in the local shard of the table. Unlike Execute, it keeps no state between calls, so
+  // lookups of the same table can run concurrently.
+  void Lookup(const float *table, const int *ids, size_t ids_num, float *output) const;
+  // The global id of the first row held by this server.
+  int offset() const { return offset_; }
+  size_t outer_dim_size() const { return outer_dim_size_; }
+
  private:
   std::vector<size_t> input_shape_;
 };
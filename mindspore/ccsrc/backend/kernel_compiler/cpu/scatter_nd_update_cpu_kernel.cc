@@ -16,6 +16,7 @@
 
 #include "backend/kernel_compiler/cpu/scatter_nd_update_cpu_kernel.h"
 #include <string>
+#include <algorithm>
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "common/thread_pool.h"
 
@@ -115,20 +116,11 @@ void ScatterNdUpdateCPUKernel::LaunchKernel(const std::vector<AddressPtr> &input
   params.indices_unit_rank_ = indices_unit_rank_;
   params.out_strides_ = &out_strides_;
 
-  const size_t thread_num = 24;
-  std::vector<Task> tasks;
-  size_t start = 0;
-  size_t once_compute_size = (num_units_ + thread_num - 1) / thread_num;
-  while (start < num_units_) {
-    size_t end = (start + once_compute_size) > num_units_ ? num_units_ : (start + once_compute_size);
-    auto task = [&params, start, end]() -> int {
-      Compute<T>(&params, start, end);
-      return SUCCESS;
-    };
-    tasks.emplace_back(task);
-    start += once_compute_size;
-  }
-  ThreadPool::GetInstance()->LaunchMultipleTask(tasks);
+  auto task = [&params](size_t start, size_t end) { Compute<T>(&params, start, end); };
+  // Every unit updates unit_size_ elements.
+  size_t grain_size = std::max(kDefaultGrainSize / std::max(IntToSize(unit_size_), static_cast<size_t>(1)),
+                               static_cast<size_t>(1));
+  CPUKernelUtils::ParallelFor(task, num_units_, grain_size);
 
   auto ret = memcpy_s(outputs[0]->addr, outputs[0]->size, x, inputs[0]->size);
   if (ret != 0) {
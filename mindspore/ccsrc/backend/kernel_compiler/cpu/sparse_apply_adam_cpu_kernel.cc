@@ -23,59 +23,24 @@ namespace {
 constexpr size_t kSparseApplyAdamInputSize = 11;
 
 template <typename T>
-void ComputeAdam(MultiThreadComputeParams<T> *input_params, size_t start, size_t end) {
-  MS_EXCEPTION_IF_NULL(input_params);
-  auto m = input_params->m_;
-  auto m_t = input_params->m_t_;
-  auto v = input_params->v_;
-  const auto beta1 = input_params->beta1_;
-  const auto beta2 = input_params->beta2_;
-  const auto use_nesterov = input_params->use_nesterov_;
-  const auto unique_sparse_grad = input_params->sparse_grad_;
-  const auto var_first_dim_size = input_params->var_first_dim_size_;
-  const auto var_outer_dim_size = input_params->var_outer_dim_size_;
-  for (size_t i = start; i < end; ++i) {
-    T index = unique_sparse_grad.indices_[i];
-    if (index < 0 || LongToSize(index) >= var_first_dim_size) {
-      MS_LOG(EXCEPTION) << "Index " << index << " in indices is out of range after unique process";
-    }
-    size_t start_index = var_outer_dim_size * index;
-    size_t end_index = start_index + var_outer_dim_size;
-    for (size_t j = start_index, k = var_outer_dim_size * i; j < end_index; ++j, ++k) {
-      auto summed_grad = unique_sparse_grad.value_[k];
-      m[j] += (1 - beta1) * summed_grad;
-      v[j] += (1 - beta2) * summed_grad * summed_grad;
-      if (use_nesterov) {
-        m_t[j] = m[j] * beta1 + (1 - beta1) * summed_grad;
-      }
-    }
-  }
+void ComputeAdam(const MultiThreadComputeParams<T> &input_params, size_t var_offset, const float *grad) {
+  AdamAccumulateRow(input_params.m_ + var_offset, input_params.v_ + var_offset, input_params.m_t_ + var_offset, grad,
+                    input_params.beta1_, input_params.beta2_, input_params.use_nesterov_,
+                    input_params.var_outer_dim_size_);
 }
 
 template <typename T>
 void ComputeMomentum(MultiThreadComputeParams<T> *input_params, size_t start, size_t end) {
   MS_EXCEPTION_IF_NULL(input_params);
-  auto m = input_params->m_;
-  auto v = input_params->v_;
-  const auto beta1 = input_params->beta1_;
-  const auto beta2 = input_params->beta2_;
-  for (size_t i = start; i < end; ++i) {
-    m[i] *= beta1;
-    v[i] *= beta2;
-  }
+  ScaleMomentum(input_params->m_ + start, input_params->v_ + start, input_params->beta1_, input_params->beta2_,
+                end - start);
 }
 
 template <typename T>
 void ComputeWeight(MultiThreadComputeParams<T> *input_params, size_t start, size_t end) {
   MS_EXCEPTION_IF_NULL(input_params);
-  auto var = input_params->var_;
-  const auto *m = input_params->m_;
-  const auto *v = input_params->v_;
-  const auto lr = input_params->lr_;
-  const auto epsilon = input_params->epsilon_;
-  for (size_t i = start; i < end; ++i) {
-    var[i] -= lr * m[i] / (std::sqrt(v[i]) + epsilon);
-  }
+  AdamWeightUpdate(input_params->var_ + start, input_params->m_ + start, input_params->v_ + start, input_params->lr_,
+                   input_params->epsilon_, end - start);
 }
 }  // namespace
 
@@ -182,7 +147,7 @@ void SparseApplyAdamCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr
   input_params.sparse_grad_ = unique_sparse_grad;
   input_params.var_first_dim_size_ = var_first_dim_size_;
   input_params.var_outer_dim_size_ = var_outer_dim_size_;
-  MultiThreadCompute<T>(ComputeAdam<T>, &input_params, unique_sparse_grad.indices_size_);
+  MultiThreadComputeRows<T>(ComputeAdam<T>, &input_params);
 
   if (use_nesterov_) {
     input_params.m_ = input_params.m_t_;
@@ -22,42 +22,10 @@ namespace kernel {
 namespace {
 constexpr size_t kSparseApplyFtrlInputSize = 5;
 template <typename T>
-void ComputeFtrl(MultiThreadComputeParams<T> *input_params, size_t start, size_t end) {
-  MS_EXCEPTION_IF_NULL(input_params);
-  auto var = input_params->var_;
-  auto accum = input_params->accum_;
-  auto linear = input_params->linear_;
-  const auto lr = input_params->lr_;
-  const auto l1 = input_params->l1_;
-  const auto l2_plus = 2 * input_params->l2_;
-  const auto lr_power = input_params->lr_power_;
-  const auto unique_sparse_grad = input_params->sparse_grad_;
-  const auto var_first_dim_size = input_params->var_first_dim_size_;
-  const auto var_outer_dim_size = input_params->var_outer_dim_size_;
-  for (size_t i = start; i < end; ++i) {
-    T index = unique_sparse_grad.indices_[i];
-    if (index < 0 || LongToSize(index) >= var_first_dim_size) {
-      MS_LOG(EXCEPTION) << "Index " << index << " in indices is out of range after unique process";
-    }
-    size_t start_index = var_outer_dim_size * index;
-    size_t end_index = start_index + var_outer_dim_size;
-    for (size_t j = start_index, k = var_outer_dim_size * i; j < end_index; ++j, ++k) {
-      auto summed_grad = unique_sparse_grad.value_[k];
-      auto accum_new = accum[j] + summed_grad * summed_grad;
-      float y;
-      if (lr_power == -0.5) {
-        y = std::sqrt(accum_new);
-        linear[j] += summed_grad - (y - std::sqrt(accum[j])) / lr * var[j];
-      } else {
-        y = std::pow(accum_new, -lr_power);
-        linear[j] += summed_grad - (y - std::pow(accum[j], -lr_power)) / lr * var[j];
-      }
-      accum[j] = accum_new;
-      auto x = Sign(linear[j]) * l1 - linear[j];
-      y = y / lr + l2_plus;
-      var[j] = std::fabs(linear[j]) > l1 ? x / y : 0;
-    }
-  }
+void ComputeFtrl(const MultiThreadComputeParams<T> &input_params, size_t var_offset, const float *grad) {
+  FtrlUpdateRow(input_params.var_ + var_offset, input_params.accum_ + var_offset, input_params.linear_ + var_offset,
+                grad, input_params.lr_, input_params.l1_, 2 * input_params.l2_, input_params.lr_power_,
+                input_params.var_outer_dim_size_);
 }
 }  // namespace
 
@@ -162,7 +130,7 @@ void SparseApplyFtrlCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr
   input_params.sparse_grad_ = unique_sparse_grad;
   input_params.var_first_dim_size_ = var_first_dim_size_;
   input_params.var_outer_dim_size_ = var_outer_dim_size_;
-  MultiThreadCompute<T>(ComputeFtrl<T>, &input_params, unique_sparse_grad.indices_size_);
+  MultiThreadComputeRows<T>(ComputeFtrl<T>, &input_params);
 }
 
 bool SparseApplyFtrlCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
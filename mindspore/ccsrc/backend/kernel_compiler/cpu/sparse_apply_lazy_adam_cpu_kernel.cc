@@ -23,37 +23,10 @@ namespace {
 constexpr size_t kSparseApplyLazyAdamInputSize = 11;
 
 template <typename T>
-void ComputeLazyAdam(MultiThreadComputeParams<T> *input_params, size_t start, size_t end) {
-  MS_EXCEPTION_IF_NULL(input_params);
-  auto var = input_params->var_;
-  auto m = input_params->m_;
-  auto v = input_params->v_;
-  const auto lr = input_params->lr_;
-  const auto beta1 = input_params->beta1_;
-  const auto beta2 = input_params->beta2_;
-  const auto epsilon = input_params->epsilon_;
-  const auto use_nesterov = input_params->use_nesterov_;
-  const auto unique_sparse_grad = input_params->sparse_grad_;
-  const auto var_first_dim_size = input_params->var_first_dim_size_;
-  const auto var_outer_dim_size = input_params->var_outer_dim_size_;
-  for (size_t i = start; i < end; ++i) {
-    T index = unique_sparse_grad.indices_[i];
-    if (index < 0 || LongToSize(index) >= var_first_dim_size) {
-      MS_LOG(EXCEPTION) << "Index " << index << " in indices is out of range";
-    }
-    size_t start_index = var_outer_dim_size * index;
-    size_t end_index = start_index + var_outer_dim_size;
-    for (size_t j = start_index, k = var_outer_dim_size * i; j < end_index; ++j, ++k) {
-      auto summed_grad = unique_sparse_grad.value_[k];
-      m[j] = beta1 * m[j] + (1 - beta1) * summed_grad;
-      v[j] = beta2 * v[j] + (1 - beta2) * summed_grad * summed_grad;
-      if (use_nesterov) {
-        var[j] -= lr * (m[j] * beta1 + (1 - beta1) * summed_grad) / (std::sqrt(v[j]) + epsilon);
-      } else {
-        var[j] -= lr * m[j] / (std::sqrt(v[j]) + epsilon);
-      }
-    }
-  }
+void ComputeLazyAdam(const MultiThreadComputeParams<T> &input_params, size_t var_offset, const float *grad) {
+  LazyAdamUpdateRow(input_params.var_ + var_offset, input_params.m_ + var_offset, input_params.v_ + var_offset, grad,
+                    input_params.lr_, input_params.beta1_, input_params.beta2_, input_params.epsilon_,
+                    input_params.use_nesterov_, input_params.var_outer_dim_size_);
 }
 }  // namespace
 
@@ -156,7 +129,7 @@ void SparseApplyLazyAdamCPUKernel::LaunchKernel(const std::vector<kernel::Addres
   input_params.sparse_grad_ = unique_sparse_grad;
   input_params.var_first_dim_size_ = var_first_dim_size_;
   input_params.var_outer_dim_size_ = var_outer_dim_size_;
-  MultiThreadCompute<T>(ComputeLazyAdam<T>, &input_params, unique_sparse_grad.indices_size_);
+  MultiThreadComputeRows<T>(ComputeLazyAdam<T>, &input_params);
 }
 
 bool SparseApplyLazyAdamCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
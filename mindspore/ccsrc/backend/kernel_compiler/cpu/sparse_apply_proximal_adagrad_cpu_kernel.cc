@@ -23,37 +23,9 @@ namespace {
 constexpr size_t kSparseApplyProximalAdagradInputSize = 7;
 
 template <typename T>
-void ComputeProximalAdagrad(MultiThreadComputeParams<T> *input_params, size_t start, size_t end) {
-  MS_EXCEPTION_IF_NULL(input_params);
-  auto var = input_params->var_;
-  auto accum = input_params->accum_;
-  const auto lr = input_params->lr_;
-  const auto l1 = input_params->l1_;
-  const auto l2 = input_params->l2_;
-  const auto unique_sparse_grad = input_params->sparse_grad_;
-  const auto var_first_dim_size = input_params->var_first_dim_size_;
-  const auto var_outer_dim_size = input_params->var_outer_dim_size_;
-  for (size_t i = start; i < end; ++i) {
-    T index = unique_sparse_grad.indices_[i];
-    if (index < 0 || LongToSize(index) >= var_first_dim_size) {
-      MS_LOG(EXCEPTION) << "Index " << index << " in indices is out of range after unique process";
-    }
-    size_t start_index = var_outer_dim_size * index;
-    size_t end_index = start_index + var_outer_dim_size;
-    for (size_t j = start_index, k = var_outer_dim_size * i; j < end_index; ++j, ++k) {
-      auto summed_grad = unique_sparse_grad.value_[k];
-      accum[j] += summed_grad * summed_grad;
-      auto learning_rate = lr * (1 / std::sqrt(accum[j]));
-      auto prox_v = var[j];
-      prox_v -= summed_grad * learning_rate;
-      if (l1 > 0) {
-        var[j] = Sign(prox_v) * std::fmax(std::fabs(prox_v) - learning_rate * l1, static_cast<float>(0.0)) /
-                 (1 + l2 * learning_rate);
-      } else {
-        var[j] = prox_v / (1 + l2 * learning_rate);
-      }
-    }
-  }
+void ComputeProximalAdagrad(const MultiThreadComputeParams<T> &input_params, size_t var_offset, const float *grad) {
+  ProximalAdagradUpdateRow(input_params.var_ + var_offset, input_params.accum_ + var_offset, grad, input_params.lr_,
+                           input_params.l1_, input_params.l2_, input_params.var_outer_dim_size_);
 }
 }  // namespace
 
@@ -150,7 +122,7 @@ void SparseApplyProximalAdagradCPUKernel::LaunchKernel(const std::vector<kernel:
   input_params.sparse_grad_ = unique_sparse_grad;
   input_params.var_first_dim_size_ = var_first_dim_size_;
   input_params.var_outer_dim_size_ = var_outer_dim_size_;
-  MultiThreadCompute<T>(ComputeProximalAdagrad<T>, &input_params, unique_sparse_grad.indices_size_);
+  MultiThreadComputeRows<T>(ComputeProximalAdagrad<T>, &input_params);
 }
 
 bool SparseApplyProximalAdagradCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -18,12 +18,12 @@
 
 #include <vector>
 #include <memory>
-#include <thread>
-#include <unordered_map>
 #include <algorithm>
 #include <utility>
+#include <cstdint>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/sparse_optimizer_row_kernels.h"
 
 namespace mindspore {
 namespace kernel {
@@ -62,7 +62,7 @@ struct MultiThreadComputeParams {
   SparseGradient<T> sparse_grad_;
   size_t var_first_dim_size_{0};
   size_t var_outer_dim_size_{0};
-  bool use_nesterov_;
+  bool use_nesterov_{false};
 };
 template <typename T>
 using MultiThreadComputeFunc = std::function<void(MultiThreadComputeParams<T> *param, size_t start, size_t end)>;
@@ -120,22 +120,64 @@ class SparseOptimizerCPUKernel : public CPUKernel {
   template <typename T>
   void MultiThreadCompute(const MultiThreadComputeFunc<T> &func, MultiThreadComputeParams<T> *params,
                           size_t total_compute_size) const {
-    const size_t kThreadNum = 24;
-    std::vector<std::thread> threads;
-    threads.reserve(kThreadNum);
-    size_t start = 0;
-    size_t once_compute_size = (total_compute_size + kThreadNum - 1) / kThreadNum;
-    while (start < total_compute_size) {
-      size_t end = (start + once_compute_size) > total_compute_size ? total_compute_size : (start + once_compute_size);
-      threads.emplace_back(std::thread(func, params, start, end));
-      start += once_compute_size;
-    }
-    for (size_t i = 0; i < threads.size(); ++i) {
-      threads[i].join();
-    }
+    // Every index updates a whole row of var_outer_dim_size_ elements.
+    size_t grain_size = std::max(kDefaultGrainSize / std::max(params->var_outer_dim_size_, static_cast<size_t>(1)),
+                                 static_cast<size_t>(1));
+    auto task = [&func, params](size_t start, size_t end) { func(params, start, end); };
+    CPUKernelUtils::ParallelFor(task, total_compute_size, grain_size);
+  }
+
+  // Call row_func(params, var_offset, grad_row) for every row of the reduced params->sparse_grad_ in parallel. While a
+  // row is updated, the states of the row kRowPrefetchDistance positions ahead are prefetched, since the unique
+  // indices scatter the rows over the whole table.
+  template <typename T, typename RowFunc>
+  void MultiThreadComputeRows(const RowFunc &row_func, MultiThreadComputeParams<T> *params) const {
+    MS_EXCEPTION_IF_NULL(params);
+    const auto &sparse_grad = params->sparse_grad_;
+    const size_t var_first_dim_size = params->var_first_dim_size_;
+    const size_t var_outer_dim_size = params->var_outer_dim_size_;
+    const float *states[] = {params->var_, params->accum_, params->linear_, params->m_, params->v_,
+                             params->use_nesterov_ ? params->m_t_ : nullptr};
+    auto task = [&](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        if (i + kRowPrefetchDistance < end) {
+          T ahead = sparse_grad.indices_[i + kRowPrefetchDistance];
+          if (ahead >= 0 && LongToSize(ahead) < var_first_dim_size) {
+            for (auto state : states) {
+              if (state != nullptr) {
+                PrefetchRow(state + var_outer_dim_size * LongToSize(ahead), var_outer_dim_size);
+              }
+            }
+          }
+        }
+        T index = sparse_grad.indices_[i];
+        if (index < 0 || LongToSize(index) >= var_first_dim_size) {
+          MS_LOG(EXCEPTION) << "Index " << index << " in indices is out of range after unique process";
+        }
+        row_func(*params, var_outer_dim_size * LongToSize(index), sparse_grad.value_ + var_outer_dim_size * i);
+      }
+    };
+    size_t grain_size =
+      std::max(kDefaultGrainSize / std::max(var_outer_dim_size, static_cast<size_t>(1)), static_cast<size_t>(1));
+    CPUKernelUtils::ParallelFor(task, sparse_grad.indices_size_, grain_size);
   }
 
  private:
+  static constexpr size_t kEmptySlot = SIZE_MAX;
+
+  // Fibonacci hashing, the indices of one bucket share their residue modulo the bucket number so the low bits alone
+  // would cluster.
+  template <typename T>
+  static size_t HashIndex(T index) {
+    return static_cast<size_t>((static_cast<uint64_t>(index) * 0x9E3779B97F4A7C15ULL) >> 32);
+  }
+
+  static void LaunchTasks(const std::vector<Task> &tasks) {
+    if (!ThreadPool::GetInstance()->LaunchMultipleTask(tasks)) {
+      MS_LOG(EXCEPTION) << "Launch " << tasks.size() << " tasks failed.";
+    }
+  }
+
   template <typename T>
   static void CalculateEachBucketSize(const std::shared_ptr<SparseGradient<T>> &sparse_grad, size_t max_index,
                                       std::vector<size_t> *each_bucket_size) {
@@ -169,8 +211,8 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     }
     size_t thread_indices_size = input_grad->indices_size_ / param.thread_num_;
     size_t left_indices_size = input_grad->indices_size_ % param.thread_num_;
-    std::vector<std::thread> threads;
-    threads.reserve(param.thread_num_);
+    std::vector<Task> tasks;
+    tasks.reserve(param.thread_num_);
     segments.reserve(param.thread_num_);
 
     size_t current_indices_offset = 0;
@@ -184,14 +226,16 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       segments[i]->value_ = input_grad->value_ + current_indices_offset * param.value_stride_;
       segments[i]->indices_ = input_grad->indices_ + current_indices_offset;
       segments[i]->indices_size_ = indices_size;
-      threads.emplace_back(
-        std::thread(CalculateEachBucketSize<T>, segments[i], param.max_index_, segment_bucket_sizes[i].get()));
+      auto segment = segments[i];
+      auto bucket_sizes = segment_bucket_sizes[i].get();
+      auto max_index = param.max_index_;
+      tasks.emplace_back([segment, max_index, bucket_sizes]() {
+        CalculateEachBucketSize<T>(segment, max_index, bucket_sizes);
+        return SUCCESS;
+      });
       current_indices_offset += indices_size;
     }
-
-    for (size_t i = 0; i < param.thread_num_; ++i) {
-      threads[i].join();
-    }
+    LaunchTasks(tasks);
   }
 
   template <typename T>
@@ -259,17 +303,19 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       }
       each_thread_buckets.emplace_back(thread_buckets);
     }
-    std::vector<std::thread> threads;
-    threads.reserve(thread_num);
+    std::vector<Task> tasks;
+    tasks.reserve(thread_num);
     current_indices_offset = 0;
     for (size_t i = 0; i < thread_num; ++i) {
-      threads.emplace_back(
-        std::thread(CopySegmentIndicesToBucket<T>, param, segments[i], current_indices_offset, each_thread_buckets[i]));
+      auto &segment = segments[i];
+      auto &thread_buckets = each_thread_buckets[i];
+      tasks.emplace_back([&param, &segment, current_indices_offset, &thread_buckets]() {
+        CopySegmentIndicesToBucket<T>(param, segment, current_indices_offset, thread_buckets);
+        return SUCCESS;
+      });
       current_indices_offset += segments[i]->indices_size_;
     }
-    for (size_t i = 0; i < thread_num; ++i) {
-      threads[i].join();
-    }
+    LaunchTasks(tasks);
   }
 
   template <typename T>
@@ -313,12 +359,13 @@ class SparseOptimizerCPUKernel : public CPUKernel {
           MS_LOG(EXCEPTION) << "Failed to copy data!";
         }
       } else {
-        for (size_t j = 0; j < param.value_stride_; ++j) {
-          reduced_bucket->value_[value_offset + j] += global_value[global_value_offset + j];
-        }
+        RowAccumulate(reduced_bucket->value_ + value_offset, global_value + global_value_offset, param.value_stride_);
       }
       last_index = index;
     }
+    if (!sorted_indices.empty()) {
+      unique_indices_size++;
+    }
     reduced_bucket->indices_size_ = unique_indices_size;
     MS_LOG(DEBUG) << "End";
   }
@@ -335,18 +382,32 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     MS_EXCEPTION_IF_NULL(reduced_bucket->value_);
     MS_EXCEPTION_IF_NULL(reduced_bucket->indices_);
 
+    // Open addressing table from index to the offset of its summed row, sized to a power of two at least twice the
+    // bucket size so probe chains stay short. It replaces a node based map whose allocations dominated for large
+    // batches of embedding ids.
+    size_t capacity = 1;
+    while (capacity < (bucket->indices_size_ << 1)) {
+      capacity <<= 1;
+    }
+    const size_t mask = capacity - 1;
+    std::vector<T> slot_indices(capacity);
+    std::vector<size_t> slot_offsets(capacity, kEmptySlot);
+
     float *global_value = param.input_grad_->value_;
-    std::unordered_map<T, size_t> index_map;
     size_t unique_indices_size = 0;
     size_t max_length = reduced_bucket->indices_size_ * param.value_stride_;
     for (size_t i = 0; i < bucket->indices_size_; ++i) {
       T index = bucket->indices_[i];
       T global_index = bucket->global_indices_[i];
-      auto iter = index_map.find(index);
-      if (iter == index_map.end()) {
+      size_t slot = HashIndex(index) & mask;
+      while (slot_offsets[slot] != kEmptySlot && slot_indices[slot] != index) {
+        slot = (slot + 1) & mask;
+      }
+      if (slot_offsets[slot] == kEmptySlot) {
         reduced_bucket->indices_[unique_indices_size] = index;
         size_t start_index = unique_indices_size * param.value_stride_;
-        index_map[index] = start_index;
+        slot_indices[slot] = index;
+        slot_offsets[slot] = start_index;
         auto ret_code =
           memcpy_s(reduced_bucket->value_ + start_index, (max_length - start_index) * sizeof(float),
                    global_value + global_index * param.value_stride_, param.value_stride_ * sizeof(float));
@@ -355,11 +416,8 @@ class SparseOptimizerCPUKernel : public CPUKernel {
         }
         unique_indices_size++;
       } else {
-        size_t start_index = iter->second;
-        size_t end_index = start_index + param.value_stride_;
-        for (size_t j = start_index, k = global_index * param.value_stride_; j < end_index; ++j, ++k) {
-          reduced_bucket->value_[j] += global_value[k];
-        }
+        RowAccumulate(reduced_bucket->value_ + slot_offsets[slot], global_value + global_index * param.value_stride_,
+                      param.value_stride_);
       }
     }
     reduced_bucket->indices_size_ = unique_indices_size;
@@ -377,8 +435,8 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     MS_EXCEPTION_IF_NULL(reduced_buckets_ptr);
     auto &reduced_buckets = *reduced_buckets_ptr;
     size_t thread_num = buckets.size();
-    std::vector<std::thread> threads;
-    threads.reserve(thread_num);
+    std::vector<Task> tasks;
+    tasks.reserve(thread_num);
 
     size_t current_indices_offset = 0;
     for (size_t i = 0; i < thread_num; ++i) {
@@ -386,16 +444,19 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       reduced_buckets[i]->value_ = param.workspace_grad_->value_ + current_indices_offset * param.value_stride_;
       reduced_buckets[i]->indices_ = param.workspace_grad_->indices_ + current_indices_offset;
       reduced_buckets[i]->indices_size_ = buckets[i]->indices_size_;
-      if (param.use_sort_reduce_) {
-        threads.emplace_back(std::thread(SortAndReduceBucketSparseGradient<T>, param, buckets[i], reduced_buckets[i]));
-      } else {
-        threads.emplace_back(std::thread(ReduceBucketSparseGradient<T>, param, buckets[i], reduced_buckets[i]));
-      }
+      auto bucket = buckets[i];
+      auto reduced_bucket = reduced_buckets[i];
+      tasks.emplace_back([&param, bucket, reduced_bucket]() {
+        if (param.use_sort_reduce_) {
+          SortAndReduceBucketSparseGradient<T>(param, bucket, reduced_bucket);
+        } else {
+          ReduceBucketSparseGradient<T>(param, bucket, reduced_bucket);
+        }
+        return SUCCESS;
+      });
       current_indices_offset += buckets[i]->indices_size_;
     }
-    for (size_t i = 0; i < thread_num; ++i) {
-      threads[i].join();
-    }
+    LaunchTasks(tasks);
   }
 
   template <typename T>
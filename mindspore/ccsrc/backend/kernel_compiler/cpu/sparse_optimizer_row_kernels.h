@@ -0,0 +1,244 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_SPARSE_OPTIMIZER_ROW_KERNELS_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_SPARSE_OPTIMIZER_ROW_KERNELS_H_
+
+#include <cmath>
+#include <cstddef>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+// Element-wise update kernels applied to one row (or a dense range) of the optimizer states. Every kernel has an
+// SSE path on x86 and a scalar path for the tail and for other targets, both computing the same expressions.
+namespace mindspore {
+namespace kernel {
+// Number of unique rows ahead of the current one whose states are prefetched.
+constexpr size_t kRowPrefetchDistance = 4;
+constexpr size_t kCacheLineFloatNum = 16;
+#ifdef __SSE__
+constexpr size_t kRowSimdWidth = 4;
+#endif
+
+inline void PrefetchRow(const float *row, size_t len) {
+  if (row == nullptr) {
+    return;
+  }
+#if defined(__GNUC__)
+  for (size_t i = 0; i < len; i += kCacheLineFloatNum) {
+    __builtin_prefetch(row + i, 1, 3);
+  }
+#endif
+}
+
+// dst += src
+inline void RowAccumulate(float *dst, const float *src, size_t len) {
+  size_t i = 0;
+#ifdef __SSE__
+  for (; i + kRowSimdWidth <= len; i += kRowSimdWidth) {
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+  }
+#endif
+  for (; i < len; ++i) {
+    dst[i] += src[i];
+  }
+}
+
+// m *= beta1, v *= beta2
+inline void ScaleMomentum(float *m, float *v, float beta1, float beta2, size_t len) {
+  size_t i = 0;
+#ifdef __SSE__
+  const __m128 beta1_vec = _mm_set1_ps(beta1);
+  const __m128 beta2_vec = _mm_set1_ps(beta2);
+  for (; i + kRowSimdWidth <= len; i += kRowSimdWidth) {
+    _mm_storeu_ps(m + i, _mm_mul_ps(_mm_loadu_ps(m + i), beta1_vec));
+    _mm_storeu_ps(v + i, _mm_mul_ps(_mm_loadu_ps(v + i), beta2_vec));
+  }
+#endif
+  for (; i < len; ++i) {
+    m[i] *= beta1;
+    v[i] *= beta2;
+  }
+}
+
+// m += (1 - beta1) * g, v += (1 - beta2) * g * g, and m_t = beta1 * m + (1 - beta1) * g for nesterov.
+inline void AdamAccumulateRow(float *m, float *v, float *m_t, const float *grad, float beta1, float beta2,
+                              bool use_nesterov, size_t len) {
+  size_t i = 0;
+#ifdef __SSE__
+  const __m128 beta1_vec = _mm_set1_ps(beta1);
+  const __m128 one_sub_beta1 = _mm_set1_ps(1 - beta1);
+  const __m128 one_sub_beta2 = _mm_set1_ps(1 - beta2);
+  for (; i + kRowSimdWidth <= len; i += kRowSimdWidth) {
+    __m128 g = _mm_loadu_ps(grad + i);
+    __m128 scaled_g = _mm_mul_ps(one_sub_beta1, g);
+    __m128 m_new = _mm_add_ps(_mm_loadu_ps(m + i), scaled_g);
+    _mm_storeu_ps(m + i, m_new);
+    _mm_storeu_ps(v + i, _mm_add_ps(_mm_loadu_ps(v + i), _mm_mul_ps(_mm_mul_ps(one_sub_beta2, g), g)));
+    if (use_nesterov) {
+      _mm_storeu_ps(m_t + i, _mm_add_ps(_mm_mul_ps(m_new, beta1_vec), scaled_g));
+    }
+  }
+#endif
+  for (; i < len; ++i) {
+    auto summed_grad = grad[i];
+    m[i] += (1 - beta1) * summed_grad;
+    v[i] += (1 - beta2) * summed_grad * summed_grad;
+    if (use_nesterov) {
+      m_t[i] = m[i] * beta1 + (1 - beta1) * summed_grad;
+    }
+  }
+}
+
+// var -= lr * m / (sqrt(v) + epsilon)
+inline void AdamWeightUpdate(float *var, const float *m, const float *v, float lr, float epsilon, size_t len) {
+  size_t i = 0;
+#ifdef __SSE__
+  const __m128 lr_vec = _mm_set1_ps(lr);
+  const __m128 epsilon_vec = _mm_set1_ps(epsilon);
+  for (; i + kRowSimdWidth <= len; i += kRowSimdWidth) {
+    __m128 denom = _mm_add_ps(_mm_sqrt_ps(_mm_loadu_ps(v + i)), epsilon_vec);
+    __m128 delta = _mm_div_ps(_mm_mul_ps(lr_vec, _mm_loadu_ps(m + i)), denom);
+    _mm_storeu_ps(var + i, _mm_sub_ps(_mm_loadu_ps(var + i), delta));
+  }
+#endif
+  for (; i < len; ++i) {
+    var[i] -= lr * m[i] / (std::sqrt(v[i]) + epsilon);
+  }
+}
+
+inline void LazyAdamUpdateRow(float *var, float *m, float *v, const float *grad, float lr, float beta1, float beta2,
+                              float epsilon, bool use_nesterov, size_t len) {
+  size_t i = 0;
+#ifdef __SSE__
+  const __m128 lr_vec = _mm_set1_ps(lr);
+  const __m128 beta1_vec = _mm_set1_ps(beta1);
+  const __m128 beta2_vec = _mm_set1_ps(beta2);
+  const __m128 one_sub_beta1 = _mm_set1_ps(1 - beta1);
+  const __m128 one_sub_beta2 = _mm_set1_ps(1 - beta2);
+  const __m128 epsilon_vec = _mm_set1_ps(epsilon);
+  for (; i + kRowSimdWidth <= len; i += kRowSimdWidth) {
+    __m128 g = _mm_loadu_ps(grad + i);
+    __m128 scaled_g = _mm_mul_ps(one_sub_beta1, g);
+    __m128 m_new = _mm_add_ps(_mm_mul_ps(beta1_vec, _mm_loadu_ps(m + i)), scaled_g);
+    __m128 v_new =
+      _mm_add_ps(_mm_mul_ps(beta2_vec, _mm_loadu_ps(v + i)), _mm_mul_ps(_mm_mul_ps(one_sub_beta2, g), g));
+    _mm_storeu_ps(m + i, m_new);
+    _mm_storeu_ps(v + i, v_new);
+    __m128 numer = use_nesterov ? _mm_add_ps(_mm_mul_ps(m_new, beta1_vec), scaled_g) : m_new;
+    __m128 denom = _mm_add_ps(_mm_sqrt_ps(v_new), epsilon_vec);
+    _mm_storeu_ps(var + i, _mm_sub_ps(_mm_loadu_ps(var + i), _mm_div_ps(_mm_mul_ps(lr_vec, numer), denom)));
+  }
+#endif
+  for (; i < len; ++i) {
+    auto summed_grad = grad[i];
+    m[i] = beta1 * m[i] + (1 - beta1) * summed_grad;
+    v[i] = beta2 * v[i] + (1 - beta2) * summed_grad * summed_grad;
+    if (use_nesterov) {
+      var[i] -= lr * (m[i] * beta1 + (1 - beta1) * summed_grad) / (std::sqrt(v[i]) + epsilon);
+    } else {
+      var[i] -= lr * m[i] / (std::sqrt(v[i]) + epsilon);
+    }
+  }
+}
+
+// The SSE path only covers lr_power == -0.5, other powers need std::pow and stay scalar.
+inline void FtrlUpdateRow(float *var, float *accum, float *linear, const float *grad, float lr, float l1,
+                          float l2_plus, float lr_power, size_t len) {
+  size_t i = 0;
+  bool is_sqrt = lr_power == -0.5;
+#ifdef __SSE__
+  if (is_sqrt) {
+    const __m128 lr_vec = _mm_set1_ps(lr);
+    const __m128 l1_vec = _mm_set1_ps(l1);
+    const __m128 l2_plus_vec = _mm_set1_ps(l2_plus);
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    for (; i + kRowSimdWidth <= len; i += kRowSimdWidth) {
+      __m128 g = _mm_loadu_ps(grad + i);
+      __m128 accum_old = _mm_loadu_ps(accum + i);
+      __m128 accum_new = _mm_add_ps(accum_old, _mm_mul_ps(g, g));
+      __m128 y = _mm_sqrt_ps(accum_new);
+      __m128 sigma = _mm_mul_ps(_mm_div_ps(_mm_sub_ps(y, _mm_sqrt_ps(accum_old)), lr_vec), _mm_loadu_ps(var + i));
+      __m128 linear_new = _mm_add_ps(_mm_loadu_ps(linear + i), _mm_sub_ps(g, sigma));
+      _mm_storeu_ps(linear + i, linear_new);
+      _mm_storeu_ps(accum + i, accum_new);
+      __m128 x = _mm_sub_ps(_mm_or_ps(_mm_and_ps(linear_new, sign_mask), l1_vec), linear_new);
+      y = _mm_add_ps(_mm_div_ps(y, lr_vec), l2_plus_vec);
+      __m128 keep = _mm_cmpgt_ps(_mm_andnot_ps(sign_mask, linear_new), l1_vec);
+      _mm_storeu_ps(var + i, _mm_and_ps(keep, _mm_div_ps(x, y)));
+    }
+  }
+#endif
+  for (; i < len; ++i) {
+    auto summed_grad = grad[i];
+    auto accum_new = accum[i] + summed_grad * summed_grad;
+    float y;
+    if (is_sqrt) {
+      y = std::sqrt(accum_new);
+      linear[i] += summed_grad - (y - std::sqrt(accum[i])) / lr * var[i];
+    } else {
+      y = std::pow(accum_new, -lr_power);
+      linear[i] += summed_grad - (y - std::pow(accum[i], -lr_power)) / lr * var[i];
+    }
+    accum[i] = accum_new;
+    auto x = std::copysign(l1, linear[i]) - linear[i];
+    y = y / lr + l2_plus;
+    var[i] = std::fabs(linear[i]) > l1 ? x / y : 0;
+  }
+}
+
+inline void ProximalAdagradUpdateRow(float *var, float *accum, const float *grad, float lr, float l1, float l2,
+                                     size_t len) {
+  size_t i = 0;
+#ifdef __SSE__
+  const __m128 lr_vec = _mm_set1_ps(lr);
+  const __m128 l1_vec = _mm_set1_ps(l1);
+  const __m128 l2_vec = _mm_set1_ps(l2);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  for (; i + kRowSimdWidth <= len; i += kRowSimdWidth) {
+    __m128 g = _mm_loadu_ps(grad + i);
+    __m128 accum_new = _mm_add_ps(_mm_loadu_ps(accum + i), _mm_mul_ps(g, g));
+    _mm_storeu_ps(accum + i, accum_new);
+    __m128 learning_rate = _mm_mul_ps(lr_vec, _mm_div_ps(one, _mm_sqrt_ps(accum_new)));
+    __m128 prox_v = _mm_sub_ps(_mm_loadu_ps(var + i), _mm_mul_ps(g, learning_rate));
+    __m128 denom = _mm_add_ps(one, _mm_mul_ps(l2_vec, learning_rate));
+    if (l1 > 0) {
+      __m128 shrunk = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(sign_mask, prox_v), _mm_mul_ps(learning_rate, l1_vec)), zero);
+      prox_v = _mm_or_ps(_mm_and_ps(prox_v, sign_mask), shrunk);
+    }
+    _mm_storeu_ps(var + i, _mm_div_ps(prox_v, denom));
+  }
+#endif
+  for (; i < len; ++i) {
+    auto summed_grad = grad[i];
+    accum[i] += summed_grad * summed_grad;
+    auto learning_rate = lr * (1 / std::sqrt(accum[i]));
+    auto prox_v = var[i];
+    prox_v -= summed_grad * learning_rate;
+    if (l1 > 0) {
+      var[i] = std::copysign(std::fmax(std::fabs(prox_v) - learning_rate * l1, 0.0f), prox_v) /
+               (1 + l2 * learning_rate);
+    } else {
+      var[i] = prox_v / (1 + l2 * learning_rate);
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_SPARSE_OPTIMIZER_ROW_KERNELS_H_
@@ -344,8 +344,8 @@ void AscendSession::RunOpHardwareOptimize(const std::shared_ptr<session::KernelG
   MS_LOG(INFO) << "Finish";
 }
 
-bool AscendSession::GraphCacheExist(const GraphInfo &graph_info) const {
-  return run_op_graphs_.find(graph_info) != run_op_graphs_.end();
+bool AscendSession::GraphCacheExist(const GraphInfo &graph_info) {
+  return run_op_graphs_.Lookup(graph_info) != nullptr;
 }
 
 void AscendSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
@@ -370,13 +370,13 @@ void AscendSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &g
   // build kernel
   RunOpAdjustKernel(graph);
   BuildKernel(graph);
-  run_op_graphs_[graph_info] = graph;
+  run_op_graphs_.Put(graph_info, graph);
   MS_LOG(INFO) << "Build op " << op_run_info.op_name << " finish !";
 }
 
 void AscendSession::RunOpImpl(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
                               const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *outputs) {
-  auto graph = run_op_graphs_[graph_info];
+  auto graph = run_op_graphs_.Get(graph_info);
   MS_EXCEPTION_IF_NULL(graph);
   MS_LOG(INFO) << "Run op " << op_run_info.op_name << " start!";
   // malloc mem
@@ -114,7 +114,7 @@ class AscendSession : public SessionBasic {
   // get graph order type vector by graph id
   const std::vector<GraphType> &GetGraphOrderType(GraphId final_graph_id) const;
   // check if graph cache exist
-  bool GraphCacheExist(const GraphInfo &graph_info) const;
+  bool GraphCacheExist(const GraphInfo &graph_info);
   // insert all assign to child graph
   void InsertAllAssigns();
   // sync intial tensors' data to device
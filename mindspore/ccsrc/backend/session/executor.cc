@@ -19,6 +19,8 @@
 #include "runtime/device/kernel_runtime_manager.h"
 #include "utils/comm_manager.h"
 #include "utils/scoped_long_running.h"
+#include "utils/utils.h"
+#include "securec/include/securec.h"
 
 namespace mindspore {
 namespace session {
@@ -70,6 +72,57 @@ void NotifyOutputTensors(const VectorRef *outputs) {
   }
 }
 
+// Hand the result of an asynchronous op over to the tensor returned for it, keeping the id the frontend knows it by.
+void MoveOpResultTensor(const tensor::TensorPtr &result, const tensor::TensorPtr &output) {
+  MS_EXCEPTION_IF_NULL(result);
+  MS_EXCEPTION_IF_NULL(output);
+  if (output->shape() != result->shape()) {
+    MS_LOG(EXCEPTION) << "The output shape " << output->shape() << " of the op differs from the inferred shape "
+                      << result->shape();
+  }
+  // The kernel may compute in another type than the inferred one.
+  if (output->data_type() != result->data_type()) {
+    (void)output->set_data_type(result->data_type());
+  }
+  output->set_device_address(result->device_address());
+  output->set_sync_status(result->sync_status());
+  if (result->device_address() == nullptr) {
+    // a value node or an input passed through, which only lives on host
+    auto ret = memcpy_s(output->data_c(), output->data().nbytes(), result->data_c(), result->data().nbytes());
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Copy the op output failed, ret " << ret;
+    }
+  }
+}
+
+void MoveOpResultTensors(const VectorRef &results, const VectorRef *outputs) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  if (results.size() != outputs->size()) {
+    MS_LOG(EXCEPTION) << "The op has " << results.size() << " outputs, but " << outputs->size() << " are inferred";
+  }
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (!utils::isa<tensor::TensorPtr>(results[i]) || !utils::isa<tensor::TensorPtr>((*outputs)[i])) {
+      MS_LOG(EXCEPTION) << "The output " << i << " of the op is not a tensor";
+    }
+    MoveOpResultTensor(utils::cast<tensor::TensorPtr>(results[i]), utils::cast<tensor::TensorPtr>((*outputs)[i]));
+  }
+}
+
+void EraseValueNodeTensors(const std::vector<int> &tensors_mask, std::vector<tensor::TensorPtr> *input_tensors) {
+  MS_EXCEPTION_IF_NULL(input_tensors);
+  if (input_tensors->size() != tensors_mask.size()) {
+    MS_LOG(EXCEPTION) << "Input tensors size " << input_tensors->size() << " should be equal to tensors mask size "
+                      << tensors_mask.size();
+  }
+  std::vector<tensor::TensorPtr> new_input_tensors;
+  for (size_t index = 0; index < tensors_mask.size(); ++index) {
+    if (tensors_mask[index] != kValueNodeTensorMask) {
+      new_input_tensors.push_back(input_tensors->at(index));
+    }
+  }
+  *input_tensors = new_input_tensors;
+}
+
 bool TensorInVector(const VectorRef *outputs) {
   MS_EXCEPTION_IF_NULL(outputs);
   for (auto item : *outputs) {
@@ -127,6 +180,26 @@ void RunOpTask::Run() {
   session_->RunOpImpl(*op_run_info_, graph_info_, input_tensors_, &outputs_);
 }
 
+void BuildRunOpTask::Run() {
+  MS_EXCEPTION_IF_NULL(session_);
+  // The frontend is already dispatching the next ops when this one runs, so the flag only applies to this thread.
+  MsContext::set_thread_pynative_infer(pynative_infer_);
+  try {
+    // The producers of the inputs have run by now, so their device addresses are known.
+    auto graph_info = HashSingleOpInputs(input_tensors_, attrs_info_);
+    session_->BuildOpImpl(op_run_info_, graph_info, input_tensors_, tensors_mask_);
+    EraseValueNodeTensors(tensors_mask_, &input_tensors_);
+    session_->RunOpImpl(op_run_info_, graph_info, input_tensors_, &results_);
+    if (!sync_run_) {
+      MoveOpResultTensors(results_, &outputs_);
+    }
+  } catch (const std::exception &e) {
+    MsException::GetInstance().SetException();
+  }
+  MsContext::reset_thread_pynative_infer();
+  NotifyOutputTensors(&outputs_);
+}
+
 void CreateCommGroupTask::Run() { result_ = CommManager::GetInstance().CreateGroupSync(group_name_, ranks_); }
 
 void DestroyCommGroupTask::Run() { result_ = CommManager::GetInstance().DestroyGroup(group_name_); }
@@ -170,7 +243,7 @@ void Executor::WorkerLoop() {
     } catch (const std::exception &e) {
       MsException::GetInstance().SetException();
     }
-    if (task->type_ != kRunGraph || task->sync_run_) {
+    if ((task->type_ != kRunGraph && task->type_ != kBuildRunOp) || task->sync_run_) {
       task = nullptr;
       sync_cond_var_.notify_all();
     } else {
@@ -330,6 +403,44 @@ void Executor::RunOp(const SessionPtr &session, OpRunInfo *op_run_info, const Gr
   *outputs = task->outputs_;
 }
 
+void Executor::BuildAndRunOp(const SessionPtr &session, const OpRunInfo &op_run_info, const GraphInfo &attrs_info,
+                             const std::vector<tensor::TensorPtr> &input_tensors,
+                             const std::vector<int> &tensors_mask, VectorRef *outputs) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  auto task = std::make_shared<BuildRunOpTask>();
+  task->session_ = session;
+  task->op_run_info_ = op_run_info;
+  task->attrs_info_ = attrs_info;
+  task->input_tensors_ = input_tensors;
+  task->tensors_mask_ = tensors_mask;
+  task->sync_run_ = true;
+  SyncRunTask(task);
+  *outputs = task->results_;
+}
+
+void Executor::RunOpAsync(const SessionPtr &session, const OpRunInfo &op_run_info, const GraphInfo &attrs_info,
+                          const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask,
+                          const VectorRef &outputs) {
+  auto task = std::make_shared<BuildRunOpTask>();
+  task->session_ = session;
+  task->op_run_info_ = op_run_info;
+  task->attrs_info_ = attrs_info;
+  task->input_tensors_ = input_tensors;
+  task->tensors_mask_ = tensors_mask;
+  task->outputs_ = outputs;
+  // Outputs of ops queued before are ready when this task runs, only a graph still pending can be behind it.
+  for (auto &tensor : input_tensors) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    if (tensor->NeedWait() && tensor->IsGraphOutput()) {
+      mindspore::ScopedLongRunning long_running;
+      tensor->Wait();
+    }
+  }
+  std::unique_lock<std::mutex> lock(task_mutex_);
+  ready_tasks_.push(task);
+  task_cond_var_.notify_all();
+}
+
 bool Executor::CreateCommGroup(const std::string &group_name, std::vector<uint32_t> ranks) {
   auto task = std::make_shared<CreateCommGroupTask>();
   task->group_name_ = group_name;
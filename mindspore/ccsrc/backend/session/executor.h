@@ -44,6 +44,7 @@ enum TaskType {
   kBuildOp,
   kRunGraph,
   kRunOp,
+  kBuildRunOp,
   kCreateCommGroup,
   kDestroyCommGroup
 };
@@ -104,7 +105,7 @@ class BuildOpTask : public Task {
   ~BuildOpTask() override = default;
   void Run() override;
   OpRunInfo *op_run_info_{nullptr};
-  GraphInfo graph_info_;
+  GraphInfo graph_info_{0};
   std::vector<tensor::TensorPtr> input_tensors_;
   std::vector<int> tensors_mask_;
 };
@@ -115,11 +116,27 @@ class RunOpTask : public Task {
   ~RunOpTask() override = default;
   void Run() override;
   OpRunInfo *op_run_info_{nullptr};
-  GraphInfo graph_info_;
+  GraphInfo graph_info_{0};
   std::vector<tensor::TensorPtr> input_tensors_;
   VectorRef outputs_;
 };
 
+class BuildRunOpTask : public Task {
+ public:
+  BuildRunOpTask() { type_ = kBuildRunOp; }
+  ~BuildRunOpTask() override = default;
+  void Run() override;
+  OpRunInfo op_run_info_;
+  GraphInfo attrs_info_{0};
+  std::vector<tensor::TensorPtr> input_tensors_;
+  std::vector<int> tensors_mask_;
+  // the MS_CTX_ENABLE_PYNATIVE_INFER value the op is built and run with
+  bool pynative_infer_{true};
+  // the tensors returned to the caller before the op is run, empty if the caller waits for the task
+  VectorRef outputs_;
+  VectorRef results_;
+};
+
 class CreateCommGroupTask : public Task {
  public:
   CreateCommGroupTask() { type_ = kCreateCommGroup; }
@@ -162,6 +179,12 @@ class Executor {
                const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask);
   void RunOp(const SessionPtr &session, OpRunInfo *op_run_info, const GraphInfo &graph_info,
              const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *outputs);
+  void BuildAndRunOp(const SessionPtr &session, const OpRunInfo &op_run_info, const GraphInfo &attrs_info,
+                     const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask,
+                     VectorRef *outputs);
+  void RunOpAsync(const SessionPtr &session, const OpRunInfo &op_run_info, const GraphInfo &attrs_info,
+                  const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask,
+                  const VectorRef &outputs);
   void OnRunGraphFinished();
   bool CreateCommGroup(const std::string &group_name, std::vector<uint32_t> ranks);
   bool DestroyCommGroup(const std::string &group_name);
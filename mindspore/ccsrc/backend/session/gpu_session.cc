@@ -312,7 +312,7 @@ void GPUSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &grap
                              const std::vector<tensor::TensorPtr> &input_tensors,
                              const std::vector<int> &tensors_mask) {
   // Check if the graph cache exists.
-  if (run_op_graphs_.find(graph_info) != run_op_graphs_.end()) {
+  if (run_op_graphs_.Lookup(graph_info) != nullptr) {
     return;
   }
   // Prepare the graph
@@ -323,12 +323,12 @@ void GPUSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &grap
   // Hide NopOp from execution graph
   opt::HideNopNode(kernel_graph.get());
   BuildKernel(kernel_graph);
-  run_op_graphs_[graph_info] = kernel_graph;
+  run_op_graphs_.Put(graph_info, kernel_graph);
 }
 
 void GPUSession::RunOpImpl(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
                            const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *outputs) {
-  auto kernel_graph = run_op_graphs_[graph_info];
+  auto kernel_graph = run_op_graphs_.Get(graph_info);
   MS_EXCEPTION_IF_NULL(kernel_graph);
   // Remove NopOp from execution graph
   opt::RemoveNopNode(kernel_graph.get());
@@ -155,14 +155,13 @@ Status ServingTensor2MSTensor(size_t index, const InferTensorBase &out_tensor, t
                                         << " data size not match shape and dtype, calculated required size "
                                         << ms_tensor->Size() << ", given " << out_tensor.data_size();
   }
-  if (out_tensor.data() == nullptr || ms_tensor->data_c() == nullptr) {
+  if (out_tensor.data() == nullptr) {
     MSI_LOG_ERROR << "invalid data buffer";
     return FAILED;
   }
-  auto ret_code = memcpy_s(ms_tensor->data_c(), ms_tensor->Size(), out_tensor.data(), out_tensor.data_size());
-  if (ret_code != 0) {
-    MS_LOG(ERROR) << "Failed to copy data from ms_tensor to out_tensor.";
-  }
+  // The request outlives the graph run, so the tensor uses the request buffer in place instead of a copy.
+  ms_tensor = std::make_shared<tensor::Tensor>(data_type, shape, const_cast<void *>(out_tensor.data()),
+                                               out_tensor.data_size(), nullptr);
   return SUCCESS;
 }
 
@@ -46,6 +46,28 @@ namespace mindspore {
 namespace session {
 static std::shared_ptr<std::map<ValuePtr, ParameterPtr>> python_paras;
 void ClearPythonParasMap() { python_paras = nullptr; }
+
+GraphInfo HashSingleOpInputs(const std::vector<tensor::TensorPtr> &input_tensors, GraphInfo seed) {
+  GraphInfo graph_info = hash_combine(seed, input_tensors.size());
+  for (const auto &tensor : input_tensors) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    const auto &tensor_shape = tensor->shape();
+    graph_info = hash_combine(graph_info, tensor_shape.size());
+    for (auto dim : tensor_shape) {
+      graph_info = hash_combine(graph_info, std::hash<int>{}(dim));
+    }
+    graph_info = hash_combine(graph_info, std::hash<int>{}(static_cast<int>(tensor->data_type())));
+    auto device_address = dynamic_cast<const device::DeviceAddress *>(tensor->device_address().get());
+    if (device_address == nullptr) {
+      graph_info = hash_combine(graph_info, 0);
+      continue;
+    }
+    graph_info = hash_combine(graph_info, std::hash<int>{}(static_cast<int>(device_address->type_id())) + 1);
+    graph_info = hash_combine(graph_info, std::hash<std::string>{}(device_address->format()));
+  }
+  return graph_info;
+}
+
 namespace {
 const int kSummaryGetItem = 2;
 
@@ -1393,6 +1415,20 @@ void SessionBasic::RunOp(OpRunInfo *op_run_info, const GraphInfo &graph_info,
   executor_->RunOp(shared_from_this(), op_run_info, graph_info, input_tensors, outputs);
 }
 
+void SessionBasic::BuildAndRunOp(const OpRunInfo &op_run_info, const GraphInfo &attrs_info,
+                                 const std::vector<tensor::TensorPtr> &input_tensors,
+                                 const std::vector<int> &tensors_mask, VectorRef *outputs) {
+  MS_EXCEPTION_IF_NULL(executor_);
+  executor_->BuildAndRunOp(shared_from_this(), op_run_info, attrs_info, input_tensors, tensors_mask, outputs);
+}
+
+void SessionBasic::RunOpAsync(const OpRunInfo &op_run_info, const GraphInfo &attrs_info,
+                              const std::vector<tensor::TensorPtr> &input_tensors,
+                              const std::vector<int> &tensors_mask, const VectorRef &outputs) {
+  MS_EXCEPTION_IF_NULL(executor_);
+  executor_->RunOpAsync(shared_from_this(), op_run_info, attrs_info, input_tensors, tensors_mask, outputs);
+}
+
 void SessionBasic::RunGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) {
   MS_EXCEPTION_IF_NULL(executor_);
   executor_->RunGraph(shared_from_this(), graph_id, inputs, outputs);
@@ -25,6 +25,7 @@
 #include "backend/session/session_context.h"
 #include "backend/session/kernel_graph.h"
 #include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/single_op_graph_cache.h"
 #include "ir/anf.h"
 #include "ir/tensor.h"
 #include "utils/any.h"
@@ -37,7 +38,6 @@
 
 namespace mindspore {
 using GraphId = uint32_t;
-using GraphInfo = std::string;
 namespace session {
 void ClearPythonParasMap();
 using CallBackFunc = uint32_t (*)(uint32_t graph_id,
@@ -52,6 +52,10 @@ struct OpRunInfo {
   ValuePtr value = nullptr;
 };
 using OpRunInfoPtr = std::shared_ptr<OpRunInfo>;
+// Fold the shapes, types and device formats of the input tensors into the cache key of a single op graph, seed is the
+// hash of the op and its attrs. It reads the device addresses of the inputs, so for an asynchronous op it is computed
+// when the producers of the inputs have run.
+GraphInfo HashSingleOpInputs(const std::vector<tensor::TensorPtr> &input_tensors, GraphInfo seed);
 class Executor;
 class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
  public:
@@ -75,9 +79,21 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   void BuildOp(OpRunInfo *, const GraphInfo &, const std::vector<tensor::TensorPtr> &input_tensors,
                const std::vector<int> &tensors_mask);
   void RunOp(OpRunInfo *, const GraphInfo &, const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *outputs);
+  // Build and run a single op after the asynchronous ops queued before it, attrs_info is the hash of the op and its
+  // attrs which HashSingleOpInputs completes to the graph info.
+  void BuildAndRunOp(const OpRunInfo &op_run_info, const GraphInfo &attrs_info,
+                     const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask,
+                     VectorRef *outputs);
+  // Queue a single op and return at once. The results are moved into the output tensors, which are created by the
+  // caller from the inferred abstract and waited on by their readers.
+  void RunOpAsync(const OpRunInfo &op_run_info, const GraphInfo &attrs_info,
+                  const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask,
+                  const VectorRef &outputs);
 
   virtual void RegisterSummaryCallBackFunc(const CallBackFunc &callback);
 
+  const SingleOpGraphCache &run_op_graphs() const { return run_op_graphs_; }
+
   void CreateCNodeKernelGraph(const AnfNodePtr node, KernelGraphPtr graph);
 
   std::shared_ptr<KernelGraph> ConstructKernelGraph(const AnfNodePtrList &lst, const AnfNodePtrList &outputs);
@@ -128,6 +144,7 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   friend class RunGraphTask;
   friend class BuildOpTask;
   friend class RunOpTask;
+  friend class BuildRunOpTask;
   virtual void CreateOutputTensors(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &input_tensors,
                                    VectorRef *outputs,
                                    std::map<tensor::TensorPtr, session::KernelWithIndex> *tensor_to_node);
@@ -175,7 +192,7 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   void UpdateGraphDynamicShapeAttr(const NotNull<KernelGraphPtr> &root_graph);
 
   std::unordered_map<GraphId, std::shared_ptr<KernelGraph>> graphs_;
-  std::unordered_map<GraphInfo, std::shared_ptr<KernelGraph>> run_op_graphs_;
+  SingleOpGraphCache run_op_graphs_;
   std::unordered_map<FuncGraphPtr, KernelGraphPtr> front_backend_graph_map_;
   std::shared_ptr<Context> context_;
   CallBackFunc summary_callback_;
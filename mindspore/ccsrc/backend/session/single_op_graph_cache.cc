@@ -0,0 +1,78 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/session/single_op_graph_cache.h"
+
+namespace mindspore {
+namespace session {
+KernelGraphPtr SingleOpGraphCache::Lookup(const GraphInfo &graph_info) {
+  auto iter = index_.find(graph_info);
+  if (iter == index_.end()) {
+    misses_++;
+    return nullptr;
+  }
+  hits_++;
+  graphs_.splice(graphs_.begin(), graphs_, iter->second);
+  return iter->second->second;
+}
+
+KernelGraphPtr SingleOpGraphCache::Get(const GraphInfo &graph_info) const {
+  auto iter = index_.find(graph_info);
+  if (iter == index_.end()) {
+    return nullptr;
+  }
+  return iter->second->second;
+}
+
+void SingleOpGraphCache::Put(const GraphInfo &graph_info, const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto iter = index_.find(graph_info);
+  if (iter != index_.end()) {
+    iter->second->second = graph;
+    graphs_.splice(graphs_.begin(), graphs_, iter->second);
+    return;
+  }
+  graphs_.emplace_front(graph_info, graph);
+  index_[graph_info] = graphs_.begin();
+  while (graphs_.size() > capacity_) {
+    Evict();
+  }
+}
+
+void SingleOpGraphCache::Clear() {
+  graphs_.clear();
+  index_.clear();
+}
+
+void SingleOpGraphCache::set_capacity(size_t capacity) {
+  if (capacity == 0) {
+    MS_LOG(EXCEPTION) << "The capacity of the single op graph cache should be positive";
+  }
+  capacity_ = capacity;
+  while (graphs_.size() > capacity_) {
+    Evict();
+  }
+}
+
+void SingleOpGraphCache::Evict() {
+  auto &last = graphs_.back();
+  MS_LOG(DEBUG) << "Drop the single op graph " << last.first << " from the cache, hits " << hits_ << ", misses "
+                << misses_;
+  (void)index_.erase(last.first);
+  graphs_.pop_back();
+  evictions_++;
+}
+}  // namespace session
+}  // namespace mindspore
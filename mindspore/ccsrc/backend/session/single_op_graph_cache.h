@@ -0,0 +1,67 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_SESSION_SINGLE_OP_GRAPH_CACHE_H_
+#define MINDSPORE_CCSRC_BACKEND_SESSION_SINGLE_OP_GRAPH_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include "backend/session/kernel_graph.h"
+
+namespace mindspore {
+// Key of the graph built for a single op, a hash of the op, its attrs and the shapes, types and formats of its inputs.
+using GraphInfo = uint64_t;
+namespace session {
+constexpr size_t kDefaultSingleOpGraphCacheSize = 1024;
+
+// The kernel graphs built for single ops in PyNative mode. When the cache is full, the least recently used graph is
+// dropped, so that the shapes seen by a long running session do not pile up.
+class SingleOpGraphCache {
+ public:
+  explicit SingleOpGraphCache(size_t capacity = kDefaultSingleOpGraphCacheSize) : capacity_(capacity) {}
+  ~SingleOpGraphCache() = default;
+
+  // Return the graph of graph_info and mark it as the most recently used one, nullptr if it is not cached. Counted as
+  // a hit or a miss.
+  KernelGraphPtr Lookup(const GraphInfo &graph_info);
+  // Return the graph of graph_info without touching the counters or the order, nullptr if it is not cached.
+  KernelGraphPtr Get(const GraphInfo &graph_info) const;
+  // Insert the graph as the most recently used one, dropping the least recently used graph if the cache is full.
+  void Put(const GraphInfo &graph_info, const KernelGraphPtr &graph);
+  void Clear();
+
+  size_t size() const { return graphs_.size(); }
+  size_t capacity() const { return capacity_; }
+  void set_capacity(size_t capacity);
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+  uint64_t evictions() const { return evictions_; }
+
+ private:
+  void Evict();
+
+  size_t capacity_;
+  // from the most to the least recently used
+  std::list<std::pair<GraphInfo, KernelGraphPtr>> graphs_;
+  std::unordered_map<GraphInfo, std::list<std::pair<GraphInfo, KernelGraphPtr>>::iterator> index_;
+  uint64_t hits_{0};
+  uint64_t misses_{0};
+  uint64_t evictions_{0};
+};
+}  // namespace session
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_SESSION_SINGLE_OP_GRAPH_CACHE_H_
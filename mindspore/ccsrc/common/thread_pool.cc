@@ -24,157 +24,200 @@ namespace mindspore {
 const int kDeviceNum = 8;
 #endif
 
-bool Queue::Enqueue(Task *task) {
-  const int tail_index = tail_.load(std::memory_order_relaxed);
-  // queue full
-  auto next = (tail_index + 1) % 2;
-  if (next == head_.load(std::memory_order_acquire)) {
-    return false;
-  }
-  buffer_[tail_index] = task;
-  tail_.store(next, std::memory_order_release);
-  ++task_size_;
-  return true;
-}
-
-bool Queue::Dequeue(Task **out) {
-  if (task_size_ == 0) {
-    return false;
-  }
-  // queue empty
-  const int head_index = head_.load(std::memory_order_relaxed);
-  if (head_index == tail_.load(std::memory_order_acquire)) {
-    return false;
-  }
-  *out = buffer_[head_index];
-  head_.store((head_index + 1) % 2, std::memory_order_release);
-  return true;
-}
-
 ThreadPool::ThreadPool() {
+  size_t cpu_core_num = std::thread::hardware_concurrency();
+  if (cpu_core_num == 0) {
+    cpu_core_num = kDefaultMaxThreadNum;
+  }
 #ifdef ENABLE_D
-  auto cpu_core_num = std::thread::hardware_concurrency();
-  max_thread_num_ = cpu_core_num / kDeviceNum;
+  cpu_core_num = cpu_core_num / kDeviceNum;
 #endif
-  SetThreadPool(core_thread_num_);
+  max_thread_num_ = std::max(cpu_core_num, static_cast<size_t>(1));
+  // The launching thread always executes tasks as well, so one thread less is spawned.
+  AddNewThread(max_thread_num_ - 1);
 }
 
-bool ThreadPool::SetThreadPool(int config_thread_num) {
-  std::lock_guard<std::mutex> Lock(pool_mtx_);
-  if (config_thread_num > max_thread_num_) {
-    MS_LOG(EXCEPTION) << "Expected thread num is greater than the max thread num, expected thread num="
-                      << config_thread_num << ", allowed max thread num=" << max_thread_num_;
+void ThreadPool::AddNewThread(size_t add_num) {
+  for (size_t i = 0; i < add_num; ++i) {
+    thread_list_.emplace_back(&ThreadPool::ThreadLoop, this);
   }
-  if (config_thread_num > cur_thread_nums_) {
-    AddNewThread(config_thread_num - cur_thread_nums_);
-  }
-  MS_LOG(DEBUG) << "cur_thread_nums_=" << cur_thread_nums_ << ", cur_thread_run_nums_=" << cur_thread_run_nums_;
-  return true;
+  MS_LOG(INFO) << "add " << add_num << " thread";
 }
 
-void ThreadPool::AddNewThread(int add_num) {
-  for (int i = cur_thread_nums_, j = 0; j < add_num; ++i, ++j) {
-    auto active = new std::atomic_bool{true};
-    auto queue = std::make_shared<Queue>();
-    std::thread thread([this, i, active, queue]() {
-      Task *task = nullptr;
-      while (!exit_run_) {
-        while (*active) {
-          if (queue->Dequeue(&task)) {
-            auto ret = (*task)();
-            if (ret != SUCCESS) {
-              error_info_.emplace_back(std::make_pair(i, std::make_pair(false, ret)));
-            }
-            queue->task_size_--;
-          }
-          std::this_thread::yield();
-        }
-        std::unique_lock<std::mutex> queue_lock(thread_mtx_);
-        queue_ready_.wait(queue_lock, [active, this] { return exit_run_ || *active; });
+void ThreadPool::ThreadLoop() {
+  while (true) {
+    QueuedTask queued_task;
+    {
+      std::unique_lock<std::mutex> lock(task_mtx_);
+      task_ready_.wait(lock, [this] { return exit_run_ || !task_queue_.empty(); });
+      if (exit_run_ && task_queue_.empty()) {
+        return;
       }
-    });
-    thread_list_.emplace_back(std::move(thread));
-    activate_list_.emplace_back(active);
-    queue_list_.emplace_back(queue);
+      queued_task = task_queue_.front();
+      task_queue_.pop_front();
+    }
+    RunTask(queued_task);
   }
-  cur_thread_nums_ += add_num;
-  cur_thread_run_nums_ += add_num;
-  MS_LOG(INFO) << "add " << add_num << " thread";
-}
-
-void ThreadPool::AddRunThread(int num) {
-  MS_LOG(DEBUG) << "num=" << num << ", cur_thread_run_nums_=" << cur_thread_run_nums_;
-  int active_nums = num - cur_thread_run_nums_;
-  if (active_nums <= 0 || static_cast<int>(activate_list_.size()) < active_nums) {
-    return;
-  }
-  for (int i = cur_thread_run_nums_ - 1, j = 0; j < active_nums; ++i, ++j) {
-    *activate_list_[i] = true;
-  }
-  std::lock_guard<std::mutex> queueLock(thread_mtx_);
-  queue_ready_.notify_all();
-  cur_thread_run_nums_ = num;
 }
 
-void ThreadPool::SubRunThread(int num) {
-  MS_LOG(DEBUG) << "sub num=" << num << ", cur_thread_run_nums_=" << cur_thread_run_nums_;
-  int deactive_nums = cur_thread_run_nums_ - num;
-  if (deactive_nums <= 0) {
-    return;
+void ThreadPool::RunTask(const QueuedTask &queued_task) {
+  MS_EXCEPTION_IF_NULL(queued_task.task_);
+  MS_EXCEPTION_IF_NULL(queued_task.batch_);
+  auto batch = queued_task.batch_;
+  int ret = FAIL;
+  try {
+    ret = (*queued_task.task_)();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(task_mtx_);
+    if (batch->exception_ == nullptr) {
+      batch->exception_ = std::current_exception();
+    }
+  }
+  if (ret != SUCCESS) {
+    batch->failed_ = true;
   }
-  for (int i = num, j = 0; j < deactive_nums; ++i, ++j) {
-    *activate_list_[i] = false;
+  if (batch->pending_.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> lock(task_mtx_);
+    task_finish_.notify_all();
   }
-  cur_thread_run_nums_ = num;
 }
 
 bool ThreadPool::LaunchMultipleTask(const std::vector<Task> &tasks) {
-  int thread_num = tasks.size();
-  if (thread_num > max_thread_num_) {
-    thread_num = max_thread_num_;
+  if (tasks.empty()) {
+    return true;
+  }
+  TaskBatch batch;
+  batch.pending_ = tasks.size();
+  {
+    std::lock_guard<std::mutex> lock(task_mtx_);
+    for (size_t i = 1; i < tasks.size(); ++i) {
+      task_queue_.push_back({&tasks[i], &batch});
+    }
+  }
+  task_ready_.notify_all();
+  task_finish_.notify_all();
+  RunTask({&tasks[0], &batch});
+  return WaitBatch(&batch, tasks.size());
+}
+
+bool ThreadPool::WaitBatch(TaskBatch *batch, size_t task_num) {
+  MS_EXCEPTION_IF_NULL(batch);
+  // Help draining the queue instead of blocking, so that tasks launched from inside a task never dead lock.
+  while (true) {
+    QueuedTask queued_task;
+    {
+      std::unique_lock<std::mutex> lock(task_mtx_);
+      task_finish_.wait(lock, [this, batch] { return batch->pending_ == 0 || !task_queue_.empty(); });
+      if (batch->pending_ == 0) {
+        break;
+      }
+      queued_task = task_queue_.front();
+      task_queue_.pop_front();
+    }
+    RunTask(queued_task);
   }
-  if (!SetThreadPool(thread_num)) {
+  if (batch->exception_ != nullptr) {
+    std::rethrow_exception(batch->exception_);
+  }
+  if (batch->failed_) {
+    MS_LOG(ERROR) << "Some of the " << task_num << " tasks failed.";
     return false;
   }
-  error_info_.clear();
-  bool succ_flag;
-  for (int task_id = 0, queue_index = 0; task_id < SizeToInt(tasks.size()); ++task_id) {
-    do {
-      succ_flag = true;
-      if (!queue_list_[queue_index]->Enqueue(const_cast<Task *>(&tasks[task_id]))) {
-        std::this_thread::yield();
-        succ_flag = false;
-      }
-    } while (!succ_flag);
-    queue_index++;
-    if (queue_index >= cur_thread_run_nums_) {
-      queue_index = queue_index - cur_thread_run_nums_;
+  MS_LOG(DEBUG) << "Finish " << task_num << " task successful";
+  return true;
+}
+
+bool ThreadPool::LaunchTaskGraph(const std::vector<Task> &tasks, const std::vector<std::vector<size_t>> &successors,
+                                 const std::vector<size_t> &dependency_num) {
+  size_t task_num = tasks.size();
+  if (successors.size() != task_num || dependency_num.size() != task_num) {
+    MS_LOG(EXCEPTION) << "The task graph is invalid, task num: " << task_num
+                      << ", successors num: " << successors.size() << ", dependency num: " << dependency_num.size();
+  }
+  if (task_num == 0) {
+    return true;
+  }
+  TaskBatch batch;
+  batch.pending_ = task_num;
+  std::unique_ptr<std::atomic_size_t[]> remain_dependency(new std::atomic_size_t[task_num]);
+  std::vector<size_t> ready_tasks;
+  for (size_t i = 0; i < task_num; ++i) {
+    remain_dependency[i] = dependency_num[i];
+    if (dependency_num[i] == 0) {
+      ready_tasks.push_back(i);
     }
   }
-  succ_flag = false;
-  while (!succ_flag) {
-    std::this_thread::yield();
-    succ_flag = true;
-    for (int i = 0; i < cur_thread_run_nums_; ++i) {
-      if (queue_list_[i]->task_size_ != 0) {
-        succ_flag = false;
-        break;
+  if (ready_tasks.empty()) {
+    MS_LOG(EXCEPTION) << "The task graph has no task to start with, there must be a cycle.";
+  }
+
+  std::vector<Task> graph_tasks(task_num);
+  for (size_t i = 0; i < task_num; ++i) {
+    graph_tasks[i] = [this, i, &tasks, &successors, &remain_dependency, &graph_tasks, &batch]() {
+      int ret = FAIL;
+      if (!batch.failed_) {
+        try {
+          ret = tasks[i]();
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(task_mtx_);
+          if (batch.exception_ == nullptr) {
+            batch.exception_ = std::current_exception();
+          }
+        }
+        if (ret != SUCCESS) {
+          batch.failed_ = true;
+        }
+      }
+      bool released = false;
+      for (auto successor : successors[i]) {
+        if (remain_dependency[successor].fetch_sub(1) != 1) {
+          continue;
+        }
+        std::lock_guard<std::mutex> lock(task_mtx_);
+        task_queue_.push_back({&graph_tasks[successor], &batch});
+        released = true;
+      }
+      if (released) {
+        task_ready_.notify_all();
+        task_finish_.notify_all();
       }
+      // The failure has been recorded in the batch already.
+      return SUCCESS;
+    };
+  }
+  {
+    std::lock_guard<std::mutex> lock(task_mtx_);
+    for (size_t i = 1; i < ready_tasks.size(); ++i) {
+      task_queue_.push_back({&graph_tasks[ready_tasks[i]], &batch});
     }
   }
-  MS_LOG(INFO) << "Finish " << tasks.size() << " task successful";
-  return CheckResult();
+  task_ready_.notify_all();
+  task_finish_.notify_all();
+  RunTask({&graph_tasks[ready_tasks[0]], &batch});
+  return WaitBatch(&batch, task_num);
 }
 
-bool ThreadPool::CheckResult() {
-  bool succ_flag = true;
-  for (auto result : error_info_) {
-    if (result.second.first) {
-      MS_LOG(ERROR) << "task " << result.first << " failed, error code is " << result.second.second;
-      succ_flag = false;
-    }
+bool ThreadPool::ParallelFor(size_t total, const ParallelTask &task, size_t grain_size) {
+  if (total == 0) {
+    return true;
+  }
+  grain_size = std::max(grain_size, static_cast<size_t>(1));
+  size_t task_num = std::min(max_thread_num_, (total + grain_size - 1) / grain_size);
+  if (task_num <= 1) {
+    task(0, total);
+    return true;
+  }
+  size_t once_compute_size = (total + task_num - 1) / task_num;
+  std::vector<Task> tasks;
+  tasks.reserve(task_num);
+  for (size_t start = 0; start < total; start += once_compute_size) {
+    size_t end = std::min(start + once_compute_size, total);
+    tasks.emplace_back([&task, start, end]() {
+      task(start, end);
+      return SUCCESS;
+    });
   }
-  return succ_flag;
+  return LaunchMultipleTask(tasks);
 }
 
 ThreadPool *ThreadPool::GetInstance() {
@@ -183,17 +226,15 @@ ThreadPool *ThreadPool::GetInstance() {
 }
 
 ThreadPool::~ThreadPool() {
-  cur_thread_run_nums_ = static_cast<int>(thread_list_.size());
-  exit_run_ = true;
-  SubRunThread(0);
-  queue_ready_.notify_all();
+  {
+    std::lock_guard<std::mutex> lock(task_mtx_);
+    exit_run_ = true;
+  }
+  task_ready_.notify_all();
   for (auto &it : thread_list_) {
     if (it.joinable()) {
       it.join();
     }
   }
-  for (const auto &it : activate_list_) {
-    delete it;
-  }
 }
 }  // namespace mindspore
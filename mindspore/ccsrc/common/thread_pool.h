@@ -21,34 +21,21 @@
 #include <condition_variable>
 #include <thread>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <string>
 #include <atomic>
 #include <memory>
 #include <utility>
 #include <functional>
-#include <iostream>
+#include <exception>
 #include "utils/log_adapter.h"
 
 namespace mindspore {
-const int kCoreThreadNum = 3;
 const int kDefaultMaxThreadNum = 8;
+const size_t kDefaultGrainSize = 4096;
 enum Status { FAIL = -1, SUCCESS = 0 };
 using Task = std::function<int()>;
-
-class Queue {
- public:
-  Queue() = default;
-  ~Queue() = default;
-  bool Enqueue(Task *task);
-  bool Dequeue(Task **out);
-  std::atomic_int task_size_ = {0};
-
- private:
-  std::atomic_int head_ = {0};
-  std::atomic_int tail_ = {0};
-  Task *buffer_[2]{};
-};
+using ParallelTask = std::function<void(size_t start, size_t end)>;
 
 class ThreadPool {
  public:
@@ -57,29 +44,42 @@ class ThreadPool {
   ThreadPool &operator=(const ThreadPool &) = delete;
 
   static ThreadPool *GetInstance();
-  // Use the tasks' size of threads to execute these tasks, one thread execute one task.
+  // Execute the tasks on the persistent threads, the calling thread also takes tasks until all of them finish.
+  // The first exception thrown by a task is rethrown on the calling thread.
   bool LaunchMultipleTask(const std::vector<Task> &tasks);
+  // Split [0, total) into at most GetThreadNum() ranges of at least grain_size elements and run them in parallel.
+  // The task runs inline on the calling thread when the work is not worth more than one range.
+  bool ParallelFor(size_t total, const ParallelTask &task, size_t grain_size = kDefaultGrainSize);
+  // Execute tasks with dependencies: tasks[i] is started once dependency_num[i] of its predecessors finished, and
+  // finishing it releases successors[i]. Once a task fails, the tasks not started yet are skipped.
+  bool LaunchTaskGraph(const std::vector<Task> &tasks, const std::vector<std::vector<size_t>> &successors,
+                       const std::vector<size_t> &dependency_num);
+  size_t GetThreadNum() const { return max_thread_num_; }
 
  private:
+  struct TaskBatch {
+    std::atomic_size_t pending_{0};
+    std::atomic_bool failed_{false};
+    std::exception_ptr exception_{nullptr};
+  };
+  struct QueuedTask {
+    const Task *task_{nullptr};
+    TaskBatch *batch_{nullptr};
+  };
+
   ThreadPool();
-  bool SetThreadPool(int config_thread_num);
-  void AddNewThread(int add_num);
-  void AddRunThread(int num);
-  void SubRunThread(int num);
-  bool CheckResult();
+  void AddNewThread(size_t add_num);
+  void ThreadLoop();
+  void RunTask(const QueuedTask &queued_task);
+  bool WaitBatch(TaskBatch *batch, size_t task_num);
 
-  int cur_thread_nums_{0};
-  int cur_thread_run_nums_{0};
-  int core_thread_num_{kCoreThreadNum};
-  int max_thread_num_{kDefaultMaxThreadNum};
-  std::mutex pool_mtx_;
-  std::mutex thread_mtx_;
-  std::condition_variable queue_ready_;
-  std::atomic_bool exit_run_ = {false};
-  std::vector<std::atomic_bool *> activate_list_{};
+  size_t max_thread_num_{1};
+  std::mutex task_mtx_;
+  std::condition_variable task_ready_;
+  std::condition_variable task_finish_;
+  std::deque<QueuedTask> task_queue_;
+  bool exit_run_{false};
   std::vector<std::thread> thread_list_{};
-  std::vector<std::shared_ptr<Queue>> queue_list_{};
-  std::vector<std::pair<int, std::pair<bool, int>>> error_info_{};
 };
 }  // namespace mindspore
 
@@ -17,14 +17,18 @@
 #include "frontend/optimizer/opt.h"
 
 #include <deque>
+#include <iomanip>
 #include <memory>
+#include <sstream>
 #include <unordered_map>
 #include <algorithm>
+#include <iterator>
 
 #include "ir/anf.h"
 #include "ir/manager.h"
 #include "frontend/optimizer/optimizer.h"
 #include "utils/log_adapter.h"
+#include "utils/profile.h"
 
 namespace mindspore {
 /* namespace to support opt */
@@ -32,7 +36,9 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action) {
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  substitution->prim_names_ = {prim->name()};
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -59,7 +65,10 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  (void)std::transform(prims.begin(), prims.end(), std::back_inserter(substitution->prim_names_),
+                       [](const PrimitivePtr &prim) { return prim->name(); });
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -103,8 +112,46 @@ static bool isTraversable(const AnfNodePtr &node) {
   return false;
 }
 
-bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
-                                      const SubstitutionPtr &transform) const {
+SubstitutionList::SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once)
+    : list_(patterns), is_once_(is_once) {
+  for (size_t i = 0; i < list_.size(); i++) {
+    MS_EXCEPTION_IF_NULL(list_[i]);
+    if (list_[i]->prim_names_.empty()) {
+      any_node_substitutions_.push_back(i);
+      continue;
+    }
+    for (auto &prim_name : list_[i]->prim_names_) {
+      auto &indexes = prim_substitutions_[prim_name];
+      if (indexes.empty() || indexes.back() != i) {
+        indexes.push_back(i);
+      }
+    }
+  }
+  // keep the order of the list between the substitutions of a primitive and the ones which can match any node
+  for (auto &iter : prim_substitutions_) {
+    std::vector<size_t> indexes;
+    (void)std::merge(iter.second.begin(), iter.second.end(), any_node_substitutions_.begin(),
+                     any_node_substitutions_.end(), std::back_inserter(indexes));
+    iter.second.swap(indexes);
+  }
+}
+
+const std::vector<size_t> &SubstitutionList::NodeSubstitutions(const AnfNodePtr &node) const {
+  auto cnode = node->cast<CNodePtr>();
+  if (cnode != nullptr && !cnode->inputs().empty()) {
+    auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+    if (prim != nullptr) {
+      auto iter = prim_substitutions_.find(prim->name());
+      if (iter != prim_substitutions_.end()) {
+        return iter->second;
+      }
+    }
+  }
+  return any_node_substitutions_;
+}
+
+bool SubstitutionList::ApplySubstitutions(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
+                                          std::vector<bool> *changes, std::vector<double> *times) const {
 #ifdef ENABLE_PROFILE
   double start = GetTime();
 #endif
@@ -114,7 +161,7 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
   std::deque<AnfNodePtr> todo(1024);
   todo.clear();
   todo.push_back(root_node);
-  bool changes = false;
+  bool changed = false;
 
   auto &all_nodes = manager->all_nodes();
   while (!todo.empty()) {
@@ -127,25 +174,55 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
     }
     node->seen_ = seen;
 
-    // select nodes that this transform can be applied.
-    bool is_match = transform->predicate_(node);
-
-    // apply transform on this node
+    // apply the substitutions which can match this node until one of them replaces it.
     bool change = false;
-    if (is_match) {
-      auto ret = (*transform)(optimizer, node);
+    for (auto index : NodeSubstitutions(node)) {
+      auto &substitution = list_[index];
+      if (!substitution->predicate_(node)) {
+        continue;
+      }
+      double substitution_start = times != nullptr ? GetTime() : 0;
+      auto ret = (*substitution)(optimizer, node);
+      if (times != nullptr) {
+        (*times)[index] += GetTime() - substitution_start;
+      }
       if (ret != nullptr && ret != node) {
         change = true;
-        changes = true;
+        changed = true;
+        (*changes)[index] = true;
 #ifdef ENABLE_PROFILE
         double t = GetTime();
 #endif
         (void)manager->Replace(node, ret);
 #ifdef ENABLE_PROFILE
-        MsProfile::StatTime("replace." + transform->name_, GetTime() - t);
+        MsProfile::StatTime("replace." + substitution->name_, GetTime() - t);
 #endif
         node = ret;
+        break;
+      }
+    }
+
+    if (change) {
+      // the new node is matched next, then the users of it, which may match now.
+      auto &node_users = manager->node_users();
+      auto users_iter = node_users.find(node);
+      if (users_iter != node_users.end()) {
+        for (auto &use : users_iter->second) {
+          auto use_node = use.first;
+          if (use_node == nullptr) {
+            continue;
+          }
+          todo.push_back(use_node);
+          if (use_node->seen_ == seen) {
+            use_node->seen_--;
+          }
+        }
       }
+      if (node->seen_ == seen) {
+        node->seen_--;
+      }
+      todo.push_front(node);
+      continue;
     }
 
     // find success, and add them to todo list
@@ -157,26 +234,12 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
       auto &inputs = node->cast<CNodePtr>()->inputs();
       (void)std::copy(inputs.begin(), inputs.end(), std::back_inserter(todo));
     }
-
-    auto &node_users = manager->node_users();
-    if (change && node_users.find(node) != node_users.end()) {
-      for (auto &use : node_users[node]) {
-        auto use_node = use.first;
-        if (use_node == nullptr) {
-          continue;
-        }
-        todo.push_back(use_node);
-        if (use_node->seen_ == seen) {
-          use_node->seen_--;
-        }
-      }
-    }
   }
 
 #ifdef ENABLE_PROFILE
   MsProfile::StatTime("opt.transform." + optimizer->name(), GetTime() - start);
 #endif
-  return changes;
+  return changed;
 }
 
 bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
@@ -185,29 +248,26 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
   FuncGraphManagerPtr manager = optimizer->manager();
   manager->AddFuncGraph(func_graph);
 
-  // for transform status counting
-  size_t space = 0;
-  std::unordered_map<std::string, std::vector<bool>> status;
-  if (optimizer->is_on_debug_) {
-    for (size_t i = 0; i < list_.size(); i++) {
-      status[list_[i]->name_ + std::to_string(i)] = {};
-    }
-  }
+  // for transform status counting, the changes of each round and the time spent in each transform
+  double start = optimizer->is_on_debug_ ? GetTime() : 0;
+  std::vector<std::vector<bool>> status(list_.size());
+  std::vector<double> times(list_.size(), 0);
+  size_t rounds = 0;
 
   bool loop = false;
   bool changes = false;
 
   do {
-    loop = false;
-    for (size_t i = 0; i < list_.size(); i++) {
-      auto change = ApplyTransform(optimizer, func_graph->output(), list_[i]);
-      changes = changes || change;
-      loop = loop || change;
-
-      // record the status of each transform
-      if (optimizer->is_on_debug_) {
-        status[list_[i]->name_ + std::to_string(i)].push_back(change);
-        space = std::max(list_[i]->name_.size(), space);
+    std::vector<bool> round_changes(list_.size(), false);
+    loop = ApplySubstitutions(optimizer, func_graph->output(), &round_changes,
+                              optimizer->is_on_debug_ ? &times : nullptr);
+    changes = changes || loop;
+    rounds++;
+
+    // record the status of each transform
+    if (optimizer->is_on_debug_) {
+      for (size_t i = 0; i < list_.size(); i++) {
+        status[i].push_back(round_changes[i]);
       }
     }
 
@@ -216,16 +276,20 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
     }
   } while (loop);
 
-  // display the status of each transform
+  // display the status and the time in ms of each transform
   if (optimizer->is_on_debug_) {
+    size_t space = 0;
+    for (auto &substitution : list_) {
+      space = std::max(substitution->name_.size(), space);
+    }
     std::stringstream ss;
     ss << std::endl
        << "Pass: " << optimizer->name() << "(" << optimizer->CurPass_.counter << ")_" << optimizer->CurPass_.name
-       << std::endl;
+       << ", " << rounds << " rounds in " << (GetTime() - start) * 1000 << " ms" << std::endl;
     for (size_t i = 0; i < list_.size(); i++) {
-      auto name = list_[i]->name_;
-      ss << std::left << std::setw(space + 4) << name << "\t";
-      for (auto change : status[name + std::to_string(i)]) {
+      ss << std::left << std::setw(space + 4) << list_[i]->name_ << "\t" << std::fixed << std::setprecision(3)
+         << times[i] * 1000 << " ms\t";
+      for (auto change : status[i]) {
         ss << change << " ";
       }
       ss << std::endl;
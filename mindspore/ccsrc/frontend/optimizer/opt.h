@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ir/anf.h"
@@ -40,6 +41,8 @@ class Substitution {
   OptimizerCallerPtr transform_;
   std::string name_;
   PredicateFuncType predicate_{nullptr};
+  // the names of the primitives of the nodes which the predicate can match, empty if it can match any node
+  std::vector<std::string> prim_names_;
   // an enum to mark this Substitution relation to renormalize pass
   RenormAction renorm_action_;
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
@@ -61,15 +64,27 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
 
 class SubstitutionList {
  public:
-  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false)
-      : list_(patterns), is_once_(is_once) {}
+  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false);
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
  private:
-  bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &transform) const;
+  // Apply the substitutions to the nodes reachable from root_node in a single traversal, each node is tried with the
+  // substitutions which can match it, in the order of the list. The users of a replaced node are visited again.
+  // Set changes[i] if list_[i] replaced a node. If times is not null, the time spent in each substitution is added
+  // to it.
+  bool ApplySubstitutions(const OptimizerPtr &optimizer, const AnfNodePtr &root_node, std::vector<bool> *changes,
+                          std::vector<double> *times) const;
+  // The indexes in list_ of the substitutions which can match node.
+  const std::vector<size_t> &NodeSubstitutions(const AnfNodePtr &node) const;
+
   std::vector<SubstitutionPtr> list_;
+  // the indexes of the substitutions which can match the nodes of a primitive, by primitive name, including the ones
+  // which can match any node
+  std::unordered_map<std::string, std::vector<size_t>> prim_substitutions_;
+  // the indexes of the substitutions which can match any node
+  std::vector<size_t> any_node_substitutions_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
 };
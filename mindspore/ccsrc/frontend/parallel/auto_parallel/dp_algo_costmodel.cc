@@ -20,16 +20,18 @@
 #include <utility>
 #include <vector>
 
+#include "common/thread_pool.h"
+
 namespace mindspore {
 namespace parallel {
-Status GetStrategy(const CostGraphPtr &graph) {
-  MS_LOG(INFO) << "Searching strategies begins.";
+namespace {
+// Shrink 'graph' using 6 operations until none of them applies, and record them in the order.
+// Note: the checking and applying of the 6 operations MUST in current order.
+void EliminateGraph(const CostGraphPtr &graph, std::vector<EliminationPtr> *eliminations) {
   MS_EXCEPTION_IF_NULL(graph);
-  std::vector<EliminationPtr> eliminations;
+  MS_EXCEPTION_IF_NULL(eliminations);
   bool flag = true;
 
-  // Phase 1: Shrink the CostGraph using 6 operations, and record them in the order.
-  // Note: the checking and applying of the 6 operations MUST in current order.
   while (flag) {
     flag = false;
     auto node = graph->CheckOpElimination();
@@ -40,7 +42,7 @@ Status GetStrategy(const CostGraphPtr &graph) {
       auto r_edge = node->GetAliveSuccEdges()[0];
       auto n_edge = graph->EliminationOp(node);
       auto elimi = std::make_shared<OpElimination>(n_edge, l_edge, node, r_edge);
-      eliminations.emplace_back(std::move(elimi));
+      eliminations->emplace_back(std::move(elimi));
     }
     if (!flag) {
       auto edges = graph->CheckEdgeElimination();
@@ -49,7 +51,7 @@ Status GetStrategy(const CostGraphPtr &graph) {
         flag = true;
         auto n_edge = graph->EliminationEdges(edges);
         auto elimi = std::make_shared<EdgeElimination>(n_edge, edges);
-        eliminations.emplace_back(std::move(elimi));
+        eliminations->emplace_back(std::move(elimi));
       }
     }
     if (!flag) {
@@ -60,7 +62,7 @@ Status GetStrategy(const CostGraphPtr &graph) {
         auto succ_edge = merge_node->GetAliveSuccEdges()[0];
         auto target_node = graph->EliminationMerge(merge_node);
         auto elimi = std::make_shared<MergeElimination>(merge_node, succ_edge, target_node);
-        eliminations.emplace_back(std::move(elimi));
+        eliminations->emplace_back(std::move(elimi));
       }
     }
     if (!flag) {
@@ -71,7 +73,7 @@ Status GetStrategy(const CostGraphPtr &graph) {
         auto prev_edge = contracted_node->GetAlivePrevEdges()[0];
         auto target_node = graph->EliminationContract(contracted_node);
         auto elimi = std::make_shared<ContractElimination>(target_node, prev_edge, contracted_node);
-        eliminations.emplace_back(std::move(elimi));
+        eliminations->emplace_back(std::move(elimi));
       }
     }
     if (!flag) {
@@ -95,7 +97,7 @@ Status GetStrategy(const CostGraphPtr &graph) {
         auto right_node = l_r_edge->next_operator();
         auto elimi =
           std::make_shared<TriangleElimination>(eliminated_node, left_edge, left_node_cpy, right_edge, right_node);
-        eliminations.emplace_back(std::move(elimi));
+        eliminations->emplace_back(std::move(elimi));
       }
     }
     if (!flag) {
@@ -110,10 +112,37 @@ Status GetStrategy(const CostGraphPtr &graph) {
           succ_nodes.push_back(succ_edges[i]->next_operator());
         }
         auto elimi = std::make_shared<StarElimination>(star_center, succ_edges, succ_nodes);
-        eliminations.emplace_back(std::move(elimi));
+        eliminations->emplace_back(std::move(elimi));
       }
     }
   }
+}
+}  // namespace
+
+Status GetStrategy(const CostGraphPtr &graph) {
+  MS_LOG(INFO) << "Searching strategies begins.";
+  MS_EXCEPTION_IF_NULL(graph);
+
+  // Phase 1: Shrink the CostGraph using 6 operations, and record them in the order.
+  // No operation spans two connected components, and each component keeps the operator order of 'graph', so the
+  // components are shrunk independently, in parallel, with the same operations as shrinking 'graph' as a whole.
+  auto components = graph->ConstructConnectedComponents(graph->GetOperators());
+  std::vector<std::vector<EliminationPtr>> eliminations(components.size());
+  if (components.size() > 1) {
+    std::vector<Task> tasks;
+    for (size_t i = 0; i < components.size(); ++i) {
+      tasks.emplace_back([&components, &eliminations, i]() {
+        EliminateGraph(components[i], &eliminations[i]);
+        return SUCCESS;
+      });
+    }
+    if (!ThreadPool::GetInstance()->LaunchMultipleTask(tasks)) {
+      MS_LOG(EXCEPTION) << "Shrinking the connected components of the cost graph failed.";
+    }
+  } else if (components.size() == 1) {
+    EliminateGraph(components[0], &eliminations[0]);
+  }
+  MS_LOG(INFO) << "Shrunk " << components.size() << " connected components of the cost graph.";
 
   // Phase 2: Search the cost_list in the final graph, and determine the optimal one
   if (graph->SearchStrategy() != SUCCESS) {
@@ -122,12 +151,13 @@ Status GetStrategy(const CostGraphPtr &graph) {
   }
 
   // Phase 3: Recover the original CostGraph, the determine strategy for each operator
-  if (RecoverStrategy(eliminations) == SUCCESS) {
-    MS_LOG(INFO) << "Searching strategies ends.";
-    return SUCCESS;
-  } else {
-    MS_LOG(EXCEPTION) << "Searching strategies failed.";
+  for (auto &component_eliminations : eliminations) {
+    if (RecoverStrategy(component_eliminations) != SUCCESS) {
+      MS_LOG(EXCEPTION) << "Searching strategies failed.";
+    }
   }
+  MS_LOG(INFO) << "Searching strategies ends.";
+  return SUCCESS;
 }
 
 Status RecoverStrategy(std::vector<EliminationPtr> eliminations) {
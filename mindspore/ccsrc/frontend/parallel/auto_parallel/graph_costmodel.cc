@@ -223,18 +223,25 @@ bool CostGraph::IsEdgeInCostGraph(const std::string &test_edge_name, size_t outp
 std::vector<std::shared_ptr<CostGraph>> CostGraph::ConstructConnectedComponents(
   std::vector<OperatorInfoPtr> alive_ops) {
   std::map<OperatorInfoPtr, bool> visited;
+  std::map<OperatorInfoPtr, size_t> op_order;
 
-  for (auto &op : alive_ops) {
-    visited[op] = false;
+  for (size_t i = 0; i < alive_ops.size(); ++i) {
+    visited[alive_ops[i]] = false;
+    op_order[alive_ops[i]] = i;
   }
 
   MS_LOG(INFO) << "visited: " << visited.size() << ".";
+  connected_compoents_.clear();
   for (auto &op : alive_ops) {
     if ((!visited[op]) && op->is_alive()) {
       std::shared_ptr<CostGraph> new_component = std::make_shared<CostGraph>();
       MS_EXCEPTION_IF_NULL(new_component);
       new_component->SetDeviceMemoryAndCostParameter();
       DFS(op, &visited, new_component);
+      // Keep the operators in the order of 'alive_ops', so that the eliminations checked on a component are the ones
+      // checked on this graph.
+      std::sort(new_component->ops_.begin(), new_component->ops_.end(),
+                [&op_order](const OperatorInfoPtr &a, const OperatorInfoPtr &b) { return op_order[a] < op_order[b]; });
       connected_compoents_.push_back(new_component);
     }
   }
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "frontend/parallel/auto_parallel/strategy_search_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "frontend/parallel/costmodel_context.h"
+#include "frontend/parallel/device_manager.h"
+#include "utils/convert_utils_base.h"
+#include "utils/hashing.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+size_t StrategyHash(const StrategyPtr &strategy) {
+  MS_EXCEPTION_IF_NULL(strategy);
+  size_t hash = std::hash<int32_t>()(strategy->GetInputStage());
+  for (auto &dims : strategy->GetInputDim()) {
+    hash = hash_combine(hash, dims.size());
+    for (auto dim : dims) {
+      hash = hash_combine(hash, std::hash<int64_t>()(dim));
+    }
+  }
+  return hash;
+}
+
+size_t CostListHash(const CostPtrList &cost_list) {
+  std::hash<double> double_hash;
+  size_t hash = cost_list.size();
+  for (auto &cost : cost_list) {
+    MS_EXCEPTION_IF_NULL(cost);
+    hash = hash_combine({hash, double_hash(cost->computation_cost_), double_hash(cost->communication_cost_),
+                         double_hash(cost->communication_without_parameter_),
+                         double_hash(cost->communication_with_partial_para_),
+                         double_hash(cost->communication_forward_), double_hash(cost->memory_with_reuse_)});
+  }
+  return hash;
+}
+
+// A copy of the cost, without the decision which refers to the cost graph shrunk by the search.
+CostPtr CopyCost(const CostPtr &cost) {
+  if (cost == nullptr) {
+    return nullptr;
+  }
+  auto copy = std::make_shared<Cost>(*cost);
+  copy->decision_ptr_ = nullptr;
+  return copy;
+}
+}  // namespace
+
+StrategySearchCache &StrategySearchCache::GetInstance() {
+  static StrategySearchCache instance;
+  return instance;
+}
+
+CostGraphSnapshot StrategySearchCache::TakeSnapshot(const CostGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(g_device_manager);
+  auto context = CostModelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  std::hash<double> double_hash;
+  size_t key = hash_combine({g_device_manager->DeviceNum(), IntToSize(g_device_manager->GetStageNum()),
+                             double_hash(context->device_memory_capacity()), double_hash(context->costmodel_alpha()),
+                             double_hash(context->costmodel_beta()), double_hash(context->costmodel_gamma()),
+                             std::hash<bool>()(context->costmodel_simplify_cal()),
+                             std::hash<bool>()(context->triangle_star_strategy_overwrite()),
+                             std::hash<int32_t>()(context->run_phase())});
+
+  CostGraphSnapshot snapshot;
+  auto ops = graph->GetOperators();
+  std::map<OperatorInfoPtr, size_t> op_index;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    op_index[ops[i]] = i;
+  }
+  for (auto &op : ops) {
+    MS_EXCEPTION_IF_NULL(op);
+    key = hash_combine(key, std::hash<std::string>()(op->name()));
+    snapshot.op_names.push_back(op->name());
+    snapshot.candidates.emplace_back();
+    auto op_strategy_cost = op->GetStrategyCost();
+    for (auto &swc : op_strategy_cost) {
+      MS_EXCEPTION_IF_NULL(swc);
+      key = hash_combine({key, StrategyHash(swc->strategy_ptr), CostListHash(swc->cost_list)});
+      snapshot.candidates.back().push_back(std::make_shared<Strategy>(*swc->strategy_ptr));
+    }
+    // The edges are visited from their previous operators, and their costs in the order of the candidate strategies
+    // of both ends, which is stable across compilations.
+    for (auto &edge : op->succ_edges()) {
+      MS_EXCEPTION_IF_NULL(edge);
+      auto iter = op_index.find(edge->next_operator());
+      if (iter == op_index.end()) {
+        continue;
+      }
+      snapshot.edges.push_back(edge);
+      key = hash_combine({key, iter->second, edge->prev_op_output_index(), edge->next_op_input_index()});
+      for (auto &prev_swc : op_strategy_cost) {
+        for (auto &next_swc : edge->next_operator()->GetStrategyCost()) {
+          key = hash_combine(key, CostListHash(edge->GetCostList(prev_swc->strategy_ptr, next_swc->strategy_ptr)));
+        }
+      }
+    }
+  }
+  snapshot.key = key;
+  return snapshot;
+}
+
+Status StrategySearchCache::Restore(const CostGraphPtr &graph, const CostGraphSnapshot &snapshot) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto iter = searches_.find(snapshot.key);
+  if (iter == searches_.end()) {
+    return FAILED;
+  }
+  const auto &search = iter->second;
+  auto ops = graph->GetOperators();
+  if (search.op_names != snapshot.op_names || search.edge_names.size() != snapshot.edges.size() ||
+      ops.size() != snapshot.op_names.size()) {
+    MS_LOG(WARNING) << "The cached strategies are for " << search.op_names.size() << " operators and "
+                    << search.edge_names.size() << " edges, which are not the " << ops.size() << " operators and "
+                    << snapshot.edges.size() << " edges of the cost graph.";
+    return FAILED;
+  }
+  for (size_t i = 0; i < snapshot.edges.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(snapshot.edges[i]);
+    if (search.edge_names[i] != snapshot.edges[i]->edge_name()) {
+      MS_LOG(WARNING) << "The cached edge: " << search.edge_names[i]
+                      << " is not the edge: " << snapshot.edges[i]->edge_name() << ".";
+      return FAILED;
+    }
+  }
+  std::vector<std::shared_ptr<StrategyWithCost>> selected;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(ops[i]);
+    const auto &candidates = search.candidates[i];
+    const auto &current_candidates = snapshot.candidates[i];
+    bool is_same_candidates = candidates.size() == current_candidates.size() &&
+                              std::equal(candidates.begin(), candidates.end(), current_candidates.begin(),
+                                         [](const StrategyPtr &cached, const StrategyPtr &current) {
+                                           return cached->IsEqual(current);
+                                         });
+    if (!is_same_candidates) {
+      MS_LOG(WARNING) << "The cached candidate strategies are not the ones of the operator: " << ops[i]->name() << ".";
+      return FAILED;
+    }
+    auto op_strategy_cost = ops[i]->GetStrategyCost();
+    auto swc_iter = std::find_if(op_strategy_cost.begin(), op_strategy_cost.end(),
+                                 [&search, i](const std::shared_ptr<StrategyWithCost> &swc) {
+                                   return swc->strategy_ptr->IsEqual(search.strategies[i]);
+                                 });
+    if (swc_iter == op_strategy_cost.end()) {
+      MS_LOG(WARNING) << "The cached strategy is not a candidate of the operator: " << ops[i]->name() << ".";
+      return FAILED;
+    }
+    selected.push_back(*swc_iter);
+  }
+  for (size_t i = 0; i < ops.size(); ++i) {
+    ops[i]->SetSelectedStrategyAndCost(selected[i]->strategy_ptr, CopyCost(search.op_costs[i]));
+  }
+  for (size_t i = 0; i < snapshot.edges.size(); ++i) {
+    snapshot.edges[i]->set_selected_cost(CopyCost(search.edge_costs[i]));
+  }
+  return SUCCESS;
+}
+
+void StrategySearchCache::Save(const CostGraphPtr &graph, const CostGraphSnapshot &snapshot) {
+  MS_EXCEPTION_IF_NULL(graph);
+  CachedSearch search{snapshot.op_names, snapshot.candidates, {}, {}, {}, {}};
+  for (auto &op : graph->GetOperators()) {
+    MS_EXCEPTION_IF_NULL(op);
+    auto strategy = op->selected_strategy();
+    if (strategy == nullptr) {
+      MS_LOG(INFO) << "No strategy is selected for the operator: " << op->name() << ", the cost graph is not cached.";
+      return;
+    }
+    search.strategies.push_back(std::make_shared<Strategy>(*strategy));
+    search.op_costs.push_back(CopyCost(op->selected_cost()));
+  }
+  for (auto &edge : snapshot.edges) {
+    MS_EXCEPTION_IF_NULL(edge);
+    search.edge_names.push_back(edge->edge_name());
+    search.edge_costs.push_back(CopyCost(edge->selected_cost()));
+  }
+  searches_[snapshot.key] = std::move(search);
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_STRATEGY_SEARCH_CACHE_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_STRATEGY_SEARCH_CACHE_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "frontend/parallel/auto_parallel/costmodel.h"
+#include "frontend/parallel/auto_parallel/edge_costmodel.h"
+#include "frontend/parallel/auto_parallel/graph_costmodel.h"
+#include "frontend/parallel/status.h"
+#include "frontend/parallel/strategy.h"
+
+namespace mindspore {
+namespace parallel {
+// What the cache knows of a cost graph before the search, which shrinks it: its key, its operators with their
+// candidate strategies, and its edges, in the order the key visits them.
+struct CostGraphSnapshot {
+  size_t key = 0;
+  std::vector<std::string> op_names;
+  std::vector<std::vector<StrategyPtr>> candidates;
+  std::vector<EdgePtr> edges;
+};
+
+// The strategies searched for the cost graphs compiled in this process. A cost graph is keyed by its operators, their
+// candidate strategies and costs, its edges, the device mesh and the cost model parameters, so compiling the same
+// network again on the same devices reuses the strategies instead of running the DP algorithm. The operators, their
+// candidate strategies and the edges are kept next to the key, so that a key collision makes the lookup miss.
+class StrategySearchCache {
+ public:
+  static StrategySearchCache &GetInstance();
+
+  // The snapshot MUST be taken before the search.
+  CostGraphSnapshot TakeSnapshot(const CostGraphPtr &graph) const;
+  // Select the cached strategies and costs for the operators of 'graph', and the cached costs for its edges. Return
+  // FAILED, leaving them untouched, if there are none for the key of 'snapshot' or they were searched for other
+  // operators, candidate strategies or edges.
+  Status Restore(const CostGraphPtr &graph, const CostGraphSnapshot &snapshot) const;
+  // Cache the strategies and costs selected for the operators and the edges of 'graph' under the key of 'snapshot'.
+  void Save(const CostGraphPtr &graph, const CostGraphSnapshot &snapshot);
+  void Clear() { searches_.clear(); }
+
+ private:
+  StrategySearchCache() = default;
+  ~StrategySearchCache() = default;
+
+  struct CachedSearch {
+    std::vector<std::string> op_names;
+    std::vector<std::vector<StrategyPtr>> candidates;
+    std::vector<std::string> edge_names;
+    std::vector<StrategyPtr> strategies;
+    CostPtrList op_costs;
+    CostPtrList edge_costs;
+  };
+
+  std::unordered_map<size_t, CachedSearch> searches_;
+};
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_STRATEGY_SEARCH_CACHE_H_
@@ -36,6 +36,7 @@
 #include "frontend/parallel/auto_parallel/rec_core/rec_generate_strategy.h"
 #include "frontend/parallel/auto_parallel/rec_core/rec_parse_graph.h"
 #include "frontend/parallel/auto_parallel/rec_core/rec_partition.h"
+#include "frontend/parallel/auto_parallel/strategy_search_cache.h"
 #include "frontend/parallel/context.h"
 #include "frontend/parallel/graph_util/node_info.h"
 #include "frontend/parallel/ops_info/reshape_info.h"
@@ -616,7 +617,8 @@ void ConstructCostGraphEdges(const std::vector<AnfNodePtr> &all_nodes) {
             edge_ptr = std::make_shared<Edge>(edge_name, prev_op_info, node_op_info, output_index, i - 1, false);
           }
 
-          // Init costs for this edge
+          // Init costs for this edge. This stays serial: the redistribution costs create communication groups
+          // through the global device manager.
           if (edge_ptr->InitEdgeCost() != SUCCESS) {
             MS_LOG(EXCEPTION) << "Edge cost initialization failed";
           }
@@ -971,7 +973,8 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   //      in this process, cost is calculated based on not only the operators, but also the edges. Here, the edge
   //      cost is caused by the redistribution of a operator's output tensor layout to the next operator's input
   //      tensor layout. Note that there may be several connected components in the costgraph, and the DP algorithm
-  //      runs on each of them.
+  //      runs on each of them. The searched strategies are cached, and reused when the same costgraph is compiled
+  //      again on the same devices.
   //
   // OUTPUT: the determined strategy for each operator.
 
@@ -1008,12 +1011,19 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
     MS_LOG(EXCEPTION) << "Calculating memory cost failed.";
   }
 
-  // Step 4: run DP algorithm on the costgraph.
-  if (GetStrategy(entire_costgraph) != SUCCESS) {
-    MS_LOG(ERROR) << "Strategy search for cost-graph fails";
-    return FAILED;
+  // Step 4: run DP algorithm on the costgraph, unless the same costgraph has been searched on the same devices.
+  auto &search_cache = StrategySearchCache::GetInstance();
+  auto costgraph_snapshot = search_cache.TakeSnapshot(entire_costgraph);
+  if (search_cache.Restore(entire_costgraph, costgraph_snapshot) == SUCCESS) {
+    MS_LOG(INFO) << "Reusing the strategies searched for the same cost-graph.";
+  } else {
+    if (GetStrategy(entire_costgraph) != SUCCESS) {
+      MS_LOG(ERROR) << "Strategy search for cost-graph fails";
+      return FAILED;
+    }
+    MS_LOG(INFO) << "Searching strategy succeeded.";
+    search_cache.Save(entire_costgraph, costgraph_snapshot);
   }
-  MS_LOG(INFO) << "Searching strategy succeeded.";
 
   if (entire_costgraph->InitSelectedStrategy() == SUCCESS) {
     MS_LOG(INFO) << "Init selected strategy succeeded.";
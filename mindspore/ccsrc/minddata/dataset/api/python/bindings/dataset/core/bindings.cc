@@ -37,12 +37,14 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("set_num_parallel_workers", &ConfigManager::set_num_parallel_workers)
                     .def("set_worker_connector_size", &ConfigManager::set_worker_connector_size)
                     .def("set_op_connector_size", &ConfigManager::set_op_connector_size)
+                    .def("set_lock_free_connector", &ConfigManager::set_lock_free_connector)
                     .def("set_seed", &ConfigManager::set_seed)
                     .def("set_monitor_sampling_interval", &ConfigManager::set_monitor_sampling_interval)
                     .def("get_rows_per_buffer", &ConfigManager::rows_per_buffer)
                     .def("get_num_parallel_workers", &ConfigManager::num_parallel_workers)
                     .def("get_worker_connector_size", &ConfigManager::worker_connector_size)
                     .def("get_op_connector_size", &ConfigManager::op_connector_size)
+                    .def("get_lock_free_connector", &ConfigManager::lock_free_connector)
                     .def("get_seed", &ConfigManager::seed)
                     .def("get_monitor_sampling_interval", &ConfigManager::monitor_sampling_interval)
                     .def("get_callback_timeout", &ConfigManager::callback_timeout)
@@ -34,6 +34,7 @@ ConfigManager::ConfigManager()
       num_parallel_workers_(kCfgParallelWorkers),
       worker_connector_size_(kCfgWorkerConnectorSize),
       op_connector_size_(kCfgOpConnectorSize),
+      lock_free_connector_(kCfgLockFreeConnector),
       seed_(kCfgDefaultSeed),
       monitor_sampling_interval_(kCfgMonitorSamplingInterval),
       callback_timout_(kCfgCallbackTimeout),
@@ -65,7 +66,8 @@ void ConfigManager::Print(std::ostream &out) const {
       << "\nDataCache Rows per buffer    : " << rows_per_buffer_
       << "\nParallelOp workers           : " << num_parallel_workers_
       << "\nParallelOp worker connector size    : " << worker_connector_size_
-      << "\nSize of each Connector : " << op_connector_size_ << std::endl;
+      << "\nSize of each Connector : " << op_connector_size_
+      << "\nLock free Connector : " << std::boolalpha << lock_free_connector_ << std::endl;
 }
 
 // Private helper function that taks a nlohmann json format and populates the settings
@@ -74,6 +76,7 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_num_parallel_workers(j.value("numParallelWorkers", num_parallel_workers_));
   set_worker_connector_size(j.value("workerConnectorSize", worker_connector_size_));
   set_op_connector_size(j.value("opConnectorSize", op_connector_size_));
+  set_lock_free_connector(j.value("lockFreeConnector", lock_free_connector_));
   set_seed(j.value("seed", seed_));
   set_monitor_sampling_interval(j.value("monitorSamplingInterval", monitor_sampling_interval_));
   set_cache_host(j.value("cacheHost", cache_host_));
@@ -121,6 +124,9 @@ void ConfigManager::set_worker_connector_size(int32_t connector_size) { worker_c
 // Setter function
 void ConfigManager::set_op_connector_size(int32_t connector_size) { op_connector_size_ = connector_size; }
 
+// Setter function
+void ConfigManager::set_lock_free_connector(bool lock_free) { lock_free_connector_ = lock_free; }
+
 uint32_t ConfigManager::seed() const { return seed_; }
 
 void ConfigManager::set_seed(uint32_t seed) { seed_ = seed; }
@@ -89,6 +89,10 @@ class ConfigManager {
   // @return The internal worker-to-master connector queue size
   int32_t worker_connector_size() const { return worker_connector_size_; }
 
+  // getter function
+  // @return Whether connectors are built over lock free queues
+  bool lock_free_connector() const { return lock_free_connector_; }
+
   // getter function
   // @return The hostname of cache server
   std::string cache_host() const { return cache_host_; }
@@ -121,6 +125,10 @@ class ConfigManager {
   // @param connector_size - The setting to apply to the config
   void set_op_connector_size(int32_t connector_size);
 
+  // setter function
+  // @param lock_free - The setting to apply to the config
+  void set_lock_free_connector(bool lock_free);
+
   // setter function
   // @param cache_host - The hostname of cache server
   void set_cache_host(std::string cache_host);
@@ -164,6 +172,7 @@ class ConfigManager {
   int32_t num_parallel_workers_;
   int32_t worker_connector_size_;
   int32_t op_connector_size_;
+  bool lock_free_connector_;
   uint32_t seed_;
   uint32_t monitor_sampling_interval_;
   uint32_t callback_timout_;
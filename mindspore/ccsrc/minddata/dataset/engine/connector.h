@@ -21,6 +21,7 @@
 #include <utility>
 #include <vector>
 #include "minddata/dataset/util/task_manager.h"
+#include "minddata/dataset/util/lock_free_queue.h"
 #include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/services.h"
 #include "minddata/dataset/util/cond_var.h"
@@ -71,8 +72,9 @@ class Connector {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each queue.
-  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
+  // @param lock_free Use lock free ring buffers that spin before parking instead of mutex guarded queues.
+  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false)
+      : num_producers_(n_producers), num_consumers_(n_consumers), lock_free_(lock_free) {
     MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
@@ -84,7 +86,11 @@ class Connector {
 
     // Initialize the queues_ to have num_producers_ number of queues.
     // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    if (lock_free_) {
+      lock_free_queues_.Init(num_producers_, queue_capacity);
+    } else {
+      queues_.Init(num_producers_, queue_capacity);
+    }
   }
 
   // Destructor of Connector
@@ -100,7 +106,7 @@ class Connector {
       MS_ASSERT(worker_id < num_consumers_);
       std::unique_lock<std::mutex> lk(m_);
       RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
-      RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+      RETURN_IF_NOT_OK(PopFront(pop_from_, result));
       pop_from_ = (pop_from_ + 1) % num_producers_;
       out_buffers_count_++;
       expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
@@ -116,7 +122,10 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el A const lvalue element to be passed/added/pushed.
   Status Push(int32_t worker_id, const T &el) noexcept {
-    MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
+    MS_ASSERT(worker_id < num_producers_);
+    if (lock_free_) {
+      return (lock_free_queues_[worker_id]->Add(el));
+    }
     MS_ASSERT(queues_[worker_id] != nullptr);
     return (queues_[worker_id]->Add(el));
   }
@@ -129,7 +138,10 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el An element to be passed/added/pushed.
   virtual Status Push(int32_t worker_id, T &&el) noexcept {
-    MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
+    MS_ASSERT(worker_id < num_producers_);
+    if (lock_free_) {
+      return (lock_free_queues_[worker_id]->Add(std::forward<T>(el)));
+    }
     MS_ASSERT(queues_[worker_id] != nullptr);
     return (queues_[worker_id]->Add(std::forward<T>(el)));
   }
@@ -140,6 +152,9 @@ class Connector {
     for (int i = 0; i < queues_.size(); ++i) {
       queues_[i]->ResetQue();
     }
+    for (int i = 0; i < lock_free_queues_.size(); ++i) {
+      lock_free_queues_[i]->ResetQue();
+    }
     expect_consumer_ = 0;
     pop_from_ = 0;
     out_buffers_count_ = 0;
@@ -149,7 +164,7 @@ class Connector {
   void Print(std::ostream &out, bool showAll) const {
     out << "\n--------- Connector ------------"
         << "\nConnector Name           : " << my_name_ << "\nNumber of consumers      : " << num_consumers_
-        << "\nNumber of producers      : " << num_producers_ << "\n";
+        << "\nNumber of producers      : " << num_producers_ << "\nLock free                : " << lock_free_ << "\n";
   }
 
   friend std::ostream &operator<<(std::ostream &out, const Connector &con) {
@@ -163,6 +178,9 @@ class Connector {
     for (int32_t i = 0; i < queues_.size(); ++i) {
       size += queues_[i]->size();
     }
+    for (int32_t i = 0; i < lock_free_queues_.size(); ++i) {
+      size += lock_free_queues_[i]->size();
+    }
     return size;
   }
 
@@ -171,6 +189,9 @@ class Connector {
     for (int32_t i = 0; i < queues_.size(); ++i) {
       capacity += queues_[i]->capacity();
     }
+    for (int32_t i = 0; i < lock_free_queues_.size(); ++i) {
+      capacity += lock_free_queues_[i]->capacity();
+    }
     return capacity;
   }
 
@@ -178,7 +199,7 @@ class Connector {
   // @param vg
   // @return
   Status Register(TaskGroup *vg) {
-    Status rc = queues_.Register(vg);
+    Status rc = lock_free_ ? lock_free_queues_.Register(vg) : queues_.Register(vg);
     if (rc.IsOk()) {
       rc = cv_.Register(vg->GetIntrpService());
     }
@@ -186,10 +207,21 @@ class Connector {
   }
 
  protected:
+  // Pop the next element from one of the internal queues, whichever kind is in use.
+  // @param queue_id The index of the queue, i.e. the id of the producer that pushed to it.
+  // @param result The address of an object where the popped element will be placed.
+  Status PopFront(int32_t queue_id, T *result) {
+    if (lock_free_) {
+      return lock_free_queues_[queue_id]->PopFront(result);
+    }
+    return queues_[queue_id]->PopFront(result);
+  }
+
   std::string my_name_;
 
-  // A list of Queues that are thread safe.
+  // A list of Queues that are thread safe. Only one of the two lists is populated, depending on lock_free_.
   QueueList<T> queues_;
+  QueueList<T, LockFreeQueue<T>> lock_free_queues_;
 
   // The consumer that we allow to get the next data from pop()
   int32_t expect_consumer_;
@@ -199,6 +231,7 @@ class Connector {
 
   int32_t num_producers_;
   int32_t num_consumers_;
+  bool lock_free_;
 
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
@@ -23,6 +23,8 @@
 #include <string>
 #include <algorithm>
 
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/device_queue_op.h"
 #include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
@@ -216,7 +218,8 @@ void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers) {
   if (oc_queue_size_ > 0) {
     out_connector_ = std::make_unique<DbConnector>(num_producers,  // The number of producers
                                                    num_consumers,  // Only one consumer (the training App)
-                                                   oc_queue_size_);
+                                                   oc_queue_size_,
+                                                   GlobalContext::config_manager()->lock_free_connector());
   } else {
     // Some op's may choose not to have an output connector
     MS_LOG(DEBUG) << "Bypassed connector creation for tree operator: " << operator_id_ << ".";
@@ -142,6 +142,8 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
   shard_reader_ = std::make_unique<ShardReader>();
+  // Blob data is parsed straight out of the mapped shard files, the reader falls back to file streams if mapping fails
+  shard_reader_->SetUseMmap(true);
   auto rc = shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_, operators_,
                                 num_padded_);
 
@@ -282,21 +284,39 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
   for (int32_t i = 0; i < rows_per_buffer_; ++i) {
     int32_t row_id = buffer_id * rows_per_buffer_ + i;
+    if (shard_reader_->IsMapped()) {
+      auto rc = shard_reader_->GetNextViewById(row_id);
+      auto task_type = rc.first;
+      const auto &tupled_buffer = rc.second;
+      if (task_type == mindrecord::TaskType::kPaddedTask) {
+        TensorRow tensor_row;
+        RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, nullptr, 0, mindrecord::json(), task_type));
+        tensor_table->push_back(std::move(tensor_row));
+      }
+      if (tupled_buffer.empty()) break;
+      for (const auto &tupled_row : tupled_buffer) {
+        TensorRow tensor_row;
+        RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, std::get<0>(tupled_row), std::get<1>(tupled_row),
+                                       std::get<2>(tupled_row), task_type));
+        tensor_table->push_back(std::move(tensor_row));
+      }
+      continue;
+    }
     auto rc = shard_reader_->GetNextById(row_id, worker_id);
     auto task_type = rc.first;
-    auto tupled_buffer = rc.second;
+    const auto &tupled_buffer = rc.second;
     if (task_type == mindrecord::TaskType::kPaddedTask) {
       TensorRow tensor_row;
-      RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, {}, mindrecord::json(), task_type));
+      RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, nullptr, 0, mindrecord::json(), task_type));
       tensor_table->push_back(std::move(tensor_row));
     }
     if (tupled_buffer.empty()) break;
     if (task_type == mindrecord::TaskType::kCommonTask) {
       for (const auto &tupled_row : tupled_buffer) {
-        std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-        mindrecord::json columns_json = std::get<1>(tupled_row);
+        const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
         TensorRow tensor_row;
-        RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, columns_blob, columns_json, task_type));
+        RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, columns_blob.data(), columns_blob.size(), std::get<1>(tupled_row),
+                                       task_type));
         tensor_table->push_back(std::move(tensor_row));
       }
     }
@@ -307,7 +327,7 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   return Status::OK();
 }
 
-Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
                                    const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
   for (uint32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
@@ -349,8 +369,8 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
       }
     } else {
       auto has_column =
-        shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr, &n_bytes,
-                                           &column_data_type, &column_data_type_size, &column_shape);
+        shard_column->GetColumnValueByName(column_name, columns_blob, blob_size, columns_json, &data, &data_ptr,
+                                           &n_bytes, &column_data_type, &column_data_type_size, &column_shape);
       if (has_column == MSRStatus::FAILED) {
         RETURN_STATUS_UNEXPECTED("Invalid data, failed to retrieve data from mindrecord reader.");
       }
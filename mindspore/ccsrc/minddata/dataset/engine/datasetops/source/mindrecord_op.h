@@ -222,9 +222,10 @@ class MindRecordOp : public ParallelOp {
 
   // Parses a single cell and puts the data into a tensor
   // @param tensor_row - the tensor row to put the parsed data in
-  // @param columns_blob - the blob data received from the reader
+  // @param columns_blob - the blob data received from the reader, either a copy or a view over the mapped file
+  // @param blob_size - the size of the blob data in bytes
   // @param columns_json - the data for fields received from the reader
-  Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+  Status LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
                        const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
 
   // Private function for computing the assignment of the column name map.
@@ -15,16 +15,22 @@
  */
 #include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
 
+#include <sys/stat.h>
 #include <algorithm>
 #include <fstream>
 #include <future>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "google/protobuf/arena.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
 #include "proto/example.pb.h"
 #include "./securec.h"
 #include "utils/ms_utils.h"
@@ -47,6 +53,265 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// What is kept of a tf_file file once its records have been walked: the number of complete records and, for the
+// readers of an equal rows shard, the offset of every kRecordCheckpointStride-th record. A reader seeks to the last
+// checkpoint before its first row and skips the few records in between, so the index costs 8 bytes per checkpoint
+// instead of 8 bytes per record. Row counting doesn't keep the checkpoints at all.
+struct TFRecordIndex {
+  int64_t file_size;
+  int64_t modify_time;
+  int64_t num_records;
+  bool has_checkpoints;
+  std::vector<int64_t> checkpoints;
+};
+
+constexpr int64_t kRecordCheckpointStride = 1024;
+
+// Records larger than this are skipped by seeking, smaller ones are cheaper to skip through the stream buffer.
+constexpr int64_t kRecordSeekThreshold = 64 * 1024;
+
+constexpr int64_t kNanosecondsPerSecond = 1000000000;
+
+std::mutex tf_record_index_mutex;
+std::unordered_map<std::string, std::shared_ptr<const TFRecordIndex>> tf_record_indexes;
+
+// A file rewritten within the same second with the same size must not match its old index.
+int64_t ModifyTime(const struct stat &file_stat) {
+#if defined(_WIN32) || defined(_WIN64)
+  return static_cast<int64_t>(file_stat.st_mtime) * kNanosecondsPerSecond;
+#else
+  return static_cast<int64_t>(file_stat.st_mtim.tv_sec) * kNanosecondsPerSecond + file_stat.st_mtim.tv_nsec;
+#endif
+}
+
+void SkipBytes(std::ifstream *reader, int64_t length) {
+  if (length > kRecordSeekThreshold) {
+    (void)reader->seekg(length, std::ios::cur);
+  } else {
+    (void)reader->ignore(static_cast<std::streamsize>(length));
+  }
+}
+
+Status BuildRecordIndex(const std::string &filename, TFRecordIndex *index) {
+  std::ifstream reader(filename, std::ios::binary);
+  if (!reader) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + filename);
+  }
+
+  int64_t offset = 0;
+  index->num_records = 0;
+  while (offset < index->file_size) {
+    int64_t record_length = 0;
+    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
+    // length, crc of length, serialized Example, crc of Example
+    int64_t data_length = static_cast<int64_t>(sizeof(int32_t)) + record_length + static_cast<int64_t>(sizeof(int32_t));
+    int64_t record_end = offset + static_cast<int64_t>(sizeof(int64_t)) + data_length;
+    if (!reader || record_length < 0 || record_end > index->file_size) {
+      MS_LOG(WARNING) << "Invalid file, ignore the truncated record at offset " << offset << " of file " << filename
+                      << ".";
+      break;
+    }
+    if (index->has_checkpoints && index->num_records % kRecordCheckpointStride == 0) {
+      index->checkpoints.push_back(offset);
+    }
+    index->num_records++;
+    SkipBytes(&reader, data_length);
+    offset = record_end;
+  }
+  return Status::OK();
+}
+
+// Get the record index of filename, building it if the file is new, has changed since it was indexed, or the
+// checkpoints are asked for but were not kept.
+Status GetRecordIndex(const std::string &filename, bool with_checkpoints,
+                      std::shared_ptr<const TFRecordIndex> *index) {
+  struct stat file_stat;
+  if (stat(filename.c_str(), &file_stat) != 0) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + filename);
+  }
+  int64_t modify_time = ModifyTime(file_stat);
+  {
+    std::lock_guard<std::mutex> lock(tf_record_index_mutex);
+    auto iter = tf_record_indexes.find(filename);
+    if (iter != tf_record_indexes.end() && iter->second->file_size == file_stat.st_size &&
+        iter->second->modify_time == modify_time && (iter->second->has_checkpoints || !with_checkpoints)) {
+      *index = iter->second;
+      return Status::OK();
+    }
+  }
+
+  // Built without the lock so that files are indexed in parallel, a file indexed twice gets the same index.
+  auto new_index = std::make_shared<TFRecordIndex>();
+  new_index->file_size = file_stat.st_size;
+  new_index->modify_time = modify_time;
+  new_index->has_checkpoints = with_checkpoints;
+  RETURN_IF_NOT_OK(BuildRecordIndex(filename, new_index.get()));
+  std::lock_guard<std::mutex> lock(tf_record_index_mutex);
+  tf_record_indexes[filename] = new_index;
+  *index = new_index;
+  return Status::OK();
+}
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::internal::WireFormatLite;
+
+// Field numbers of the messages of example.proto and feature.proto.
+constexpr int kExampleFeaturesField = 1;
+constexpr int kFeaturesFeatureField = 1;
+constexpr int kMapEntryKeyField = 1;
+constexpr int kMapEntryValueField = 2;
+constexpr int kFeatureBytesListField = 1;
+constexpr int kFeatureFloatListField = 2;
+constexpr int kFeatureInt64ListField = 3;
+constexpr int kListValueField = 1;
+
+// A length delimited field of a serialized message, size is -1 if the field is not set.
+struct WireSpan {
+  const uint8_t *data = nullptr;
+  int size = -1;
+};
+
+// Reads the length delimited field following the tag at the current position of input, which reads message.
+bool ReadSpan(const WireSpan &message, CodedInputStream *input, WireSpan *field) {
+  uint32_t length = 0;
+  if (!input->ReadVarint32(&length)) {
+    return false;
+  }
+  int position = input->CurrentPosition();
+  if (length > static_cast<uint32_t>(message.size - position)) {
+    return false;
+  }
+  field->data = message.data + position;
+  field->size = static_cast<int>(length);
+  return input->Skip(field->size);
+}
+
+// Calls visit(field_number, field) for each length delimited field of a serialized message and skips the other fields.
+template <typename VisitFunc>
+bool WalkFields(const WireSpan &message, VisitFunc visit) {
+  CodedInputStream input(message.data, std::max(message.size, 0));
+  while (uint32_t tag = input.ReadTag()) {
+    if (WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      WireSpan field;
+      if (!ReadSpan(message, &input, &field) || !visit(WireFormatLite::GetTagFieldNumber(tag), field)) {
+        return false;
+      }
+    } else if (!WireFormatLite::SkipField(&input, tag)) {
+      return false;
+    }
+  }
+  return input.ConsumedEntireMessage();
+}
+
+// Calls packed(run) for each packed run and single(input) for each unpacked value of the values of a serialized
+// FloatList or Int64List, whose unpacked values have single_wire_type.
+template <typename PackedFunc, typename SingleFunc>
+bool WalkListValues(const WireSpan &list, WireFormatLite::WireType single_wire_type, PackedFunc packed,
+                    SingleFunc single) {
+  CodedInputStream input(list.data, std::max(list.size, 0));
+  while (uint32_t tag = input.ReadTag()) {
+    if (WireFormatLite::GetTagFieldNumber(tag) == kListValueField) {
+      if (WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+        WireSpan run;
+        if (!ReadSpan(list, &input, &run) || !packed(run)) {
+          return false;
+        }
+        continue;
+      }
+      if (WireFormatLite::GetTagWireType(tag) == single_wire_type) {
+        if (!single(&input)) {
+          return false;
+        }
+        continue;
+      }
+    }
+    if (!WireFormatLite::SkipField(&input, tag)) {
+      return false;
+    }
+  }
+  return input.ConsumedEntireMessage();
+}
+
+bool CountFloats(const WireSpan &float_list, int32_t *count) {
+  *count = 0;
+  return WalkListValues(
+    float_list, WireFormatLite::WIRETYPE_FIXED32,
+    [count](const WireSpan &run) {
+      if (run.size % sizeof(float) != 0) {
+        return false;
+      }
+      *count += run.size / static_cast<int>(sizeof(float));
+      return true;
+    },
+    [count](CodedInputStream *input) {
+      uint32_t bits = 0;
+      (*count)++;
+      return input->ReadLittleEndian32(&bits);
+    });
+}
+
+bool ReadFloats(const WireSpan &float_list, float *values) {
+  return WalkListValues(
+    float_list, WireFormatLite::WIRETYPE_FIXED32,
+    [&values](const WireSpan &run) {
+      // Packed floats are little endian, as the tensor data.
+      if (run.size > 0 && memcpy_s(values, run.size, run.data, run.size) != EOK) {
+        return false;
+      }
+      values += run.size / sizeof(float);
+      return true;
+    },
+    [&values](CodedInputStream *input) {
+      uint32_t bits = 0;
+      if (!input->ReadLittleEndian32(&bits)) {
+        return false;
+      }
+      *values++ = WireFormatLite::DecodeFloat(bits);
+      return true;
+    });
+}
+
+bool CountInt64s(const WireSpan &int64_list, int32_t *count) {
+  *count = 0;
+  return WalkListValues(
+    int64_list, WireFormatLite::WIRETYPE_VARINT,
+    [count](const WireSpan &run) {
+      // Each varint ends with the only of its bytes without the continuation bit.
+      *count += static_cast<int32_t>(std::count_if(run.data, run.data + run.size, [](uint8_t b) { return b < 0x80; }));
+      return run.size == 0 || run.data[run.size - 1] < 0x80;
+    },
+    [count](CodedInputStream *input) {
+      uint64_t value = 0;
+      (*count)++;
+      return input->ReadVarint64(&value);
+    });
+}
+
+template <typename T>
+bool ReadInt64s(const WireSpan &int64_list, T *values) {
+  auto read_value = [&values](CodedInputStream *input) {
+    uint64_t value = 0;
+    if (!input->ReadVarint64(&value)) {
+      return false;
+    }
+    *values++ = static_cast<T>(static_cast<int64_t>(value));
+    return true;
+  };
+  return WalkListValues(int64_list, WireFormatLite::WIRETYPE_VARINT,
+                        [&read_value](const WireSpan &run) {
+                          CodedInputStream input(run.data, run.size);
+                          while (!input.ExpectAtEnd()) {
+                            if (!read_value(&input)) {
+                              return false;
+                            }
+                          }
+                          return true;
+                        },
+                        read_value);
+}
+}  // namespace
+
 TFReaderOp::Builder::Builder()
     : builder_device_id_(0),
       builder_num_devices_(1),
@@ -191,6 +456,8 @@ Status TFReaderOp::Init() {
     RETURN_IF_NOT_OK(CreateSchema(dataset_files_list_[0], columns_to_load_));
   }
 
+  RETURN_IF_NOT_OK(data_schema_->GetColumnNameMap(&column_index_));
+
   if (total_rows_ == 0) {
     total_rows_ = data_schema_->num_rows();
   }
@@ -221,8 +488,15 @@ Status TFReaderOp::CalculateNumRowsPerShard() {
   }
 
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    std::vector<std::string> file(1, it.value());
-    int64_t num = CountTotalRowsSectioned(file, 0, 1);
+    // The shard readers seek with the checkpoints, keep them while counting so the file is walked once.
+    std::shared_ptr<const TFRecordIndex> record_index;
+    int64_t num = 0;
+    Status rc = GetRecordIndex(it.value(), true, &record_index);
+    if (rc.IsOk()) {
+      num = record_index->num_records;
+    } else {
+      MS_LOG(DEBUG) << "TFReader operator failed to open file " << it.value() << ".";
+    }
     filename_numrows_[it.value()] = num;
     num_rows_ += num;
   }
@@ -570,17 +844,31 @@ Status TFReaderOp::PushIoBlockQueue(int32_t index, std::unique_ptr<FilenameBlock
 Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_offset, const int64_t end_offset,
                             const int32_t &worker_id) {
   std::ifstream reader;
-  reader.open(filename);
+  reader.open(filename, std::ios::binary);
   if (!reader) {
     RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + filename);
   }
 
   int64_t rows_read = 0;
   int64_t rows_total = 0;
+  int64_t rows_end = std::numeric_limits<int64_t>::max();
+  if (start_offset != kInvalidOffset) {
+    // Only the rows of the shard are read, starting from the checkpoint before the first one.
+    std::shared_ptr<const TFRecordIndex> record_index;
+    RETURN_IF_NOT_OK(GetRecordIndex(filename, true, &record_index));
+    rows_end = std::min(end_offset, record_index->num_records);
+    if (start_offset >= rows_end) {
+      return Status::OK();
+    }
+    int64_t checkpoint = start_offset / kRecordCheckpointStride;
+    (void)reader.seekg(record_index->checkpoints[checkpoint]);
+    rows_total = checkpoint * kRecordCheckpointStride;
+  }
   std::unique_ptr<DataBuffer> current_buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
   std::unique_ptr<TensorQTable> new_tensor_table = std::make_unique<TensorQTable>();
+  google::protobuf::Arena arena;
 
-  while (reader.peek() != EOF) {
+  while (rows_total < rows_end && reader.peek() != EOF) {
     if (!load_jagged_connector_) {
       break;
     }
@@ -593,19 +881,19 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
     // ignore crc header
     (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
 
+    // skip the rows between the checkpoint and the shard, with their crc footer
+    if (rows_total < start_offset) {
+      SkipBytes(&reader, record_length + static_cast<int64_t>(sizeof(int32_t)));
+      rows_total++;
+      continue;
+    }
+
     // read serialized Example
     std::string serialized_example;
     serialized_example.resize(record_length);
     (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
-    if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Invalid file, failed to parse tfrecord file : " + serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
-      }
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &new_tensor_table, rows_read));
-      rows_read++;
-    }
+    RETURN_IF_NOT_OK(LoadExample(serialized_example, &arena, &new_tensor_table, rows_read));
+    rows_read++;
 
     // ignore crc footer
     (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
@@ -618,6 +906,7 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
       current_buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
       new_tensor_table = std::make_unique<TensorQTable>();
       rows_read = 0;
+      (void)arena.Reset();
     }
   }
 
@@ -630,72 +919,106 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
 }
 
 // Parses a single row and puts the data into a tensor table.
-Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, std::unique_ptr<TensorQTable> *tensor_table,
-                               int64_t row) {
+Status TFReaderOp::LoadExample(const std::string &serialized_example, google::protobuf::Arena *arena,
+                               std::unique_ptr<TensorQTable> *tensor_table, int64_t row) {
   int32_t num_columns = data_schema_->NumColumns();
   TensorRow newRow(num_columns, nullptr);
   (*tensor_table)->push_back(std::move(newRow));
 
+  // Find the serialized Feature of each column, a name seen again replaces the Feature as in a map.
+  std::vector<WireSpan> column_features(num_columns);
+  std::string feature_name;
+  WireSpan example{reinterpret_cast<const uint8_t *>(serialized_example.data()),
+                   static_cast<int>(serialized_example.size())};
+  auto visit_entry = [this, &column_features, &feature_name](const WireSpan &entry) {
+    WireSpan key{nullptr, 0};
+    WireSpan value{nullptr, 0};
+    if (!WalkFields(entry, [&key, &value](int field_number, const WireSpan &field) {
+          if (field_number == kMapEntryKeyField) {
+            key = field;
+          } else if (field_number == kMapEntryValueField) {
+            value = field;
+          }
+          return true;
+        })) {
+      return false;
+    }
+    (void)feature_name.assign(reinterpret_cast<const char *>(key.data), key.size);
+    auto iter = column_index_.find(feature_name);
+    if (iter != column_index_.end()) {
+      column_features[iter->second] = value;
+    }
+    return true;
+  };
+  bool parsed = WalkFields(example, [&visit_entry](int field_number, const WireSpan &features) {
+    if (field_number != kExampleFeaturesField) {
+      return true;
+    }
+    return WalkFields(features, [&visit_entry](int field_number, const WireSpan &entry) {
+      return field_number != kFeaturesFeatureField || visit_entry(entry);
+    });
+  });
+  if (!parsed) {
+    std::string errMsg = "Invalid file, failed to parse tfrecord file : " + serialized_example;
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
+
   for (int32_t col = 0; col < num_columns; ++col) {
     const ColDescriptor current_col = data_schema_->column(col);
-    const dataengine::Features &example_features = tf_file->features();
-    const google::protobuf::Map<std::string, dataengine::Feature> &feature_map = example_features.feature();
-    auto iter_column = feature_map.find(current_col.name());
-    if (iter_column == feature_map.end()) {
+    const WireSpan &feature = column_features[col];
+    if (feature.size < 0) {
       RETURN_STATUS_UNEXPECTED("Invalid parameter, column name: " + current_col.name() + " does not exist.");
     }
-    const dataengine::Feature &column_values_list = iter_column->second;
-    RETURN_IF_NOT_OK(LoadFeature(tensor_table, column_values_list, current_col, row, col));
+    RETURN_IF_NOT_OK(LoadFeature(tensor_table, feature.data, feature.size, arena, current_col, row, col));
   }
 
   return Status::OK();
 }
 
 // Parses a single cell and puts the data into a tensor table.
-Status TFReaderOp::LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table,
-                               const dataengine::Feature &column_values_list, const ColDescriptor &current_col,
+Status TFReaderOp::LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table, const uint8_t *feature,
+                               int32_t feature_size, google::protobuf::Arena *arena, const ColDescriptor &current_col,
                                int64_t row, int32_t col) {
-  const dataengine::Feature::KindCase column_list_type = column_values_list.kind_case();
-  std::unique_ptr<float[]> float_array;     // For staging data from protobuf deserialization
-  const unsigned char *data_ptr = nullptr;  // Generic pointer used for populating the Tensor
+  // The kind of the Feature is the last list set, as for a oneof.
+  int column_list_type = 0;
+  WireSpan column_values_list;
+  if (!WalkFields(WireSpan{feature, feature_size},
+                  [&column_list_type, &column_values_list](int field_number, const WireSpan &field) {
+                    if (field_number == kFeatureBytesListField || field_number == kFeatureFloatListField ||
+                        field_number == kFeatureInt64ListField) {
+                      column_list_type = field_number;
+                      column_values_list = field;
+                    }
+                    return true;
+                  })) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse tfrecord feature of column: " + current_col.name());
+  }
 
-  // This variable will point into the above staging variables.
-  // Also used for creating shape attributes.
+  // This variable is also used for creating shape attributes.
   int32_t num_elements = 0;
 
-  // we build a tensor first a read directly into it if we need to cast
+  // The float and int lists are read directly into the tensor, the bytes list is parsed on the arena of the buffer
   std::shared_ptr<Tensor> ts;
 
-  // Depending on the type of data from the tf_file, we want to extract 2 things:
-  // 1) A pointer to the data as a const unsigned char *
-  // 2) The number of elements of the data
-  // After those are determined, we can then build the tensor to represent this data.
   switch (column_list_type) {
-    case dataengine::Feature::KindCase::kBytesList: {
-      RETURN_IF_NOT_OK(LoadBytesList(current_col, column_values_list, &num_elements, &ts));
-
+    case kFeatureBytesListField: {
+      auto column_feature = google::protobuf::Arena::CreateMessage<dataengine::Feature>(arena);
+      if (!column_feature->mutable_bytes_list()->ParseFromArray(column_values_list.data, column_values_list.size)) {
+        RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse tfrecord feature of column: " + current_col.name());
+      }
+      RETURN_IF_NOT_OK(LoadBytesList(current_col, *column_feature, &num_elements, &ts));
       break;
     }
-    case dataengine::Feature::KindCase::kFloatList: {
-      RETURN_IF_NOT_OK(LoadFloatList(current_col, column_values_list, &num_elements, &float_array));
-
-      data_ptr = reinterpret_cast<const unsigned char *>(float_array.get());
-
-      // only floatList needs to create the tensor here, other two lists read directly
-      // into the tensor
-      TensorShape current_shape = TensorShape::CreateUnknownRankShape();
-      RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &current_shape));
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(current_shape, current_col.type(), data_ptr, &ts));
+    case kFeatureFloatListField: {
+      RETURN_IF_NOT_OK(
+        LoadFloatList(current_col, column_values_list.data, column_values_list.size, &num_elements, &ts));
       break;
     }
-    case dataengine::Feature::KindCase::kInt64List: {
-      RETURN_IF_NOT_OK(LoadIntListSwitch(current_col, column_values_list, &num_elements, &ts));
+    case kFeatureInt64ListField: {
+      RETURN_IF_NOT_OK(
+        LoadIntListSwitch(current_col, column_values_list.data, column_values_list.size, &num_elements, &ts));
       break;
     }
-    case dataengine::Feature::KindCase::KIND_NOT_SET: {
-      std::string err_msg = "Invalid data, tf_file column type must be uint8, int64 or float32.";
-      RETURN_STATUS_UNEXPECTED(err_msg);
-    }
     default: {
       std::string err_msg = "Invalid data, tf_file column type must be uint8, int64 or float32.";
       RETURN_STATUS_UNEXPECTED(err_msg);
@@ -778,8 +1101,8 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
   return Status::OK();
 }
 
-Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                 int32_t *num_elements, std::unique_ptr<float[]> *float_array) {
+Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const uint8_t *float_list,
+                                 int32_t float_list_size, int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
   // KFloatList can only map to DE types:
   // DE_FLOAT32
   if (current_col.type() != DataType::DE_FLOAT32) {
@@ -788,38 +1111,41 @@ Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const dataeng
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
 
-  const dataengine::FloatList &float_list = column_values_list.float_list();
-
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
-  *num_elements = float_list.value_size();
-  *float_array = std::make_unique<float[]>(*num_elements);
-  for (int i = 0; i < float_list.value_size(); ++i) {
-    (*float_array)[i] = float_list.value(i);
+  // Identify how many values we have, create the tensor and then deserialize into it
+  WireSpan list{float_list, float_list_size};
+  if (!CountFloats(list, num_elements)) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse tfrecord float list of column: " + current_col.name());
+  }
+  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
+  if (*num_elements > 0 && !ReadFloats(list, &(*(*tensor)->begin<float>()))) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse tfrecord float list of column: " + current_col.name());
   }
 
   return Status::OK();
 }
 
 // Determines which template type to use and calls LoadIntList
-Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                     int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
+Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col, const uint8_t *int64_list,
+                                     int32_t int64_list_size, int32_t *num_elements,
+                                     std::shared_ptr<Tensor> *tensor) {
   if (current_col.type() == DataType::DE_UINT64) {
-    RETURN_IF_NOT_OK(LoadIntList<uint64_t>(current_col, column_values_list, num_elements, tensor));
+    RETURN_IF_NOT_OK(LoadIntList<uint64_t>(current_col, int64_list, int64_list_size, num_elements, tensor));
   } else if (current_col.type() == DataType::DE_INT64) {
-    RETURN_IF_NOT_OK(LoadIntList<int64_t>(current_col, column_values_list, num_elements, tensor));
+    RETURN_IF_NOT_OK(LoadIntList<int64_t>(current_col, int64_list, int64_list_size, num_elements, tensor));
   } else if (current_col.type() == DataType::DE_UINT32) {
-    RETURN_IF_NOT_OK(LoadIntList<uint32_t>(current_col, column_values_list, num_elements, tensor));
+    RETURN_IF_NOT_OK(LoadIntList<uint32_t>(current_col, int64_list, int64_list_size, num_elements, tensor));
   } else if (current_col.type() == DataType::DE_INT32) {
-    RETURN_IF_NOT_OK(LoadIntList<int32_t>(current_col, column_values_list, num_elements, tensor));
+    RETURN_IF_NOT_OK(LoadIntList<int32_t>(current_col, int64_list, int64_list_size, num_elements, tensor));
   } else if (current_col.type() == DataType::DE_UINT16) {
-    RETURN_IF_NOT_OK(LoadIntList<uint16_t>(current_col, column_values_list, num_elements, tensor));
+    RETURN_IF_NOT_OK(LoadIntList<uint16_t>(current_col, int64_list, int64_list_size, num_elements, tensor));
   } else if (current_col.type() == DataType::DE_INT16) {
-    RETURN_IF_NOT_OK(LoadIntList<int16_t>(current_col, column_values_list, num_elements, tensor));
+    RETURN_IF_NOT_OK(LoadIntList<int16_t>(current_col, int64_list, int64_list_size, num_elements, tensor));
   } else if (current_col.type() == DataType::DE_UINT8) {
-    RETURN_IF_NOT_OK(LoadIntList<uint8_t>(current_col, column_values_list, num_elements, tensor));
+    RETURN_IF_NOT_OK(LoadIntList<uint8_t>(current_col, int64_list, int64_list_size, num_elements, tensor));
   } else if (current_col.type() == DataType::DE_INT8) {
-    RETURN_IF_NOT_OK(LoadIntList<int8_t>(current_col, column_values_list, num_elements, tensor));
+    RETURN_IF_NOT_OK(LoadIntList<int8_t>(current_col, int64_list, int64_list_size, num_elements, tensor));
   } else {
     std::string err_msg = "Invalid data, invalid datatype for Tensor at column: " + current_col.name() +
                           ", data type should be uint64, int64, uint32, int32, uint16, int16, uint8 or int8" +
@@ -833,7 +1159,7 @@ Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col, const dat
 // Reads values from a bytes list and casts the value to type T, must be an integral type
 // compatible with int64_t
 template <typename T>
-Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const uint8_t *int64_list, int32_t int64_list_size,
                                int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
   if (!(current_col.type().IsInt())) {
     std::string err_msg = "Invalid data, invalid data type for Tensor at column: " + current_col.name() +
@@ -841,22 +1167,18 @@ Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const dataengin
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
 
-  const dataengine::Int64List &int64_list = column_values_list.int64_list();
-
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
-  *num_elements = int64_list.value_size();
+  // Identify how many values we have and then deserialize them into the tensor
+  WireSpan list{int64_list, int64_list_size};
+  if (!CountInt64s(list, num_elements)) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse tfrecord int list of column: " + current_col.name());
+  }
 
   // know how many elements there are, create tensor here:
   TensorShape current_shape = TensorShape::CreateUnknownRankShape();
   RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &current_shape));
   RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
-
-  int64_t i = 0;
-  auto it = (*tensor)->begin<T>();
-  for (; it != (*tensor)->end<T>(); i++, ++it) {
-    T element = static_cast<T>(int64_list.value(i));
-    *it = element;
+  if (*num_elements > 0 && !ReadInt64s(list, &(*(*tensor)->begin<T>()))) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse tfrecord int list of column: " + current_col.name());
   }
 
   return Status::OK();
@@ -986,28 +1308,13 @@ Status TFReaderOp::CountTotalRows(int64_t *out_total_rows, const std::vector<std
 int64_t TFReaderOp::CountTotalRowsSectioned(const std::vector<std::string> &filenames, int64_t begin, int64_t end) {
   int64_t rows_read = 0;
   for (int i = begin; i < end; i++) {
-    std::ifstream reader;
-    reader.open(filenames[i]);
-    if (!reader) {
+    std::shared_ptr<const TFRecordIndex> record_index;
+    Status rc = GetRecordIndex(filenames[i], false, &record_index);
+    if (rc.IsError()) {
       MS_LOG(DEBUG) << "TFReader operator failed to open file " << filenames[i] << ".";
+      continue;
     }
-
-    while (reader.peek() != EOF) {
-      // read length
-      int64_t record_length = 0;
-      (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
-
-      // ignore crc header
-      (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-      // ignore tf_file contents
-      (void)reader.ignore(static_cast<std::streamsize>(record_length));
-
-      // ignore crc footer
-      (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-      rows_read++;
-    }
+    rows_read += record_index->num_records;
   }
 
   return rows_read;
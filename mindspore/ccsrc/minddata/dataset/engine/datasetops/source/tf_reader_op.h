@@ -22,6 +22,7 @@
 #include <mutex>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <utility>
 #include <map>
 
@@ -38,6 +39,12 @@ class Feature;
 class BytesList;
 }  // namespace dataengine
 
+namespace google {
+namespace protobuf {
+class Arena;
+}  // namespace protobuf
+}  // namespace google
+
 namespace mindspore {
 namespace dataset {
 template <typename T>
@@ -297,29 +304,36 @@ class TFReaderOp : public ParallelOp {
   // @return Status - the error code returned.
   Status PushIoBlockQueue(int32_t index, std::unique_ptr<FilenameBlock> &&io_block);
 
-  // Reads a tf_file file and loads the data into multiple buffers.
+  // Reads a tf_file file and loads the data into multiple buffers. If start_offset is valid, the reader seeks to the
+  // last checkpoint of the record index of the file before start_offset, skips to start_offset and stops at
+  // end_offset.
   // @param filename - the tf_file file to read.
-  // @param start_offset - the start offset of file.
-  // @param end_offset - the end offset of file.
+  // @param start_offset - the index of the first row to read, or kInvalidOffset to read the whole file.
+  // @param end_offset - one greater than the index of the last row to read.
   // @param worker_id - the id of the worker that is executing this function.
   // @return Status - the error code returned.
   Status LoadFile(const std::string &filename, const int64_t start_offset, const int64_t end_offset,
                   const int32_t &worker_id);
 
-  // Parses a single row and puts the data into a tensor table.
-  // @param tf_file - the row to be parsed.
+  // Parses a single row and puts the data into a tensor table. The serialized Example is decoded on the wire and
+  // only the features of the columns to load are parsed, the others are skipped.
+  // @param serialized_example - the row to be parsed.
+  // @param arena - the arena of the current buffer, holding the bytes lists parsed by protobuf.
   // @param tensor_table - the tensor table to put the parsed data in.
   // @param row - the id of the row filled in the tensor table.
   // @return Status - the error code returned.
-  Status LoadExample(const dataengine::Example *tf_file, std::unique_ptr<TensorQTable> *tensor_table, int64_t row);
+  Status LoadExample(const std::string &serialized_example, google::protobuf::Arena *arena,
+                     std::unique_ptr<TensorQTable> *tensor_table, int64_t row);
 
   // Parses a single cell and puts the data into a tensor table.
   // @param tensor_table - the tensor table to put the parsed data in.
-  // @param column_values_list - the cell to parse.
+  // @param feature - the serialized Feature of the cell.
+  // @param feature_size - the size of the serialized Feature.
+  // @param arena - the arena of the current buffer, holding the bytes lists parsed by protobuf.
   // @param current_col - the column descriptor containing the expected shape and type of the data.
   // @return Status - the error code returned.
-  Status LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table, const dataengine::Feature &column_values_list,
-                     const ColDescriptor &current_col, int64_t row, int32_t col);
+  Status LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table, const uint8_t *feature, int32_t feature_size,
+                     google::protobuf::Arena *arena, const ColDescriptor &current_col, int64_t row, int32_t col);
 
   // Reads values from a bytes list
   // @param current_col - the column descriptor containing the expected shape and type of the data.
@@ -329,40 +343,44 @@ class TFReaderOp : public ParallelOp {
   static Status LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
                               int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
-  // Reads values from a float list
+  // Reads values from a serialized float list straight into the tensor
   // @param current_col - the column descriptor containing the expected shape and type of the data.
-  // @param column_values_list - the cell that contains the float list to read from.
+  // @param float_list - the serialized FloatList of the cell.
+  // @param float_list_size - the size of the serialized FloatList.
   // @Param numElements - number of values in the float list.
-  // @param float_array - the array we read the values into.
+  // @param tensor - the tensor we read the values into.
   // @return Status - the error code returned.
-  Status LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                       int32_t *num_elements, std::unique_ptr<float[]> *float_array);
+  Status LoadFloatList(const ColDescriptor &current_col, const uint8_t *float_list, int32_t float_list_size,
+                       int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
-  // Reads values from a bytes list and casts the value to type T, must be an integral
+  // Reads values from a serialized int list and casts the value to type T, must be an integral
   // type compatible with int64_t
   // @param current_col - the column descriptor containing the expected shape and type of the data.
-  // @param column_values_list - the cell that contains the int list to read from.
+  // @param int64_list - the serialized Int64List of the cell.
+  // @param int64_list_size - the size of the serialized Int64List.
   // @Param num_elements - number of values in the int list.
   // @param tensor - the tensor we read the values into.
   // @return Status - the error code returned.
   template <typename T>
-  Status LoadIntList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+  Status LoadIntList(const ColDescriptor &current_col, const uint8_t *int64_list, int32_t int64_list_size,
                      int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   // Determines which template type to use and calls LoadIntList
   // @param current_col - the column descriptor containing the expected shape and type of the data.
-  // @param column_values_list - the cell that contains the int list to read from.
+  // @param int64_list - the serialized Int64List of the cell.
+  // @param int64_list_size - the size of the serialized Int64List.
   // @Param numElements - number of values in the int list.
   // @param tensor - the tensor we read the values into.
   // @return Status - the error code returned.
-  Status LoadIntListSwitch(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+  Status LoadIntListSwitch(const ColDescriptor &current_col, const uint8_t *int64_list, int32_t int64_list_size,
                            int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   // Reads one row of data from a tf file and creates a schema based on that row
   // @return Status - the error code returned.
   Status CreateSchema(const std::string tf_file, std::vector<std::string> columns_to_load);
 
-  // Meant to be called async. Will read files in the range [begin, end) and return the total rows
+  // Meant to be called async. Will count the rows of files in the range [begin, end) from their record indexes,
+  // counting the records of the files which are not indexed yet, and return the total rows
   // @param filenames - a list of tf data filenames.
   // @param begin - index of first file to read.
   // @param end - one greater than the index of the last file to read.
@@ -407,6 +425,7 @@ class TFReaderOp : public ParallelOp {
   bool finished_reading_dataset_;
   bool shuffle_files_;
   std::unique_ptr<DataSchema> data_schema_;
+  std::unordered_map<std::string, int32_t> column_index_;  // column id of each column name of the schema
   std::unique_ptr<StringIndex> filename_index_;
   bool load_io_block_queue_;
   bool load_jagged_connector_;
@@ -34,8 +34,10 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each internal queue.
-  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity), end_of_file_(false) {}
+  // @param lock_free Use lock free internal queues.
+  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false)
+      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity, lock_free),
+        end_of_file_(false) {}
 
   // Destructor of DbConnector
   ~DbConnector() = default;
@@ -67,7 +69,7 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
       if (end_of_file_) {
         *result = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
       } else {
-        RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+        RETURN_IF_NOT_OK(PopFront(pop_from_, result));
         if (*result == nullptr) {
           return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                         "[ERROR] nullptr detected when getting data from db connector");
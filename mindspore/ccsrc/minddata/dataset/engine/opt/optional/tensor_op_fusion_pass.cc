@@ -14,38 +14,86 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <memory>
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
 #include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/type_cast_rescale_op.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+bool CastsToFloat32(const std::shared_ptr<TensorOp> &op) {
+  std::vector<DataType> outputs;
+  auto rc = op->OutputType({DataType(DataType::DE_UINT8)}, outputs);
+  return rc.IsOk() && !outputs.empty() && outputs[0] == DataType::DE_FLOAT32;
+}
+}  // namespace
 
-Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified) {
-  // Most primitive pattern: DecodeOp immediately followed by RandomCropAndResizeOp
-  // Abstract into a more general member function that can find any pattern, expressed
-  // by regular expressions, for instance.
-  // Add a list of optimisation policies. For now, just this lambda
-  auto FindPattern = [](auto &tfuncs) {
-    auto it =
-      std::find_if(tfuncs.begin(), tfuncs.end(), [](const auto &tf) -> bool { return tf->Name() == kDecodeOp; });
-    auto next = it + 1;
-    if (it != tfuncs.end() && next != tfuncs.end() && (*next)->Name() == kRandomCropAndResizeOp) {
-      return it;
-    } else {
-      return tfuncs.end();
-    }
+const std::vector<TensorOpFusionPass::FusionRule> &TensorOpFusionPass::Rules() {
+  using TensorOps = std::vector<std::shared_ptr<TensorOp>>;
+  static const std::vector<FusionRule> rules = {
+    // crop the jpeg while decoding
+    {{kDecodeOp, kRandomCropAndResizeOp},
+     [](const TensorOps &ops) -> std::shared_ptr<TensorOp> {
+       return std::make_shared<RandomCropDecodeResizeOp>(*static_cast<RandomCropAndResizeOp *>(ops[1].get()));
+     }},
+    // decode the jpeg at a reduced DCT scale
+    {{kDecodeOp, kResizeOp},
+     [](const TensorOps &ops) -> std::shared_ptr<TensorOp> {
+       return std::make_shared<DecodeResizeOp>(*static_cast<ResizeOp *>(ops[1].get()));
+     }},
+    // normalize into the transposed layout
+    {{kNormalizeOp, kHwcToChwOp},
+     [](const TensorOps &ops) -> std::shared_ptr<TensorOp> {
+       return std::make_shared<NormalizeHwcToChwOp>(*static_cast<NormalizeOp *>(ops[0].get()));
+     }},
+    // rescale converts to float32 by itself
+    {{kTypeCastOp, kRescaleOp},
+     [](const TensorOps &ops) -> std::shared_ptr<TensorOp> {
+       if (!CastsToFloat32(ops[0])) return nullptr;
+       return std::make_shared<TypeCastRescaleOp>(*static_cast<RescaleOp *>(ops[1].get()));
+     }},
+    // rescale already outputs float32
+    {{kRescaleOp, kTypeCastOp},
+     [](const TensorOps &ops) -> std::shared_ptr<TensorOp> { return CastsToFloat32(ops[1]) ? ops[0] : nullptr; }},
   };
+  return rules;
+}
 
+Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified) {
   auto &tfuncs = node->TFuncs();
-  auto it = FindPattern(tfuncs);
-  if (it != tfuncs.end()) {
-    auto next = it + 1;
-    auto op = static_cast<RandomCropAndResizeOp *>(next->get());
-    *it = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*op));
-    tfuncs.erase(next);
+  auto name_matches = [](const std::string &name, const std::shared_ptr<TensorOp> &op) { return op->Name() == name; };
+  size_t pos = 0;
+  while (pos < tfuncs.size()) {
+    bool fused = false;
+    for (const auto &rule : Rules()) {
+      auto len = rule.pattern.size();
+      if (pos + len > tfuncs.size() ||
+          !std::equal(rule.pattern.begin(), rule.pattern.end(), tfuncs.begin() + pos, name_matches)) {
+        continue;
+      }
+      std::vector<std::shared_ptr<TensorOp>> ops(tfuncs.begin() + pos, tfuncs.begin() + pos + len);
+      auto fused_op = rule.fuse(ops);
+      if (fused_op == nullptr) {
+        continue;
+      }
+      MS_LOG(INFO) << "Fused " << len << " tensor ops starting with " << ops[0]->Name() << " into "
+                   << fused_op->Name() << ".";
+      tfuncs[pos] = fused_op;
+      tfuncs.erase(tfuncs.begin() + pos + 1, tfuncs.begin() + pos + len);
+      fused = true;
+      break;
+    }
+    // the fused op may start another pattern, so stay at this position after a fusion
+    if (!fused) {
+      ++pos;
+    }
   }
   if (modified != nullptr) {
     *modified = true;
@@ -16,16 +16,34 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 #include "minddata/dataset/engine/opt/pass.h"
 
 namespace mindspore {
 namespace dataset {
 
+class TensorOp;
+
 /// \class TensorOpFusionPass tensor_op_fusion_pass.h
 /// \brief And optional optimization pass identifying and fusing
 ///     tensor ops within MapOp
 class TensorOpFusionPass : public NodePass {
+ public:
+  /// \brief A run of consecutive tensor ops, matched by name, and the function building the fused op from them.
+  ///     The function returns nullptr when the parameters of the matched ops do not allow the fusion.
+  struct FusionRule {
+    std::vector<std::string> pattern;
+    std::function<std::shared_ptr<TensorOp>(const std::vector<std::shared_ptr<TensorOp>> &)> fuse;
+  };
+
+  /// \brief The rules applied by the pass, the first rule matching at a position wins
+  /// \return The list of fusion rules
+  static const std::vector<FusionRule> &Rules();
+
+ private:
   /// \brief Identifies and fuses tensor ops within MapOp
   /// \param[in] node The node being visited
   /// \param[inout] *modified indicates whether the node has been visited
@@ -285,7 +285,11 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
 }
 
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int scale_num) {
+  if (scale_num < 1 || scale_num > kJpegScaleDenom) {
+    RETURN_STATUS_UNEXPECTED("Jpeg scale " + std::to_string(scale_num) + "/" + std::to_string(kJpegScaleDenom) +
+                             " is not supported");
+  }
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -299,6 +303,8 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
+    cinfo.scale_num = scale_num;
+    cinfo.scale_denom = kJpegScaleDenom;
     jpeg_calc_output_dimensions(&cinfo);
   } catch (std::runtime_error &e) {
     return DestroyDecompressAndReturnError(e.what());
@@ -632,6 +638,64 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   }
 }
 
+template <typename T>
+static void NormalizeHwcToChwImpl(const T *src, float *dst, int64_t num_pixels, const float *scale,
+                                  const float *shift) {
+  constexpr int kNumChannels = 3;
+  float *dst_r = dst;
+  float *dst_g = dst + num_pixels;
+  float *dst_b = dst + 2 * num_pixels;
+  for (int64_t i = 0; i < num_pixels; ++i, src += kNumChannels) {
+    dst_r[i] = static_cast<float>(src[0]) * scale[0] + shift[0];
+    dst_g[i] = static_cast<float>(src[1]) * scale[1] + shift[1];
+    dst_b[i] = static_cast<float>(src[2]) * scale[2] + shift[2];
+  }
+}
+
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std) {
+  if (input->Rank() != 3 || input->shape()[2] != 3 ||
+      (input->type() != DataType::DE_UINT8 && input->type() != DataType::DE_FLOAT32)) {
+    // no single pass kernel for this input, fall back to the two ops
+    std::shared_ptr<Tensor> normalized;
+    RETURN_IF_NOT_OK(Normalize(input, &normalized, mean, std));
+    return HwcToChw(normalized, output);
+  }
+  mean->Squeeze();
+  if (mean->type() != DataType::DE_FLOAT32 || mean->Rank() != 1 || mean->shape()[0] != 3) {
+    std::string err_msg = "Mean tensor should be of size 3 and type float.";
+    return Status(StatusCode::kShapeMisMatch, err_msg);
+  }
+  std->Squeeze();
+  if (std->type() != DataType::DE_FLOAT32 || std->Rank() != 1 || std->shape()[0] != 3) {
+    std::string err_msg = "Std tensor should be of size 3 and type float.";
+    return Status(StatusCode::kShapeMisMatch, err_msg);
+  }
+  // same arithmetic as Normalize: x * (1 / std) + (-mean / std)
+  float scale[3];
+  float shift[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    float mean_c, std_c;
+    RETURN_IF_NOT_OK(mean->GetItemAt<float>(&mean_c, {i}));
+    RETURN_IF_NOT_OK(std->GetItemAt<float>(&std_c, {i}));
+    scale[i] = static_cast<float>(1.0 / std_c);
+    shift[i] = static_cast<float>(-mean_c / std_c);
+  }
+  int height = input->shape()[0];
+  int width = input->shape()[1];
+  std::shared_ptr<Tensor> output_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape{3, height, width}, DataType(DataType::DE_FLOAT32), &output_tensor));
+  float *dst = &(*output_tensor->begin<float>());
+  int64_t num_pixels = static_cast<int64_t>(height) * width;
+  if (input->type() == DataType::DE_UINT8) {
+    NormalizeHwcToChwImpl(input->GetBuffer(), dst, num_pixels, scale, shift);
+  } else {
+    NormalizeHwcToChwImpl(reinterpret_cast<const float *>(input->GetBuffer()), dst, num_pixels, scale, shift);
+  }
+  *output = output_tensor;
+  return Status::OK();
+}
+
 Status AdjustBrightness(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float &alpha) {
   try {
     std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
@@ -96,8 +96,16 @@ bool IsNonEmptyJPEG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+// libjpeg can scale an image by scale_num / kJpegScaleDenom while decoding, in its DCT domain
+constexpr int kJpegScaleDenom = 8;
+
+/// \brief Decodes a jpeg image, optionally cropped and scaled down
+/// \param input: CVTensor containing the not decoded image 1D bytes
+/// \param output: Decoded image Tensor of shape <h,w,C> and type DE_UINT8. Pixel order is RGB
+/// \param x, y, w, h: crop window in the scaled image, all 0 to decode the full image
+/// \param scale_num: the image is scaled by scale_num / kJpegScaleDenom, in [1, kJpegScaleDenom]
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int scale_num = kJpegScaleDenom);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -182,6 +190,14 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                  const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std);
 
+/// \brief Returns Normalized image in CHW layout, doing Normalize and HwcToChw in one pass
+/// \param input: Tensor of shape <H,W,C> in RGB order and any OpenCv compatible type, see CVTensor.
+/// \param mean: Tensor of shape <3> and type DE_FLOAT32 which are mean of each channel in RGB order
+/// \param std:  Tensor of shape <3> and type DE_FLOAT32 which are std of each channel in RGB order
+/// \param output: Normalized image Tensor of shape <C,H,W> and type DE_FLOAT32
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std);
+
 /// \brief Returns image with adjusted brightness.
 /// \param input: Tensor of shape <H,W,3> in RGB order and any OpenCv compatible type, see CVTensor.
 /// \param alpha: Alpha value to adjust brightness by. Should be a positive number.
@@ -41,7 +41,7 @@ class RescaleOp : public TensorOp {
 
   std::string Name() const override { return kRescaleOp; }
 
- private:
+ protected:
   float rescale_;
   float shift_;
 };
@@ -0,0 +1,225 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LOCK_FREE_QUEUE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LOCK_FREE_QUEUE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/services.h"
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+// A bounded multi-producer multi-consumer queue over a ring of slots, with the same interface as Queue.
+// Every slot carries a sequence number telling whether it is free for the producer at a given position or filled
+// for the consumer at that position, so Add and PopFront only race on one atomic position each and never take a
+// lock. A caller that finds the queue full (or empty) spins for a short while, then yields, and only then parks on a
+// condition variable; the other side only touches the mutex when somebody is parked.
+template <typename T>
+class LockFreeQueue {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+
+  explicit LockFreeQueue(int sz)
+      : sz_(sz), slots_(new Slot[sz]), head_(0), tail_(0), my_name_(Services::GetUniqueID()) {
+    for (size_t i = 0; i < sz_; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MS_LOG(DEBUG) << "Create lock free Q with uuid " << my_name_ << " of size " << sz_ << ".";
+  }
+
+  virtual ~LockFreeQueue() { ResetQue(); }
+
+  size_t size() const {
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  size_t capacity() const { return sz_; }
+
+  bool empty() const { return size() == 0; }
+
+  void Reset() { ResetQue(); }
+
+  // Producer
+  Status Add(const_reference ele) noexcept {
+    return Push([&ele](void *p) { new (p) T(ele); });
+  }
+
+  Status Add(T &&ele) noexcept {
+    return Push([&ele](void *p) { new (p) T(std::move(ele)); });
+  }
+
+  template <typename... Ts>
+  Status EmplaceBack(Ts &&... args) noexcept {
+    return Push([&args...](void *p) { new (p) T(std::forward<Ts>(args)...); });
+  }
+
+  // Consumer
+  Status PopFront(pointer p) {
+    auto try_pop = [this, p]() -> bool { return TryPop(p); };
+    Status rc = Wait(try_pop, &consumers_parked_, &empty_cv_);
+    if (rc.IsOk()) {
+      Wake(producers_parked_, &full_cv_);
+    } else {
+      full_cv_.Interrupt();
+    }
+    return rc;
+  }
+
+  // Not thread safe, the queue must be idle
+  void ResetQue() noexcept {
+    T val;
+    while (TryPop(&val)) {
+      // Let val go out of scope and its destructor will be invoked automatically.
+    }
+    empty_cv_.ResetIntrpState();
+    full_cv_.ResetIntrpState();
+  }
+
+  Status Register(TaskGroup *vg) {
+    Status rc1 = empty_cv_.Register(vg->GetIntrpService());
+    Status rc2 = full_cv_.Register(vg->GetIntrpService());
+    if (rc1.IsOk()) {
+      return rc2;
+    } else {
+      return rc1;
+    }
+  }
+
+ private:
+  // Rounds of busy polling and of yielding before a caller parks
+  static constexpr int kSpinCount = 64;
+  static constexpr int kYieldCount = 16;
+
+  struct Slot {
+    std::atomic<size_t> seq;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  template <typename F>
+  Status Push(const F &construct) noexcept {
+    auto try_push = [this, &construct]() -> bool { return TryPush(construct); };
+    Status rc = Wait(try_push, &producers_parked_, &full_cv_);
+    if (rc.IsOk()) {
+      Wake(consumers_parked_, &empty_cv_);
+    } else {
+      empty_cv_.Interrupt();
+    }
+    return rc;
+  }
+
+  template <typename F>
+  bool TryPush(const F &construct) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[pos % sz_];
+      size_t seq = slot.seq.load(std::memory_order_acquire);
+      if (seq == pos) {
+        // the slot is free for this position, claim it
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          construct(&slot.storage);
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (seq < pos) {
+        // the slot still holds the element of the previous lap, the queue is full
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool TryPop(pointer p) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[pos % sz_];
+      size_t seq = slot.seq.load(std::memory_order_acquire);
+      if (seq == pos + 1) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          T *ele = reinterpret_cast<T *>(&slot.storage);
+          *p = std::move(*ele);
+          ele->~T();
+          // free the slot for the producer of the next lap
+          slot.seq.store(pos + sz_, std::memory_order_release);
+          return true;
+        }
+      } else if (seq < pos + 1) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Spin, then yield, then park until try_op succeeds
+  template <typename F>
+  Status Wait(const F &try_op, std::atomic<int> *parked, CondVar *cv) {
+    for (int i = 0; i < kSpinCount + kYieldCount; ++i) {
+      if (try_op()) {
+        return Status::OK();
+      }
+      if (i >= kSpinCount) {
+        std::this_thread::yield();
+      }
+    }
+    std::unique_lock<std::mutex> lck(mux_);
+    parked->fetch_add(1);
+    // pairs with the fence in Wake, either we see the other side's update or it sees us parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Status rc = cv->Wait(&lck, try_op);
+    parked->fetch_sub(1);
+    return rc;
+  }
+
+  void Wake(const std::atomic<int> &parked, CondVar *cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked.load(std::memory_order_relaxed) > 0) {
+      // taking the mutex makes sure the waiter is either before its last check or already asleep
+      { std::lock_guard<std::mutex> lck(mux_); }
+      cv->NotifyAll();
+    }
+  }
+
+  size_t sz_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(64) std::atomic<size_t> head_;
+  alignas(64) std::atomic<size_t> tail_;
+  alignas(64) std::atomic<int> producers_parked_{0};
+  std::atomic<int> consumers_parked_{0};
+  std::string my_name_;
+  std::mutex mux_;
+  CondVar empty_cv_;
+  CondVar full_cv_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LOCK_FREE_QUEUE_H_
@@ -171,8 +171,9 @@ class Queue {
 };
 
 // A container of queues with [] operator accessors.  Basically this is a wrapper over of a vector of queues
-// to help abstract/simplify code that is maintaining multiple queues.
-template <typename T>
+// to help abstract/simplify code that is maintaining multiple queues. Q is the queue type, any class with the
+// interface of Queue, e.g. LockFreeQueue, can be used.
+template <typename T, typename Q = Queue<T>>
 class QueueList {
  public:
   QueueList() {}
@@ -180,7 +181,7 @@ class QueueList {
   void Init(int num_queues, int capacity) {
     queue_list_.reserve(num_queues);
     for (int i = 0; i < num_queues; i++) {
-      queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity));
+      queue_list_.emplace_back(std::make_unique<Q>(capacity));
     }
   }
 
@@ -196,9 +197,9 @@ class QueueList {
 
   auto size() const { return queue_list_.size(); }
 
-  std::unique_ptr<Queue<T>> &operator[](const int index) { return queue_list_[index]; }
+  std::unique_ptr<Q> &operator[](const int index) { return queue_list_[index]; }
 
-  const std::unique_ptr<Queue<T>> &operator[](const int index) const { return queue_list_[index]; }
+  const std::unique_ptr<Q> &operator[](const int index) const { return queue_list_[index]; }
 
   ~QueueList() = default;
 
@@ -206,7 +207,7 @@ class QueueList {
   // Queue contains non-copyable objects, so it cannot be added to a vector due to the vector
   // requirement that objects must have copy semantics.  To resolve this, we use a vector of unique
   // pointers.  This allows us to provide dynamic creation of queues in a container.
-  std::vector<std::unique_ptr<Queue<T>>> queue_list_;
+  std::vector<std::unique_ptr<Q>> queue_list_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,128 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+// suffix of the columnar index file written next to each shard file and its sqlite index
+const char kColumnarIndexSuffix[] = ".idx";
+
+/// \brief Read-only, columnar copy of the INDEXES table of one shard.
+///
+/// The file holds the fixed offset columns of every row sorted by ROW_ID, plus one dictionary-encoded column per
+/// index field: the sorted distinct values as they are rendered by sqlite, and a 32-bit code per row. It is mapped
+/// into memory on Open, so readers get offsets and category values without running any sql.
+class ShardColumnarIndex {
+ public:
+  // fixed columns, in the order they are stored
+  enum Column {
+    kRowGroupId = 0,
+    kPageIdRaw,
+    kPageOffsetRaw,
+    kPageOffsetRawEnd,
+    kPageIdBlob,
+    kPageOffsetBlob,
+    kPageOffsetBlobEnd,
+    kNumFixedColumns
+  };
+
+  ShardColumnarIndex() = default;
+
+  ~ShardColumnarIndex();
+
+  ShardColumnarIndex(const ShardColumnarIndex &) = delete;
+
+  ShardColumnarIndex &operator=(const ShardColumnarIndex &) = delete;
+
+  /// \brief serialize one shard's index
+  /// \param[in] index_path path of the index file
+  /// \param[in] shard_name file name of the shard, used to validate the pairing on open
+  /// \param[in] shard_size size of the shard file in bytes, used to detect stale index files
+  /// \param[in] field_names index field names, as generated by ShardIndexGenerator::GenerateFieldName
+  /// \param[in] rows rows sorted by ROW_ID, kNumFixedColumns offsets followed by one value per index field
+  /// \return MSRStatus the status of MSRStatus
+  static MSRStatus Write(const std::string &index_path, const std::string &shard_name, uint64_t shard_size,
+                         const std::vector<std::string> &field_names, const std::vector<std::vector<std::string>> &rows);
+
+  /// \brief map an index file and check it belongs to the given shard
+  /// \param[in] shard_path path of the shard file, the index is read from shard_path + kColumnarIndexSuffix
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus Open(const std::string &shard_path);
+
+  /// \brief get the number of rows
+  uint64_t GetNumRows() const { return num_rows_; }
+
+  /// \brief get a fixed column value of a row
+  uint64_t Get(Column column, uint64_t row) const { return columns_[column][row]; }
+
+  /// \brief get the rows [begin, end) stored in a blob page
+  std::pair<uint64_t, uint64_t> GetRowsInBlobPage(uint64_t page_id) const;
+
+  /// \brief get the id of an index field, -1 if the field is not indexed
+  int GetFieldId(const std::string &field_name) const;
+
+  /// \brief get the number of distinct values of an index field
+  uint64_t GetNumDistinct(int field_id) const { return fields_[field_id].num_distinct; }
+
+  /// \brief get a distinct value of an index field, values are sorted
+  std::string GetDistinctValue(int field_id, uint32_t code) const;
+
+  /// \brief get the dictionary code of a row
+  uint32_t GetCode(int field_id, uint64_t row) const { return fields_[field_id].codes[row]; }
+
+  /// \brief find the codes equal to a criteria value, numbers are compared by value like sqlite does
+  /// \param[in] field_id id of index field
+  /// \param[in] value criteria value
+  /// \param[in] is_number whether the field holds numbers
+  /// \return flag per code
+  std::vector<bool> MatchCodes(int field_id, const std::string &value, bool is_number) const;
+
+ private:
+  struct Field {
+    std::string name;
+    uint64_t num_distinct;
+    const uint64_t *value_offsets;  // num_distinct + 1 offsets into values
+    const char *values;
+    const uint32_t *codes;  // one per row
+  };
+
+  /// \brief parse the mapped buffer
+  MSRStatus Parse(const std::string &shard_path);
+
+  /// \brief release the mapped buffer
+  void Release();
+
+  uint8_t *data_ = nullptr;
+  uint64_t size_ = 0;
+  std::vector<uint8_t> buffer_;  // used instead of mmap on platforms without it
+  uint64_t num_rows_ = 0;
+  const uint64_t *columns_[kNumFixedColumns] = {nullptr};
+  std::vector<Field> fields_;
+  std::unordered_map<std::string, int> field_ids_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
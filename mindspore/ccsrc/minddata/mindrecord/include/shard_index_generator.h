@@ -25,6 +25,7 @@
 #include <tuple>
 #include <utility>
 #include <vector>
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "minddata/mindrecord/include/shard_header.h"
 #include "./sqlite3.h"
 
@@ -105,6 +106,9 @@ class ShardIndexGenerator {
   void AddIndexFieldByRawData(const std::vector<json> &schema_detail,
                               std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
 
+  /// \brief dump the INDEXES table of one shard into its columnar index file
+  MSRStatus WriteColumnarIndex(int shard_no);
+
   void DatabaseWriter();  // worker thread
 
   std::string file_path_;
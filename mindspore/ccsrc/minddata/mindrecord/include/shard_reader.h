@@ -18,8 +18,10 @@
 #define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_READER_H_
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <signal.h>
 #if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
 #include <sys/prctl.h>
 #endif
 #include <sys/stat.h>
@@ -45,6 +47,7 @@
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
@@ -63,6 +66,7 @@ using ROW_GROUP_BRIEF =
   std::tuple<MSRStatus, std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_RETURN_CONTENT =
   std::pair<MSRStatus, std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>>;
+using TASK_RETURN_VIEW = std::pair<TaskType, std::vector<std::tuple<const uint8_t *, uint64_t, json>>>;
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
 
 class ShardReader {
@@ -183,6 +187,11 @@ class ShardReader {
   std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> GetNextById(const int64_t &task_id,
                                                                                        const int32_t &consumer_id);
 
+  /// \brief return a row by id without copying its blob, only available when shard files are mapped
+  /// \param[in] task_id task ID
+  /// \return task type and a row of (blob address, blob size, label), the blob stays valid until Close()
+  TASK_RETURN_VIEW GetNextViewById(const int64_t &task_id);
+
   /// \brief return a batch, given that one is ready, python API
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<std::vector<uint8_t>>, pybind11::object>> GetNextPy();
@@ -199,6 +208,17 @@ class ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief look up offsets and index fields in the columnar index files when they exist, must be set before Open
+  /// \return null
+  void SetUseColumnarIndex(bool use_columnar_index) { use_columnar_index_ = use_columnar_index; }
+
+  /// \brief read shard files through mmap instead of file streams, must be set before Open
+  /// \return null
+  void SetUseMmap(bool use_mmap) { use_mmap_ = use_mmap; }
+
+  /// \brief check if shard files are mapped, i.e. GetNextViewById is available
+  bool IsMapped() const { return !file_maps_.empty(); }
+
   /// \brief get all classes
   MSRStatus GetAllClasses(const std::string &category_field, std::set<std::string> &categories);
 
@@ -218,6 +238,29 @@ class ShardReader {
   /// \brief read all rows for specified columns
   ROW_GROUPS ReadAllRowGroup(std::vector<std::string> &columns);
 
+  /// \brief read a label from raw data page
+  MSRStatus ReadLabelFromRawPage(std::shared_ptr<std::fstream> fs, int raw_page_id, uint64_t label_start,
+                                 uint64_t label_end, const std::vector<std::string> &columns, json *label);
+
+  /// \brief convert an index field value to json by its type in schema
+  static json ConvertIndexValue(const json &schema, const std::string &column, const std::string &value);
+
+  /// \brief read all rows in one shard from its columnar index
+  MSRStatus ReadAllRowsInColumnarIndex(int shard_id, const std::vector<std::string> &columns,
+                                       std::vector<std::vector<std::vector<uint64_t>>> &offsets,
+                                       std::vector<std::vector<json>> &column_values);
+
+  /// \brief get the columnar index rows of a blob page that satisfy the criteria
+  MSRStatus GetRowsInColumnarIndex(int page_id, int shard_id, const std::pair<std::string, std::string> &criteria,
+                                   std::vector<uint64_t> *rows);
+
+  /// \brief get the index fields of some columns in columnar index, with their values converted to json
+  MSRStatus GetColumnarIndexFields(int shard_id, const std::vector<std::string> &columns,
+                                   std::vector<std::pair<int, std::vector<json>>> *fields);
+
+  /// \brief get classes of one shard from its columnar index
+  void GetClassesInColumnarIndex(int shard_id, const std::string &field_name, std::set<std::string> &categories);
+
   /// \brief read all rows in one shard
   MSRStatus ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                                std::vector<std::vector<std::vector<uint64_t>>> &offsets,
@@ -267,6 +310,19 @@ class ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
+  /// \brief map all shard files into memory, shared by all consumers
+  MSRStatus MapFiles();
+
+  /// \brief unmap shard files
+  void UnmapFiles();
+
+  /// \brief get the position of one task's blob in its shard file
+  MSRStatus LocateTaskBlob(int task_id, TaskType *task_type, int *shard_id, uint64_t *file_offset,
+                           uint64_t *blob_size);
+
+  /// \brief hint the kernel to page in the blob of one task ahead of use
+  void PrefetchTask(int task_id);
+
   /// \brief read one row by one task
   TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
 
@@ -294,9 +350,11 @@ class ShardReader {
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardColumnarIndex>> columnar_indexes_;            // columnar index list
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::pair<uint8_t *, uint64_t>> file_maps_;                        // mapped files (address, size)
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -307,8 +365,11 @@ class ShardReader {
   std::mutex shard_locker_;                                // locker of shard
 
   // flags
-  bool all_in_index_ = true;  // if all columns are stored in index-table
-  bool interrupt_ = false;    // reader interrupted
+  bool all_in_index_ = true;        // if all columns are stored in index-table
+  bool interrupt_ = false;          // reader interrupted
+  bool use_mmap_ = false;           // read shard files through mmap
+  bool use_columnar_index_ = true;  // prefer columnar index files to sqlite
+  bool random_access_ = false;      // tasks are visited out of file order
 
   int num_padded_;  // number of padding samples
 
@@ -23,6 +23,7 @@ using mindspore::ExceptionType::NoExceptionType;
 using mindspore::MsLogLevel::DEBUG;
 using mindspore::MsLogLevel::ERROR;
 using mindspore::MsLogLevel::INFO;
+using mindspore::MsLogLevel::WARNING;
 
 namespace mindspore {
 namespace mindrecord {
@@ -562,6 +563,65 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
   return SUCCESS;
 }
 
+MSRStatus ShardIndexGenerator::WriteColumnarIndex(int shard_no) {
+  std::string shard_address = shard_header_.GetShardAddressByID(shard_no);
+  std::string index_address = shard_address + kColumnarIndexSuffix;
+  // never leave an index of the previous content behind, readers fall back to sqlite without one
+  (void)remove(common::SafeCStr(index_address));
+
+  sqlite3 *db = nullptr;
+  if (sqlite3_open_v2(common::SafeCStr(shard_address + ".db"), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+    MS_LOG(ERROR) << "Invalid file, failed to open database: " << shard_address << ".db, error: " << sqlite3_errmsg(db);
+    (void)sqlite3_close(db);
+    return FAILED;
+  }
+  // read back what sqlite stored, so that values are rendered exactly as sql readers would see them
+  std::string sql =
+    "SELECT ROW_GROUP_ID, PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END, PAGE_ID_BLOB, PAGE_OFFSET_BLOB, "
+    "PAGE_OFFSET_BLOB_END";
+  std::vector<std::string> field_names;
+  for (const auto &field : fields_) {
+    auto ret = GenerateFieldName(field);
+    if (ret.first != SUCCESS) {
+      (void)sqlite3_close(db);
+      return FAILED;
+    }
+    sql += "," + ret.second;
+    field_names.push_back(ret.second);
+  }
+  sql += " FROM INDEXES ORDER BY ROW_ID;";
+  std::vector<std::vector<std::string>> rows;
+  char *errmsg = nullptr;
+  auto select_callback = [](void *p_data, int num_fields, char **p_fields, char **p_col_names) -> int {
+    auto *records = static_cast<std::vector<std::vector<std::string>> *>(p_data);
+    std::vector<std::string> record;
+    for (int i = 0; i < num_fields; ++i) {
+      record.emplace_back(p_fields[i] == nullptr ? "" : p_fields[i]);
+    }
+    records->push_back(std::move(record));
+    return 0;
+  };
+  if (sqlite3_exec(db, common::SafeCStr(sql), select_callback, &rows, &errmsg) != SQLITE_OK) {
+    MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
+    sqlite3_free(errmsg);
+    (void)sqlite3_close(db);
+    return FAILED;
+  }
+  (void)sqlite3_close(db);
+
+  struct stat shard_stat;
+  if (stat(common::SafeCStr(shard_address), &shard_stat) != 0) {
+    MS_LOG(ERROR) << "Invalid file, failed to get size of file: " << shard_address;
+    return FAILED;
+  }
+  if (ShardColumnarIndex::Write(index_address, GetFileName(shard_address).second,
+                                static_cast<uint64_t>(shard_stat.st_size), field_names, rows) != SUCCESS) {
+    MS_LOG(WARNING) << "Failed to generate columnar index for shard: " << shard_no << ", readers will use sqlite.";
+    (void)remove(common::SafeCStr(index_address));
+  }
+  return SUCCESS;
+}
+
 MSRStatus ShardIndexGenerator::WriteToDatabase() {
   fields_ = shard_header_.GetFields();
   page_size_ = shard_header_.GetPageSize();
@@ -620,6 +680,10 @@ void ShardIndexGenerator::DatabaseWriter() {
       write_success_ = false;
       return;
     }
+    if (WriteColumnarIndex(shard_no) != SUCCESS) {
+      write_success_ = false;
+      return;
+    }
     MS_LOG(INFO) << "Generate index db for shard: " << shard_no << " successfully.";
     shard_no = task_++;
   }
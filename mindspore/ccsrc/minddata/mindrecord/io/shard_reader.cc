@@ -95,6 +95,16 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
       MS_LOG(ERROR) << "Mindrecord files meta information is different.";
       return FAILED;
     }
+    // with a columnar index, the shard never needs to touch sqlite
+    if (use_columnar_index_) {
+      auto columnar_index = std::make_shared<ShardColumnarIndex>();
+      if (columnar_index->Open(file) == SUCCESS) {
+        columnar_indexes_.push_back(columnar_index);
+        database_paths_.push_back(nullptr);
+        continue;
+      }
+    }
+    columnar_indexes_.push_back(nullptr);
     sqlite3 *db = nullptr;
     // sqlite3_open create a database if not found, use sqlite3_open_v2 instead of it
     int rc = sqlite3_open_v2(common::SafeCStr(file + ".db"), &db, SQLITE_OPEN_READONLY, nullptr);
@@ -151,7 +161,9 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
   MS_LOG(INFO) << "Blob data size, on disk: " << disk_size << " , addtional uncompression: " << compression_size
                << " , Total: " << total_blob_size_;
 
-  MS_LOG(INFO) << "Get meta from mindrecord file & index file successfully.";
+  MS_LOG(INFO) << "Get meta from mindrecord file & index file successfully, "
+               << std::count(database_paths_.begin(), database_paths_.end(), nullptr) << " of " << file_paths_.size()
+               << " shards use columnar index.";
 
   return SUCCESS;
 }
@@ -191,6 +203,13 @@ MSRStatus ShardReader::Open() {
 }
 
 MSRStatus ShardReader::Open(int n_consumer) {
+  if (use_mmap_) {
+    if (MapFiles() == SUCCESS) {
+      return SUCCESS;
+    }
+    MS_LOG(WARNING) << "Failed to map shard files, fall back to file streams.";
+    UnmapFiles();
+  }
   file_streams_random_ =
     std::vector<std::vector<std::shared_ptr<std::fstream>>>(n_consumer, std::vector<std::shared_ptr<std::fstream>>());
   for (const auto &file : file_paths_) {
@@ -209,6 +228,52 @@ MSRStatus ShardReader::Open(int n_consumer) {
   return SUCCESS;
 }
 
+MSRStatus ShardReader::MapFiles() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  // Shuffled and category-driven tasks jump around the file, where kernel readahead only pollutes the page cache
+  random_access_ = std::any_of(operators_.begin(), operators_.end(), [](const std::shared_ptr<ShardOperator> &op) {
+    return std::dynamic_pointer_cast<ShardShuffle>(op) != nullptr ||
+           std::dynamic_pointer_cast<ShardCategory>(op) != nullptr;
+  });
+  for (const auto &file : file_paths_) {
+    int fd = open(common::SafeCStr(file), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(ERROR) << "Invalid file, failed to open file: " << file;
+      return FAILED;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+      MS_LOG(ERROR) << "Invalid file, failed to get size of file: " << file;
+      (void)close(fd);
+      return FAILED;
+    }
+    auto file_size = static_cast<uint64_t>(file_stat.st_size);
+    void *addr = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+      MS_LOG(ERROR) << "Failed to map file: " << file;
+      return FAILED;
+    }
+    (void)madvise(addr, file_size, random_access_ ? MADV_RANDOM : MADV_SEQUENTIAL);
+    file_maps_.emplace_back(static_cast<uint8_t *>(addr), file_size);
+  }
+  MS_LOG(INFO) << "Map shard files successfully, access pattern is " << (random_access_ ? "random." : "sequential.");
+  return SUCCESS;
+#else
+  MS_LOG(WARNING) << "Mapping shard files is not supported on this platform.";
+  return FAILED;
+#endif
+}
+
+void ShardReader::UnmapFiles() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (auto &file_map : file_maps_) {
+    (void)munmap(file_map.first, file_map.second);
+  }
+#endif
+  file_maps_.clear();
+}
+
 void ShardReader::FileStreamsOperator() {
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; --i) {
     if (file_streams_[i] != nullptr) {
@@ -222,6 +287,7 @@ void ShardReader::FileStreamsOperator() {
       }
     }
   }
+  UnmapFiles();
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       auto ret = sqlite3_close(database_paths_[i]);
@@ -309,31 +375,9 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
       int raw_page_id = std::stoi(labels[i][3]);
       uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
       uint64_t label_end = std::stoull(labels[i][5]);
-      auto len = label_end - label_start;
-      auto label_raw = std::vector<uint8_t>(len);
-      auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-      if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-        MS_LOG(ERROR) << "File seekg failed";
-        fs->close();
-        return FAILED;
-      }
-
-      auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-      if (!io_read.good() || io_read.fail() || io_read.bad()) {
-        MS_LOG(ERROR) << "File read failed";
-        fs->close();
-        return FAILED;
-      }
-      json label_json = json::from_msgpack(label_raw);
       json tmp;
-      if (!columns.empty()) {
-        for (auto &col : columns) {
-          if (label_json.find(col) != label_json.end()) {
-            tmp[col] = label_json[col];
-          }
-        }
-      } else {
-        tmp = label_json;
+      if (ReadLabelFromRawPage(fs, raw_page_id, label_start, label_end, columns, &tmp) != SUCCESS) {
+        return FAILED;
       }
       column_values[shard_id].emplace_back(tmp);
     } else {
@@ -362,9 +406,161 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
   return SUCCESS;
 }
 
+MSRStatus ShardReader::ReadLabelFromRawPage(std::shared_ptr<std::fstream> fs, int raw_page_id, uint64_t label_start,
+                                            uint64_t label_end, const std::vector<std::string> &columns, json *label) {
+  auto len = label_end - label_start;
+  auto label_raw = std::vector<uint8_t>(len);
+  auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    MS_LOG(ERROR) << "File seekg failed";
+    fs->close();
+    return FAILED;
+  }
+
+  auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    MS_LOG(ERROR) << "File read failed";
+    fs->close();
+    return FAILED;
+  }
+  json label_json = json::from_msgpack(label_raw);
+  if (!columns.empty()) {
+    for (auto &col : columns) {
+      if (label_json.find(col) != label_json.end()) {
+        (*label)[col] = label_json[col];
+      }
+    }
+  } else {
+    *label = std::move(label_json);
+  }
+  return SUCCESS;
+}
+
+json ShardReader::ConvertIndexValue(const json &schema, const std::string &column, const std::string &value) {
+  // convert the string to base type by schema
+  if (schema[column]["type"] == "int32") {
+    return StringToNum<int32_t>(value);
+  } else if (schema[column]["type"] == "int64") {
+    return StringToNum<int64_t>(value);
+  } else if (schema[column]["type"] == "float32") {
+    return StringToNum<float>(value);
+  } else if (schema[column]["type"] == "float64") {
+    return StringToNum<double>(value);
+  }
+  return value;
+}
+
+MSRStatus ShardReader::GetColumnarIndexFields(int shard_id, const std::vector<std::string> &columns,
+                                              std::vector<std::pair<int, std::vector<json>>> *fields) {
+  const auto &index = columnar_indexes_[shard_id];
+  auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+  for (const auto &column : columns) {
+    auto field_name = column + "_" + std::to_string(column_schema_id_[column]);
+    int field_id = index->GetFieldId(field_name);
+    if (field_id < 0) {
+      MS_LOG(ERROR) << "Field " << field_name << " does not exist in columnar index of shard " << shard_id << ".";
+      return FAILED;
+    }
+    // convert each distinct value once, rows only refer to them by code
+    std::vector<json> values;
+    for (uint32_t code = 0; code < index->GetNumDistinct(field_id); ++code) {
+      values.push_back(ConvertIndexValue(schema, column, index->GetDistinctValue(field_id, code)));
+    }
+    fields->emplace_back(field_id, std::move(values));
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::ReadAllRowsInColumnarIndex(int shard_id, const std::vector<std::string> &columns,
+                                                  std::vector<std::vector<std::vector<uint64_t>>> &offsets,
+                                                  std::vector<std::vector<json>> &column_values) {
+  const auto &index = columnar_indexes_[shard_id];
+  std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
+  std::vector<std::pair<int, std::vector<json>>> fields;
+  if (!all_in_index_) {
+    fs->open(common::SafeCStr(file_paths_[shard_id]), std::ios::in | std::ios::binary);
+    if (!fs->good()) {
+      MS_LOG(ERROR) << "Invalid file, failed to open file: " << file_paths_[shard_id];
+      return FAILED;
+    }
+  } else if (GetColumnarIndexFields(shard_id, columns, &fields) != SUCCESS) {
+    return FAILED;
+  }
+
+  uint64_t num_rows = index->GetNumRows();
+  offsets[shard_id].reserve(num_rows);
+  column_values[shard_id].reserve(num_rows);
+  for (uint64_t row = 0; row < num_rows; ++row) {
+    offsets[shard_id].emplace_back(std::vector<uint64_t>{
+      static_cast<uint64_t>(shard_id), index->Get(ShardColumnarIndex::kRowGroupId, row),
+      index->Get(ShardColumnarIndex::kPageOffsetBlob, row) + kInt64Len,
+      index->Get(ShardColumnarIndex::kPageOffsetBlobEnd, row)});
+    json label;
+    if (!all_in_index_) {
+      if (ReadLabelFromRawPage(fs, static_cast<int>(index->Get(ShardColumnarIndex::kPageIdRaw, row)),
+                               index->Get(ShardColumnarIndex::kPageOffsetRaw, row) + kInt64Len,
+                               index->Get(ShardColumnarIndex::kPageOffsetRawEnd, row), columns, &label) != SUCCESS) {
+        return FAILED;
+      }
+    } else {
+      for (uint32_t j = 0; j < columns.size(); ++j) {
+        label[columns[j]] = fields[j].second[index->GetCode(fields[j].first, row)];
+      }
+    }
+    column_values[shard_id].push_back(std::move(label));
+  }
+  MS_LOG(INFO) << "Get " << num_rows << " records from shard " << shard_id << " columnar index.";
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::GetRowsInColumnarIndex(int page_id, int shard_id,
+                                              const std::pair<std::string, std::string> &criteria,
+                                              std::vector<uint64_t> *rows) {
+  const auto &index = columnar_indexes_[shard_id];
+  auto range = index->GetRowsInBlobPage(page_id);
+  if (criteria.first.empty()) {
+    for (uint64_t row = range.first; row < range.second; ++row) {
+      rows->push_back(row);
+    }
+    return SUCCESS;
+  }
+  auto field_name = criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]);
+  int field_id = index->GetFieldId(field_name);
+  if (field_id < 0) {
+    MS_LOG(ERROR) << "Field " << field_name << " does not exist in columnar index of shard " << shard_id << ".";
+    return FAILED;
+  }
+  auto schema = shard_header_->GetSchemas()[0]->GetSchema();
+  bool is_number = kNumberFieldTypeSet.find(schema["schema"][criteria.first]["type"]) != kNumberFieldTypeSet.end();
+  auto matched = index->MatchCodes(field_id, criteria.second, is_number);
+  for (uint64_t row = range.first; row < range.second; ++row) {
+    if (matched[index->GetCode(field_id, row)]) {
+      rows->push_back(row);
+    }
+  }
+  return SUCCESS;
+}
+
+void ShardReader::GetClassesInColumnarIndex(int shard_id, const std::string &field_name,
+                                            std::set<std::string> &categories) {
+  const auto &index = columnar_indexes_[shard_id];
+  int field_id = index->GetFieldId(field_name);
+  if (field_id < 0) {
+    MS_LOG(ERROR) << "Field " << field_name << " does not exist in columnar index of shard " << shard_id << ".";
+    return;
+  }
+  std::lock_guard<std::mutex> lck(shard_locker_);
+  for (uint32_t code = 0; code < index->GetNumDistinct(field_id); ++code) {
+    categories.emplace(index->GetDistinctValue(field_id, code));
+  }
+}
+
 MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                                           std::vector<std::vector<std::vector<uint64_t>>> &offsets,
                                           std::vector<std::vector<json>> &column_values) {
+  if (columnar_indexes_[shard_id] != nullptr) {
+    return ReadAllRowsInColumnarIndex(shard_id, columns, offsets, column_values);
+  }
   auto db = database_paths_[shard_id];
   std::vector<std::vector<std::string>> labels;
   char *errmsg = nullptr;
@@ -407,11 +603,17 @@ MSRStatus ShardReader::GetAllClasses(const std::string &category_field, std::set
   std::string sql = "SELECT DISTINCT " + ret.second + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
+    if (columnar_indexes_[x] != nullptr) {
+      GetClassesInColumnarIndex(x, ret.second, categories);
+      continue;
+    }
     threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, std::ref(categories));
   }
 
   for (int x = 0; x < shard_count_; x++) {
-    threads[x].join();
+    if (threads[x].joinable()) {
+      threads[x].join();
+    }
   }
   return SUCCESS;
 }
@@ -526,6 +728,19 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
 
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
+  if (columnar_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    if (GetRowsInColumnarIndex(page_id, shard_id, criteria, &rows) != SUCCESS) {
+      return std::vector<std::vector<uint64_t>>();
+    }
+    const auto &index = columnar_indexes_[shard_id];
+    std::vector<std::vector<uint64_t>> res;
+    for (auto row : rows) {
+      res.emplace_back(std::vector<uint64_t>{index->Get(ShardColumnarIndex::kPageOffsetBlob, row) + kInt64Len,
+                                             index->Get(ShardColumnarIndex::kPageOffsetBlobEnd, row)});
+    }
+    return res;
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql =
@@ -674,6 +889,20 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromBinaryFile(
 std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromPage(
   int page_id, int shard_id, const std::vector<std::string> &columns,
   const std::pair<std::string, std::string> &criteria) {
+  if (columnar_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    if (GetRowsInColumnarIndex(page_id, shard_id, criteria, &rows) != SUCCESS) {
+      return {FAILED, {}};
+    }
+    const auto &index = columnar_indexes_[shard_id];
+    std::vector<std::vector<std::string>> label_offsets;
+    for (auto row : rows) {
+      label_offsets.push_back({std::to_string(index->Get(ShardColumnarIndex::kPageIdRaw, row)),
+                               std::to_string(index->Get(ShardColumnarIndex::kPageOffsetRaw, row)),
+                               std::to_string(index->Get(ShardColumnarIndex::kPageOffsetRawEnd, row))});
+    }
+    return GetLabelsFromBinaryFile(shard_id, columns, label_offsets);
+  }
   // get page info from sqlite
   auto db = database_paths_[shard_id];
   std::string sql = "SELECT PAGE_ID_RAW, PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END FROM INDEXES WHERE PAGE_ID_BLOB = " +
@@ -705,6 +934,24 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromPage(
 std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabels(int page_id, int shard_id,
                                                                const std::vector<std::string> &columns,
                                                                const std::pair<std::string, std::string> &criteria) {
+  if (all_in_index_ && columnar_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    std::vector<std::pair<int, std::vector<json>>> fields;
+    if (GetRowsInColumnarIndex(page_id, shard_id, criteria, &rows) != SUCCESS ||
+        GetColumnarIndexFields(shard_id, columns, &fields) != SUCCESS) {
+      return {FAILED, {}};
+    }
+    const auto &index = columnar_indexes_[shard_id];
+    std::vector<json> ret;
+    for (auto row : rows) {
+      json construct_json;
+      for (unsigned int j = 0; j < columns.size(); ++j) {
+        construct_json[columns[j]] = fields[j].second[index->GetCode(fields[j].first, row)];
+      }
+      ret.push_back(std::move(construct_json));
+    }
+    return {SUCCESS, ret};
+  }
   if (all_in_index_) {
     auto db = database_paths_[shard_id];
     std::string fields;
@@ -790,6 +1037,10 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count);
   std::set<std::string> categories;
   for (int x = 0; x < shard_count; x++) {
+    if (columnar_indexes_[x] != nullptr) {
+      GetClassesInColumnarIndex(x, ret.second, categories);
+      continue;
+    }
     sqlite3 *db = nullptr;
     int rc = sqlite3_open_v2(common::SafeCStr(file_paths_[x] + ".db"), &db, SQLITE_OPEN_READONLY, nullptr);
     if (SQLITE_OK != rc) {
@@ -801,7 +1052,9 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   }
 
   for (int x = 0; x < shard_count; x++) {
-    threads[x].join();
+    if (threads[x].joinable()) {
+      threads[x].join();
+    }
   }
   return categories.size();
 }
@@ -1091,57 +1344,97 @@ MSRStatus ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, u
   return SUCCESS;
 }
 
-TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
+MSRStatus ShardReader::LocateTaskBlob(int task_id, TaskType *task_type, int *shard_id, uint64_t *file_offset,
+                                      uint64_t *blob_size) {
   // All tasks are done
-  if (task_id >= static_cast<int>(tasks_.Size())) {
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  if (task_id < 0 || task_id >= static_cast<int>(tasks_.Size())) {
+    return FAILED;
   }
 
   // Pick up task from task list
-  auto task = tasks_.GetTaskByID(tasks_.permutation_[task_id]);
+  const auto &task = tasks_.GetTaskByID(tasks_.permutation_[task_id]);
 
   // check task type
-  auto task_type = std::get<0>(task);
-  if (task_type == TaskType::kPaddedTask) {
-    return std::make_pair(SUCCESS,
-                          std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  *task_type = std::get<0>(task);
+  if (*task_type == TaskType::kPaddedTask) {
+    return SUCCESS;
   }
 
-  auto shard_id = std::get<0>(std::get<1>(task));
+  *shard_id = std::get<0>(std::get<1>(task));
   auto group_id = std::get<1>(std::get<1>(task));
-  auto addr = std::get<2>(task);
-  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  const auto &addr = std::get<2>(task);
+  const auto &ret = shard_header_->GetPageByGroupId(group_id, *shard_id);
   if (SUCCESS != ret.first) {
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    return FAILED;
   }
   const std::shared_ptr<Page> &page = ret.second;
+  *file_offset = header_size_ + page_size_ * (page->GetPageID()) + addr[0];
+  *blob_size = addr[1] - addr[0];
+  if (!file_maps_.empty() && *file_offset + *blob_size > file_maps_[*shard_id].second) {
+    MS_LOG(ERROR) << "Invalid data, blob [" << *file_offset << ", " << *file_offset + *blob_size
+                  << ") exceeds the size of shard file " << *shard_id << ".";
+    return FAILED;
+  }
+  return SUCCESS;
+}
 
-  // Pack image list
-  std::vector<uint8_t> images(addr[1] - addr[0]);
-  auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + addr[0];
+void ShardReader::PrefetchTask(int task_id) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  TaskType task_type = TaskType::kCommonTask;
+  int shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  if (LocateTaskBlob(task_id, &task_type, &shard_id, &file_offset, &blob_size) != SUCCESS ||
+      task_type == TaskType::kPaddedTask || blob_size == 0) {
+    return;
+  }
+  // madvise wants a page-aligned start address
+  static const uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t aligned_offset = file_offset / page_size * page_size;
+  (void)madvise(file_maps_[shard_id].first + aligned_offset, file_offset + blob_size - aligned_offset, MADV_WILLNEED);
+#endif
+}
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
+TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
+  TaskType task_type = TaskType::kCommonTask;
+  int shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  if (LocateTaskBlob(task_id, &task_type, &shard_id, &file_offset, &blob_size) != SUCCESS) {
     return std::make_pair(FAILED,
                           std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
   }
+  if (task_type == TaskType::kPaddedTask) {
+    return std::make_pair(SUCCESS,
+                          std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  }
 
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  // Pack image list
+  std::vector<uint8_t> images(blob_size);
+  if (!file_maps_.empty()) {
+    const uint8_t *blob = file_maps_[shard_id].first + file_offset;
+    std::copy(blob, blob + blob_size, images.begin());
+  } else {
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      MS_LOG(ERROR) << "File seekg failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(
+        FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    }
+
+    auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_size);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      MS_LOG(ERROR) << "File read failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(FAILED,
+                            std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    }
   }
 
   // Deliver batch data to output map
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
-  batch.emplace_back(std::move(images), std::move(std::get<3>(task)));
+  batch.emplace_back(std::move(images), std::get<3>(tasks_.GetTaskByID(tasks_.permutation_[task_id])));
 
   return std::make_pair(SUCCESS, std::make_pair(TaskType::kCommonTask, std::move(batch)));
 }
@@ -1219,6 +1512,30 @@ std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardRe
   return std::move(ret.second);
 }
 
+TASK_RETURN_VIEW ShardReader::GetNextViewById(const int64_t &task_id) {
+  if (interrupt_ || file_maps_.empty()) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<const uint8_t *, uint64_t, json>>());
+  }
+  TaskType task_type = TaskType::kCommonTask;
+  int shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  if (LocateTaskBlob(task_id, &task_type, &shard_id, &file_offset, &blob_size) != SUCCESS) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<const uint8_t *, uint64_t, json>>());
+  }
+  if (task_type == TaskType::kPaddedTask) {
+    return std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<const uint8_t *, uint64_t, json>>());
+  }
+  // Sequential access is left to kernel readahead, random access pages in the next row while this one is parsed
+  if (random_access_) {
+    PrefetchTask(task_id + 1);
+  }
+  std::vector<std::tuple<const uint8_t *, uint64_t, json>> batch;
+  batch.emplace_back(file_maps_[shard_id].first + file_offset, blob_size,
+                     std::get<3>(tasks_.GetTaskByID(tasks_.permutation_[task_id])));
+  return std::make_pair(TaskType::kCommonTask, std::move(batch));
+}
+
 std::pair<MSRStatus, std::vector<std::vector<uint8_t>>> ShardReader::UnCompressBlob(
   const std::vector<uint8_t> &raw_blob_data) {
   auto loaded_columns = selected_columns_.size() == 0 ? shard_column_->GetColumnName() : selected_columns_;
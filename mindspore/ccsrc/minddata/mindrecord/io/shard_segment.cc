@@ -28,7 +28,11 @@ using mindspore::MsLogLevel::INFO;
 
 namespace mindspore {
 namespace mindrecord {
-ShardSegment::ShardSegment() { SetAllInIndex(false); }
+ShardSegment::ShardSegment() {
+  SetAllInIndex(false);
+  // segment queries run sql on the shard databases directly
+  SetUseColumnarIndex(false);
+}
 
 std::pair<MSRStatus, vector<std::string>> ShardSegment::GetCategoryFields() {
   // Skip if already populated
@@ -96,6 +96,15 @@ MSRStatus ShardColumn::GetColumnValueByName(const std::string &column_name, cons
                                             std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes,
                                             ColumnDataType *column_data_type, uint64_t *column_data_type_size,
                                             std::vector<int64_t> *column_shape) {
+  return GetColumnValueByName(column_name, columns_blob.data(), columns_blob.size(), columns_json, data, data_ptr,
+                              n_bytes, column_data_type, column_data_type_size, column_shape);
+}
+
+MSRStatus ShardColumn::GetColumnValueByName(const std::string &column_name, const uint8_t *columns_blob,
+                                            uint64_t blob_size, const json &columns_json, const unsigned char **data,
+                                            std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes,
+                                            ColumnDataType *column_data_type, uint64_t *column_data_type_size,
+                                            std::vector<int64_t> *column_shape) {
   // Skip if column not found
   auto column_category = CheckColumnName(column_name);
   if (column_category == ColumnNotFound) {
@@ -119,7 +128,7 @@ MSRStatus ShardColumn::GetColumnValueByName(const std::string &column_name, cons
   }
 
   // Retrieve value from blob
-  if (GetColumnFromBlob(column_name, columns_blob, data, data_ptr, n_bytes) == FAILED) {
+  if (GetColumnFromBlob(column_name, columns_blob, blob_size, data, data_ptr, n_bytes) == FAILED) {
     MS_LOG(ERROR) << "Error when get data from blob, column name is " << column_name << ".";
     return FAILED;
   }
@@ -257,9 +266,15 @@ MSRStatus ShardColumn::GetInt(std::unique_ptr<unsigned char[]> *data_ptr, const
 MSRStatus ShardColumn::GetColumnFromBlob(const std::string &column_name, const std::vector<uint8_t> &columns_blob,
                                          const unsigned char **data, std::unique_ptr<unsigned char[]> *data_ptr,
                                          uint64_t *const n_bytes) {
+  return GetColumnFromBlob(column_name, columns_blob.data(), columns_blob.size(), data, data_ptr, n_bytes);
+}
+
+MSRStatus ShardColumn::GetColumnFromBlob(const std::string &column_name, const uint8_t *columns_blob,
+                                         uint64_t blob_size, const unsigned char **data,
+                                         std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes) {
   uint64_t offset_address = 0;
   auto column_id = column_name_id_[column_name];
-  if (GetColumnAddressInBlock(column_id, columns_blob, n_bytes, &offset_address) == FAILED) {
+  if (GetColumnAddressInBlock(column_id, columns_blob, blob_size, n_bytes, &offset_address) == FAILED) {
     return FAILED;
   }
 
@@ -273,7 +288,7 @@ MSRStatus ShardColumn::GetColumnFromBlob(const std::string &column_name, const s
       return FAILED;
     }
   } else {
-    *data = reinterpret_cast<const unsigned char *>(&(columns_blob[offset_address]));
+    *data = reinterpret_cast<const unsigned char *>(columns_blob + offset_address);
   }
 
   return SUCCESS;
@@ -308,7 +323,7 @@ std::vector<uint8_t> ShardColumn::CompressBlob(const std::vector<uint8_t> &blob,
     }
 
     // Just copy and continue if column dat type is not int32/int64
-    uint64_t num_bytes = BytesBigToUInt64(blob, i_src, kInt64Type);
+    uint64_t num_bytes = BytesBigToUInt64(blob.data(), i_src, kInt64Type);
     if (src_data_type != ColumnInt32 && src_data_type != ColumnInt64) {
       dst_blob.insert(dst_blob.end(), blob.begin() + i_src, blob.begin() + i_src + kInt64Len + num_bytes);
       i_src += kInt64Len + num_bytes;
@@ -356,7 +371,7 @@ vector<uint8_t> ShardColumn::CompressInt(const vector<uint8_t> &src_bytes, const
     // Shift to next int position
     uint64_t pos = i * (kUnsignedOne << static_cast<uint8_t>(int_type));
     // Narrow down this int
-    int64_t i_n = BytesLittleToMinIntType(src_bytes, pos, int_type, &dst_int_type);
+    int64_t i_n = BytesLittleToMinIntType(src_bytes.data(), pos, int_type, &dst_int_type);
 
     // Write this int to destination blob
     uint64_t u_n = *reinterpret_cast<uint64_t *>(&i_n);
@@ -375,18 +390,26 @@ vector<uint8_t> ShardColumn::CompressInt(const vector<uint8_t> &src_bytes, const
   return dst_bytes;
 }
 
-MSRStatus ShardColumn::GetColumnAddressInBlock(const uint64_t &column_id, const std::vector<uint8_t> &columns_blob,
-                                               uint64_t *num_bytes, uint64_t *shift_idx) {
+MSRStatus ShardColumn::GetColumnAddressInBlock(const uint64_t &column_id, const uint8_t *columns_blob,
+                                               uint64_t blob_size, uint64_t *num_bytes, uint64_t *shift_idx) {
   if (num_blob_column_ == 1) {
-    *num_bytes = columns_blob.size();
+    *num_bytes = blob_size;
     *shift_idx = 0;
     return SUCCESS;
   }
   auto blob_id = blob_column_id_[column_name_[column_id]];
 
   for (int32_t i = 0; i < blob_id; i++) {
+    if (*shift_idx + kInt64Len > blob_size) {
+      MS_LOG(ERROR) << "Invalid data, blob of size " << blob_size << " is truncated.";
+      return FAILED;
+    }
     *shift_idx += kInt64Len + BytesBigToUInt64(columns_blob, *shift_idx, kInt64Type);
   }
+  if (*shift_idx + kInt64Len > blob_size) {
+    MS_LOG(ERROR) << "Invalid data, blob of size " << blob_size << " is truncated.";
+    return FAILED;
+  }
   *num_bytes = BytesBigToUInt64(columns_blob, *shift_idx, kInt64Type);
 
   (*shift_idx) += kInt64Len;
@@ -396,8 +419,7 @@ MSRStatus ShardColumn::GetColumnAddressInBlock(const uint64_t &column_id, const
 
 template <typename T>
 MSRStatus ShardColumn::UncompressInt(const uint64_t &column_id, std::unique_ptr<unsigned char[]> *const data_ptr,
-                                     const std::vector<uint8_t> &columns_blob, uint64_t *num_bytes,
-                                     uint64_t shift_idx) {
+                                     const uint8_t *columns_blob, uint64_t *num_bytes, uint64_t shift_idx) {
   auto num_elements = BytesBigToUInt64(columns_blob, shift_idx, kInt32Type);
   *num_bytes = sizeof(T) * num_elements;
 
@@ -424,8 +446,7 @@ MSRStatus ShardColumn::UncompressInt(const uint64_t &column_id, std::unique_ptr<
   return SUCCESS;
 }
 
-uint64_t ShardColumn::BytesBigToUInt64(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
-                                       const IntegerType &i_type) {
+uint64_t ShardColumn::BytesBigToUInt64(const uint8_t *bytes_array, const uint64_t &pos, const IntegerType &i_type) {
   uint64_t result = 0;
   for (uint64_t i = 0; i < (kUnsignedOne << static_cast<uint8_t>(i_type)); i++) {
     result = (result << kBitsOfByte) + bytes_array[pos + i];
@@ -453,7 +474,7 @@ std::vector<uint8_t> ShardColumn::UIntToBytesLittle(uint64_t value, const Intege
   return result;
 }
 
-int64_t ShardColumn::BytesLittleToMinIntType(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
+int64_t ShardColumn::BytesLittleToMinIntType(const uint8_t *bytes_array, const uint64_t &pos,
                                              const IntegerType &src_i_type, IntegerType *dst_i_type) {
   uint64_t u_temp = 0;
   for (uint64_t i = 0; i < (kUnsignedOne << static_cast<uint8_t>(src_i_type)); i++) {
@@ -0,0 +1,335 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_columnar_index.h"
+#include <fcntl.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#endif
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include "utils/ms_utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::DEBUG;
+using mindspore::MsLogLevel::ERROR;
+using mindspore::MsLogLevel::INFO;
+using mindspore::MsLogLevel::WARNING;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+// "MRCIDX01" read as a little-endian integer, bump the digits when the layout changes
+const uint64_t kColumnarIndexMagic = 0x3130584449434D52;
+
+uint64_t AlignUp(uint64_t size) { return (size + kInt64Len - 1) / kInt64Len * kInt64Len; }
+
+void WriteUInt64(std::ofstream *out, uint64_t value) { out->write(reinterpret_cast<const char *>(&value), kInt64Len); }
+
+void WritePadding(std::ofstream *out, uint64_t size) {
+  static const char kZeros[kInt64Len] = {0};
+  out->write(kZeros, AlignUp(size) - size);
+}
+
+void WriteString(std::ofstream *out, const std::string &str) {
+  WriteUInt64(out, str.size());
+  out->write(str.data(), str.size());
+  WritePadding(out, str.size());
+}
+
+// cursor over the mapped file, every read is bounds checked
+class Cursor {
+ public:
+  Cursor(const uint8_t *data, uint64_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  const T *Take(uint64_t count) {
+    uint64_t bytes = count * sizeof(T);
+    if (count > size_ / sizeof(T) || pos_ + AlignUp(bytes) > size_) {
+      return nullptr;
+    }
+    auto ptr = reinterpret_cast<const T *>(data_ + pos_);
+    pos_ += AlignUp(bytes);
+    return ptr;
+  }
+
+  bool TakeUInt64(uint64_t *value) {
+    auto ptr = Take<uint64_t>(1);
+    if (ptr == nullptr) {
+      return false;
+    }
+    *value = *ptr;
+    return true;
+  }
+
+  bool TakeString(std::string *str) {
+    uint64_t len = 0;
+    if (!TakeUInt64(&len)) {
+      return false;
+    }
+    auto ptr = Take<char>(len);
+    if (ptr == nullptr) {
+      return false;
+    }
+    str->assign(ptr, len);
+    return true;
+  }
+
+  bool AtEnd() const { return pos_ == size_; }
+
+ private:
+  const uint8_t *data_;
+  uint64_t size_;
+  uint64_t pos_ = 0;
+};
+}  // namespace
+
+ShardColumnarIndex::~ShardColumnarIndex() { Release(); }
+
+MSRStatus ShardColumnarIndex::Write(const std::string &index_path, const std::string &shard_name, uint64_t shard_size,
+                                    const std::vector<std::string> &field_names,
+                                    const std::vector<std::vector<std::string>> &rows) {
+  const uint64_t num_columns = kNumFixedColumns + field_names.size();
+  uint64_t prev_page_id = 0;
+  for (const auto &row : rows) {
+    if (row.size() != num_columns) {
+      MS_LOG(ERROR) << "Invalid data, index row has " << row.size() << " columns, expect " << num_columns << ".";
+      return FAILED;
+    }
+    // rows of a blob page must be contiguous so that readers can binary search them
+    uint64_t page_id = std::stoull(row[kPageIdBlob]);
+    if (page_id < prev_page_id) {
+      MS_LOG(WARNING) << "Blob pages are not in row order, columnar index is not generated for " << shard_name;
+      return FAILED;
+    }
+    prev_page_id = page_id;
+  }
+
+  std::ofstream out(common::SafeCStr(index_path), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out.good()) {
+    MS_LOG(ERROR) << "Invalid file, failed to open file: " << index_path;
+    return FAILED;
+  }
+  WriteUInt64(&out, kColumnarIndexMagic);
+  WriteUInt64(&out, shard_size);
+  WriteUInt64(&out, rows.size());
+  WriteUInt64(&out, field_names.size());
+  WriteString(&out, shard_name);
+
+  for (int column = 0; column < kNumFixedColumns; ++column) {
+    for (const auto &row : rows) {
+      WriteUInt64(&out, std::stoull(row[column]));
+    }
+  }
+
+  for (uint64_t i = 0; i < field_names.size(); ++i) {
+    const uint64_t column = kNumFixedColumns + i;
+    std::map<std::string, uint32_t> dictionary;
+    for (const auto &row : rows) {
+      dictionary.emplace(row[column], 0);
+    }
+    uint32_t code = 0;
+    uint64_t offset = 0;
+    WriteString(&out, field_names[i]);
+    WriteUInt64(&out, dictionary.size());
+    WriteUInt64(&out, offset);
+    for (auto &entry : dictionary) {
+      entry.second = code++;
+      offset += entry.first.size();
+      WriteUInt64(&out, offset);
+    }
+    for (const auto &entry : dictionary) {
+      out.write(entry.first.data(), entry.first.size());
+    }
+    WritePadding(&out, offset);
+    for (const auto &row : rows) {
+      code = dictionary[row[column]];
+      out.write(reinterpret_cast<const char *>(&code), sizeof(code));
+    }
+    WritePadding(&out, rows.size() * sizeof(code));
+  }
+  out.close();
+  if (!out.good()) {
+    MS_LOG(ERROR) << "Failed to write columnar index: " << index_path;
+    (void)remove(common::SafeCStr(index_path));
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Write " << rows.size() << " rows to columnar index " << index_path << " successfully.";
+  return SUCCESS;
+}
+
+MSRStatus ShardColumnarIndex::Open(const std::string &shard_path) {
+  Release();
+  std::string index_path = shard_path + kColumnarIndexSuffix;
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(common::SafeCStr(index_path), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(DEBUG) << "Columnar index does not exist: " << index_path;
+    return FAILED;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    (void)close(fd);
+    return FAILED;
+  }
+  size_ = static_cast<uint64_t>(file_stat.st_size);
+  void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(WARNING) << "Failed to map columnar index: " << index_path;
+    size_ = 0;
+    return FAILED;
+  }
+  data_ = static_cast<uint8_t *>(addr);
+#else
+  std::ifstream in(common::SafeCStr(index_path), std::ios::in | std::ios::binary | std::ios::ate);
+  if (!in.good()) {
+    MS_LOG(DEBUG) << "Columnar index does not exist: " << index_path;
+    return FAILED;
+  }
+  size_ = static_cast<uint64_t>(in.tellg());
+  buffer_.resize(size_);
+  in.seekg(0, std::ios::beg);
+  if (!in.read(reinterpret_cast<char *>(buffer_.data()), size_)) {
+    Release();
+    return FAILED;
+  }
+  data_ = buffer_.data();
+#endif
+  if (Parse(shard_path) != SUCCESS) {
+    MS_LOG(WARNING) << "Invalid columnar index " << index_path << ", fall back to sqlite index.";
+    Release();
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardColumnarIndex::Parse(const std::string &shard_path) {
+  Cursor cursor(data_, size_);
+  uint64_t magic = 0;
+  uint64_t shard_size = 0;
+  uint64_t num_fields = 0;
+  std::string shard_name;
+  if (!cursor.TakeUInt64(&magic) || magic != kColumnarIndexMagic || !cursor.TakeUInt64(&shard_size) ||
+      !cursor.TakeUInt64(&num_rows_) || !cursor.TakeUInt64(&num_fields) || !cursor.TakeString(&shard_name)) {
+    return FAILED;
+  }
+
+  // the index must describe this very shard, an index left behind by an older dataset of the same name is stale
+  struct stat shard_stat;
+  if (shard_name != GetFileName(shard_path).second || stat(common::SafeCStr(shard_path), &shard_stat) != 0 ||
+      static_cast<uint64_t>(shard_stat.st_size) != shard_size) {
+    return FAILED;
+  }
+
+  for (int column = 0; column < kNumFixedColumns; ++column) {
+    columns_[column] = cursor.Take<uint64_t>(num_rows_);
+    if (columns_[column] == nullptr) {
+      return FAILED;
+    }
+  }
+  if (!std::is_sorted(columns_[kPageIdBlob], columns_[kPageIdBlob] + num_rows_)) {
+    return FAILED;
+  }
+
+  for (uint64_t i = 0; i < num_fields; ++i) {
+    Field field;
+    if (!cursor.TakeString(&field.name) || !cursor.TakeUInt64(&field.num_distinct)) {
+      return FAILED;
+    }
+    field.value_offsets = cursor.Take<uint64_t>(field.num_distinct + 1);
+    if (field.value_offsets == nullptr ||
+        !std::is_sorted(field.value_offsets, field.value_offsets + field.num_distinct + 1)) {
+      return FAILED;
+    }
+    field.values = cursor.Take<char>(field.value_offsets[field.num_distinct]);
+    field.codes = cursor.Take<uint32_t>(num_rows_);
+    if (field.values == nullptr || field.codes == nullptr ||
+        std::any_of(field.codes, field.codes + num_rows_, [&field](uint32_t c) { return c >= field.num_distinct; })) {
+      return FAILED;
+    }
+    field_ids_[field.name] = static_cast<int>(fields_.size());
+    fields_.push_back(std::move(field));
+  }
+  return cursor.AtEnd() ? SUCCESS : FAILED;
+}
+
+void ShardColumnarIndex::Release() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr) {
+    (void)munmap(data_, size_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  buffer_.clear();
+  num_rows_ = 0;
+  std::fill(columns_, columns_ + kNumFixedColumns, nullptr);
+  fields_.clear();
+  field_ids_.clear();
+}
+
+std::pair<uint64_t, uint64_t> ShardColumnarIndex::GetRowsInBlobPage(uint64_t page_id) const {
+  auto range = std::equal_range(columns_[kPageIdBlob], columns_[kPageIdBlob] + num_rows_, page_id);
+  return {range.first - columns_[kPageIdBlob], range.second - columns_[kPageIdBlob]};
+}
+
+int ShardColumnarIndex::GetFieldId(const std::string &field_name) const {
+  auto it = field_ids_.find(field_name);
+  return it == field_ids_.end() ? -1 : it->second;
+}
+
+std::string ShardColumnarIndex::GetDistinctValue(int field_id, uint32_t code) const {
+  const auto &field = fields_[field_id];
+  auto begin = field.value_offsets[code];
+  return std::string(field.values + begin, field.value_offsets[code + 1] - begin);
+}
+
+std::vector<bool> ShardColumnarIndex::MatchCodes(int field_id, const std::string &value, bool is_number) const {
+  const auto &field = fields_[field_id];
+  std::vector<bool> matched(field.num_distinct, false);
+  if (!is_number) {
+    // the dictionary is sorted, so a string matches at most one code
+    uint64_t low = 0;
+    uint64_t high = field.num_distinct;
+    while (low < high) {
+      uint64_t mid = low + (high - low) / 2;
+      if (GetDistinctValue(field_id, mid) < value) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    if (low < field.num_distinct && GetDistinctValue(field_id, low) == value) {
+      matched[low] = true;
+    }
+    return matched;
+  }
+  char *end = nullptr;
+  double number = std::strtod(value.c_str(), &end);
+  if (value.empty() || *end != '\0') {
+    return matched;
+  }
+  for (uint64_t code = 0; code < field.num_distinct; ++code) {
+    matched[code] = std::strtod(GetDistinctValue(field_id, code).c_str(), nullptr) == number;
+  }
+  return matched;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
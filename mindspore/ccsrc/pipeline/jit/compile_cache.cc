@@ -0,0 +1,469 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/compile_cache.h"
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+#include "ir/tensor.h"
+#include "ir/graph_utils.h"
+#include "proto/onnx.pb.h"
+#include "debug/dump_proto.h"
+#include "utils/load_onnx/anf_model_parser.h"
+#include "frontend/parallel/context.h"
+#include "utils/hashing.h"
+#include "utils/convert_utils_base.h"
+#include "utils/ms_context.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+// Bump when the content of the cached graphs or the key changes.
+constexpr size_t kCompileCacheVersion = 3;
+
+// FNV-1a. The keys name files which outlive the process, std::hash may give other values in another build.
+size_t HashBytes(const void *data, size_t size) {
+  constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+  constexpr uint64_t kFnvPrime = 1099511628211ULL;
+  auto bytes = static_cast<const uint8_t *>(data);
+  uint64_t hash = kFnvOffsetBasis;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= kFnvPrime;
+  }
+  return static_cast<size_t>(hash);
+}
+
+size_t HashString(const std::string &str) { return HashBytes(str.data(), str.size()); }
+
+size_t HashTensor(const tensor::TensorPtr &tensor, bool with_data) {
+  size_t hash = hash_combine(HashString("Tensor"), IntToSize(tensor->data_type()));
+  for (auto dim : tensor->shape()) {
+    hash = hash_combine(hash, LongToSize(dim));
+  }
+  if (with_data) {
+    hash = hash_combine(hash, HashBytes(tensor->data_c(), LongToSize(tensor->data().nbytes())));
+  }
+  return hash;
+}
+
+// Hash the nodes of a graph and of the graphs it uses, by their content only, so that the same network gets the same
+// hash in every process. Nodes and graphs are identified by the order in which they are visited.
+class GraphHasher {
+ public:
+  GraphHasher() = default;
+  ~GraphHasher() = default;
+
+  size_t Hash(const FuncGraphPtr &top_graph) {
+    size_t hash = HashString("FuncGraph");
+    (void)GraphIndex(top_graph);
+    while (!todo_.empty()) {
+      auto func_graph = todo_.front();
+      todo_.pop_front();
+      hash = hash_combine(hash, HashGraph(func_graph));
+    }
+    return hash;
+  }
+
+ private:
+  size_t GraphIndex(const FuncGraphPtr &func_graph) {
+    auto iter = graph_index_.find(func_graph);
+    if (iter != graph_index_.end()) {
+      return iter->second;
+    }
+    auto index = graph_index_.size();
+    graph_index_[func_graph] = index;
+    todo_.push_back(func_graph);
+    return index;
+  }
+
+  size_t NodeIndex(const AnfNodePtr &node) {
+    auto iter = node_index_.find(node);
+    if (iter != node_index_.end()) {
+      return iter->second;
+    }
+    auto index = node_index_.size();
+    node_index_[node] = index;
+    return index;
+  }
+
+  size_t HashGraph(const FuncGraphPtr &func_graph) {
+    size_t hash = hash_combine(HashString("Graph"), GraphIndex(func_graph));
+    for (auto &node : func_graph->parameters()) {
+      auto param = node->cast<ParameterPtr>();
+      MS_EXCEPTION_IF_NULL(param);
+      hash = hash_combine(hash, NodeIndex(param));
+      // The weights are bound by name when a cached graph is loaded, their values don't change the graph.
+      if (param->has_default()) {
+        hash = hash_combine(hash, HashString(param->name()));
+        auto tensor = param->default_param()->cast<tensor::TensorPtr>();
+        hash = hash_combine(hash, tensor != nullptr ? HashTensor(tensor, false) : HashString("Default"));
+      }
+    }
+    for (auto &node : TopoSort(func_graph->get_return())) {
+      MS_EXCEPTION_IF_NULL(node);
+      hash = hash_combine(hash, HashNode(node));
+    }
+    return hash;
+  }
+
+  size_t HashNode(const AnfNodePtr &node) {
+    size_t hash = NodeIndex(node);
+    if (node->isa<CNode>()) {
+      for (auto &input : node->cast<CNodePtr>()->inputs()) {
+        hash = hash_combine(hash, NodeIndex(input));
+      }
+    } else if (node->isa<ValueNode>()) {
+      hash = hash_combine(hash, HashValue(GetValueNode(node)));
+    }
+    return hash;
+  }
+
+  size_t HashValue(const ValuePtr &value) {
+    MS_EXCEPTION_IF_NULL(value);
+    if (value->isa<FuncGraph>()) {
+      return hash_combine(HashString("FuncGraph"), GraphIndex(value->cast<FuncGraphPtr>()));
+    }
+    if (value->isa<Primitive>()) {
+      auto prim = value->cast<PrimitivePtr>();
+      // The attrs are not ordered, sum their hashes.
+      size_t attrs_hash = 0;
+      for (auto &attr : prim->attrs()) {
+        attrs_hash += hash_combine(HashString(attr.first), attr.second != nullptr ? HashValue(attr.second) : 0);
+      }
+      return hash_combine(HashString(prim->name()), attrs_hash);
+    }
+    if (value->isa<tensor::Tensor>()) {
+      return HashTensor(value->cast<tensor::TensorPtr>(), true);
+    }
+    if (value->isa<ValueSequeue>()) {
+      size_t hash = HashString(value->type_name());
+      for (auto &element : value->cast<ValueSequeuePtr>()->value()) {
+        hash = hash_combine(hash, HashValue(element));
+      }
+      return hash;
+    }
+    return hash_combine(HashString(value->type_name()), HashString(value->ToString()));
+  }
+
+  std::unordered_map<FuncGraphPtr, size_t> graph_index_;
+  std::unordered_map<AnfNodePtr, size_t> node_index_;
+  std::deque<FuncGraphPtr> todo_;
+};
+
+size_t HashContext() {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  return hash_combine({HashString(context->get_param<std::string>(MS_CTX_DEVICE_TARGET)),
+                       IntToSize(context->get_param<int>(MS_CTX_EXECUTION_MODE)),
+                       static_cast<size_t>(context->get_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL)),
+                       static_cast<size_t>(context->get_param<bool>(MS_CTX_ENABLE_AUTO_MIXED_PRECISION)),
+                       static_cast<size_t>(context->get_param<bool>(MS_CTX_ENABLE_SPARSE)),
+                       HashString(parallel_context->parallel_mode()), IntToSize(parallel_context->device_num()),
+                       IntToSize(parallel_context->global_rank()),
+                       static_cast<size_t>(parallel_context->gradients_mean()),
+                       static_cast<size_t>(parallel_context->full_batch()),
+                       static_cast<size_t>(parallel_context->gradient_fp32_sync()),
+                       static_cast<size_t>(parallel_context->loss_repeated_mean()),
+                       static_cast<size_t>(parallel_context->parameter_broadcast()),
+                       static_cast<size_t>(parallel_context->enable_all_reduce_fusion()),
+                       static_cast<size_t>(parallel_context->enable_parallel_optimizer()),
+                       IntToSize(parallel_context->pipeline_stage_split_num()),
+                       HashString(parallel_context->strategy_search_mode()),
+                       HashString(parallel_context->strategy_ckpt_load_file())});
+}
+
+bool HasSubGraph(const FuncGraphPtr &func_graph) {
+  auto nodes = TopoSort(func_graph->get_return());
+  return std::any_of(nodes.begin(), nodes.end(), [](const AnfNodePtr &node) { return IsValueNode<FuncGraph>(node); });
+}
+
+std::vector<CNodePtr> TopoSortCNodes(const FuncGraphPtr &func_graph) {
+  std::vector<CNodePtr> cnodes;
+  for (auto &node : TopoSort(func_graph->get_return())) {
+    if (node->isa<CNode>()) {
+      cnodes.push_back(node->cast<CNodePtr>());
+    }
+  }
+  return cnodes;
+}
+
+bool IsSameValue(const ValuePtr &value, const ValuePtr &imported_value) {
+  if (value == nullptr || imported_value == nullptr) {
+    return value == imported_value;
+  }
+  if (value->isa<Primitive>()) {
+    // The importer creates plain primitives, only the name and the attrs are kept.
+    auto prim = value->cast<PrimitivePtr>();
+    auto imported_prim = imported_value->cast<PrimitivePtr>();
+    if (imported_prim == nullptr || prim->name() != imported_prim->name() ||
+        prim->attrs().size() != imported_prim->attrs().size()) {
+      return false;
+    }
+    return std::all_of(prim->attrs().begin(), prim->attrs().end(), [&imported_prim](const auto &attr) {
+      auto iter = imported_prim->attrs().find(attr.first);
+      return iter != imported_prim->attrs().end() && IsSameValue(attr.second, iter->second);
+    });
+  }
+  if (value->isa<tensor::Tensor>()) {
+    auto imported_tensor = imported_value->cast<tensor::TensorPtr>();
+    return imported_tensor != nullptr && value->cast<tensor::TensorPtr>()->ValueEqual(*imported_tensor);
+  }
+  if (value->isa<ValueSequeue>()) {
+    auto &elements = value->cast<ValueSequeuePtr>()->value();
+    auto imported_sequence = imported_value->cast<ValueSequeuePtr>();
+    if (value->type_name() != imported_value->type_name() || imported_sequence == nullptr ||
+        elements.size() != imported_sequence->value().size()) {
+      return false;
+    }
+    for (size_t i = 0; i < elements.size(); ++i) {
+      if (!IsSameValue(elements[i], imported_sequence->value()[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return *value == *imported_value;
+}
+
+// Whether imported_graph, imported from the MindIR of func_graph, is the same graph: the parameters have the same
+// shapes, and node by node the CNodes have the same inputs, the primitives the same names and attrs and the value
+// nodes the same values. Value nodes are compared by value, since the importer doesn't share them like the graph may.
+bool IsSameImportedGraph(const FuncGraphPtr &func_graph, const FuncGraphPtr &imported_graph) {
+  auto &params = func_graph->parameters();
+  auto &imported_params = imported_graph->parameters();
+  if (params.size() != imported_params.size()) {
+    return false;
+  }
+  std::unordered_map<AnfNodePtr, AnfNodePtr> imported_nodes;
+  for (size_t i = 0; i < params.size(); ++i) {
+    // MindIR stores the shape of a scalar as [1].
+    auto shape = params[i]->Shape();
+    auto imported_shape = imported_params[i]->Shape();
+    if (shape == nullptr || imported_shape == nullptr || *shape != *imported_shape) {
+      return false;
+    }
+    imported_nodes[params[i]] = imported_params[i];
+  }
+  auto cnodes = TopoSortCNodes(func_graph);
+  auto imported_cnodes = TopoSortCNodes(imported_graph);
+  if (cnodes.size() != imported_cnodes.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < cnodes.size(); ++i) {
+    auto &inputs = cnodes[i]->inputs();
+    auto &imported_inputs = imported_cnodes[i]->inputs();
+    if (inputs.size() != imported_inputs.size()) {
+      return false;
+    }
+    for (size_t j = 0; j < inputs.size(); ++j) {
+      if (inputs[j]->isa<ValueNode>()) {
+        if (!imported_inputs[j]->isa<ValueNode>() ||
+            !IsSameValue(GetValueNode(inputs[j]), GetValueNode(imported_inputs[j]))) {
+          return false;
+        }
+        continue;
+      }
+      // The inputs come before the node in topological order, so they are mapped already.
+      auto iter = imported_nodes.find(inputs[j]);
+      if (iter == imported_nodes.end() || iter->second != imported_inputs[j]) {
+        return false;
+      }
+    }
+    imported_nodes[cnodes[i]] = imported_cnodes[i];
+  }
+  return true;
+}
+
+bool ReadFile(const std::string &path, std::string *content) {
+  std::ifstream ifs(path, std::ios::in | std::ios::binary);
+  if (!ifs.is_open()) {
+    return false;
+  }
+  std::ostringstream oss;
+  oss << ifs.rdbuf();
+  *content = oss.str();
+  return ifs.good() || ifs.eof();
+}
+
+// Write to a temporary file which is renamed to path, so that a concurrent reader never sees a partial file.
+bool WriteFile(const std::string &path, const std::string &content) {
+  std::string tmp_path = path + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream ofs(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+      MS_LOG(WARNING) << "Open compile cache file " << tmp_path << " failed.";
+      return false;
+    }
+    ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+    if (!ofs.good()) {
+      MS_LOG(WARNING) << "Write compile cache file " << tmp_path << " failed.";
+      (void)std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    MS_LOG(WARNING) << "Rename compile cache file " << tmp_path << " to " << path << " failed.";
+    (void)std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+bool CompileCache::IsContextSupported() {
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  auto parallel_mode = parallel_context->parallel_mode();
+  return parallel_mode == parallel::STAND_ALONE || parallel_mode == parallel::DATA_PARALLEL;
+}
+
+std::string CompileCache::GraphKey(const FuncGraphPtr &func_graph, const abstract::AbstractBasePtrList &args_spec) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  size_t hash = hash_combine({kCompileCacheVersion, HashContext(), GraphHasher().Hash(func_graph)});
+  for (auto &arg : args_spec) {
+    MS_EXCEPTION_IF_NULL(arg);
+    hash = hash_combine(hash, HashString(arg->ToString()));
+  }
+  std::ostringstream oss;
+  oss << std::hex << std::setw(sizeof(size_t) * 2) << std::setfill('0') << hash;
+  return oss.str();
+}
+
+FuncGraphPtr CompileCache::Load(const std::string &key, const FuncGraphPtr &resolved_graph) const {
+  MS_EXCEPTION_IF_NULL(resolved_graph);
+  std::string params_content;
+  std::string graph_content;
+  // The graph file is written last, the params file of a complete entry is always there.
+  if (!ReadFile(GraphPath(key), &graph_content) || !ReadFile(ParamsPath(key), &params_content)) {
+    return nullptr;
+  }
+  onnx::ModelProto model;
+  FuncGraphPtr func_graph = nullptr;
+  try {
+    if (model.ParseFromString(graph_content)) {
+      func_graph = lite::MSANFModelParser().Parse(model);
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Import compile cache file " << GraphPath(key) << " failed: " << e.what();
+    return nullptr;
+  }
+  if (func_graph == nullptr) {
+    MS_LOG(WARNING) << "Import compile cache file " << GraphPath(key) << " failed.";
+    return nullptr;
+  }
+
+  std::unordered_map<std::string, ParameterPtr> weights;
+  for (auto &node : resolved_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    if (param != nullptr && param->has_default()) {
+      weights[param->name()] = param;
+    }
+  }
+  std::istringstream params_stream(params_content);
+  std::string name;
+  auto &params = func_graph->parameters();
+  size_t index = 0;
+  for (; std::getline(params_stream, name); ++index) {
+    if (index >= params.size()) {
+      break;
+    }
+    if (name.empty()) {
+      continue;
+    }
+    auto iter = weights.find(name);
+    if (iter == weights.end()) {
+      MS_LOG(WARNING) << "Weight " << name << " of compile cache entry " << key << " is not in graph "
+                      << resolved_graph->ToString() << ".";
+      return nullptr;
+    }
+    auto param = params[index]->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    auto value = iter->second->default_param();
+    auto abs_value = value->ToAbstract()->cast<abstract::AbstractTensorPtr>();
+    if (abs_value == nullptr || param->Shape() == nullptr || *param->Shape() != *abs_value->BuildShape()) {
+      MS_LOG(WARNING) << "Weight " << name << " of compile cache entry " << key << " doesn't match graph "
+                      << resolved_graph->ToString() << ".";
+      return nullptr;
+    }
+    param->set_name(name);
+    param->set_default_param(value);
+    auto ref_key = std::make_shared<RefKey>(name);
+    param->set_abstract(std::make_shared<abstract::AbstractRef>(ref_key->ToAbstract(), abs_value));
+  }
+  if (index != params.size()) {
+    MS_LOG(WARNING) << "Compile cache entry " << key << " is broken, it has " << params.size() << " parameters but "
+                    << index << " parameter names.";
+    return nullptr;
+  }
+  return func_graph;
+}
+
+bool CompileCache::Store(const std::string &key, const FuncGraphPtr &optimized_graph) const {
+  MS_EXCEPTION_IF_NULL(optimized_graph);
+  if (HasSubGraph(optimized_graph)) {
+    MS_LOG(INFO) << "Graph " << optimized_graph->ToString() << " has sub graphs, it is not cached.";
+    return false;
+  }
+  onnx::ModelProto model;
+  FuncGraphPtr imported_graph = nullptr;
+  try {
+    if (!model.ParseFromString(GetBinaryProtoString(optimized_graph))) {
+      return false;
+    }
+    // The values of the weights are taken from the network when the graph is loaded.
+    model.mutable_graph()->clear_initializer();
+    // Import the graph again, the entry is only kept if the import gives back the same graph.
+    imported_graph = lite::MSANFModelParser().Parse(model);
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Graph " << optimized_graph->ToString() << " can't be exported to MindIR, it is not cached: "
+                 << e.what();
+    return false;
+  }
+  if (imported_graph == nullptr || !IsSameImportedGraph(optimized_graph, imported_graph)) {
+    MS_LOG(INFO) << "Graph " << optimized_graph->ToString() << " can't be imported from MindIR, it is not cached.";
+    return false;
+  }
+
+  std::ostringstream params_stream;
+  for (auto &node : optimized_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    params_stream << (param->has_default() ? param->name() : "") << "\n";
+  }
+  std::string graph_content;
+  if (!model.SerializeToString(&graph_content)) {
+    return false;
+  }
+  if (!WriteFile(ParamsPath(key), params_stream.str()) || !WriteFile(GraphPath(key), graph_content)) {
+    return false;
+  }
+  MS_LOG(INFO) << "Store graph " << optimized_graph->ToString() << " into compile cache entry " << key << ".";
+  return true;
+}
+}  // namespace pipeline
+}  // namespace mindspore
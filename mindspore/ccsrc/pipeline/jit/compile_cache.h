@@ -0,0 +1,64 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+
+#include <string>
+#include "ir/func_graph.h"
+#include "abstract/abstract_value.h"
+
+namespace mindspore {
+namespace pipeline {
+// On-disk cache of the graphs produced by the frontend actions, from abstract_specialize to validate, so that a
+// process compiling an unchanged network with the same input signature again skips type inference and the irpass
+// optimizations. An entry is addressed by the key of the resolved graph, see GraphKey, and holds the optimized graph
+// in MindIR with the weights stripped, plus the names of its weight parameters, which are bound to the weights of the
+// resolved graph when the entry is loaded.
+// Only graphs which are a single func graph after the optimizations are cached, as MindIR import doesn't support sub
+// graphs, and only if their MindIR imports back the same node by node. The backend still selects and builds the
+// kernels of a loaded graph, the kernel binaries are cached in kernel_meta by the kernel compilers.
+// The cache is only used in the stand_alone and data_parallel modes, the graphs of semi_auto_parallel and
+// auto_parallel depend on the strategies, the cost model and the communication groups, which aren't in the key.
+class CompileCache {
+ public:
+  explicit CompileCache(const std::string &cache_path) : cache_path_(cache_path) {}
+  ~CompileCache() = default;
+
+  // Whether the graphs compiled under the current parallel mode can be cached.
+  static bool IsContextSupported();
+
+  // The key of func_graph, a graph after symbol_resolve, compiled with the arguments of args_spec under the current
+  // context. The key covers the structure of the graph, the constants, the names, types and shapes of the weights,
+  // the abstracts of the arguments and the context options which change the optimized graph.
+  static std::string GraphKey(const FuncGraphPtr &func_graph, const abstract::AbstractBasePtrList &args_spec);
+
+  // Load the entry of key and bind its weights to the parameters of resolved_graph. Return nullptr if there is no
+  // such entry or it doesn't fit resolved_graph.
+  FuncGraphPtr Load(const std::string &key, const FuncGraphPtr &resolved_graph) const;
+  // Store optimized_graph as the entry of key. Return false if the graph can't be cached.
+  bool Store(const std::string &key, const FuncGraphPtr &optimized_graph) const;
+
+ private:
+  std::string GraphPath(const std::string &key) const { return cache_path_ + "/" + key + ".mindir"; }
+  std::string ParamsPath(const std::string &key) const { return cache_path_ + "/" + key + ".params"; }
+
+  std::string cache_path_;
+};
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
@@ -294,7 +294,33 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("is_role_worker", &PSContext::is_role_worker, "Get whether the role of this process is Worker.")
     .def("is_role_pserver", &PSContext::is_role_pserver, "Get whether the role of this process is PServer.")
     .def("is_role_sched", &PSContext::is_role_sched, "Get whether the role of this process is Scheduler.")
-    .def("ps_rank_id", &PSContext::ps_rank_id, "Get Worker and PServer rank id.");
+    .def("ps_rank_id", &PSContext::ps_rank_id, "Get Worker and PServer rank id.")
+    .def("set_ps_mode", &PSContext::SetPSMode, "Set PS training mode: sync, async or ssp.")
+    .def("ps_mode", &PSContext::ps_mode_name, "Get PS training mode.")
+    .def("set_staleness_threshold", &PSContext::SetStalenessThreshold, "Set staleness threshold of ssp mode.")
+    .def("staleness_threshold", &PSContext::staleness_threshold, "Get staleness threshold of ssp mode.")
+    .def("set_embedding_cache_size", &PSContext::SetEmbeddingCacheSize, "Set rows of worker embedding cache.")
+    .def("embedding_cache_size", &PSContext::embedding_cache_size, "Get rows of worker embedding cache.")
+    .def("set_embedding_cache_policy", &PSContext::SetEmbeddingCachePolicy, "Set worker embedding cache policy.")
+    .def("embedding_cache_policy", &PSContext::embedding_cache_policy_name, "Get worker embedding cache policy.")
+    .def("set_embedding_cache_staleness", &PSContext::SetEmbeddingCacheStaleness,
+         "Set steps a worker embedding cache row is used.")
+    .def("embedding_cache_staleness", &PSContext::embedding_cache_staleness,
+         "Get steps a worker embedding cache row is used.")
+    .def("set_grad_compression", &PSContext::SetGradCompression, "Set compression of pushed gradients.")
+    .def("grad_compression", &PSContext::grad_compression_name, "Get compression of pushed gradients.")
+    .def("set_param_grad_compression", &PSContext::SetParamGradCompression,
+         "Set gradient compression of parameters by name.")
+    .def("param_grad_compression", &PSContext::param_grad_compression,
+         "Get gradient compression of parameters by name.")
+    .def("set_grad_compression_min_size", &PSContext::SetGradCompressionMinSize,
+         "Set elements of the smallest compressed gradient.")
+    .def("grad_compression_min_size", &PSContext::grad_compression_min_size,
+         "Get elements of the smallest compressed gradient.")
+    .def("set_grad_compression_topk_ratio", &PSContext::SetGradCompressionTopKRatio,
+         "Set ratio of gradient elements top-k compression sends.")
+    .def("grad_compression_topk_ratio", &PSContext::grad_compression_topk_ratio,
+         "Get ratio of gradient elements top-k compression sends.");
 
   (void)py::class_<OpInfoLoaderPy, std::shared_ptr<OpInfoLoaderPy>>(m, "OpInfoLoaderPy")
     .def(py::init())
@@ -26,7 +26,9 @@
 
 #include "ir/param_info.h"
 #include "pipeline/jit/pass.h"
+#include "pipeline/jit/compile_cache.h"
 #include "pipeline/jit/parse/data_converter.h"
+#include "pipeline/jit/parse/parse.h"
 #include "frontend/optimizer/ad/dfunctor.h"
 #include "debug/anf_ir_dump.h"
 #include "debug/dump_proto.h"
@@ -433,6 +435,45 @@ std::vector<ActionItem> GetPipline(const ResourcePtr &resource, const std::strin
   return GePipeline();
 }
 
+// Run actions with the compile cache at cache_path. The actions from abstract_specialize to validate are skipped when
+// the graph after symbol_resolve is in the cache, their result is stored into the cache otherwise.
+static void RunPipelineWithCompileCache(const ResourcePtr &resource, const std::vector<ActionItem> &actions,
+                                        const std::string &cache_path) {
+  auto find_action = [&actions](const std::string &name) {
+    return std::find_if(actions.begin(), actions.end(), [&name](const ActionItem &item) { return item.first == name; });
+  };
+  auto resolve_iter = find_action("symbol_resolve");
+  auto validate_iter = find_action("validate");
+  // Nothing is cached for the pipelines which don't compile the graph to the backend, like the ones of export.
+  if (resolve_iter == actions.end() || validate_iter == actions.end() || validate_iter + 1 == actions.end()) {
+    std::make_shared<Pipeline>(resource, actions)->Run();
+    return;
+  }
+  std::make_shared<Pipeline>(resource, std::vector<ActionItem>(actions.begin(), resolve_iter + 1))->Run();
+
+  CompileCache cache(cache_path);
+  auto key = CompileCache::GraphKey(resource->func_graph(), resource->args_spec());
+  auto cached_graph = cache.Load(key, resource->func_graph());
+  std::vector<ActionItem> rest_actions;
+  if (cached_graph != nullptr) {
+    MS_LOG(INFO) << "Load graph " << resource->func_graph()->ToString() << " from compile cache entry " << key << ".";
+    auto manager = resource->manager();
+    MS_EXCEPTION_IF_NULL(manager);
+    manager->AddFuncGraph(cached_graph, true);
+    manager->KeepRoots({cached_graph});
+    parse::Parser::UpdateTopFuncGraph(cached_graph);
+    resource->set_func_graph(cached_graph);
+  } else {
+    rest_actions.assign(resolve_iter + 1, validate_iter + 1);
+    rest_actions.emplace_back(std::make_pair("compile_cache_store", [cache, key](const ResourcePtr &res) {
+      (void)cache.Store(key, res->func_graph());
+      return true;
+    }));
+  }
+  rest_actions.insert(rest_actions.end(), validate_iter + 1, actions.end());
+  std::make_shared<Pipeline>(resource, rest_actions)->Run();
+}
+
 bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, const py::object &phase, bool use_vm) {
   MS_LOG(DEBUG) << "Start ExecutorPy compile!";
   if ((!py::isinstance<py::str>(phase))) {
@@ -453,7 +494,7 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   ResourcePtr resource = std::make_shared<Resource>(obj);
 
   auto p_actions = GetPipline(resource, phase_s, use_vm);
-  std::shared_ptr<Pipeline> pip = std::make_shared<Pipeline>(resource, FilterActions(p_actions, phase_s));
+  auto actions = FilterActions(p_actions, phase_s);
 
   // get the parameters items and add the value to args_spec
   abstract::AbstractBasePtrList args_spec;
@@ -475,7 +516,17 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   executor_info->arg_list_size = size;
   executor_info->resource = resource;
   info_[phase_s] = executor_info;
-  pip->Run();
+  auto compile_cache_path = MsContext::GetInstance()->get_param<std::string>(MS_CTX_COMPILE_CACHE_PATH);
+  if (!compile_cache_path.empty() && !CompileCache::IsContextSupported()) {
+    MS_LOG(INFO) << "Compile cache is not used in parallel mode "
+                 << parallel::ParallelContext::GetInstance()->parallel_mode() << ".";
+    compile_cache_path.clear();
+  }
+  if (compile_cache_path.empty()) {
+    std::make_shared<Pipeline>(resource, actions)->Run();
+  } else {
+    RunPipelineWithCompileCache(resource, actions, compile_cache_path);
+  }
 
   // save the run graph func to MsPipeLine
   SaveCompiledGraph(phase_s);
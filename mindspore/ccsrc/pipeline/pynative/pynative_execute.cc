@@ -399,33 +399,45 @@ OpExecInfoPtr GenerateOpExecInfo(const py::args &args) {
   return op_exec_info;
 }
 
-std::string GetSingleOpGraphInfo(const OpExecInfoPtr &op_exec_info,
-                                 const std::vector<tensor::TensorPtr> &input_tensors) {
-  MS_EXCEPTION_IF_NULL(op_exec_info);
-  std::string graph_info;
-  // get input tensor info
-  for (const auto &tensor : input_tensors) {
-    MS_EXCEPTION_IF_NULL(tensor);
-    auto tensor_shape = tensor->shape();
-    (void)std::for_each(tensor_shape.begin(), tensor_shape.end(),
-                        [&](const auto &dim) { (void)graph_info.append(std::to_string(dim) + "_"); });
-    (void)graph_info.append(std::to_string(tensor->data_type()) + "_");
-    if (tensor->device_address() != nullptr) {
-      (void)graph_info.append(
-        std::to_string(std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address())->type_id()) + "_");
-      (void)graph_info.append(std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address())->format() +
-                              "_");
+// Hash an attr value by its content. Scalars, strings and number types carry a hash of their value, sequences are
+// hashed element by element, and the rare other values by their text.
+std::size_t HashAttrValue(const ValuePtr &value) {
+  if (value == nullptr) {
+    return 0;
+  }
+  if (value->isa<ValueSequeue>()) {
+    const auto &elements = value->cast<ValueSequeuePtr>()->value();
+    auto hash_value = hash_combine(value->tid(), elements.size());
+    for (const auto &element : elements) {
+      hash_value = hash_combine(hash_value, HashAttrValue(element));
     }
+    return hash_value;
+  }
+  if (value->isa<Scalar>() || value->isa<StringImm>() || value->isa<Number>()) {
+    return hash_combine(value->tid(), value->hash());
   }
+  return std::hash<std::string>{}(value->ToString());
+}
+
+mindspore::GraphInfo HashSingleOpAttrs(const OpExecInfoPtr &op_exec_info) {
+  MS_EXCEPTION_IF_NULL(op_exec_info);
   // get prim and abstract info
-  (void)graph_info.append(op_exec_info->prim_id + "_");
-  // get attr info
+  mindspore::GraphInfo attrs_info = std::hash<std::string>{}(op_exec_info->prim_id);
+  // get attr info, combined regardless of the order of the attr map
   const auto &op_prim = op_exec_info->py_primitive;
   MS_EXCEPTION_IF_NULL(op_prim);
   const auto &attr_map = op_prim->evaluate_added_attrs();
-  (void)std::for_each(attr_map.begin(), attr_map.end(),
-                      [&](const auto &element) { (void)graph_info.append(element.second->ToString() + "_"); });
-  return graph_info;
+  mindspore::GraphInfo attrs_sum = 0;
+  for (const auto &element : attr_map) {
+    attrs_sum += hash_combine(std::hash<std::string>{}(element.first), HashAttrValue(element.second));
+  }
+  return hash_combine(attrs_info, attrs_sum);
+}
+
+mindspore::GraphInfo GetSingleOpGraphInfo(const OpExecInfoPtr &op_exec_info,
+                                          const std::vector<tensor::TensorPtr> &input_tensors) {
+  // prim and attr info, then input tensor info
+  return session::HashSingleOpInputs(input_tensors, HashSingleOpAttrs(op_exec_info));
 }
 
 py::object RunOpInVM(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *status) {
@@ -441,6 +453,8 @@ py::object RunOpInVM(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *stat
     for (size_t i = 0; i < op_inputs.size(); i++) {
       py::object input = op_inputs[i];
       auto tensor = py::cast<tensor::TensorPtr>(input);
+      // the device address of an output of an asynchronous op is set when the op has run
+      TensorPy::WaitData(*tensor);
       auto new_tensor = std::make_shared<tensor::Tensor>(tensor->data_type(), tensor->shape(), tensor->data_ptr());
       new_tensor->set_device_address(tensor->device_address());
       new_tensor->set_sync_status(tensor->sync_status());
@@ -650,11 +664,71 @@ BaseRef TransformBaseRefListToTuple(const BaseRef &base_ref) {
   }
 }
 
+// Create the outputs of an op dispatched asynchronously from its inferred abstract, they are filled in by the backend
+// worker. Return false if the outputs are only known when the op has run, e.g. for a dynamic shape.
+bool CreateAsyncOpOutputTensors(const AbstractBasePtr &abstract, VectorRef *outputs) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  if (abstract == nullptr) {
+    return false;
+  }
+  AbstractBasePtrList elements;
+  if (abstract->isa<abstract::AbstractTuple>()) {
+    elements = abstract->cast<abstract::AbstractTuplePtr>()->elements();
+  } else {
+    elements.push_back(abstract);
+  }
+  if (elements.empty()) {
+    return false;
+  }
+  for (const auto &element : elements) {
+    MS_EXCEPTION_IF_NULL(element);
+    auto abstract_tensor = element->cast<abstract::AbstractTensorPtr>();
+    if (abstract_tensor == nullptr || abstract_tensor->element() == nullptr) {
+      return false;
+    }
+    auto shape = abstract_tensor->BuildShape()->cast<abstract::ShapePtr>();
+    if (shape == nullptr ||
+        std::any_of(shape->shape().begin(), shape->shape().end(), [](int dim) { return dim < 0; })) {
+      return false;
+    }
+    auto dtype = abstract_tensor->element()->BuildType();
+    MS_EXCEPTION_IF_NULL(dtype);
+    outputs->push_back(std::make_shared<tensor::Tensor>(dtype->type_id(), shape->shape()));
+  }
+  for (auto &output : *outputs) {
+    utils::cast<tensor::TensorPtr>(output)->SetNeedWait(true);
+  }
+  return true;
+}
+
+// Queue the op on the backend worker and return its outputs before it has run, so that the frontend infers the next
+// ops while the backend builds and runs this one.
+py::object RunOpAsyncInMs(const OpExecInfoPtr &op_exec_info, const std::vector<tensor::TensorPtr> &input_tensors,
+                          const std::vector<int> &tensors_mask) {
+  MS_EXCEPTION_IF_NULL(op_exec_info);
+  MS_EXCEPTION_IF_NULL(op_exec_info->py_primitive);
+  // The later calls of the op share the primitive and may change its attrs before this one is built.
+  auto primitive = std::make_shared<Primitive>(*op_exec_info->py_primitive);
+  session::OpRunInfo op_run_info = {op_exec_info->op_name, primitive, op_exec_info->abstract, op_exec_info->value};
+  auto attrs_info = HashSingleOpAttrs(op_exec_info);
+  VectorRef outputs;
+  if (CreateAsyncOpOutputTensors(op_exec_info->abstract, &outputs)) {
+    session->RunOpAsync(op_run_info, attrs_info, input_tensors, tensors_mask, outputs);
+  } else {
+    session->BuildAndRunOp(op_run_info, attrs_info, input_tensors, tensors_mask, &outputs);
+  }
+  return BaseRefToPyData(outputs);
+}
+
 py::object RunOpInMs(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *status) {
   MS_EXCEPTION_IF_NULL(op_exec_info);
   MS_LOG(INFO) << "Start run op[" << op_exec_info->op_name << "] with backend policy ms";
   auto ms_context = MsContext::GetInstance();
-  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, true);
+  // In async mode the flag goes with each queued op and is only set on the backend worker.
+  bool enable_async = ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_ASYNC);
+  if (!enable_async) {
+    ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, true);
+  }
   std::string device_target = ms_context->get_param<std::string>(MS_CTX_DEVICE_TARGET);
   if (device_target != kAscendDevice && device_target != kGPUDevice) {
     MS_EXCEPTION(ArgumentError) << "Device target [" << device_target << "] is not supported in Pynative mode";
@@ -669,8 +743,14 @@ py::object RunOpInMs(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *stat
   std::vector<tensor::TensorPtr> input_tensors;
   std::vector<int> tensors_mask;
   ConstructInputTensor(op_exec_info, &tensors_mask, &input_tensors);
+  if (enable_async) {
+    auto result = RunOpAsyncInMs(op_exec_info, input_tensors, tensors_mask);
+    *status = PYNATIVE_SUCCESS;
+    MS_LOG(INFO) << "End dispatch op[" << op_exec_info->op_name << "] with backend policy ms";
+    return result;
+  }
   // get graph info for checking it whether existing in the cache
-  std::string graph_info = GetSingleOpGraphInfo(op_exec_info, input_tensors);
+  auto graph_info = GetSingleOpGraphInfo(op_exec_info, input_tensors);
   session::OpRunInfo op_run_info = {op_exec_info->op_name, op_exec_info->py_primitive, op_exec_info->abstract,
                                     op_exec_info->value};
   session->BuildOp(&op_run_info, graph_info, input_tensors, tensors_mask);
@@ -0,0 +1,240 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/embedding_cache.h"
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+// The lookup counts are halved once more ids than this many times the capacity were counted.
+constexpr size_t kLookupCountFactor = 8;
+
+void CopyRow(float *dst, const float *src, size_t row_dim) {
+  size_t row_size = row_dim * sizeof(float);
+  auto ret = memcpy_s(dst, row_size, src, row_size);
+  if (ret != EOK) {
+    MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+  }
+}
+}  // namespace
+
+EmbeddingCache::EmbeddingCache(size_t capacity, size_t row_dim, EmbeddingCachePolicy policy, size_t staleness,
+                               bool write_back)
+    : capacity_(capacity),
+      row_dim_(row_dim),
+      policy_(policy),
+      staleness_(std::max(staleness, size_t(1))),
+      write_back_(write_back),
+      step_(0),
+      tick_(0),
+      rows_(capacity * row_dim) {
+  free_slots_.reserve(capacity_);
+  for (size_t i = capacity_; i > 0; --i) {
+    free_slots_.push_back(i - 1);
+  }
+}
+
+std::vector<int> EmbeddingCache::Lookup(const int *ids, size_t ids_num, float *output) {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(output);
+  std::lock_guard<std::mutex> lock(mutex_);
+  step_++;
+  std::vector<int> missed;
+  std::unordered_set<int> missed_ids;
+  for (size_t i = 0; i < ids_num; ++i) {
+    int id = ids[i];
+    if (policy_ == kCachePolicyLFU) {
+      (void)CountLookup(id);
+    }
+    auto iter = entries_.find(id);
+    if (iter != entries_.end() && step_ - iter->second.fetch_step >= staleness_) {
+      stats_.stale_rows++;
+      Erase(id);
+      iter = entries_.end();
+    }
+    if (iter != entries_.end()) {
+      CopyRow(output + i * row_dim_, rows_.data() + iter->second.slot * row_dim_, row_dim_);
+      Touch(id, &iter->second);
+      stats_.hits++;
+      continue;
+    }
+    stats_.misses++;
+    if (missed_ids.insert(id).second) {
+      missed.push_back(id);
+    }
+  }
+  stats_.fetched_rows += missed.size();
+  return missed;
+}
+
+void EmbeddingCache::Fill(const int *ids, size_t ids_num, const std::vector<int> &missed, const float *rows,
+                          float *output) {
+  if (missed.empty()) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(rows);
+  MS_EXCEPTION_IF_NULL(output);
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::unordered_map<int, const float *> fetched;
+  for (size_t i = 0; i < missed.size(); ++i) {
+    const float *row = rows + i * row_dim_;
+    fetched[missed[i]] = row;
+    Admit(missed[i], row);
+  }
+  for (size_t i = 0; i < ids_num; ++i) {
+    auto iter = fetched.find(ids[i]);
+    if (iter != fetched.end()) {
+      CopyRow(output + i * row_dim_, iter->second, row_dim_);
+    }
+  }
+}
+
+void EmbeddingCache::AccumulateGrad(const int *indices, size_t indices_num, const float *grads) {
+  MS_EXCEPTION_IF_NULL(indices);
+  MS_EXCEPTION_IF_NULL(grads);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < indices_num; ++i) {
+    PendingGrad &pending = pending_grads_[indices[i]];
+    if (pending.grad.empty()) {
+      pending.first_step = step_;
+      pending.grad.resize(row_dim_, 0);
+    }
+    const float *grad = grads + i * row_dim_;
+    for (size_t j = 0; j < row_dim_; ++j) {
+      pending.grad[j] += grad[j];
+    }
+  }
+}
+
+void EmbeddingCache::TakeDueGrads(bool flush_all, std::vector<int> *indices, std::vector<float> *grads) {
+  MS_EXCEPTION_IF_NULL(indices);
+  MS_EXCEPTION_IF_NULL(grads);
+  std::lock_guard<std::mutex> lock(mutex_);
+  indices->clear();
+  grads->clear();
+  for (auto iter = pending_grads_.begin(); iter != pending_grads_.end();) {
+    int id = iter->first;
+    bool cached = entries_.count(id) > 0;
+    if (!flush_all && cached && step_ + 1 - iter->second.first_step < staleness_) {
+      ++iter;
+      continue;
+    }
+    indices->push_back(id);
+    grads->insert(grads->end(), iter->second.grad.begin(), iter->second.grad.end());
+    if (cached) {
+      Erase(id);
+    }
+    stats_.flushed_rows++;
+    iter = pending_grads_.erase(iter);
+  }
+}
+
+EmbeddingCacheStats EmbeddingCache::stats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+double EmbeddingCache::hit_rate() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t total = stats_.hits + stats_.misses;
+  return total == 0 ? 0 : static_cast<double>(stats_.hits) / total;
+}
+
+std::string EmbeddingCache::StatsString() {
+  EmbeddingCacheStats stats = this->stats();
+  std::ostringstream buffer;
+  buffer << "hit rate " << hit_rate() << ", hits " << stats.hits << ", misses " << stats.misses << ", fetched rows "
+         << stats.fetched_rows << ", stale rows " << stats.stale_rows << ", evictions " << stats.evictions
+         << ", rejections " << stats.rejections << ", flushed rows " << stats.flushed_rows;
+  return buffer.str();
+}
+
+EmbeddingCache::Rank EmbeddingCache::NewRank(int id) {
+  tick_++;
+  if (policy_ == kCachePolicyLFU) {
+    auto iter = lookup_counts_.find(id);
+    return Rank(iter == lookup_counts_.end() ? 0 : iter->second, tick_);
+  }
+  return Rank(tick_, 0);
+}
+
+void EmbeddingCache::Touch(int id, Entry *entry) {
+  (void)order_.erase(std::make_pair(entry->rank, id));
+  entry->rank = NewRank(id);
+  (void)order_.emplace(entry->rank, id);
+}
+
+void EmbeddingCache::Erase(int id) {
+  auto iter = entries_.find(id);
+  if (iter == entries_.end()) {
+    return;
+  }
+  (void)order_.erase(std::make_pair(iter->second.rank, id));
+  free_slots_.push_back(iter->second.slot);
+  (void)entries_.erase(iter);
+}
+
+void EmbeddingCache::Admit(int id, const float *row) {
+  if (capacity_ == 0) {
+    return;
+  }
+  auto iter = entries_.find(id);
+  if (iter != entries_.end()) {
+    CopyRow(rows_.data() + iter->second.slot * row_dim_, row, row_dim_);
+    iter->second.fetch_step = step_;
+    Touch(id, &iter->second);
+    return;
+  }
+  Rank rank = NewRank(id);
+  if (free_slots_.empty()) {
+    const auto &victim = *order_.begin();
+    if (policy_ == kCachePolicyLFU && rank.first <= victim.first.first) {
+      stats_.rejections++;
+      return;
+    }
+    stats_.evictions++;
+    Erase(victim.second);
+  }
+  size_t slot = free_slots_.back();
+  free_slots_.pop_back();
+  CopyRow(rows_.data() + slot * row_dim_, row, row_dim_);
+  entries_[id] = Entry{slot, step_, rank};
+  (void)order_.emplace(rank, id);
+}
+
+uint32_t EmbeddingCache::CountLookup(int id) {
+  uint32_t count = ++lookup_counts_[id];
+  if (lookup_counts_.size() > kLookupCountFactor * std::max(capacity_, size_t(1))) {
+    // Age the counts so rows which turned cold can be evicted.
+    for (auto iter = lookup_counts_.begin(); iter != lookup_counts_.end();) {
+      iter->second /= 2;
+      if (iter->second == 0) {
+        iter = lookup_counts_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+  return count;
+}
+}  // namespace ps
+}  // namespace mindspore
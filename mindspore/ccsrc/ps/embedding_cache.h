@@ -0,0 +1,121 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_EMBEDDING_CACHE_H_
+#define MINDSPORE_CCSRC_PS_EMBEDDING_CACHE_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+constexpr char kCachePolicyNameLRU[] = "lru";
+constexpr char kCachePolicyNameLFU[] = "lfu";
+
+// kCachePolicyLRU: every fetched row is cached, the least recently used row is evicted.
+// kCachePolicyLFU: a fetched row is only cached if it was looked up more often than the row it would evict.
+enum EmbeddingCachePolicy { kCachePolicyLRU = 0, kCachePolicyLFU };
+
+struct EmbeddingCacheStats {
+  // lookup ids served from the cache
+  uint64_t hits{0};
+  // lookup ids fetched from the servers, and the distinct rows fetched for them
+  uint64_t misses{0};
+  uint64_t fetched_rows{0};
+  // cached rows dropped because they were older than the staleness bound
+  uint64_t stale_rows{0};
+  uint64_t evictions{0};
+  // fetched rows the LFU policy refused to cache
+  uint64_t rejections{0};
+  // rows whose accumulated gradients were pushed to the servers in write back mode
+  uint64_t flushed_rows{0};
+};
+
+// A worker local cache of the rows of one embedding table.
+// A fetched row serves the lookups of staleness steps, every lookup of the table counting as one step, and is
+// fetched again afterwards. In write back mode the sparse gradients of the rows are summed up locally too, and the
+// sum of a row is pushed once it is staleness steps old or its row left the cache. The cached copy of a pushed row
+// is dropped, so the next lookup reads the row updated by the servers.
+class EmbeddingCache {
+ public:
+  EmbeddingCache(size_t capacity, size_t row_dim, EmbeddingCachePolicy policy, size_t staleness, bool write_back);
+  ~EmbeddingCache() = default;
+  EmbeddingCache(const EmbeddingCache &) = delete;
+  EmbeddingCache &operator=(const EmbeddingCache &) = delete;
+
+  // Start a step: copy the cached rows of ids to output, row i to output + i * row_dim, and return the distinct ids
+  // which have to be fetched.
+  std::vector<int> Lookup(const int *ids, size_t ids_num, float *output);
+  // Cache the rows fetched for the missed ids of Lookup, and copy them to the positions of output they were looked
+  // up for.
+  void Fill(const int *ids, size_t ids_num, const std::vector<int> &missed, const float *rows, float *output);
+  // Add the gradients of a sparse push, row i of grads belonging to indices[i].
+  void AccumulateGrad(const int *indices, size_t indices_num, const float *grads);
+  // Take the accumulated gradients which are due, or all of them if flush_all is set.
+  void TakeDueGrads(bool flush_all, std::vector<int> *indices, std::vector<float> *grads);
+
+  size_t row_dim() const { return row_dim_; }
+  bool write_back() const { return write_back_; }
+  EmbeddingCacheStats stats();
+  double hit_rate();
+  std::string StatsString();
+
+ private:
+  // position in the eviction order, the smallest rank is evicted first
+  using Rank = std::pair<uint64_t, uint64_t>;
+  struct Entry {
+    size_t slot;
+    uint64_t fetch_step;
+    Rank rank;
+  };
+  struct PendingGrad {
+    uint64_t first_step;
+    std::vector<float> grad;
+  };
+
+  Rank NewRank(int id);
+  void Touch(int id, Entry *entry);
+  void Erase(int id);
+  void Admit(int id, const float *row);
+  uint32_t CountLookup(int id);
+
+  size_t capacity_;
+  size_t row_dim_;
+  EmbeddingCachePolicy policy_;
+  size_t staleness_;
+  bool write_back_;
+  uint64_t step_;
+  uint64_t tick_;
+
+  std::vector<float> rows_;
+  std::vector<size_t> free_slots_;
+  std::unordered_map<int, Entry> entries_;
+  std::set<std::pair<Rank, int>> order_;
+  // lookup counts of recently seen ids, for LFU admission and eviction
+  std::unordered_map<int, uint32_t> lookup_counts_;
+  std::map<int, PendingGrad> pending_grads_;
+  EmbeddingCacheStats stats_;
+  std::mutex mutex_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_EMBEDDING_CACHE_H_
@@ -0,0 +1,303 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/gradient_compressor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include "base/float16.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+// The words of the type and the number of elements in front of the payload.
+constexpr size_t kHeaderSize = 2;
+constexpr size_t kInt8BlockSize = 256;
+constexpr float kInt8Max = 127;
+
+size_t WordsOf(size_t bytes) { return (bytes + sizeof(float) - 1) / sizeof(float); }
+
+uint16_t FloatToBFloat16(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  if (std::isnan(value)) {
+    return 0x7FC0;
+  }
+  // Round to the nearest, ties to even.
+  bits += 0x7FFF + ((bits >> 16) & 1);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+float BFloat16ToFloat(uint16_t value) {
+  uint32_t bits = static_cast<uint32_t>(value) << 16;
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+}  // namespace
+
+bool GradCompressTypeOf(const std::string &name, GradCompressType *type) {
+  MS_EXCEPTION_IF_NULL(type);
+  if (name == kGradCompressNameNone) {
+    *type = kGradCompressNone;
+  } else if (name == kGradCompressNameFP16) {
+    *type = kGradCompressFP16;
+  } else if (name == kGradCompressNameBF16) {
+    *type = kGradCompressBF16;
+  } else if (name == kGradCompressNameTopK) {
+    *type = kGradCompressTopK;
+  } else if (name == kGradCompressNameInt8) {
+    *type = kGradCompressInt8;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+std::string GradCompressTypeName(GradCompressType type) {
+  switch (type) {
+    case kGradCompressFP16:
+      return kGradCompressNameFP16;
+    case kGradCompressBF16:
+      return kGradCompressNameBF16;
+    case kGradCompressTopK:
+      return kGradCompressNameTopK;
+    case kGradCompressInt8:
+      return kGradCompressNameInt8;
+    default:
+      return kGradCompressNameNone;
+  }
+}
+
+std::shared_ptr<GradientCompressor> GradientCompressor::Create(GradCompressType type, float topk_ratio) {
+  switch (type) {
+    case kGradCompressFP16:
+    case kGradCompressBF16:
+      return std::make_shared<HalfGradientCompressor>(type);
+    case kGradCompressTopK:
+      return std::make_shared<TopKGradientCompressor>(topk_ratio);
+    case kGradCompressInt8:
+      return std::make_shared<Int8GradientCompressor>();
+    default:
+      return nullptr;
+  }
+}
+
+void GradientCompressor::Compress(const float *grad, size_t grad_size, std::vector<float> *out) {
+  MS_EXCEPTION_IF_NULL(grad);
+  MS_EXCEPTION_IF_NULL(out);
+  if (grad_size > std::numeric_limits<uint32_t>::max()) {
+    MS_LOG(EXCEPTION) << "The gradient of " << grad_size << " elements is too large to compress.";
+  }
+  out->assign(kHeaderSize + PayloadSize(grad_size), 0);
+  uint32_t *header = reinterpret_cast<uint32_t *>(out->data());
+  header[0] = type_;
+  header[1] = static_cast<uint32_t>(grad_size);
+  size_t payload_size = Encode(grad, grad_size, out->data() + kHeaderSize);
+  out->resize(kHeaderSize + payload_size);
+}
+
+void GradientCompressor::Decompress(const float *data, size_t data_size, std::vector<float> *grad) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(grad);
+  if (data_size < kHeaderSize) {
+    MS_LOG(EXCEPTION) << "The compressed gradient of " << data_size << " words has no header.";
+  }
+  const uint32_t *header = reinterpret_cast<const uint32_t *>(data);
+  auto compressor = Create(static_cast<GradCompressType>(header[0]), 0);
+  if (compressor == nullptr) {
+    MS_LOG(EXCEPTION) << "Invalid gradient compress type " << header[0];
+  }
+  size_t grad_size = header[1];
+  grad->assign(grad_size, 0);
+  compressor->Decode(data + kHeaderSize, data_size - kHeaderSize, grad_size, grad->data());
+}
+
+void GradientCompressor::WritePushLead(size_t compressed_index, float *lead) {
+  MS_EXCEPTION_IF_NULL(lead);
+  uint32_t index = static_cast<uint32_t>(compressed_index);
+  std::memcpy(lead, &index, sizeof(index));
+}
+
+void GradientCompressor::DecompressPush(const float *vals, size_t vals_size, const int *lens, size_t lens_size,
+                                        std::vector<float> *values, std::vector<int> *lengths) {
+  MS_EXCEPTION_IF_NULL(vals);
+  MS_EXCEPTION_IF_NULL(lens);
+  MS_EXCEPTION_IF_NULL(values);
+  MS_EXCEPTION_IF_NULL(lengths);
+  if (lens_size == 0 || lens[0] < static_cast<int>(kCompressedPushLeadSize) || vals_size < kCompressedPushLeadSize) {
+    MS_LOG(EXCEPTION) << "The compressed push of " << lens_size << " inputs has no leading word.";
+  }
+  uint32_t compressed_index;
+  std::memcpy(&compressed_index, vals, sizeof(compressed_index));
+  if (compressed_index >= lens_size) {
+    MS_LOG(EXCEPTION) << "The compressed input " << compressed_index << " is out of " << lens_size << " inputs.";
+  }
+  lengths->assign(lens, lens + lens_size);
+  (*lengths)[0] -= static_cast<int>(kCompressedPushLeadSize);
+  size_t total_size = 0;
+  size_t compressed_offset = 0;
+  for (size_t i = 0; i < lens_size; i++) {
+    if ((*lengths)[i] < 0) {
+      MS_LOG(EXCEPTION) << "The input " << i << " of the compressed push has the negative length " << (*lengths)[i];
+    }
+    if (i == compressed_index) {
+      compressed_offset = total_size;
+    }
+    total_size += static_cast<size_t>((*lengths)[i]);
+  }
+  if (total_size + kCompressedPushLeadSize != vals_size) {
+    MS_LOG(EXCEPTION) << "The compressed push has " << vals_size << " values, but its lengths sum up to "
+                      << total_size + kCompressedPushLeadSize;
+  }
+  const float *src = vals + kCompressedPushLeadSize;
+  size_t compressed_size = static_cast<size_t>((*lengths)[compressed_index]);
+  std::vector<float> grad;
+  Decompress(src + compressed_offset, compressed_size, &grad);
+  (*lengths)[compressed_index] = static_cast<int>(grad.size());
+  values->resize(total_size - compressed_size + grad.size());
+  auto dst = std::copy(src, src + compressed_offset, values->begin());
+  dst = std::copy(grad.begin(), grad.end(), dst);
+  (void)std::copy(src + compressed_offset + compressed_size, src + total_size, dst);
+}
+
+size_t HalfGradientCompressor::PayloadSize(size_t grad_size) const { return WordsOf(grad_size * sizeof(uint16_t)); }
+
+size_t HalfGradientCompressor::Encode(const float *grad, size_t grad_size, float *payload) {
+  if (type() == kGradCompressFP16) {
+    float16 *halves = reinterpret_cast<float16 *>(payload);
+    for (size_t i = 0; i < grad_size; i++) {
+      halves[i] = float16(grad[i]);
+    }
+  } else {
+    uint16_t *halves = reinterpret_cast<uint16_t *>(payload);
+    for (size_t i = 0; i < grad_size; i++) {
+      halves[i] = FloatToBFloat16(grad[i]);
+    }
+  }
+  return PayloadSize(grad_size);
+}
+
+void HalfGradientCompressor::Decode(const float *payload, size_t payload_size, size_t grad_size, float *grad) const {
+  if (payload_size != PayloadSize(grad_size)) {
+    MS_LOG(EXCEPTION) << "The 16 bits payload of " << payload_size << " words doesn't match " << grad_size
+                      << " elements.";
+  }
+  if (type() == kGradCompressFP16) {
+    const float16 *halves = reinterpret_cast<const float16 *>(payload);
+    for (size_t i = 0; i < grad_size; i++) {
+      grad[i] = static_cast<float>(halves[i]);
+    }
+  } else {
+    const uint16_t *halves = reinterpret_cast<const uint16_t *>(payload);
+    for (size_t i = 0; i < grad_size; i++) {
+      grad[i] = BFloat16ToFloat(halves[i]);
+    }
+  }
+}
+
+size_t TopKGradientCompressor::TopKSize(size_t grad_size) const {
+  auto k = static_cast<size_t>(std::ceil(ratio_ * grad_size));
+  return std::min(std::max(k, size_t(1)), grad_size);
+}
+
+// The payload is the number k of elements sent, k indices and k values.
+size_t TopKGradientCompressor::PayloadSize(size_t grad_size) const { return 1 + 2 * TopKSize(grad_size); }
+
+size_t TopKGradientCompressor::Encode(const float *grad, size_t grad_size, float *payload) {
+  if (residual_.size() != grad_size) {
+    residual_.assign(grad_size, 0);
+  }
+  for (size_t i = 0; i < grad_size; i++) {
+    residual_[i] += grad[i];
+  }
+  size_t k = TopKSize(grad_size);
+  std::vector<uint32_t> order(grad_size);
+  std::iota(order.begin(), order.end(), 0);
+  if (k < grad_size) {
+    std::nth_element(order.begin(), order.begin() + k, order.end(), [this](uint32_t lhs, uint32_t rhs) {
+      return std::fabs(residual_[lhs]) > std::fabs(residual_[rhs]);
+    });
+  }
+  reinterpret_cast<uint32_t *>(payload)[0] = static_cast<uint32_t>(k);
+  uint32_t *indices = reinterpret_cast<uint32_t *>(payload + 1);
+  float *values = payload + 1 + k;
+  for (size_t i = 0; i < k; i++) {
+    uint32_t index = order[i];
+    indices[i] = index;
+    values[i] = residual_[index];
+    residual_[index] = 0;
+  }
+  return 1 + 2 * k;
+}
+
+void TopKGradientCompressor::Decode(const float *payload, size_t payload_size, size_t grad_size, float *grad) const {
+  size_t k = payload_size == 0 ? 0 : reinterpret_cast<const uint32_t *>(payload)[0];
+  if (payload_size != 1 + 2 * k || k > grad_size) {
+    MS_LOG(EXCEPTION) << "The top-k payload of " << payload_size << " words doesn't match " << k << " elements.";
+  }
+  const uint32_t *indices = reinterpret_cast<const uint32_t *>(payload + 1);
+  const float *values = payload + 1 + k;
+  for (size_t i = 0; i < k; i++) {
+    if (indices[i] >= grad_size) {
+      MS_LOG(EXCEPTION) << "The top-k index " << indices[i] << " is out of " << grad_size << " elements.";
+    }
+    grad[indices[i]] += values[i];
+  }
+}
+
+// The payload is the scale of every block, followed by the 8 bits elements.
+size_t Int8GradientCompressor::PayloadSize(size_t grad_size) const {
+  return (grad_size + kInt8BlockSize - 1) / kInt8BlockSize + WordsOf(grad_size * sizeof(int8_t));
+}
+
+size_t Int8GradientCompressor::Encode(const float *grad, size_t grad_size, float *payload) {
+  size_t block_num = (grad_size + kInt8BlockSize - 1) / kInt8BlockSize;
+  float *scales = payload;
+  int8_t *elements = reinterpret_cast<int8_t *>(payload + block_num);
+  for (size_t block = 0; block < block_num; block++) {
+    size_t begin = block * kInt8BlockSize;
+    size_t end = std::min(begin + kInt8BlockSize, grad_size);
+    float max_abs = 0;
+    for (size_t i = begin; i < end; i++) {
+      max_abs = std::max(max_abs, std::fabs(grad[i]));
+    }
+    float scale = max_abs / kInt8Max;
+    scales[block] = scale;
+    for (size_t i = begin; i < end; i++) {
+      elements[i] = scale == 0 ? 0 : static_cast<int8_t>(std::lround(grad[i] / scale));
+    }
+  }
+  return PayloadSize(grad_size);
+}
+
+void Int8GradientCompressor::Decode(const float *payload, size_t payload_size, size_t grad_size, float *grad) const {
+  if (payload_size != PayloadSize(grad_size)) {
+    MS_LOG(EXCEPTION) << "The 8 bits payload of " << payload_size << " words doesn't match " << grad_size
+                      << " elements.";
+  }
+  size_t block_num = (grad_size + kInt8BlockSize - 1) / kInt8BlockSize;
+  const float *scales = payload;
+  const int8_t *elements = reinterpret_cast<const int8_t *>(payload + block_num);
+  for (size_t i = 0; i < grad_size; i++) {
+    grad[i] = scales[i / kInt8BlockSize] * elements[i];
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
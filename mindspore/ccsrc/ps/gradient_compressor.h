@@ -0,0 +1,126 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSOR_H_
+#define MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSOR_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// The words in front of the inputs of a compressed push.
+constexpr size_t kCompressedPushLeadSize = 1;
+
+constexpr char kGradCompressNameNone[] = "none";
+constexpr char kGradCompressNameFP16[] = "fp16";
+constexpr char kGradCompressNameBF16[] = "bf16";
+constexpr char kGradCompressNameTopK[] = "topk";
+constexpr char kGradCompressNameInt8[] = "int8";
+
+// kGradCompressFP16, kGradCompressBF16: every element is cast to 16 bits.
+// kGradCompressTopK: only the elements of the largest magnitude are sent, the others are kept by the worker and
+// added to the gradient of the next push (error feedback).
+// kGradCompressInt8: every block of elements is quantized to 8 bits with the scale of its largest magnitude.
+enum GradCompressType : uint32_t {
+  kGradCompressNone = 0,
+  kGradCompressFP16,
+  kGradCompressBF16,
+  kGradCompressTopK,
+  kGradCompressInt8
+};
+
+bool GradCompressTypeOf(const std::string &name, GradCompressType *type);
+std::string GradCompressTypeName(GradCompressType type);
+
+// Encodes the gradient of one key for the wire. The encoding is a sequence of float words, like the other push
+// values: the compress type and the number of elements, followed by the payload of the type. So the servers decode
+// it without knowing how the workers were configured.
+class GradientCompressor {
+ public:
+  virtual ~GradientCompressor() = default;
+
+  // Replace the content of out by the encoding of grad_size elements of grad.
+  void Compress(const float *grad, size_t grad_size, std::vector<float> *out);
+  // Replace the content of grad by the elements encoded in data_size words of data.
+  static void Decompress(const float *data, size_t data_size, std::vector<float> *grad);
+  // A compressed push leads with a word holding the index of its compressed input. The word is counted in the length
+  // of the first input, so that the lengths stay one-to-one with the keys of the push.
+  static void WritePushLead(size_t compressed_index, float *lead);
+  // Replace the content of values and lengths by the inputs of a compressed push of lens_size inputs, the compressed
+  // one decompressed.
+  static void DecompressPush(const float *vals, size_t vals_size, const int *lens, size_t lens_size,
+                             std::vector<float> *values, std::vector<int> *lengths);
+  static std::shared_ptr<GradientCompressor> Create(GradCompressType type, float topk_ratio);
+
+  GradCompressType type() const { return type_; }
+
+ protected:
+  explicit GradientCompressor(GradCompressType type) : type_(type) {}
+  // The number of payload words the encoding of grad_size elements takes at most.
+  virtual size_t PayloadSize(size_t grad_size) const = 0;
+  // Write the payload and return the number of words written.
+  virtual size_t Encode(const float *grad, size_t grad_size, float *payload) = 0;
+  virtual void Decode(const float *payload, size_t payload_size, size_t grad_size, float *grad) const = 0;
+
+ private:
+  GradCompressType type_;
+};
+
+class HalfGradientCompressor : public GradientCompressor {
+ public:
+  explicit HalfGradientCompressor(GradCompressType type) : GradientCompressor(type) {}
+  ~HalfGradientCompressor() override = default;
+
+ protected:
+  size_t PayloadSize(size_t grad_size) const override;
+  size_t Encode(const float *grad, size_t grad_size, float *payload) override;
+  void Decode(const float *payload, size_t payload_size, size_t grad_size, float *grad) const override;
+};
+
+class TopKGradientCompressor : public GradientCompressor {
+ public:
+  explicit TopKGradientCompressor(float ratio) : GradientCompressor(kGradCompressTopK), ratio_(ratio) {}
+  ~TopKGradientCompressor() override = default;
+
+ protected:
+  size_t PayloadSize(size_t grad_size) const override;
+  size_t Encode(const float *grad, size_t grad_size, float *payload) override;
+  void Decode(const float *payload, size_t payload_size, size_t grad_size, float *grad) const override;
+
+ private:
+  size_t TopKSize(size_t grad_size) const;
+
+  float ratio_;
+  // the gradient not sent yet
+  std::vector<float> residual_;
+};
+
+class Int8GradientCompressor : public GradientCompressor {
+ public:
+  Int8GradientCompressor() : GradientCompressor(kGradCompressInt8) {}
+  ~Int8GradientCompressor() override = default;
+
+ protected:
+  size_t PayloadSize(size_t grad_size) const override;
+  size_t Encode(const float *grad, size_t grad_size, float *payload) override;
+  void Decode(const float *payload, size_t payload_size, size_t grad_size, float *grad) const override;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSOR_H_
@@ -0,0 +1,152 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_KEYED_EXECUTOR_H_
+#define MINDSPORE_CCSRC_PS_KEYED_EXECUTOR_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+// Runs tasks on a fixed set of threads, called lanes. Tasks submitted with the same key go to the same lane and run
+// in submission order, tasks with different keys may run concurrently.
+//
+// Unlike the global ThreadPool, a lane never picks up tasks of other callers while waiting, so tasks may hold
+// locks across calls which launch work on the ThreadPool.
+class KeyedExecutor {
+ public:
+  explicit KeyedExecutor(size_t thread_num) {
+    thread_num = std::max(thread_num, size_t(1));
+    for (size_t i = 0; i < thread_num; ++i) {
+      lanes_.emplace_back(std::make_unique<Lane>());
+    }
+    for (auto &lane : lanes_) {
+      lane->thread = std::thread(&KeyedExecutor::Loop, lane.get());
+    }
+  }
+
+  ~KeyedExecutor() { Stop(); }
+
+  KeyedExecutor(const KeyedExecutor &) = delete;
+  KeyedExecutor &operator=(const KeyedExecutor &) = delete;
+
+  size_t thread_num() const { return lanes_.size(); }
+
+  void Submit(uint64_t key, std::function<void()> task) {
+    Lane *lane = lanes_[key % lanes_.size()].get();
+    {
+      std::lock_guard<std::mutex> lock(lane->mutex);
+      lane->tasks.push_back(std::move(task));
+    }
+    lane->cv.notify_one();
+  }
+
+  // Run task(key) for every key on the lane of the key and block until all of them finish. The first exception
+  // thrown by a task is rethrown here.
+  void RunAndWait(const std::vector<uint64_t> &keys, const std::function<void(uint64_t)> &task) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t pending = keys.size();
+    std::exception_ptr exception = nullptr;
+    for (auto key : keys) {
+      Submit(key, [&, key]() {
+        std::exception_ptr task_exception = nullptr;
+        try {
+          task(key);
+        } catch (...) {
+          task_exception = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (exception == nullptr) {
+          exception = task_exception;
+        }
+        if (--pending == 0) {
+          cv.notify_all();
+        }
+      });
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&pending] { return pending == 0; });
+    if (exception != nullptr) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  // Finish the queued tasks and join the lanes.
+  void Stop() {
+    for (auto &lane : lanes_) {
+      {
+        std::lock_guard<std::mutex> lock(lane->mutex);
+        lane->stop = true;
+      }
+      lane->cv.notify_one();
+    }
+    for (auto &lane : lanes_) {
+      if (lane->thread.joinable()) {
+        lane->thread.join();
+      }
+    }
+  }
+
+ private:
+  struct Lane {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> tasks;
+    bool stop{false};
+    std::thread thread;
+  };
+
+  static void Loop(Lane *lane) {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(lane->mutex);
+        lane->cv.wait(lock, [lane] { return lane->stop || !lane->tasks.empty(); });
+        if (lane->tasks.empty()) {
+          return;
+        }
+        task = std::move(lane->tasks.front());
+        lane->tasks.pop_front();
+      }
+      // A task which escapes an exception must not take the lane down with it, the other keys of the lane still
+      // have to run.
+      try {
+        task();
+      } catch (const std::exception &e) {
+        MS_LOG(ERROR) << "Keyed executor task failed: " << e.what();
+      } catch (...) {
+        MS_LOG(ERROR) << "Keyed executor task failed with an unknown exception.";
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<Lane>> lanes_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_KEYED_EXECUTOR_H_
@@ -24,6 +24,10 @@
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
 #include <condition_variable>
 #include <thread>
 #include <cmath>
@@ -41,6 +45,9 @@
 #include "ps/optimizer_info_builder.h"
 #include "ps/util.h"
 #include "ps/ps_context.h"
+#include "ps/gradient_compressor.h"
+#include "ps/keyed_executor.h"
+#include "ps/striped_lock.h"
 #include "runtime/device/cpu/kernel_select_cpu.h"
 #include "utils/ms_context.h"
 #include "backend/kernel_compiler/kernel.h"
@@ -56,6 +63,26 @@ namespace mindspore {
 namespace ps {
 using mindspore::kernel::ps::PServerKernel;
 using AnfAlgo = session::AnfRuntimeAlgorithm;
+using mindspore::kernel::ps::EmbeddingLookUpPSKernel;
+// Rows of an embedding table guarded by the same lock stripe are grouped in ranges of this size.
+constexpr size_t kRowsPerLockRange = 64;
+constexpr size_t kMaxServerThreadNum = 16;
+
+// Locking:
+//   tables_mutex_ guards the structure of the per key maps. The init handlers hold it exclusively while adding keys,
+//   everything else holds it shared and only touches the entries of existing keys.
+//   key_locks_ guards the per key state: gradients, optimizer infos, counters and tokens.
+//   row_locks_ guards ranges of rows of the embedding tables, which are read by lookups and written by optimizers.
+//   mutex_ only guards the condition of apply_grads_cv_.
+// Push, pull and lookup requests are handled on executor_ off the ps-lite receiving thread, pushes and pulls of one
+// key on the same lane and in order. The optimizers of different keys also run concurrently on executor_.
+//
+// Training modes (see PSMode):
+//   In sync mode a key is updated once all workers pushed it, with the mean of their gradients, and a worker can't
+//   push a key again before all workers pulled the update.
+//   In async and ssp modes every push is applied at once on the lane of its key. worker_clocks_ counts the pushes of
+//   every worker per key, in ssp mode a worker can't push a key while it is more than staleness_threshold_ pushes
+//   ahead of the slowest worker.
 template <typename T>
 class ParameterServer {
  public:
@@ -72,6 +99,13 @@ class ParameterServer {
         worker_num_(0),
         rank_id_(0),
         grad_accum_count_(0),
+        grad_key_num_(0),
+        push_count_(0),
+        first_push_time_(0),
+        lookup_count_(0),
+        ps_mode_(kPSModeSync),
+        staleness_threshold_(0),
+        max_staleness_(0),
         ps_(new ::ps::KVServer<T>(0)),
         handler_(nullptr),
         func_graph_(nullptr),
@@ -90,6 +124,7 @@ class ParameterServer {
     void operator()(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVServer<T> *server);
 
    private:
+    void Dispatch(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandlePushReq(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandlePullReq(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleInitWeights(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
@@ -101,6 +136,7 @@ class ParameterServer {
     void HandleCheckReadyForPull(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleEmbeddingLookup(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleFinalize(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
+    static size_t WorkerRank(const ::ps::KVMeta &req_meta);
 
     ParameterServer *ps_;
     typedef void (ServerHandler::*RequestHandler)(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
@@ -122,27 +158,38 @@ class ParameterServer {
   bool HasWeight(const Key &key);
   void Finalize();
   void UpdateWeights();
-  void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
+  void UpdateWeight(const Key &key, size_t grad_num);
+  void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths, size_t worker_rank);
+  std::vector<std::unique_lock<std::mutex>> LockRows(const Key &key, const std::vector<int> &rows);
   WeightPtr weight(const Key &key);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res);
   bool ReadyForUpdateWeights();
-  bool ReadyForPush(const Key &key);
+  bool ReadyForPush(const Key &key, size_t worker_rank);
   bool ReadyForPull(const Key &key);
   void ResetGradAccumCount();
   const CNodePtr GetCNode(const std::string &name) const;
-  std::mutex &mutex();
+  std::shared_mutex &mutex();
   void GetEmbeddingTableParamPtr();
   void SyncEmbeddingTables();
 
   size_t pserver_num_;
   size_t worker_num_;
   size_t rank_id_;
-  size_t grad_accum_count_;
+  // number of keys which received the gradients of all workers in this step
+  std::atomic<size_t> grad_accum_count_;
+  std::atomic<size_t> grad_key_num_;
+  std::atomic<uint64_t> push_count_;
+  std::atomic<int64_t> first_push_time_;
+  std::atomic<uint64_t> lookup_count_;
+  PSMode ps_mode_;
+  uint64_t staleness_threshold_;
+  // the largest lead of a worker over the slowest one seen by a push
+  std::atomic<uint64_t> max_staleness_;
   std::unique_ptr<::ps::KVServer<T>> ps_;
   std::unique_ptr<ServerHandler> handler_;
   FuncGraphPtr func_graph_;
   std::shared_ptr<session::SessionBasic> sess_;
-  bool running_;
+  std::atomic<bool> running_;
 
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> optimizers_;
   std::unordered_map<Key, InputsShapePtr> optim_inputs_shape_;
@@ -155,11 +202,17 @@ class ParameterServer {
   std::unordered_map<Key, bool> is_embedding_;
   std::unordered_map<Key, WeightPtr> grads_;
   std::unordered_map<Key, size_t> grads_accum_counter_;
-  std::unordered_map<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
+  std::unordered_map<Key, std::shared_ptr<EmbeddingLookUpPSKernel>> embedding_lookup_ops_;
   std::unordered_map<Key, uint64_t> tokens_;
+  // number of pushes of every worker rank per key
+  std::unordered_map<Key, std::vector<uint64_t>> worker_clocks_;
 
+  std::shared_mutex tables_mutex_;
+  StripedLock key_locks_;
+  std::unordered_map<Key, std::shared_ptr<StripedLock>> row_locks_;
   std::mutex mutex_;
   std::condition_variable apply_grads_cv_;
+  std::unique_ptr<KeyedExecutor> executor_;
 
   std::unique_ptr<std::thread> thread_;
   std::map<Key, ParameterPtr> embedding_tables_;
@@ -172,16 +225,35 @@ template <typename T>
 void ParameterServer<T>::ServerHandler::operator()(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
                                                    ::ps::KVServer<T> *server) {
   MS_EXCEPTION_IF_NULL(server);
+  bool is_lookup = req_meta.cmd == kEmbeddingLookupCmd;
+  bool is_data_req = (handlers_.count(req_meta.cmd) == 0) || is_lookup || req_meta.cmd == kCheckReadyForPushCmd ||
+                     req_meta.cmd == kCheckReadyForPullCmd;
+  if (is_data_req && !req_data.keys.empty()) {
+    // Lookups only read the table and are spread over all the lanes, the other requests of a key keep their order.
+    uint64_t lane = is_lookup ? ps_->lookup_count_++ : req_data.keys[0];
+    ps_->executor_->Submit(lane, [this, req_meta, req_data, server]() {
+      ::ps::KVPairs<T> res;
+      Dispatch(req_meta, req_data, &res);
+      server->Response(req_meta, res);
+    });
+    return;
+  }
   ::ps::KVPairs<T> res;
-  if (handlers_.count(req_meta.cmd) > 0) {
-    auto &handler_ptr = handlers_[req_meta.cmd];
-    (this->*handler_ptr)(req_meta, req_data, &res);
+  Dispatch(req_meta, req_data, &res);
+  server->Response(req_meta, res);
+}
+
+template <typename T>
+void ParameterServer<T>::ServerHandler::Dispatch(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
+                                                 ::ps::KVPairs<T> *res) {
+  auto handler_iter = handlers_.find(req_meta.cmd);
+  if (handler_iter != handlers_.end()) {
+    (this->*(handler_iter->second))(req_meta, req_data, res);
   } else if (req_meta.push) {
-    HandlePushReq(req_meta, req_data, &res);
+    HandlePushReq(req_meta, req_data, res);
   } else {
-    HandlePullReq(req_meta, req_data, &res);
+    HandlePullReq(req_meta, req_data, res);
   }
-  server->Response(req_meta, res);
 }
 
 template <typename T>
@@ -200,7 +272,22 @@ template <typename T>
 void ParameterServer<T>::ServerHandler::HandlePushReq(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
                                                       ::ps::KVPairs<T> *res) {
   MS_EXCEPTION_IF_NULL(res);
-  ps_->AccumGrad(req_data.keys, req_data.vals, req_data.lens);
+  if (req_meta.cmd == kCompressedPushCmd) {
+    std::vector<float> inputs;
+    std::vector<int> inputs_lens;
+    GradientCompressor::DecompressPush(req_data.vals.data(), req_data.vals.size(), req_data.lens.data(),
+                                       req_data.lens.size(), &inputs, &inputs_lens);
+    Values values;
+    Lengths lengths;
+    values.CopyFrom(inputs.data(), inputs.size());
+    lengths.CopyFrom(inputs_lens.data(), inputs_lens.size());
+    ps_->AccumGrad(req_data.keys, values, lengths, WorkerRank(req_meta));
+  } else {
+    ps_->AccumGrad(req_data.keys, req_data.vals, req_data.lens, WorkerRank(req_meta));
+  }
+  if (ps_->push_count_++ == 0) {
+    ps_->first_push_time_ = std::chrono::steady_clock::now().time_since_epoch().count();
+  }
 }
 
 template <typename T>
@@ -215,7 +302,7 @@ void ParameterServer<T>::ServerHandler::HandlePullReq(const ::ps::KVMeta &req_me
 template <typename T>
 void ParameterServer<T>::ServerHandler::HandleInitWeights(const ::ps::KVMeta &req_meta,
                                                           const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   size_t key_num = req_data.keys.size();
   T *data_ptr = req_data.vals.data();
@@ -242,7 +329,7 @@ template <typename T>
 void ParameterServer<T>::ServerHandler::HandleInitWeightToOptimId(const ::ps::KVMeta &req_meta,
                                                                   const ::ps::KVPairs<T> &req_data,
                                                                   ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   size_t key_num = req_data.keys.size();
   for (size_t i = 0; i < key_num; i++) {
@@ -260,7 +347,7 @@ void ParameterServer<T>::ServerHandler::HandleInitWeightToOptimId(const ::ps::KV
 template <typename T>
 void ParameterServer<T>::ServerHandler::HandleInitInputsShape(const ::ps::KVMeta &req_meta,
                                                               const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   const Key &key = req_data.keys[0];
   if (init_optim_info_[key]) {
@@ -274,7 +361,7 @@ void ParameterServer<T>::ServerHandler::HandleInitInputsShape(const ::ps::KVMeta
 template <typename T>
 void ParameterServer<T>::ServerHandler::HandleInitEmbeddings(const ::ps::KVMeta &req_meta,
                                                              const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   const Key &key = req_data.keys[0];
   MS_LOG(INFO) << "Initializing embedding table for key:" << key;
@@ -311,7 +398,7 @@ void ParameterServer<T>::ServerHandler::HandleCheckReadyForPush(const ::ps::KVMe
                                                                 ::ps::KVPairs<T> *res) {
   MS_EXCEPTION_IF_NULL(res);
   const Key &key = req_data.keys[0];
-  bool ready = ps_->ReadyForPush(key);
+  bool ready = ps_->ReadyForPush(key, WorkerRank(req_meta));
   res->keys.push_back(key);
   res->vals.push_back(ready);
 }
@@ -345,16 +432,27 @@ void ParameterServer<T>::ServerHandler::HandleFinalize(const ::ps::KVMeta &req_m
   ps_->Finalize();
 }
 
+template <typename T>
+size_t ParameterServer<T>::ServerHandler::WorkerRank(const ::ps::KVMeta &req_meta) {
+  return IntToSize(::ps::Postoffice::Get()->IDtoRank(req_meta.sender));
+}
+
 template <typename T>
 bool ParameterServer<T>::Init(const FuncGraphPtr &func_graph) {
   pserver_num_ = ::ps::NumServers();
   worker_num_ = ::ps::NumWorkers();
   func_graph_ = func_graph;
   rank_id_ = ::ps::MyRank();
+  ps_mode_ = PSContext::instance()->ps_mode();
+  staleness_threshold_ = IntToSize(PSContext::instance()->staleness_threshold());
+  MS_LOG(INFO) << "PServer rank " << rank_id_ << " runs in " << PSContext::instance()->ps_mode_name()
+               << " mode, staleness threshold " << staleness_threshold_;
   handler_.reset(new ServerHandler(this));
   handler_->Init();
 
   InitOptimInfoBuilders();
+  size_t thread_num = std::min(static_cast<size_t>(std::thread::hardware_concurrency()), kMaxServerThreadNum);
+  executor_.reset(new KeyedExecutor(thread_num));
   ps_->set_request_handle(*handler_);
   thread_.reset(new std::thread(&ParameterServer::UpdateWeights, this));
   GetEmbeddingTableParamPtr();
@@ -461,7 +559,10 @@ void ParameterServer<T>::InitWeight(const Key &key, const WeightPtr &weight) {
     MS_LOG(INFO) << "Initializing weight for key " << key << ", server rank " << rank_id_;
     weights_[key] = weight;
     tokens_[key] = 0;
+    worker_clocks_[key] = std::vector<uint64_t>(worker_num_, 0);
     is_embedding_[key] = false;
+    // the slot is filled by the first push, keys can't be added to the map while serving requests
+    (void)optim_infos_.emplace(key, nullptr);
   }
 }
 
@@ -471,6 +572,7 @@ void ParameterServer<T>::InitGrad(const Key &key, const GradPtr &grad) {
   if (grads_.count(key) == 0) {
     grads_[key] = grad;
     grads_accum_counter_[key] = 0;
+    grad_key_num_ = grads_accum_counter_.size();
   }
 }
 
@@ -479,8 +581,8 @@ void ParameterServer<T>::InitEmbeddingTable(
   const Key &key, const std::shared_ptr<std::vector<std::shared_ptr<std::vector<size_t>>>> &shapes) {
   MS_EXCEPTION_IF_NULL(shapes);
   if (weights_.count(key) == 0) {
-    std::shared_ptr<PServerKernel> lookup =
-      std::make_shared<kernel::ps::EmbeddingLookUpPSKernel>(rank_id_, pserver_num_, worker_num_);
+    std::shared_ptr<EmbeddingLookUpPSKernel> lookup =
+      std::make_shared<EmbeddingLookUpPSKernel>(rank_id_, pserver_num_, worker_num_);
     lookup->InitKernel(shapes);
     embedding_lookup_ops_[key] = lookup;
 
@@ -498,9 +600,13 @@ void ParameterServer<T>::InitEmbeddingTable(
     }
     weights_[key] = embedding;
     tokens_[key] = 0;
+    worker_clocks_[key] = std::vector<uint64_t>(worker_num_, 0);
     is_embedding_[key] = true;
+    (void)optim_infos_.emplace(key, nullptr);
+    row_locks_[key] = std::make_shared<StripedLock>();
 
     grads_accum_counter_[key] = 0;
+    grad_key_num_ = grads_accum_counter_.size();
   }
 }
 
@@ -511,203 +617,298 @@ bool ParameterServer<T>::HasWeight(const Key &key) {
 
 template <typename T>
 void ParameterServer<T>::Finalize() {
-  running_ = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
   apply_grads_cv_.notify_one();
+  uint64_t push_count = push_count_;
+  if (push_count > 0) {
+    double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch() -
+                                    std::chrono::steady_clock::duration(first_push_time_.load()))
+        .count();
+    MS_LOG(INFO) << "PServer rank " << rank_id_ << " handled " << push_count << " pushes in " << seconds
+                 << " seconds, " << (seconds > 0 ? push_count / seconds : 0) << " pushes/sec.";
+  }
+  if (ps_mode_ != kPSModeSync) {
+    MS_LOG(INFO) << "PServer rank " << rank_id_ << " saw workers at most " << max_staleness_ << " pushes apart.";
+  }
+  // Wait for the step in flight
+  std::unique_lock<std::shared_mutex> tables_lock(tables_mutex_);
   SyncEmbeddingTables();
 }
 
 template <typename T>
 void ParameterServer<T>::UpdateWeights() {
   while (true) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
-    if (!running_) {
-      break;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
+      if (!running_) {
+        break;
+      }
     }
 
+    std::shared_lock<std::shared_mutex> tables_lock(tables_mutex_);
+    std::vector<uint64_t> keys;
+    keys.reserve(weights_.size());
     for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
-      Key key = iter->first;
-      WeightPtr weight_ptr = iter->second;
+      keys.push_back(iter->first);
+    }
+    // Each key is updated on the lane serving its pushes and pulls.
+    executor_->RunAndWait(keys, [this](uint64_t key) { UpdateWeight(key, worker_num_); });
+    ResetGradAccumCount();
+  }
+}
 
-      std::shared_ptr<PServerKernel> optimizer = nullptr;
-      if (weight_key_to_optims_.count(key) > 0) {
-        optimizer = optimizers_[key];
+// Apply the mean of the grad_num gradients accumulated for the key.
+template <typename T>
+void ParameterServer<T>::UpdateWeight(const Key &key, size_t grad_num) {
+  std::unique_lock<std::mutex> key_lock(key_locks_.Get(key));
+  std::shared_ptr<PServerKernel> optimizer = nullptr;
+  if (weight_key_to_optims_.count(key) > 0 && optimizers_.count(key) > 0) {
+    optimizer = optimizers_.at(key);
+  }
+  MS_EXCEPTION_IF_NULL(optimizer);
+
+  auto optim_info_iter = optim_infos_.find(key);
+  std::shared_ptr<OptimizerInfo> optim_info = optim_info_iter == optim_infos_.end() ? nullptr : optim_info_iter->second;
+  if (optim_info != nullptr) {
+    const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
+    const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
+    const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
+
+    std::vector<std::vector<size_t>> shapes = {};
+    std::vector<size_t> indices_shape = {};
+    indices_shape.emplace_back(optim_info->indice_size());
+    shapes.push_back(indices_shape);
+
+    auto original_shape_iter = original_optim_inputs_shape_.find(key);
+    if (original_shape_iter != original_optim_inputs_shape_.end()) {
+      for (auto input_shapes : *(original_shape_iter->second)) {
+        shapes.push_back(*input_shapes);
       }
-      MS_EXCEPTION_IF_NULL(optimizer);
-
-      std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-      if (optim_info != nullptr) {
-        const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
-        const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
-        const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
-
-        std::vector<std::vector<size_t>> shapes = {};
-        std::vector<size_t> indices_shape = {};
-        indices_shape.emplace_back(optim_info->indice_size());
-        shapes.push_back(indices_shape);
-
-        if (original_optim_inputs_shape_.count(key) != 0) {
-          for (auto input_shapes : *(original_optim_inputs_shape_[key])) {
-            shapes.push_back(*input_shapes);
-          }
+    }
+    optimizer->ReInit(shapes);
+    optim_info->ComputeMean(shapes, grad_num, pserver_num_, rank_id_);
+    {
+      // Lazy Adam and FTRL only write the rows of the gradient, lookups of the other rows can go on meanwhile.
+      std::vector<std::unique_lock<std::mutex>> row_locks;
+      const std::string &optim_name = weight_key_to_optims_.at(key);
+      auto row_lock_iter = row_locks_.find(key);
+      if (row_lock_iter != row_locks_.end()) {
+        if (optim_info->IsSparse() && (optim_name == kSparseLazyAdam || optim_name == kSparseFtrl)) {
+          // indices are local and deduplicated by ComputeMean
+          const AddressPtr &indices = optim_info->indices();
+          MS_EXCEPTION_IF_NULL(indices);
+          const int *indices_data = reinterpret_cast<int *>(indices->addr);
+          std::vector<int> rows(indices_data, indices_data + indices->size / sizeof(int));
+          row_locks = LockRows(key, rows);
+        } else {
+          row_locks = row_lock_iter->second->LockAll();
         }
-        optimizer->ReInit(shapes);
-        optim_info->ComputeMean(shapes, worker_num_, pserver_num_, rank_id_);
-        optimizer->Execute(inputs, workspaces, outputs);
-        optim_info->Reset();
-      }
-      if (!is_embedding_[key]) {
-        tokens_[key] = worker_num_;
       }
+      optimizer->Execute(inputs, workspaces, outputs);
     }
-    ResetGradAccumCount();
+    optim_info->Reset();
+  }
+  auto is_embedding_iter = is_embedding_.find(key);
+  if (ps_mode_ == kPSModeSync && (is_embedding_iter == is_embedding_.end() || !is_embedding_iter->second)) {
+    tokens_.at(key) = worker_num_;
   }
 }
 
 template <typename T>
-void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
-  std::unique_lock<std::mutex> lock(mutex_);
+void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths,
+                                   size_t worker_rank) {
+  std::shared_lock<std::shared_mutex> tables_lock(tables_mutex_);
   const Key &key = keys[0];
   bool no_sparse_grad = values.size() == 1 && values[0] == -100;
-  if (!no_sparse_grad) {
-    std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-
-    // Create or update the optimizer info
-    if (optim_info == nullptr) {
-      const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-      std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
-      if (pserver_kernel == nullptr) {
-        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+  {
+    std::unique_lock<std::mutex> key_lock(key_locks_.Get(key));
+    if (!no_sparse_grad) {
+      auto optim_info_iter = optim_infos_.find(key);
+      if (optim_info_iter == optim_infos_.end()) {
+        MS_LOG(EXCEPTION) << "Push for key " << key << " which is not initialized";
+      }
+      std::shared_ptr<OptimizerInfo> &optim_info = optim_info_iter->second;
+
+      // Create or update the optimizer info
+      if (optim_info == nullptr) {
+        auto optim_name_iter = weight_key_to_optims_.find(key);
+        auto optimizer_iter = optimizers_.find(key);
+        if (optim_name_iter == weight_key_to_optims_.end() || optimizer_iter == optimizers_.end() ||
+            optimizer_iter->second == nullptr) {
+          MS_LOG(EXCEPTION) << "no optimizer found for key " << key;
+        }
+        const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_.at(optim_name_iter->second);
+        std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizer_iter->second;
+        OptimizerInfo *optim = builder->Build(pserver_kernel, weights_.at(key), keys, values, lengths,
+                                              optim_inputs_shape_.at(key), worker_num_);
+        optim_info.reset(optim);
+      } else {
+        optim_info->Update(values, lengths);
+        optim_info->Accumulate(values, lengths);
+      }
+    }
+
+    if (ps_mode_ != kPSModeSync) {
+      std::vector<uint64_t> &clocks = worker_clocks_.at(key);
+      EXC_IF_VEC_IDX_OOB(clocks, worker_rank);
+      clocks[worker_rank]++;
+      uint64_t lead = clocks[worker_rank] - *std::min_element(clocks.begin(), clocks.end());
+      uint64_t max_staleness = max_staleness_;
+      while (lead > max_staleness && !max_staleness_.compare_exchange_weak(max_staleness, lead)) {
       }
-      MS_EXCEPTION_IF_NULL(pserver_kernel);
-      OptimizerInfo *optim =
-        builder->Build(pserver_kernel, weights_[key], keys, values, lengths, optim_inputs_shape_[key], worker_num_);
-      optim_info.reset(optim);
-      optim_infos_[key] = optim_info;
     } else {
-      optim_info->Update(values, lengths);
-      optim_info->Accumulate(values, lengths);
+      size_t &accum_counter = grads_accum_counter_.at(key);
+      accum_counter += 1;
+      if (accum_counter == worker_num_) {
+        grad_accum_count_++;
+      }
     }
   }
-
-  grads_accum_counter_[key] += 1;
-  if (grads_accum_counter_[key] == worker_num_) {
-    grad_accum_count_++;
+  if (ps_mode_ != kPSModeSync) {
+    // Pushes of a key are serialized on its lane, so the gradient accumulated is this push only.
+    if (!no_sparse_grad) {
+      UpdateWeight(key, 1);
+    }
+    return;
   }
   if (ReadyForUpdateWeights()) {
+    std::lock_guard<std::mutex> lock(mutex_);
     apply_grads_cv_.notify_one();
   }
 }
 
 template <typename T>
 WeightPtr ParameterServer<T>::weight(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
+  std::shared_lock<std::shared_mutex> tables_lock(tables_mutex_);
+  auto weight_iter = weights_.find(key);
+  if (weight_iter == weights_.end()) {
     MS_LOG(EXCEPTION) << "Invalid weight key " << key;
   }
-  WeightPtr weight_ptr = weights_[key];
+  std::unique_lock<std::mutex> key_lock(key_locks_.Get(key));
+  WeightPtr weight_ptr = weight_iter->second;
   MS_EXCEPTION_IF_NULL(weight_ptr);
   WeightPtr copy_weight_ptr = std::make_shared<::ps::SArray<T>>(weight_ptr->size(), 0);
   MS_EXCEPTION_IF_NULL(copy_weight_ptr);
   copy_weight_ptr->CopyFrom(weight_ptr->data(), weight_ptr->size());
-  tokens_[key] -= 1;
+  if (ps_mode_ == kPSModeSync) {
+    tokens_.at(key) -= 1;
+  }
   return copy_weight_ptr;
 }
 
 template <typename T>
 void ParameterServer<T>::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(mutex_);
+  std::shared_lock<std::shared_mutex> tables_lock(tables_mutex_);
   MS_EXCEPTION_IF_NULL(res);
-  if (weights_.count(key) == 0) {
+  auto table_iter = weights_.find(key);
+  if (table_iter == weights_.end()) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
+  auto lookup_op_iter = embedding_lookup_ops_.find(key);
+  if (lookup_op_iter == embedding_lookup_ops_.end()) {
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
     return;
   }
-  WeightPtr table_ptr = weights_[key];
+  WeightPtr table_ptr = table_iter->second;
   MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
+  std::shared_ptr<EmbeddingLookUpPSKernel> table_lookup_op = lookup_op_iter->second;
   MS_EXCEPTION_IF_NULL(table_lookup_op);
 
-  // Update shapes of lookup operator
-  std::vector<std::vector<size_t>> shapes = {};
-  std::vector<size_t> indices_shape = {};
-  indices_shape.emplace_back(lookup_ids.size());
-  shapes.push_back(indices_shape);
-  table_lookup_op->ReInit(shapes);
-
-  const std::vector<size_t> output_shapes = table_lookup_op->output_sizes();
-  std::vector<kernel::AddressPtr> inputs;
-  AddressPtr embedding_table = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(embedding_table);
-  AddressPtr indices = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(indices);
-  inputs.push_back(embedding_table);
-  inputs.push_back(indices);
-  embedding_table->addr = table_ptr->data();
-  embedding_table->size = table_ptr->size() * sizeof(T);
-
-  std::unique_ptr<int[]> tmp_ids(new int[lookup_ids.size()]);
-  MS_EXCEPTION_IF_NULL(tmp_ids);
+  std::vector<int> ids(lookup_ids.size());
+  std::vector<int> rows(lookup_ids.size());
   for (size_t i = 0; i < lookup_ids.size(); i++) {
-    tmp_ids[i] = static_cast<int>(lookup_ids[i]);
+    ids[i] = static_cast<int>(lookup_ids[i]);
+    rows[i] = ids[i] - table_lookup_op->offset();
   }
-  indices->addr = tmp_ids.get();
-  indices->size = lookup_ids.size() * sizeof(int);
-
-  std::vector<kernel::AddressPtr> workspaces;
-  std::vector<kernel::AddressPtr> outputs;
-  AddressPtr output = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(output);
-  std::shared_ptr<Values> addr = std::make_shared<Values>(output_shapes[0] / sizeof(T), 0);
+  std::shared_ptr<Values> addr =
+    std::make_shared<Values>(lookup_ids.size() * table_lookup_op->outer_dim_size(), 0);
   MS_EXCEPTION_IF_NULL(addr);
-
-  output->addr = addr->data();
-  output->size = output_shapes[0];
-  outputs.push_back(output);
-
-  table_lookup_op->Execute(inputs, workspaces, outputs);
+  {
+    auto row_locks = LockRows(key, rows);
+    table_lookup_op->Lookup(table_ptr->data(), ids.data(), ids.size(), addr->data());
+  }
   res->vals = *addr;
   res->lens.push_back(res->vals.size());
 }
 
+template <typename T>
+std::vector<std::unique_lock<std::mutex>> ParameterServer<T>::LockRows(const Key &key, const std::vector<int> &rows) {
+  auto row_lock_iter = row_locks_.find(key);
+  if (row_lock_iter == row_locks_.end()) {
+    return {};
+  }
+  std::vector<uint64_t> ranges;
+  ranges.reserve(rows.size());
+  for (auto row : rows) {
+    if (row >= 0) {
+      ranges.push_back(IntToSize(row) / kRowsPerLockRange);
+    }
+  }
+  return row_lock_iter->second->LockMany(ranges);
+}
+
 template <typename T>
 inline bool ParameterServer<T>::ReadyForUpdateWeights() {
-  return grads_accum_counter_.size() > 0 && grad_accum_count_ == grads_accum_counter_.size();
+  return grad_key_num_ > 0 && grad_accum_count_ == grad_key_num_;
 }
 
 template <typename T>
-inline bool ParameterServer<T>::ReadyForPush(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
+inline bool ParameterServer<T>::ReadyForPush(const Key &key, size_t worker_rank) {
+  std::shared_lock<std::shared_mutex> tables_lock(tables_mutex_);
   if (weights_.empty()) {
     MS_LOG(EXCEPTION) << "The weights in server is empty. Many reasons could cause this: 1.The Worker didn't send "
                          "kInitWeightsCmd command. 2.The Server failed to initialize weights.";
   }
-  return grad_accum_count_ < weights_.size() && tokens_[key] <= 0;
+  if (ps_mode_ == kPSModeAsync) {
+    return true;
+  }
+  std::unique_lock<std::mutex> key_lock(key_locks_.Get(key));
+  if (ps_mode_ == kPSModeStaleSync) {
+    auto clocks_iter = worker_clocks_.find(key);
+    if (clocks_iter == worker_clocks_.end()) {
+      return true;
+    }
+    const std::vector<uint64_t> &clocks = clocks_iter->second;
+    EXC_IF_VEC_IDX_OOB(clocks, worker_rank);
+    return clocks[worker_rank] - *std::min_element(clocks.begin(), clocks.end()) <= staleness_threshold_;
+  }
+  auto token_iter = tokens_.find(key);
+  return grad_accum_count_ < weights_.size() && (token_iter == tokens_.end() || token_iter->second <= 0);
 }
 
 template <typename T>
 inline bool ParameterServer<T>::ReadyForPull(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (tokens_.count(key) == 0 || weights_[key] == 0) {
+  std::shared_lock<std::shared_mutex> tables_lock(tables_mutex_);
+  auto weight_iter = weights_.find(key);
+  if (tokens_.count(key) == 0 || weight_iter == weights_.end() || weight_iter->second == 0) {
     MS_LOG(EXCEPTION) << "Invalid weight key " << key;
   }
-  return tokens_[key] > 0;
+  // Pushes are applied before the pulls queued after them, so a worker always reads its own updates.
+  if (ps_mode_ != kPSModeSync) {
+    return true;
+  }
+  std::unique_lock<std::mutex> key_lock(key_locks_.Get(key));
+  return tokens_.at(key) > 0;
 }
 
 template <typename T>
 inline void ParameterServer<T>::ResetGradAccumCount() {
-  grad_accum_count_ = 0;
   for (auto iter = grads_accum_counter_.begin(); iter != grads_accum_counter_.end(); iter++) {
-    grads_accum_counter_[iter->first] = 0;
+    std::unique_lock<std::mutex> key_lock(key_locks_.Get(iter->first));
+    iter->second = 0;
   }
+  grad_accum_count_ = 0;
 }
 
 template <typename T>
-inline std::mutex &ParameterServer<T>::mutex() {
-  return mutex_;
+inline std::shared_mutex &ParameterServer<T>::mutex() {
+  return tables_mutex_;
 }
 
 template <typename T>
@@ -776,6 +977,7 @@ void ParameterServer<T>::Run(const FuncGraphPtr &func_graph) {
   Init(func_graph);
   PSContext::instance()->SetPSRankId(rank_id_);
   thread_->join();
+  executor_->Stop();
   MS_LOG(INFO) << "PServer finished updating models, starts finalizing...";
   ::ps::Finalize(0, true);
   MS_LOG(INFO) << "PServer finalized successfully.";
@@ -17,6 +17,7 @@
 #include "ps/ps_context.h"
 #include "utils/log_adapter.h"
 #include "utils/ms_utils.h"
+#include "utils/convert_utils_base.h"
 
 namespace mindspore {
 namespace ps {
@@ -57,6 +58,15 @@ void PSContext::Reset() {
   is_worker_ = false;
   is_pserver_ = false;
   is_sched_ = false;
+  ps_mode_ = kPSModeSync;
+  staleness_threshold_ = 1;
+  embedding_cache_size_ = 0;
+  embedding_cache_policy_ = kCachePolicyLRU;
+  embedding_cache_staleness_ = 1;
+  grad_compression_ = kGradCompressNone;
+  param_grad_compression_.clear();
+  grad_compression_min_size_ = kDefaultGradCompressionMinSize;
+  grad_compression_topk_ratio_ = kDefaultGradCompressionTopKRatio;
 }
 
 std::string PSContext::ms_role() const {
@@ -80,5 +90,132 @@ bool PSContext::is_role_sched() const { return is_sched_; }
 void PSContext::SetPSRankId(int rank_id) { rank_id_ = rank_id; }
 
 int PSContext::ps_rank_id() const { return rank_id_; }
+
+void PSContext::SetPSMode(const std::string &mode) {
+  if (mode == kPSModeNameSync) {
+    ps_mode_ = kPSModeSync;
+  } else if (mode == kPSModeNameAsync) {
+    ps_mode_ = kPSModeAsync;
+  } else if (mode == kPSModeNameStaleSync) {
+    ps_mode_ = kPSModeStaleSync;
+  } else {
+    MS_LOG(EXCEPTION) << "PS mode " << mode << " is invalid, it should be one of " << kPSModeNameSync << ", "
+                      << kPSModeNameAsync << " and " << kPSModeNameStaleSync << ".";
+  }
+}
+
+std::string PSContext::ps_mode_name() const {
+  if (ps_mode_ == kPSModeAsync) {
+    return kPSModeNameAsync;
+  } else if (ps_mode_ == kPSModeStaleSync) {
+    return kPSModeNameStaleSync;
+  } else {
+    return kPSModeNameSync;
+  }
+}
+
+PSMode PSContext::ps_mode() const { return ps_mode_; }
+
+void PSContext::SetStalenessThreshold(int threshold) {
+  if (threshold < 0) {
+    MS_LOG(EXCEPTION) << "Staleness threshold " << threshold << " is invalid, it should not be negative.";
+  }
+  staleness_threshold_ = threshold;
+}
+
+int PSContext::staleness_threshold() const { return staleness_threshold_; }
+
+void PSContext::SetEmbeddingCacheSize(int size) {
+  if (size < 0) {
+    MS_LOG(EXCEPTION) << "Embedding cache size " << size << " is invalid, it should not be negative.";
+  }
+  embedding_cache_size_ = size;
+}
+
+int PSContext::embedding_cache_size() const { return embedding_cache_size_; }
+
+void PSContext::SetEmbeddingCachePolicy(const std::string &policy) {
+  if (policy == kCachePolicyNameLRU) {
+    embedding_cache_policy_ = kCachePolicyLRU;
+  } else if (policy == kCachePolicyNameLFU) {
+    embedding_cache_policy_ = kCachePolicyLFU;
+  } else {
+    MS_LOG(EXCEPTION) << "Embedding cache policy " << policy << " is invalid, it should be " << kCachePolicyNameLRU
+                      << " or " << kCachePolicyNameLFU << ".";
+  }
+}
+
+std::string PSContext::embedding_cache_policy_name() const {
+  return embedding_cache_policy_ == kCachePolicyLFU ? kCachePolicyNameLFU : kCachePolicyNameLRU;
+}
+
+EmbeddingCachePolicy PSContext::embedding_cache_policy() const { return embedding_cache_policy_; }
+
+void PSContext::SetEmbeddingCacheStaleness(int staleness) {
+  if (staleness < 1) {
+    MS_LOG(EXCEPTION) << "Embedding cache staleness " << staleness << " is invalid, it should be at least 1.";
+  }
+  embedding_cache_staleness_ = staleness;
+}
+
+int PSContext::embedding_cache_staleness() const { return embedding_cache_staleness_; }
+
+namespace {
+GradCompressType GradCompressTypeOrThrow(const std::string &name) {
+  GradCompressType type = kGradCompressNone;
+  if (!GradCompressTypeOf(name, &type)) {
+    MS_LOG(EXCEPTION) << "Gradient compression " << name << " is invalid, it should be one of "
+                      << kGradCompressNameNone << ", " << kGradCompressNameFP16 << ", " << kGradCompressNameBF16
+                      << ", " << kGradCompressNameTopK << " and " << kGradCompressNameInt8 << ".";
+  }
+  return type;
+}
+}  // namespace
+
+void PSContext::SetGradCompression(const std::string &type) { grad_compression_ = GradCompressTypeOrThrow(type); }
+
+std::string PSContext::grad_compression_name() const { return GradCompressTypeName(grad_compression_); }
+
+void PSContext::SetParamGradCompression(const std::map<std::string, std::string> &param_types) {
+  std::map<std::string, GradCompressType> param_grad_compression;
+  for (const auto &param_type : param_types) {
+    param_grad_compression[param_type.first] = GradCompressTypeOrThrow(param_type.second);
+  }
+  param_grad_compression_ = param_grad_compression;
+}
+
+std::map<std::string, std::string> PSContext::param_grad_compression() const {
+  std::map<std::string, std::string> param_types;
+  for (const auto &param_type : param_grad_compression_) {
+    param_types[param_type.first] = GradCompressTypeName(param_type.second);
+  }
+  return param_types;
+}
+
+void PSContext::SetGradCompressionMinSize(int size) {
+  if (size < 0) {
+    MS_LOG(EXCEPTION) << "Gradient compression min size " << size << " is invalid, it should not be negative.";
+  }
+  grad_compression_min_size_ = size;
+}
+
+int PSContext::grad_compression_min_size() const { return grad_compression_min_size_; }
+
+void PSContext::SetGradCompressionTopKRatio(float ratio) {
+  if (ratio <= 0 || ratio > 1) {
+    MS_LOG(EXCEPTION) << "Gradient compression top-k ratio " << ratio << " is invalid, it should be in (0, 1].";
+  }
+  grad_compression_topk_ratio_ = ratio;
+}
+
+float PSContext::grad_compression_topk_ratio() const { return grad_compression_topk_ratio_; }
+
+GradCompressType PSContext::grad_compression(const std::string &param_name, size_t grad_size) const {
+  auto iter = param_grad_compression_.find(param_name);
+  if (iter != param_grad_compression_.end()) {
+    return iter->second;
+  }
+  return grad_size < IntToSize(grad_compression_min_size_) ? kGradCompressNone : grad_compression_;
+}
 }  // namespace ps
 }  // namespace mindspore
@@ -17,8 +17,11 @@
 #ifndef MINDSPORE_CCSRC_PS_CONTEXT_H_
 #define MINDSPORE_CCSRC_PS_CONTEXT_H_
 
+#include <map>
 #include <string>
 #include <memory>
+#include "ps/embedding_cache.h"
+#include "ps/gradient_compressor.h"
 
 namespace mindspore {
 namespace ps {
@@ -28,6 +31,20 @@ constexpr char kEnvRoleOfWorker[] = "MS_WORKER";
 constexpr char kEnvRoleOfScheduler[] = "MS_SCHED";
 constexpr char kEnvRoleOfNotPS[] = "MS_NOT_PS";
 
+constexpr char kPSModeNameSync[] = "sync";
+constexpr char kPSModeNameAsync[] = "async";
+constexpr char kPSModeNameStaleSync[] = "ssp";
+
+// How the servers apply the gradients pushed by the workers.
+// kPSModeSync: the gradients of all workers are averaged once per step, workers wait for the slowest one.
+// kPSModeAsync: every push is applied at once, workers never wait for each other.
+// kPSModeStaleSync: every push is applied at once, but a worker may run at most staleness_threshold steps ahead of
+// the slowest one.
+enum PSMode { kPSModeSync = 0, kPSModeAsync, kPSModeStaleSync };
+
+constexpr int kDefaultGradCompressionMinSize = 1024;
+constexpr float kDefaultGradCompressionTopKRatio = 0.01;
+
 class PSContext {
  public:
   ~PSContext() = default;
@@ -44,14 +61,60 @@ class PSContext {
   bool is_role_sched() const;
   void SetPSRankId(int rank_id);
   int ps_rank_id() const;
+  void SetPSMode(const std::string &mode);
+  std::string ps_mode_name() const;
+  PSMode ps_mode() const;
+  void SetStalenessThreshold(int threshold);
+  int staleness_threshold() const;
+  void SetEmbeddingCacheSize(int size);
+  int embedding_cache_size() const;
+  void SetEmbeddingCachePolicy(const std::string &policy);
+  std::string embedding_cache_policy_name() const;
+  EmbeddingCachePolicy embedding_cache_policy() const;
+  void SetEmbeddingCacheStaleness(int staleness);
+  int embedding_cache_staleness() const;
+  void SetGradCompression(const std::string &type);
+  std::string grad_compression_name() const;
+  void SetParamGradCompression(const std::map<std::string, std::string> &param_types);
+  std::map<std::string, std::string> param_grad_compression() const;
+  void SetGradCompressionMinSize(int size);
+  int grad_compression_min_size() const;
+  void SetGradCompressionTopKRatio(float ratio);
+  float grad_compression_topk_ratio() const;
+  // The compression of the gradient of a parameter with grad_size elements.
+  GradCompressType grad_compression(const std::string &param_name, size_t grad_size) const;
 
  private:
-  PSContext() : ps_enabled_(false), is_worker_(false), is_pserver_(false), is_sched_(false), rank_id_(-1) {}
+  PSContext()
+      : ps_enabled_(false),
+        is_worker_(false),
+        is_pserver_(false),
+        is_sched_(false),
+        rank_id_(-1),
+        ps_mode_(kPSModeSync),
+        staleness_threshold_(1),
+        embedding_cache_size_(0),
+        embedding_cache_policy_(kCachePolicyLRU),
+        embedding_cache_staleness_(1),
+        grad_compression_(kGradCompressNone),
+        grad_compression_min_size_(kDefaultGradCompressionMinSize),
+        grad_compression_topk_ratio_(kDefaultGradCompressionTopKRatio) {}
   bool ps_enabled_;
   bool is_worker_;
   bool is_pserver_;
   bool is_sched_;
   int rank_id_;
+  PSMode ps_mode_;
+  int staleness_threshold_;
+  // rows of every embedding table cached by a worker, 0 disables the cache
+  int embedding_cache_size_;
+  EmbeddingCachePolicy embedding_cache_policy_;
+  int embedding_cache_staleness_;
+  // applies to the gradients of at least grad_compression_min_size_ elements, unless the parameter has its own
+  GradCompressType grad_compression_;
+  std::map<std::string, GradCompressType> param_grad_compression_;
+  int grad_compression_min_size_;
+  float grad_compression_topk_ratio_;
 };
 }  // namespace ps
 }  // namespace mindspore
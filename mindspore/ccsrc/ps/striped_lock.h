@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_STRIPED_LOCK_H_
+#define MINDSPORE_CCSRC_PS_STRIPED_LOCK_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+constexpr size_t kDefaultLockStripeNum = 64;
+
+// A fixed set of mutexes shared by an unbounded set of ids, id i is guarded by stripe i % stripe_num. Ids which
+// share a stripe are serialized, ids on different stripes never contend.
+class StripedLock {
+ public:
+  explicit StripedLock(size_t stripe_num = kDefaultLockStripeNum) : mutexes_(std::max(stripe_num, size_t(1))) {}
+  ~StripedLock() = default;
+  StripedLock(const StripedLock &) = delete;
+  StripedLock &operator=(const StripedLock &) = delete;
+
+  size_t stripe_num() const { return mutexes_.size(); }
+
+  std::mutex &Get(uint64_t id) { return mutexes_[id % mutexes_.size()]; }
+
+  // Lock the stripes of all the given ids. The stripes are taken in ascending order, so callers locking
+  // overlapping sets of ids can not dead lock each other.
+  std::vector<std::unique_lock<std::mutex>> LockMany(const std::vector<uint64_t> &ids) {
+    std::vector<size_t> stripes;
+    stripes.reserve(ids.size());
+    for (auto id : ids) {
+      stripes.push_back(id % mutexes_.size());
+    }
+    std::sort(stripes.begin(), stripes.end());
+    stripes.erase(std::unique(stripes.begin(), stripes.end()), stripes.end());
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(stripes.size());
+    for (auto stripe : stripes) {
+      locks.emplace_back(mutexes_[stripe]);
+    }
+    return locks;
+  }
+
+  std::vector<std::unique_lock<std::mutex>> LockAll() {
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(mutexes_.size());
+    for (auto &mutex : mutexes_) {
+      locks.emplace_back(mutex);
+    }
+    return locks;
+  }
+
+ private:
+  std::vector<std::mutex> mutexes_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_STRIPED_LOCK_H_
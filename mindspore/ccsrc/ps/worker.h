@@ -30,6 +30,9 @@
 #include "ps/util.h"
 #include "ps/common.h"
 #include "ps/worker_proxy.h"
+#include "ps/ps_context.h"
+#include "ps/embedding_cache.h"
+#include "ps/gradient_compressor.h"
 #include "utils/shape_utils.h"
 
 namespace mindspore {
@@ -68,6 +71,13 @@ class Worker {
   void InitPSOptimId(const size_t param_key);
   void InitPSOptimInputShapes(const size_t key);
   void InitPSParamData(const std::vector<size_t> &keys, void *origin_addr, size_t size);
+  void SendPush(const std::vector<size_t> &keys, const std::vector<uintptr_t> &addrs, const ShapeVector &sizes,
+                bool is_sparse, int grad_index, int indice_index, bool compressed = false);
+  bool CompressGrad(size_t key, int optim_id, const std::vector<uintptr_t> &addrs, const ShapeVector &sizes,
+                    int *grad_index, std::vector<float> *compressed_grad);
+  void SaveWriteBackInputs(const std::vector<size_t> &keys, const std::vector<uintptr_t> &addrs,
+                           const ShapeVector &sizes, int grad_index, int indice_index);
+  void FlushEmbeddingCaches();
   static void EmbeddingLookupIdSlicer(const ::ps::KVPairs<T> &send, const std::vector<::ps::Range> &ranges,
                                       std::vector<std::pair<bool, ::ps::KVPairs<T>>> *sliced) {}
 
@@ -79,6 +89,22 @@ class Worker {
   std::map<size_t, int> key_to_optimId_;
   std::map<size_t, std::vector<ShapeVector>> key_to_optim_shapes_;
   std::map<std::string, bool> param_to_init_in_server_;
+
+  // The inputs of the last sparse push of a key whose gradients are written back by the embedding cache, except for
+  // the gradient and indices. The gradients left in the cache are pushed along with them when finalizing.
+  struct WriteBackInputs {
+    std::vector<size_t> keys;
+    std::vector<std::vector<T>> inputs;
+    ShapeVector sizes;
+    int grad_index;
+    int indice_index;
+  };
+  std::map<size_t, WriteBackInputs> write_back_inputs_;
+
+  // The index of the gradient among the push inputs of a key and its compressor, null if it is sent as it is.
+  std::map<size_t, std::pair<size_t, std::shared_ptr<GradientCompressor>>> grad_compressors_;
+  size_t grad_raw_bytes_{0};
+  size_t grad_compressed_bytes_{0};
 };
 
 template <typename T>
@@ -125,9 +151,84 @@ void Worker<T>::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> add
     indice_index = 1;
   }
 
+  ShapeVector push_sizes = sizes;
+  std::vector<int> flush_indices;
+  std::vector<float> flush_grads;
+  std::shared_ptr<EmbeddingCache> cache = is_sparse ? kv_worker_->embedding_cache(key) : nullptr;
+  if (cache != nullptr && cache->write_back()) {
+    // Sum the gradients up in the embedding cache and only push the rows which are due.
+    size_t indices_num = IntToSize(sizes[indice_index]);
+    if (IntToSize(sizes[grad_index]) != indices_num * cache->row_dim()) {
+      MS_LOG(EXCEPTION) << "The gradient size " << sizes[grad_index] << " of key " << key << " doesn't match "
+                        << indices_num << " indices of " << cache->row_dim() << " columns.";
+    }
+    cache->AccumulateGrad(reinterpret_cast<int *>(addrs[indice_index]), indices_num,
+                          reinterpret_cast<float *>(addrs[grad_index]));
+    SaveWriteBackInputs(keys, addrs, sizes, grad_index, indice_index);
+    cache->TakeDueGrads(false, &flush_indices, &flush_grads);
+    if (flush_indices.empty()) {
+      return;
+    }
+    addrs[grad_index] = reinterpret_cast<uintptr_t>(flush_grads.data());
+    addrs[indice_index] = reinterpret_cast<uintptr_t>(flush_indices.data());
+    push_sizes[grad_index] = SizeToInt(flush_grads.size());
+    push_sizes[indice_index] = SizeToInt(flush_indices.size());
+  }
+  std::vector<float> compressed_grad;
+  bool compressed = !is_sparse && CompressGrad(key, optim_id, addrs, sizes, &grad_index, &compressed_grad);
+  if (compressed) {
+    addrs[grad_index] = reinterpret_cast<uintptr_t>(compressed_grad.data());
+    push_sizes[grad_index] = SizeToInt(compressed_grad.size());
+  }
+  SendPush(keys, addrs, push_sizes, is_sparse, grad_index, indice_index, compressed);
+}
+
+template <typename T>
+bool Worker<T>::CompressGrad(size_t key, int optim_id, const std::vector<uintptr_t> &addrs, const ShapeVector &sizes,
+                             int *grad_index, std::vector<float> *compressed_grad) {
+  MS_EXCEPTION_IF_NULL(grad_index);
+  MS_EXCEPTION_IF_NULL(compressed_grad);
+  auto iter = grad_compressors_.find(key);
+  if (iter == grad_compressors_.end()) {
+    size_t index = kOptimToPSSendIdx.at(Util::optimizer_name(optim_id)).at("grad");
+    EXC_IF_VEC_IDX_OOB(sizes, index);
+    std::string param_name;
+    for (const auto &param_key : param_to_key_) {
+      if (param_key.second == key) {
+        param_name = param_key.first;
+      }
+    }
+    auto ps_context = PSContext::instance();
+    GradCompressType type = ps_context->grad_compression(param_name, IntToSize(sizes[index]));
+    auto compressor = GradientCompressor::Create(type, ps_context->grad_compression_topk_ratio());
+    if (compressor != nullptr) {
+      MS_LOG(INFO) << "The gradients of parameter " << param_name << " are compressed by "
+                   << GradCompressTypeName(type);
+    }
+    iter = grad_compressors_.emplace(key, std::make_pair(index, compressor)).first;
+  }
+  size_t index = iter->second.first;
+  std::shared_ptr<GradientCompressor> &compressor = iter->second.second;
+  if (compressor == nullptr) {
+    return false;
+  }
+  size_t grad_size = IntToSize(sizes[index]);
+  compressor->Compress(reinterpret_cast<float *>(addrs[index]), grad_size, compressed_grad);
+  grad_raw_bytes_ += grad_size * sizeof(float);
+  grad_compressed_bytes_ += compressed_grad->size() * sizeof(float);
+  *grad_index = SizeToInt(index);
+  return true;
+}
+
+template <typename T>
+void Worker<T>::SendPush(const std::vector<size_t> &keys, const std::vector<uintptr_t> &addrs,
+                         const ShapeVector &sizes, bool is_sparse, int grad_index, int indice_index,
+                         bool compressed) {
+  Key key = keys[0];
+  size_t lead_size = compressed ? kCompressedPushLeadSize : 0;
   size_t total_size = std::accumulate(sizes.begin(), sizes.end(), 0, std::plus<int>());
-  ::ps::SArray<T> total_buffer(total_size, 0);
-  size_t offset = 0;
+  ::ps::SArray<T> total_buffer(lead_size + total_size, 0);
+  size_t offset = lead_size * sizeof(T);
   size_t dst_size = 0;
   size_t src_size = 0;
   for (size_t i = 0; i < sizes.size(); i++) {
@@ -145,11 +246,18 @@ void Worker<T>::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> add
     offset += sizes[i] * sizeof(T);
   }
 
-  while (!kv_worker_->IsReadyForPush(keys[0])) {
+  // In async mode the servers never hold a push back, skip the round trips of asking.
+  while (PSContext::instance()->ps_mode() != kPSModeAsync && !kv_worker_->IsReadyForPush(keys[0])) {
     continue;
   }
   if (!is_sparse) {
-    kv_worker_->PushData(::ps::SArray<::ps::Key>(keys), total_buffer, ::ps::SArray<int>(sizes));
+    ::ps::SArray<int> lens(sizes);
+    if (compressed) {
+      // The servers learn from the leading word which input is compressed.
+      GradientCompressor::WritePushLead(IntToSize(grad_index), reinterpret_cast<float *>(total_buffer.data()));
+      lens[0] += SizeToInt(lead_size);
+    }
+    kv_worker_->PushData(::ps::SArray<::ps::Key>(keys), total_buffer, lens, compressed ? kCompressedPushCmd : 0);
   } else {
     std::vector<int> &var_shape = key_to_optim_shapes_[key][0];
     int first_dim_size = var_shape[0];
@@ -163,7 +271,7 @@ template <typename T>
 void Worker<T>::Pull(const size_t key, void *dev_addr, const size_t size) {
   MS_EXCEPTION_IF_NULL(dev_addr);
   ::ps::SArray<T> variables(size / sizeof(T), 0);
-  while (!kv_worker_->IsReadyForPull(key)) {
+  while (PSContext::instance()->ps_mode() == kPSModeSync && !kv_worker_->IsReadyForPull(key)) {
     continue;
   }
   kv_worker_->PullData({key}, &variables);
@@ -187,6 +295,11 @@ template <typename T>
 void Worker<T>::Finalize() {
   if (running_) {
     MS_LOG(INFO) << "Worker starts finalizing...";
+    FlushEmbeddingCaches();
+    if (grad_raw_bytes_ > 0) {
+      MS_LOG(INFO) << "Gradient compression pushed " << grad_compressed_bytes_ << " bytes of gradients instead of "
+                   << grad_raw_bytes_ << " bytes.";
+    }
     kv_worker_->Finalize();
     kv_worker_.reset();
     running_ = false;
@@ -194,6 +307,52 @@ void Worker<T>::Finalize() {
   }
 }
 
+template <typename T>
+void Worker<T>::SaveWriteBackInputs(const std::vector<size_t> &keys, const std::vector<uintptr_t> &addrs,
+                                    const ShapeVector &sizes, int grad_index, int indice_index) {
+  WriteBackInputs &saved = write_back_inputs_[keys[0]];
+  saved.keys = keys;
+  saved.sizes = sizes;
+  saved.grad_index = grad_index;
+  saved.indice_index = indice_index;
+  saved.inputs.resize(sizes.size());
+  for (size_t i = 0; i < sizes.size(); i++) {
+    if (SizeToInt(i) == grad_index || SizeToInt(i) == indice_index) {
+      continue;
+    }
+    const T *input = reinterpret_cast<const T *>(addrs[i]);
+    saved.inputs[i].assign(input, input + sizes[i]);
+  }
+}
+
+template <typename T>
+void Worker<T>::FlushEmbeddingCaches() {
+  for (auto &saved_iter : write_back_inputs_) {
+    std::shared_ptr<EmbeddingCache> cache = kv_worker_->embedding_cache(saved_iter.first);
+    MS_EXCEPTION_IF_NULL(cache);
+    std::vector<int> flush_indices;
+    std::vector<float> flush_grads;
+    cache->TakeDueGrads(true, &flush_indices, &flush_grads);
+    if (flush_indices.empty()) {
+      continue;
+    }
+    WriteBackInputs &saved = saved_iter.second;
+    std::vector<uintptr_t> addrs;
+    for (auto &input : saved.inputs) {
+      addrs.push_back(reinterpret_cast<uintptr_t>(input.data()));
+    }
+    ShapeVector sizes = saved.sizes;
+    addrs[saved.grad_index] = reinterpret_cast<uintptr_t>(flush_grads.data());
+    addrs[saved.indice_index] = reinterpret_cast<uintptr_t>(flush_indices.data());
+    sizes[saved.grad_index] = SizeToInt(flush_grads.size());
+    sizes[saved.indice_index] = SizeToInt(flush_indices.size());
+    SendPush(saved.keys, addrs, sizes, true, saved.grad_index, saved.indice_index);
+  }
+  for (auto &cache_iter : kv_worker_->embedding_caches()) {
+    MS_LOG(INFO) << "Embedding cache of key " << cache_iter.first << ": " << cache_iter.second->StatsString();
+  }
+}
+
 template <typename T>
 void Worker<T>::InitPSParamData(const std::vector<size_t> &keys, void *origin_addr, size_t size) {
   MS_EXCEPTION_IF_NULL(origin_addr);
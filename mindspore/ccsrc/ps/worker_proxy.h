@@ -30,6 +30,7 @@
 #include "ps/util.h"
 #include "backend/kernel_compiler/common_utils.h"
 #include "ps/ps_context.h"
+#include "ps/embedding_cache.h"
 
 namespace mindspore {
 namespace ps {
@@ -72,6 +73,9 @@ class WorkerProxy : public ::ps::KVWorker<T> {
                          const ::ps::SArray<int> &lens = {}, const Callback &cb = nullptr, int priority = 0);
   bool IsReadyForPush(const Key &key);
   bool IsReadyForPull(const Key &key);
+  // Slice the keys of send, with their values and lengths, to the servers of the keys.
+  static void SliceByServer(const ::ps::KVPairs<T> &send, const std::unordered_map<::ps::Key, int> &key_to_server_id,
+                            SlicedKVs *sliced);
   void PushData(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<T> &vals, const ::ps::SArray<int> &lens = {},
                 int cmd = 0, int priority = 0);
   void PushSparseData(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<T> &vals, const ::ps::SArray<int> &lens,
@@ -79,8 +83,16 @@ class WorkerProxy : public ::ps::KVWorker<T> {
   void PullData(const ::ps::SArray<::ps::Key> &keys, ::ps::SArray<T> *vals, ::ps::SArray<int> *lens = nullptr,
                 int cmd = 0, int priority = 0);
   void Finalize();
+  std::shared_ptr<EmbeddingCache> embedding_cache(const ::ps::Key &key);
+  const std::unordered_map<::ps::Key, std::shared_ptr<EmbeddingCache>> &embedding_caches() const {
+    return embedding_caches_;
+  }
 
  private:
+  void SendEmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
+                           ::ps::SArray<T> *outs, int cmd, const Callback &cb, int priority);
+  void CachedEmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
+                             ::ps::SArray<T> *outs, int cmd, int priority);
   template <typename C>
   int AddLookupCB(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids, C *vals, int cmd,
                   const Callback &cb);
@@ -126,6 +138,7 @@ class WorkerProxy : public ::ps::KVWorker<T> {
   std::unordered_map<int, int> expected_result_count_;
   std::unordered_map<::ps::Key, int> key_to_server_id_;
   std::unordered_map<::ps::Key, size_t> embedding_row_cnt_;
+  std::unordered_map<::ps::Key, std::shared_ptr<EmbeddingCache>> embedding_caches_;
 };
 
 template <typename T>
@@ -169,6 +182,19 @@ void WorkerProxy<T>::EmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const
                                      const ::ps::SArray<int> &lens, ::ps::SArray<T> *outs, int cmd, const Callback &cb,
                                      int priority) {
   MS_EXCEPTION_IF_NULL(outs);
+  if (PSContext::instance()->embedding_cache_size() > 0 && !lookup_ids.empty()) {
+    CachedEmbeddingLookup(keys, lookup_ids, outs, cmd, priority);
+    if (cb) {
+      cb();
+    }
+    return;
+  }
+  SendEmbeddingLookup(keys, lookup_ids, outs, cmd, cb, priority);
+}
+
+template <typename T>
+void WorkerProxy<T>::SendEmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
+                                         ::ps::SArray<T> *outs, int cmd, const Callback &cb, int priority) {
   int ts = AddLookupCB(keys, lookup_ids, outs, cmd, cb);
   ::ps::KVPairs<T> kvs;
   kvs.keys = keys;
@@ -182,6 +208,41 @@ void WorkerProxy<T>::EmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const
   expected_result_count_.erase(ts);
 }
 
+// Serve the ids from the embedding cache of the table and only fetch the rows which missed.
+template <typename T>
+void WorkerProxy<T>::CachedEmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
+                                           ::ps::SArray<T> *outs, int cmd, int priority) {
+  const ::ps::Key &key = keys[0];
+  size_t row_dim = outs->size() / lookup_ids.size();
+  std::shared_ptr<EmbeddingCache> &cache = embedding_caches_[key];
+  if (cache == nullptr) {
+    auto context = PSContext::instance();
+    // Summing up gradients on the worker delays them, which only async mode allows.
+    bool write_back = context->ps_mode() == kPSModeAsync;
+    cache = std::make_shared<EmbeddingCache>(IntToSize(context->embedding_cache_size()), row_dim,
+                                             context->embedding_cache_policy(),
+                                             IntToSize(context->embedding_cache_staleness()), write_back);
+    MS_LOG(INFO) << "Create embedding cache for key " << key << ", rows " << context->embedding_cache_size()
+                 << ", policy " << context->embedding_cache_policy_name() << ", staleness "
+                 << context->embedding_cache_staleness() << ", write back " << write_back;
+  }
+  std::vector<int> missed = cache->Lookup(lookup_ids.data(), lookup_ids.size(), outs->data());
+  if (missed.empty()) {
+    return;
+  }
+  ::ps::SArray<int> missed_ids(missed.size(), 0);
+  std::copy(missed.begin(), missed.end(), missed_ids.begin());
+  ::ps::SArray<T> missed_rows(missed.size() * row_dim, 0);
+  SendEmbeddingLookup(keys, missed_ids, &missed_rows, cmd, nullptr, priority);
+  cache->Fill(lookup_ids.data(), lookup_ids.size(), missed, missed_rows.data(), outs->data());
+}
+
+template <typename T>
+std::shared_ptr<EmbeddingCache> WorkerProxy<T>::embedding_cache(const ::ps::Key &key) {
+  auto iter = embedding_caches_.find(key);
+  return iter == embedding_caches_.end() ? nullptr : iter->second;
+}
+
 template <typename T>
 int WorkerProxy<T>::InitEmbeddingTable(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<T> &vals,
                                        const ::ps::SArray<int> &lens, const Callback &cb, int priority) {
@@ -658,6 +719,18 @@ void WorkerProxy<T>::RoundRobinSlicer(int timestamp, const ::ps::KVPairs<T> &sen
                                       const std::map<int, int> &attr) {
   MS_EXCEPTION_IF_NULL(sliced);
   sliced->resize(server_num_);
+  SliceByServer(send, key_to_server_id_, sliced);
+  for (auto &server_kv_pairs : *sliced) {
+    if (server_kv_pairs.first) {
+      expected_result_count_[timestamp] += 1;
+    }
+  }
+}
+
+template <typename T>
+void WorkerProxy<T>::SliceByServer(const ::ps::KVPairs<T> &send,
+                                   const std::unordered_map<::ps::Key, int> &key_to_server_id, SlicedKVs *sliced) {
+  MS_EXCEPTION_IF_NULL(sliced);
   auto keys = send.keys;
   auto vals = send.vals;
   auto lens = send.lens;
@@ -666,11 +739,13 @@ void WorkerProxy<T>::RoundRobinSlicer(int timestamp, const ::ps::KVPairs<T> &sen
   ::ps::Key param_key;
   for (size_t i = 0; i < keys.size(); i++) {
     param_key = keys[i];
-    server_id = key_to_server_id_[param_key];
-    if (!sliced->at(server_id).first) {
-      sliced->at(server_id).first = true;
-      expected_result_count_[timestamp] += 1;
+    auto server_iter = key_to_server_id.find(param_key);
+    if (server_iter == key_to_server_id.end() || server_iter->second < 0 ||
+        static_cast<size_t>(server_iter->second) >= sliced->size()) {
+      MS_LOG(EXCEPTION) << "The server of key " << param_key << " is unknown.";
     }
+    server_id = server_iter->second;
+    sliced->at(server_id).first = true;
 
     ::ps::KVPairs<T> &server_kv_pairs = sliced->at(server_id).second;
     server_kv_pairs.keys.push_back(param_key);
@@ -257,11 +257,15 @@ py::tuple TensorPy::GetPyTupleShape(const Tensor &tensor) {
   return dims;
 }
 
-py::array TensorPy::SyncAsNumpy(const Tensor &tensor) {
+void TensorPy::WaitData(const Tensor &tensor) {
   if (tensor.NeedWait()) {
     py::gil_scoped_release gil_release;
     tensor.Wait();
   }
+}
+
+py::array TensorPy::SyncAsNumpy(const Tensor &tensor) {
+  WaitData(tensor);
   tensor.data_sync();
   return AsNumpy(tensor);
 }
@@ -460,8 +464,16 @@ REGISTER_PYBIND_DEFINE(Tensor, ([](const py::module *m) {
                                   mindspore.int32
                               )mydelimiter")
                            .def("set_cast_dtype", &Tensor::set_cast_dtype, py::arg("dtype") = nullptr)
-                           .def("__str__", &Tensor::ToString)
-                           .def("__repr__", &Tensor::ToStringRepr)
+                           .def("__str__",
+                                [](const Tensor &tensor) {
+                                  TensorPy::WaitData(tensor);
+                                  return tensor.ToString();
+                                })
+                           .def("__repr__",
+                                [](const Tensor &tensor) {
+                                  TensorPy::WaitData(tensor);
+                                  return tensor.ToStringRepr();
+                                })
                            .def(py::pickle(
                              [](const Tensor &t) {  // __getstate__
                                /* Return a tuple that fully encodes the state of the object */
@@ -104,6 +104,9 @@ class TensorPy {
   // param input [py::array] Data value of the tensor.
   static TensorPtr MakeTensorNoCopy(const py::array &input);
 
+  // Wait until the op producing the tensor has run, with the GIL released.
+  static void WaitData(const Tensor &tensor);
+
   static py::array SyncAsNumpy(const Tensor &tensor);
 
   static py::array AsNumpy(const Tensor &tensor);
@@ -76,16 +76,19 @@ REGISTER_PYBIND_DEFINE(MsContextPy, ([](const py::module *m) {
                          (void)py::enum_<MsCtxParam>(*m, "ms_ctx_param", py::arithmetic())
                            .value("enable_auto_mixed_precision", MsCtxParam::MS_CTX_ENABLE_AUTO_MIXED_PRECISION)
                            .value("check_bprop", MsCtxParam::MS_CTX_CHECK_BPROP_FLAG)
+                           .value("enable_cpu_parallel_execute", MsCtxParam::MS_CTX_ENABLE_CPU_PARALLEL_EXECUTE)
                            .value("enable_dump", MsCtxParam::MS_CTX_ENABLE_DUMP)
                            .value("enable_graph_kernel", MsCtxParam::MS_CTX_ENABLE_GRAPH_KERNEL)
                            .value("enable_reduce_precision", MsCtxParam::MS_CTX_ENABLE_REDUCE_PRECISION)
                            .value("enable_sparse", MsCtxParam::MS_CTX_ENABLE_SPARSE)
+                           .value("enable_pynative_async", MsCtxParam::MS_CTX_ENABLE_PYNATIVE_ASYNC)
                            .value("precompile_only", MsCtxParam::MS_CTX_PRECOMPILE_ONLY)
                            .value("enable_profiling", MsCtxParam::MS_CTX_ENABLE_PROFILING)
                            .value("save_graphs", MsCtxParam::MS_CTX_SAVE_GRAPHS_FLAG)
                            .value("max_device_memory", MsCtxParam::MS_CTX_MAX_DEVICE_MEMORY)
                            .value("mode", MsCtxParam::MS_CTX_EXECUTION_MODE)
                            .value("device_target", MsCtxParam::MS_CTX_DEVICE_TARGET)
+                           .value("compile_cache_path", MsCtxParam::MS_CTX_COMPILE_CACHE_PATH)
                            .value("_graph_memory_max_size", MsCtxParam::MS_CTX_GRAPH_MEMORY_MAX_SIZE)
                            .value("print_file_path", MsCtxParam::MS_CTX_PRINT_FILE_PATH)
                            .value("profiling_options", MsCtxParam::MS_CTX_PROFILING_OPTIONS)
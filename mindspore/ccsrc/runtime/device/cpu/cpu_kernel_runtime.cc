@@ -20,6 +20,8 @@
 #include <numeric>
 #include <utility>
 #include <functional>
+#include <algorithm>
+#include <unordered_map>
 #include "backend/kernel_compiler/kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "utils/ms_context.h"
@@ -28,16 +30,74 @@
 #include "frontend/operator/ops.h"
 #include "utils/shape_utils.h"
 #include "utils/profile.h"
+#include "common/thread_pool.h"
+#include "backend/optimizer/common/helper.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 const size_t INIT_NODE_REF = 1;
+namespace {
+// Kernels talking to the parameter server keep their original order when the graph is launched in parallel.
+const std::set<std::string> kOrderedKernelSet = {kPushOpName, kPullOpName, kEmbeddingLookupProxyOpName};
+
+// Collect the kernels reaching node through the virtual nodes, Depend forwards its first input only but the kernels
+// producing its attached input must finish first as well.
+void CollectInputKernels(const AnfNodePtr &node, const std::unordered_map<AnfNode *, size_t> &kernel_index,
+                         std::set<size_t> *result, std::set<AnfNodePtr> *visited) {
+  MS_EXCEPTION_IF_NULL(node);
+  MS_EXCEPTION_IF_NULL(result);
+  MS_EXCEPTION_IF_NULL(visited);
+  if (!node->isa<CNode>() || !visited->insert(node).second) {
+    return;
+  }
+  auto iter = kernel_index.find(node.get());
+  if (iter != kernel_index.end()) {
+    (void)result->insert(iter->second);
+    return;
+  }
+  if (AnfAlgo::CheckPrimitiveType(node, prim::kPrimControlDepend) ||
+      (AnfAlgo::IsRealKernel(node) && !opt::IsNopNode(node))) {
+    return;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+    CollectInputKernels(cnode->input(i), kernel_index, result, visited);
+  }
+}
+
+std::set<size_t> GetControlDependKernels(const AnfNodePtr &node, int depend_mode,
+                                         const std::unordered_map<AnfNode *, size_t> &kernel_index,
+                                         const std::unordered_map<AnfNode *, std::set<size_t>> &parameter_users) {
+  MS_EXCEPTION_IF_NULL(node);
+  std::set<size_t> kernels;
+  if (node->isa<Parameter>()) {
+    // With depend_mode 1 a parameter stands for all the kernels using it, otherwise it adds no relation.
+    auto iter = parameter_users.find(node.get());
+    if (depend_mode == 1 && iter != parameter_users.end()) {
+      kernels = iter->second;
+    }
+    return kernels;
+  }
+  std::set<AnfNodePtr> visited;
+  CollectInputKernels(node, kernel_index, &kernels, &visited);
+  return kernels;
+}
+}  // namespace
+
 void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
   AssignValueNodeAddress(kernel_graph);
   AssignInputNodeAddress(kernel_graph);
   AssignKernelOutputAddress(kernel_graph);
   resource_manager_.AssignMemory(kernel_graph);
+  auto graph_id = kernel_graph->graph_id();
+  (void)graph_launch_info_.erase(graph_id);
+  if (resource_manager_.mem_reuse()) {
+    (void)mem_reuse_graphs_.insert(graph_id);
+  } else {
+    (void)mem_reuse_graphs_.erase(graph_id);
+  }
 }
 
 void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph) {
@@ -325,7 +385,226 @@ void CPUKernelRuntime::DecreaseSummaryRefCount(const session::NamedSummaryOutput
   resource_manager_.DecreaseSummaryRefCount(summary_outputs);
 }
 
-bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink) {
+void CPUKernelRuntime::BindLaunchAddress(const DeviceAddressPtr &address, GraphLaunchInfo *launch_info,
+                                         std::vector<kernel::AddressPtr> *address_list) {
+  MS_EXCEPTION_IF_NULL(address);
+  MS_EXCEPTION_IF_NULL(launch_info);
+  MS_EXCEPTION_IF_NULL(address_list);
+  auto launch_address = std::make_shared<kernel::Address>();
+  launch_info->launch_addresses_.emplace_back(address, launch_address);
+  address_list->push_back(launch_address);
+}
+
+void CPUKernelRuntime::BuildLaunchInfo(const session::KernelGraph *kernel_graph, GraphLaunchInfo *launch_info) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  MS_EXCEPTION_IF_NULL(launch_info);
+  launch_info->execution_order_ = kernel_graph->execution_order();
+  launch_info->kernels_.clear();
+  launch_info->launch_addresses_.clear();
+  for (const auto &kernel : launch_info->execution_order_) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    KernelLaunchInfo kernel_info;
+    kernel_info.kernel_ = kernel;
+    kernel_info.kernel_mod_ = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_info.kernel_mod_);
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      BindLaunchAddress(AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i), launch_info, &kernel_info.inputs_);
+    }
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      BindLaunchAddress(AnfAlgo::GetMutableOutputAddr(kernel, i), launch_info, &kernel_info.outputs_);
+    }
+    for (size_t i = 0; i < kernel_info.kernel_mod_->GetWorkspaceSizeList().size(); ++i) {
+      BindLaunchAddress(AnfAlgo::GetMutableWorkspaceAddr(kernel, i), launch_info, &kernel_info.workspaces_);
+    }
+    launch_info->kernels_.emplace_back(std::move(kernel_info));
+  }
+  BuildKernelDependency(kernel_graph, launch_info);
+}
+
+void CPUKernelRuntime::BuildKernelDependency(const session::KernelGraph *kernel_graph, GraphLaunchInfo *launch_info) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  MS_EXCEPTION_IF_NULL(launch_info);
+  auto &kernels = launch_info->kernels_;
+  std::unordered_map<AnfNode *, size_t> kernel_index;
+  std::unordered_map<AnfNode *, std::set<size_t>> parameter_users;
+  // Kernels may update the weights in place, the kernels using the same weight run in execution order.
+  std::unordered_map<AnfNode *, size_t> last_weight_user;
+  size_t last_ordered_kernel = kernels.size();
+  std::vector<std::set<size_t>> kernel_predecessors(kernels.size());
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    auto &kernel = kernels[i].kernel_;
+    auto &predecessors = kernel_predecessors[i];
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t j = 0; j < input_num; ++j) {
+      auto input_node = AnfAlgo::GetPrevNodeOutput(kernel, j).first;
+      while (input_node->isa<CNode>() && kernel_index.count(input_node.get()) == 0 && opt::IsNopNode(input_node)) {
+        input_node = AnfAlgo::GetPrevNodeOutput(input_node, 0).first;
+      }
+      if (input_node->isa<Parameter>()) {
+        (void)parameter_users[input_node.get()].insert(i);
+        if (!AnfAlgo::IsParameterWeight(input_node->cast<ParameterPtr>())) {
+          continue;
+        }
+        auto iter = last_weight_user.find(input_node.get());
+        if (iter != last_weight_user.end() && iter->second != i) {
+          (void)predecessors.insert(iter->second);
+        }
+        last_weight_user[input_node.get()] = i;
+        continue;
+      }
+      auto iter = kernel_index.find(input_node.get());
+      if (iter != kernel_index.end()) {
+        (void)predecessors.insert(iter->second);
+      }
+    }
+    std::set<AnfNodePtr> visited;
+    for (size_t j = 1; j < kernel->inputs().size(); ++j) {
+      CollectInputKernels(kernel->input(j), kernel_index, &predecessors, &visited);
+    }
+    if (kOrderedKernelSet.count(AnfAlgo::GetCNodeName(kernel)) != 0) {
+      if (last_ordered_kernel < kernels.size()) {
+        (void)predecessors.insert(last_ordered_kernel);
+      }
+      last_ordered_kernel = i;
+    }
+    kernel_index[kernel.get()] = i;
+  }
+
+  // ControlDepend orders kernels without any data flowing between them. The execution order already respects it, so
+  // only the edges pointing forward in the order are kept and the graph stays acyclic.
+  for (const auto &node : TopoSort(kernel_graph->get_return())) {
+    if (!AnfAlgo::CheckPrimitiveType(node, prim::kPrimControlDepend)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    int depend_mode = 0;
+    if (AnfAlgo::HasNodeAttr(kControlDependMode, cnode)) {
+      depend_mode = AnfAlgo::GetNodeAttr<int>(cnode, kControlDependMode);
+    }
+    auto prior_kernels =
+      GetControlDependKernels(cnode->input(kControlDependPriorIndex), depend_mode, kernel_index, parameter_users);
+    auto behind_kernels =
+      GetControlDependKernels(cnode->input(kControlDependBehindIndex), depend_mode, kernel_index, parameter_users);
+    for (auto behind : behind_kernels) {
+      for (auto prior : prior_kernels) {
+        if (prior < behind) {
+          (void)kernel_predecessors[behind].insert(prior);
+        }
+      }
+    }
+  }
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    kernels[i].predecessors_.assign(kernel_predecessors[i].begin(), kernel_predecessors[i].end());
+  }
+
+  launch_info->successors_.assign(kernels.size(), {});
+  launch_info->dependency_num_.assign(kernels.size(), 0);
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    launch_info->dependency_num_[i] = kernels[i].predecessors_.size();
+    for (auto predecessor : kernels[i].predecessors_) {
+      launch_info->successors_[predecessor].push_back(i);
+    }
+  }
+}
+
+CPUKernelRuntime::GraphLaunchInfo *CPUKernelRuntime::GetGraphLaunchInfo(const session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto &launch_info = graph_launch_info_[kernel_graph->graph_id()];
+  if (launch_info.kernels_.empty() || launch_info.execution_order_ != kernel_graph->execution_order()) {
+    BuildLaunchInfo(kernel_graph, &launch_info);
+  }
+  return &launch_info;
+}
+
+void CPUKernelRuntime::UpdateLaunchAddress(GraphLaunchInfo *launch_info) {
+  MS_EXCEPTION_IF_NULL(launch_info);
+  for (auto &item : launch_info->launch_addresses_) {
+    auto &device_address = item.first;
+    if (device_address->ptr_ == nullptr) {
+      device_address->ptr_ = resource_manager_.MemMalloc(device_address->size_);
+    }
+    MS_EXCEPTION_IF_NULL(device_address->ptr_);
+    item.second->addr = device_address->ptr_;
+    item.second->size = device_address->size_;
+  }
+}
+
+bool CPUKernelRuntime::SerialRun(const GraphLaunchInfo &launch_info) {
+  for (const auto &kernel_info : launch_info.kernels_) {
+#ifdef ENABLE_PROFILE
+    double start_time = GetTime();
+#endif
+    auto ret = kernel_info.kernel_mod_->Launch(kernel_info.inputs_, kernel_info.workspaces_, kernel_info.outputs_, 0);
+    if (!ret) {
+      MS_LOG(EXCEPTION) << "Launch kernel failed.";
+    }
+#ifdef ENABLE_PROFILE
+    double cost_time = GetTime() - start_time;
+    MS_LOG(INFO) << "cpu kernel: " << kernel_info.kernel_->fullname_with_scope() << "  costs " << cost_time * 1e6
+                 << " us";
+#endif
+  }
+  return true;
+}
+
+bool CPUKernelRuntime::ParallelRun(const GraphLaunchInfo &launch_info) {
+  auto &kernels = launch_info.kernels_;
+  std::vector<double> kernel_times(kernels.size(), 0);
+  std::vector<Task> tasks;
+  tasks.reserve(kernels.size());
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    tasks.emplace_back([&kernels, &kernel_times, i]() {
+      auto &kernel_info = kernels[i];
+      double start_time = GetTime();
+      auto ret = kernel_info.kernel_mod_->Launch(kernel_info.inputs_, kernel_info.workspaces_, kernel_info.outputs_, 0);
+      kernel_times[i] = (GetTime() - start_time) * 1e6;
+      if (!ret) {
+        MS_LOG(ERROR) << "Launch kernel " << kernel_info.kernel_->fullname_with_scope() << " failed.";
+        return FAIL;
+      }
+      return SUCCESS;
+    });
+  }
+  double start_time = GetTime();
+  auto ret = ThreadPool::GetInstance()->LaunchTaskGraph(tasks, launch_info.successors_, launch_info.dependency_num_);
+  double step_time = (GetTime() - start_time) * 1e6;
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed.";
+  }
+  UpdateParallelExecuteStats(launch_info, kernel_times, step_time);
+  return true;
+}
+
+void CPUKernelRuntime::UpdateParallelExecuteStats(const GraphLaunchInfo &launch_info,
+                                                  const std::vector<double> &kernel_times, double step_time) {
+  auto &kernels = launch_info.kernels_;
+  // The kernels are in a topological order, so the predecessors are always finished before.
+  std::vector<double> finish_times(kernels.size(), 0);
+  double critical_path_time = 0;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    double start_time = 0;
+    for (auto predecessor : kernels[i].predecessors_) {
+      start_time = std::max(start_time, finish_times[predecessor]);
+    }
+    finish_times[i] = start_time + kernel_times[i];
+    critical_path_time = std::max(critical_path_time, finish_times[i]);
+  }
+  auto &stats = parallel_execute_stats_;
+  stats.kernel_num_ = kernels.size();
+  stats.thread_num_ = ThreadPool::GetInstance()->GetThreadNum();
+  stats.step_time_ = step_time;
+  stats.kernel_time_ = std::accumulate(kernel_times.begin(), kernel_times.end(), 0.0);
+  stats.critical_path_time_ = critical_path_time;
+  stats.utilization_ = step_time > 0 ? stats.kernel_time_ / (step_time * stats.thread_num_) : 0;
+  MS_LOG(DEBUG) << "Parallel execute " << stats.kernel_num_ << " kernels on " << stats.thread_num_
+               << " threads, step time " << stats.step_time_ << " us, kernel time " << stats.kernel_time_
+               << " us, critical path " << stats.critical_path_time_ << " us, utilization " << stats.utilization_;
+}
+
+bool CPUKernelRuntime::RunWithDynamicMalloc(const session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   resource_manager_.IncreaseAddressRefCount(kernel_graph);
 
@@ -368,6 +647,30 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink
   }
   return true;
 }
+
+bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  // The device memory is freed and allocated while running, the launch addresses can not be bound in advance.
+  if (resource_manager_.dynamic_malloc()) {
+    return RunWithDynamicMalloc(kernel_graph);
+  }
+  auto launch_info = GetGraphLaunchInfo(kernel_graph);
+  MS_EXCEPTION_IF_NULL(launch_info);
+  UpdateLaunchAddress(launch_info);
+
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  bool parallel_execute = context_ptr->get_param<bool>(MS_CTX_ENABLE_CPU_PARALLEL_EXECUTE);
+  if (parallel_execute && mem_reuse_graphs_.count(kernel_graph->graph_id()) != 0) {
+    MS_LOG(WARNING) << "Graph " << kernel_graph->graph_id()
+                    << " was compiled with memory reuse, its kernels are launched serially.";
+    parallel_execute = false;
+  }
+  if (parallel_execute && launch_info->kernels_.size() > 1 && ThreadPool::GetInstance()->GetThreadNum() > 1) {
+    return ParallelRun(*launch_info);
+  }
+  return SerialRun(*launch_info);
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
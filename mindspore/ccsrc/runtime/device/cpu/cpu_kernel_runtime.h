@@ -21,6 +21,8 @@
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <utility>
 #include "runtime/device/kernel_runtime.h"
 #include "backend/session/kernel_graph.h"
 #include "backend/session/session_basic.h"
@@ -30,6 +32,16 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+// Statistics of the last step run by the parallel executor, times are in microseconds.
+struct ParallelExecuteStats {
+  size_t kernel_num_{0};
+  size_t thread_num_{0};
+  double step_time_{0};
+  double kernel_time_{0};
+  double critical_path_time_{0};
+  double utilization_{0};
+};
+
 class CPUKernelRuntime : public KernelRuntime {
  public:
   CPUKernelRuntime() = default;
@@ -44,6 +56,7 @@ class CPUKernelRuntime : public KernelRuntime {
                        VectorRef *outputs);
   void IncreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
+  const ParallelExecuteStats &parallel_execute_stats() const { return parallel_execute_stats_; }
   bool GenDynamicKernel(const session::KernelGraph *graph) override { return true; }
   bool RunDynamicKernelAsync(const session::KernelGraph *graph) override { return true; }
 
@@ -53,6 +66,34 @@ class CPUKernelRuntime : public KernelRuntime {
                                        TypeId type_id) override;
 
  private:
+  struct KernelLaunchInfo {
+    CNodePtr kernel_;
+    kernel::KernelMod *kernel_mod_{nullptr};
+    std::vector<kernel::AddressPtr> inputs_;
+    std::vector<kernel::AddressPtr> workspaces_;
+    std::vector<kernel::AddressPtr> outputs_;
+    std::vector<size_t> predecessors_;
+  };
+  struct GraphLaunchInfo {
+    std::vector<CNodePtr> execution_order_;
+    std::vector<KernelLaunchInfo> kernels_;
+    // The device pointers may be rebound between steps, they are copied to the launch addresses before each step.
+    std::vector<std::pair<DeviceAddressPtr, kernel::AddressPtr>> launch_addresses_;
+    std::vector<std::vector<size_t>> successors_;
+    std::vector<size_t> dependency_num_;
+  };
+
+  bool RunWithDynamicMalloc(const session::KernelGraph *kernel_graph);
+  bool SerialRun(const GraphLaunchInfo &launch_info);
+  bool ParallelRun(const GraphLaunchInfo &launch_info);
+  GraphLaunchInfo *GetGraphLaunchInfo(const session::KernelGraph *kernel_graph);
+  void BuildLaunchInfo(const session::KernelGraph *kernel_graph, GraphLaunchInfo *launch_info);
+  void BuildKernelDependency(const session::KernelGraph *kernel_graph, GraphLaunchInfo *launch_info);
+  void UpdateLaunchAddress(GraphLaunchInfo *launch_info);
+  void BindLaunchAddress(const DeviceAddressPtr &address, GraphLaunchInfo *launch_info,
+                         std::vector<kernel::AddressPtr> *address_list);
+  void UpdateParallelExecuteStats(const GraphLaunchInfo &launch_info, const std::vector<double> &kernel_times,
+                                  double step_time);
   tensor::TensorPtr CreatTensorForOutput(session::KernelGraph *kernel_graph, const CNodePtr &node, size_t index);
   BaseRef CreatTensorForOutput(session::KernelGraph *kernel_graph, const session::KernelWithIndex &kernel_with_index);
   void BindInputTensorAddressPtr(const session::KernelGraph &graph, const std::vector<tensor::TensorPtr> &inputs);
@@ -64,6 +105,10 @@ class CPUKernelRuntime : public KernelRuntime {
   CPUResourceManager resource_manager_;
   std::set<DeviceAddressPtr> bound_addresses_;
   std::map<AnfNodePtr, tensor::TensorPtr> input_param_tensor_map_;
+  std::unordered_map<uint32_t, GraphLaunchInfo> graph_launch_info_;
+  // Graphs whose memory plan reuses buffers between kernels, they are always run serially.
+  std::set<uint32_t> mem_reuse_graphs_;
+  ParallelExecuteStats parallel_execute_stats_;
 };
 }  // namespace cpu
 }  // namespace device
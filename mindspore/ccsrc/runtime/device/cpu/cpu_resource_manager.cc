@@ -15,6 +15,7 @@
  */
 #include "runtime/device/cpu/cpu_resource_manager.h"
 #include "backend/session/anf_runtime_algorithm.h"
+#include "utils/ms_context.h"
 
 namespace mindspore {
 namespace device {
@@ -35,6 +36,11 @@ void CPUResourceManager::MemFree() {
 }
 
 void CPUResourceManager::AssignMemory(const session::KernelGraph *graph) {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // Kernels launched in parallel may overlap in time, so the liveness based reuse is only safe for serial runs.
+  mem_plan_.set_mem_reuse(context_ptr->get_param<bool>(MS_CTX_ENABLE_MEM_REUSE) &&
+                          !context_ptr->get_param<bool>(MS_CTX_ENABLE_CPU_PARALLEL_EXECUTE));
   size_t graph_mem_size = mem_plan_.MemPlan(graph);
   if (graph_mem_size > mem_size_) {
     if (mem_size_ > 0) {
@@ -37,6 +37,10 @@ class CPUResourceManager {
   void MemFree(void *ptr);
   void IncreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
+  size_t planned_mem_size() const { return mem_plan_.planned_mem_size(); }
+  size_t naive_mem_size() const { return mem_plan_.naive_mem_size(); }
+  bool mem_reuse() const { return mem_plan_.mem_reuse(); }
+  bool dynamic_malloc() const { return dynamic_malloc_; }
 
  private:
   void MemFree();
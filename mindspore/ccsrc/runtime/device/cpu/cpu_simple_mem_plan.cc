@@ -14,14 +14,151 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include "utils/mem_block_plan.h"
 #include "backend/session/anf_runtime_algorithm.h"
+#include "frontend/operator/ops.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+constexpr size_t kMemAlignSize = 32;
+constexpr size_t kMemPlanPadding = 32;
+}  // namespace
+
 size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 32;
+  naive_mem_size_ = NaiveMemPlan(graph);
+  if (!mem_reuse_) {
+    planned_mem_size_ = naive_mem_size_;
+    return planned_mem_size_;
+  }
+  planned_mem_size_ = ReuseMemPlan(graph);
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " memory plan: planned " << planned_mem_size_ << " bytes, naive "
+               << naive_mem_size_ << " bytes, " << mem_blocks_.size() << " blocks.";
+  return planned_mem_size_;
+}
+
+void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  if (!mem_reuse_) {
+    NaiveMemAssign(graph, base_ptr);
+    return;
+  }
+  ReuseMemAssign(base_ptr);
+}
+
+size_t CPUSimpleMemPlan::AssignBlockOffsets(std::vector<MemBlock> *blocks) {
+  MS_EXCEPTION_IF_NULL(blocks);
+  return AssignMemBlockOffsets(blocks, kMemAlignSize);
+}
+
+void CPUSimpleMemPlan::AddBlock(DeviceAddress *address, size_t step) {
+  MS_EXCEPTION_IF_NULL(address);
+  if (block_index_.find(address) != block_index_.end()) {
+    return;
+  }
+  MemBlock block;
+  block.size_ = address->size_;
+  block.def_step_ = step;
+  block.last_step_ = step;
+  block_index_[address] = mem_blocks_.size();
+  mem_blocks_.push_back(block);
+  block_addresses_.push_back(address);
+}
+
+void CPUSimpleMemPlan::UpdateBlockLastStep(const DeviceAddress *address, size_t step) {
+  auto iter = block_index_.find(address);
+  if (iter == block_index_.end()) {
+    return;
+  }
+  auto &block = mem_blocks_[iter->second];
+  block.last_step_ = std::max(block.last_step_, step);
+}
+
+size_t CPUSimpleMemPlan::ReuseMemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  mem_blocks_.clear();
+  block_addresses_.clear();
+  block_index_.clear();
+  auto kernels = graph->execution_order();
+  for (size_t step = 0; step < kernels.size(); ++step) {
+    auto &kernel = kernels[step];
+    MS_EXCEPTION_IF_NULL(kernel);
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
+      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
+      if (kernel_with_index.first->isa<Parameter>()) {
+        continue;
+      }
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
+      MS_EXCEPTION_IF_NULL(address);
+      if (address->ptr_ == nullptr) {
+        // Produced outside the execution order, keep it alive from the beginning.
+        AddBlock(address.get(), 0);
+        UpdateBlockLastStep(address.get(), step);
+      }
+    }
+
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(address);
+      if (address->ptr_ == nullptr) {
+        AddBlock(address.get(), step);
+      }
+    }
+
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(address);
+      if (address->ptr_ == nullptr) {
+        AddBlock(address, step);
+      }
+    }
+  }
+
+  // Graph outputs and summary tensors are read after the graph finishes, they must never be reused.
+  size_t end_step = kernels.size();
+  auto outputs = AnfAlgo::GetAllOutput(graph->output(), {prim::kPrimTupleGetItem});
+  for (const auto &output : outputs) {
+    auto kernel_with_index = AnfAlgo::VisitKernelWithReturnType(output, 0, true);
+    MS_EXCEPTION_IF_NULL(kernel_with_index.first);
+    if (!kernel_with_index.first->isa<CNode>() ||
+        !AnfAlgo::OutputAddrExist(kernel_with_index.first, kernel_with_index.second)) {
+      continue;
+    }
+    UpdateBlockLastStep(AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second), end_step);
+  }
+  for (const auto &summary_item : graph->summary_nodes()) {
+    auto &node = summary_item.second.first;
+    size_t index = IntToSize(summary_item.second.second);
+    if (node == nullptr || !AnfAlgo::OutputAddrExist(node, index)) {
+      continue;
+    }
+    UpdateBlockLastStep(AnfAlgo::GetOutputAddr(node, index), end_step);
+  }
+
+  return AssignBlockOffsets(&mem_blocks_) + kMemPlanPadding;
+}
+
+void CPUSimpleMemPlan::ReuseMemAssign(uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  for (size_t i = 0; i < mem_blocks_.size(); ++i) {
+    auto address = block_addresses_[i];
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->ptr_ == nullptr) {
+      address->ptr_ = base_ptr + mem_blocks_[i].offset_;
+    }
+  }
+}
+
+size_t CPUSimpleMemPlan::NaiveMemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  size_t total_mem_size = kMemPlanPadding;
   auto kernels = graph->execution_order();
   for (const auto &kernel : kernels) {
     MS_EXCEPTION_IF_NULL(kernel);
@@ -62,7 +199,7 @@ size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
   return total_mem_size;
 }
 
-void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+void CPUSimpleMemPlan::NaiveMemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(base_ptr);
   uint8_t *mem_ptr = base_ptr;
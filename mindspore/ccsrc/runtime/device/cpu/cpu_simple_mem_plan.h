@@ -17,12 +17,21 @@
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 
 #include <vector>
+#include <unordered_map>
 #include "backend/session/kernel_graph.h"
 #include "runtime/device/device_address.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+// A memory block of the reuse plan, alive from def_step_ to last_step_ (inclusive) of the execution order.
+struct MemBlock {
+  size_t size_{0};
+  size_t def_step_{0};
+  size_t last_step_{0};
+  size_t offset_{0};
+};
+
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
@@ -30,6 +39,27 @@ class CPUSimpleMemPlan {
 
   size_t MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  void set_mem_reuse(bool mem_reuse) { mem_reuse_ = mem_reuse; }
+  bool mem_reuse() const { return mem_reuse_; }
+  size_t naive_mem_size() const { return naive_mem_size_; }
+  size_t planned_mem_size() const { return planned_mem_size_; }
+  // Pack blocks whose lifetimes do not overlap into shared offsets, return the total size of the packed memory.
+  static size_t AssignBlockOffsets(std::vector<MemBlock> *blocks);
+
+ private:
+  size_t NaiveMemPlan(const session::KernelGraph *graph);
+  void NaiveMemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  size_t ReuseMemPlan(const session::KernelGraph *graph);
+  void ReuseMemAssign(uint8_t *base_ptr);
+  void AddBlock(DeviceAddress *address, size_t step);
+  void UpdateBlockLastStep(const DeviceAddress *address, size_t step);
+
+  bool mem_reuse_{false};
+  size_t naive_mem_size_{0};
+  size_t planned_mem_size_{0};
+  std::vector<MemBlock> mem_blocks_;
+  std::vector<DeviceAddress *> block_addresses_;
+  std::unordered_map<const DeviceAddress *, size_t> block_index_;
 };
 }  // namespace cpu
 }  // namespace device
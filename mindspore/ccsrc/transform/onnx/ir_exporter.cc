@@ -71,7 +71,7 @@ class IrExporter {
 class IrExportBuilder {
  public:
   IrExportBuilder() = default;
-  ~IrExportBuilder() { google::protobuf::ShutdownProtobufLibrary(); }
+  ~IrExportBuilder() = default;
   std::string GetProtoString(const FuncGraphPtr &func_graph);
   void BuildModelInfo();
   void BuildModel(const FuncGraphPtr &func_graph);
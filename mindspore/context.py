@@ -193,6 +193,12 @@ class _Context:
     def set_save_graphs_path(self, save_graphs_path):
         self.set_param(ms_ctx_param.save_graphs_path, _make_directory(save_graphs_path))
 
+    def set_compile_cache_path(self, compile_cache_path):
+        if not compile_cache_path:
+            self.set_param(ms_ctx_param.compile_cache_path, "")
+            return
+        self.set_param(ms_ctx_param.compile_cache_path, _make_directory(compile_cache_path))
+
     def set_device_target(self, target):
         valid_targets = ["CPU", "GPU", "Ascend", "Davinci"]
         if not target in valid_targets:
@@ -261,6 +267,7 @@ class _Context:
         'mode': set_mode,
         'backend_policy': set_backend_policy,
         'save_graphs_path': set_save_graphs_path,
+        'compile_cache_path': set_compile_cache_path,
         'device_target': set_device_target,
         'device_id': set_device_id,
         'max_call_depth': set_max_call_depth,
@@ -462,7 +469,9 @@ def _check_target_specific_cfgs(device, arg_key):
         'profiling_options': ['Ascend'],
         'print_file_path': ['Ascend'],
         'variable_memory_max_size': ['Ascend'],
-        'max_device_memory': ['GPU']
+        'max_device_memory': ['GPU'],
+        'enable_cpu_parallel_execute': ['CPU'],
+        'enable_pynative_async': ['Ascend', 'GPU']
     }
     # configs not in map device_cfgs are supposed to be suitable for all devices
     if not arg_key in device_cfgs:
@@ -480,7 +489,8 @@ def _check_target_specific_cfgs(device, arg_key):
                  save_dump_path=str, enable_reduce_precision=bool, variable_memory_max_size=str,
                  enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
                  enable_graph_kernel=bool, check_bprop=bool, max_device_memory=str, print_file_path=str,
-                 enable_sparse=bool, max_call_depth=int)
+                 enable_sparse=bool, max_call_depth=int, enable_cpu_parallel_execute=bool,
+                 enable_pynative_async=bool, compile_cache_path=str)
 def set_context(**kwargs):
     """
     Sets context for running environment.
@@ -514,6 +524,7 @@ def set_context(**kwargs):
     reserve_class_name_in_scope  profiling_options
     save_graphs                  variable_memory_max_size
     save_graphs_path             print_file_path
+    compile_cache_path
     ===========================  ===========================  =================
 
     Args:
@@ -557,6 +568,18 @@ def set_context(**kwargs):
             suffix to the file. Default: ''.
         enable_sparse (bool): Whether to enable sparsity feature. Default: False.
         max_call_depth(int): Specify the maximum depth of function call. Default: 1000.
+        enable_cpu_parallel_execute (bool): Whether to launch the independent kernels of a graph concurrently on CPU.
+            The kernels are scheduled by their data dependencies instead of running one by one, and the memory
+            of the graph is not reused between kernels in this mode. Default: False.
+        enable_pynative_async (bool): Whether to dispatch the operators of PyNative mode to the backend
+            asynchronously. An operator returns as soon as its outputs are inferred, and reading the value of an
+            output, e.g. by `asnumpy()` or in a Python condition, waits until it is computed. Errors of an operator
+            are raised when its outputs are read. Default: False.
+        compile_cache_path (str): Path of the compile cache of graph mode. If it is set, the graphs optimized by
+            the frontend are saved in this path, and a later compilation of the same network with the same inputs
+            loads the optimized graph instead of inferring and optimizing the network again. Only networks without
+            control flow are cached, in the stand_alone and data_parallel modes. An empty path disables the
+            cache. Default: "".
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -578,6 +601,9 @@ def set_context(**kwargs):
         >>> context.set_context(max_device_memory="3.5GB")
         >>> context.set_context(print_file_path="print.pb")
         >>> context.set_context(max_call_depth=80)
+        >>> context.set_context(enable_cpu_parallel_execute=True)
+        >>> context.set_context(enable_pynative_async=True)
+        >>> context.set_context(compile_cache_path="./compile_cache")
     """
     ctx = _context()
     # set device target first
@@ -651,7 +677,9 @@ class ParallelMode:
     AUTO_PARALLEL = "auto_parallel"
     MODE_LIST = [STAND_ALONE, DATA_PARALLEL, HYBRID_PARALLEL, SEMI_AUTO_PARALLEL, AUTO_PARALLEL]
 
-@args_type_check(enable_ps=bool)
+@args_type_check(enable_ps=bool, ps_mode=str, staleness_threshold=int, embedding_cache_size=int,
+                 embedding_cache_policy=str, embedding_cache_staleness=int, grad_compression=str,
+                 param_grad_compression=dict, grad_compression_min_size=int, grad_compression_topk_ratio=float)
 def set_ps_context(**kwargs):
     """
     Set parameter server training mode context.
@@ -676,12 +704,41 @@ def set_ps_context(**kwargs):
         enable_ps (bool): Whether to enable parameter server training mode.
                           Only after enable_ps is set True, the environment variables will be effective.
                           Default: False.
+        ps_mode (str): How the servers apply the gradients of the workers, one of "sync", "async" and "ssp".
+                       "sync" averages the gradients of all workers once per step, "async" applies every
+                       gradient at once without waiting for the other workers, "ssp" applies every gradient
+                       at once but keeps the fastest worker at most staleness_threshold steps ahead of the
+                       slowest one. Default: "sync".
+        staleness_threshold (int): The number of steps a worker may run ahead of the slowest one in "ssp" mode.
+                                   Default: 1.
+        embedding_cache_size (int): The number of rows of every embedding table a worker caches, so ids which
+                                    repeat across steps are not fetched from the servers again. 0 disables
+                                    the cache. Default: 0.
+        embedding_cache_policy (str): Which rows the embedding cache keeps, "lru" or "lfu". "lru" keeps the
+                                      recently used rows, "lfu" only admits a row used more often than the row
+                                      it would evict. Default: "lru".
+        embedding_cache_staleness (int): The number of steps a cached row is used before it is fetched again.
+                                         In "async" mode the sparse gradients of the cached rows are summed up
+                                         on the worker and pushed once per this many steps too. Default: 1.
+        grad_compression (str): How the workers compress the dense gradients they push, one of "none", "fp16",
+                                "bf16", "topk" and "int8". "fp16" and "bf16" cast every element to 16 bits,
+                                "topk" only sends the largest grad_compression_topk_ratio of the elements and
+                                adds the others to the next gradient, "int8" quantizes every block of 256
+                                elements to 8 bits. Default: "none".
+        param_grad_compression (dict): The compression of the gradients of some parameters, by parameter name.
+                                       It overrides grad_compression and grad_compression_min_size.
+                                       Default: {}.
+        grad_compression_min_size (int): Gradients of fewer elements are pushed uncompressed. Default: 1024.
+        grad_compression_topk_ratio (float): The ratio of the elements "topk" sends, in (0, 1]. Default: 0.01.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
 
     Examples:
         >>> context.set_ps_context(enable_ps=True)
+        >>> context.set_ps_context(enable_ps=True, ps_mode="ssp", staleness_threshold=2)
+        >>> context.set_ps_context(enable_ps=True, grad_compression="fp16",
+        ...                        param_grad_compression={"fc3.weight": "topk"})
     """
     _set_ps_context(**kwargs)
 
@@ -706,5 +763,14 @@ def reset_ps_context():
     Reset parameter server training mode context attributes to the default values:
 
     - enable_ps: False.
+    - ps_mode: "sync".
+    - staleness_threshold: 1.
+    - embedding_cache_size: 0.
+    - embedding_cache_policy: "lru".
+    - embedding_cache_staleness: 1.
+    - grad_compression: "none".
+    - param_grad_compression: {}.
+    - grad_compression_min_size: 1024.
+    - grad_compression_topk_ratio: 0.01.
     """
     _reset_ps_context()
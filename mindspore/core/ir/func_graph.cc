@@ -243,8 +243,7 @@ bool FuncGraph::DropFreeVariable(AnfNodePtr node) {
 const BaseRefCounterMap &FuncGraph::free_variables_total() {
   auto mng = manager_.lock();
   MS_EXCEPTION_IF_NULL(mng);
-  auto &fv_total = mng->free_variables_total();
-  return fv_total[shared_from_base<FuncGraph>()];
+  return mng->free_variables_total(shared_from_base<FuncGraph>());
 }
 
 std::vector<AnfNodePtr> FuncGraph::free_variables_nodes() {
@@ -245,13 +245,11 @@ void Cloner::CloneParameters(const FuncGraphPtr &func_graph, const FuncGraphPtr
 
 void Cloner::GenParameters(const FuncGraphPtr &func_graph) {
   MS_EXCEPTION_IF_NULL(func_graph);
-  auto &free_vars = manager_->free_variables_total();
-  auto iter = free_vars.find(func_graph);
-  if (iter == free_vars.end()) {
+  if (!manager_->func_graphs().contains(func_graph)) {
     return;
   }
 
-  for (auto &fv_map : iter->second) {
+  for (auto &fv_map : manager_->free_variables_total(func_graph)) {
     auto &free_var = fv_map.first;
     if (utils::isa<AnfNodePtr>(free_var)) {
       repl_func_graph_params_[func_graph].push_back(AddParameter(func_graph, utils::cast<AnfNodePtr>(free_var)));
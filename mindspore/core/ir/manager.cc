@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <list>
+#include <vector>
 
 #include "ir/func_graph.h"
 #include "utils/convert_utils_base.h"
@@ -27,6 +28,17 @@
 
 namespace mindspore {
 
+namespace {
+// the analysis being computed in this thread, the innermost one at the back
+thread_local std::vector<DepComputer::AnalysisEntry> computing_analysis;
+
+class ComputingAnalysisGuard {
+ public:
+  explicit ComputingAnalysisGuard(const DepComputer::AnalysisEntry &entry) { computing_analysis.push_back(entry); }
+  ~ComputingAnalysisGuard() { computing_analysis.pop_back(); }
+};
+}  // namespace
+
 FuncGraphManagerPtr MakeManager(const std::vector<FuncGraphPtr> &func_graphs, bool manage) {
   auto m = std::make_shared<FuncGraphManager>(func_graphs, manage);
   m->Init();
@@ -140,8 +152,25 @@ FuncGraphSet &FuncGraphManager::scopes(const FuncGraphPtr &fg) const {
 
 FVTotalMap &FuncGraphManager::free_variables_total() const {
   MS_EXCEPTION_IF_NULL(free_variables_total_);
-  free_variables_total_->Recompute();
-  return free_variables_total_->fv_total_analysis();
+  for (auto &fg : func_graphs_) {
+    free_variables_total_->Recompute(fg);
+  }
+  auto &fv_total = free_variables_total_->fv_total_analysis();
+  for (auto iter = fv_total.begin(); iter != fv_total.end();) {
+    if (func_graphs_.contains(iter->first)) {
+      ++iter;
+    } else {
+      iter = fv_total.erase(iter);
+    }
+  }
+  return fv_total;
+}
+
+OrderedMap<BaseRef, int, BaseRefHash> &FuncGraphManager::free_variables_total(const FuncGraphPtr &fg) const {
+  MS_EXCEPTION_IF_NULL(fg);
+  MS_EXCEPTION_IF_NULL(free_variables_total_);
+  free_variables_total_->Recompute(fg);
+  return free_variables_total_->fv_total_analysis()[fg];
 }
 
 FuncGraphSet &FuncGraphManager::func_graphs_used_total(const FuncGraphPtr &fg) const {
@@ -211,7 +240,7 @@ void FuncGraphManager::Clear() {
   node_users_.clear();
   roots_.clear();
 
-  signals_->InvalidateComputer();
+  signals_->InvalidateComputer(nullptr);
 }
 
 void FuncGraphManager::KeepRoots(const std::vector<FuncGraphPtr> &func_graphs) {
@@ -311,6 +340,9 @@ void FuncGraphManager::MaybeDropFuncGraphs(const FuncGraphSet &func_graphs, bool
     }
     MS_LOG(DEBUG) << "Func graph dropped " << fg->ToString();
   }
+  if (!dropped.empty()) {
+    signals_->DropFuncGraphs(dropped);
+  }
 }
 
 void FuncGraphManager::ProcessEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) {
@@ -484,15 +516,16 @@ void FuncGraphManager::AddEdge(AnfNodePtr node, int index, AnfNodePtr input) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->AddFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->AddFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        signals_->InvalidateComputer(fg);
       }
       if (IsPrimitiveCNode(node, prim::kPrimJ)) {
         fg->AddJFuncGraph(used);
+        signals_->InvalidateComputer(fg);
       }
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->AddFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      signals_->InvalidateComputer(fg);
     }
   }
 }
@@ -505,15 +538,16 @@ void FuncGraphManager::DropEdge(AnfNodePtr node, int index, AnfNodePtr input) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->DropFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->DropFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        signals_->InvalidateComputer(fg);
       }
       if (IsPrimitiveCNode(node, prim::kPrimJ)) {
         fg->DropJFuncGraph(used);
+        signals_->InvalidateComputer(fg);
       }
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->DropFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      signals_->InvalidateComputer(fg);
     }
   }
 }
@@ -525,7 +559,7 @@ void FuncGraphManager::MoveAllNodes(FuncGraphPtr source, FuncGraphPtr target) {
   target->CopyFreeVariables(source);
   target->CopyFuncGraphsUsed(source);
   target->CopyJFuncGraphs(source);
-  signals_->InvalidateComputer();
+  signals_->InvalidateComputer(nullptr);
   source->ClearAllManagerInfo();
 }
 
@@ -659,6 +693,7 @@ void FuncGraphTransaction::Commit() {
 DepComputer::DepComputer(const FuncGraphManager *const manager) : manager_(manager) {
   MS_EXCEPTION_IF_NULL(manager_);
   manager_->signals()->InvalidateComputer.connect(this, &DepComputer::OnInvalidateComputer);
+  manager_->signals()->DropFuncGraphs.connect(this, &DepComputer::OnDropFuncGraphs);
   validate_ = false;
 }
 
@@ -671,15 +706,86 @@ void DepComputer::Recompute() {
 
 void DepComputer::Recompute(const FuncGraphPtr &fg) {
   if (func_graphs_validate_.count(fg) == 0 || !func_graphs_validate_[fg]) {
+    ComputingAnalysisGuard guard(std::make_pair(this, fg));
     RealRecompute(fg);
     func_graphs_validate_[fg] = true;
   }
+  if (!computing_analysis.empty()) {
+    (void)analysis_readers_[fg].insert(computing_analysis.back());
+  }
+}
+
+void DepComputer::ReadFuncGraph(const FuncGraphPtr &fg) {
+  if (!computing_analysis.empty()) {
+    auto &entry = computing_analysis.back();
+    entry.first->func_graph_readers_[fg].add(entry.second);
+  }
+}
+
+void DepComputer::Invalidate(const FuncGraphPtr &fg) {
+  auto iter = func_graphs_validate_.find(fg);
+  if (iter == func_graphs_validate_.end() || !iter->second) {
+    return;
+  }
+  iter->second = false;
+  ExtraInvalidate(fg);
+  auto readers_iter = analysis_readers_.find(fg);
+  if (readers_iter == analysis_readers_.end()) {
+    return;
+  }
+  auto readers = std::move(readers_iter->second);
+  (void)analysis_readers_.erase(readers_iter);
+  for (auto &reader : readers) {
+    reader.first->Invalidate(reader.second);
+  }
+}
+
+void DepComputer::OnInvalidateComputer(const FuncGraphPtr &fg) {
+  if (fg == nullptr) {
+    Reset();
+    return;
+  }
+  auto iter = func_graph_readers_.find(fg);
+  if (iter == func_graph_readers_.end()) {
+    return;
+  }
+  auto readers = std::move(iter->second);
+  (void)func_graph_readers_.erase(iter);
+  for (auto &reader : readers) {
+    Invalidate(reader);
+  }
+}
+
+void DepComputer::OnDropFuncGraphs(const std::set<FuncGraphPtr> &func_graphs) {
+  for (auto &fg : func_graphs) {
+    OnInvalidateComputer(fg);
+    Invalidate(fg);
+    (void)func_graphs_validate_.erase(fg);
+    (void)analysis_readers_.erase(fg);
+    (void)func_graph_readers_.erase(fg);
+  }
+  // the dropped graphs may still be recorded as readers of the kept graphs
+  for (auto &item : analysis_readers_) {
+    for (auto iter = item.second.begin(); iter != item.second.end();) {
+      if (func_graphs.find(iter->second) != func_graphs.end()) {
+        iter = item.second.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+  for (auto &item : func_graph_readers_) {
+    for (auto &fg : func_graphs) {
+      (void)item.second.erase(fg);
+    }
+  }
 }
 
 FuncGraphSetPtr FuncGraphParentsTotalComputer::SeekParents(const FuncGraphPtr &fg, size_t seen_num) {
   if (fg->seen_ == seen_num) {
     return std::make_shared<FuncGraphSet>();
   }
+  ReadFuncGraph(fg);
   FuncGraphSetPtr parents = std::make_shared<FuncGraphSet>();
 
   // Append all the fvs in fg.
@@ -760,45 +866,42 @@ void ScopeComputer::RealRecompute(FuncGraphPtr fg) {
   }
 }
 
-void FVTotalComputer::RealRecompute() {
-  auto manager = DepComputer::manager_;
-  MS_EXCEPTION_IF_NULL(manager);
+void FVTotalComputer::RealRecompute(FuncGraphPtr fg) {
+  MS_EXCEPTION_IF_NULL(manager_);
+  MS_EXCEPTION_IF_NULL(fg);
+  ReadFuncGraph(fg);
+  OrderedMap<BaseRef, int, BaseRefHash> fv_total;
 
-  for (auto &fg : manager->func_graphs()) {
-    fv_total_analysis_[fg] = OrderedMap<BaseRef, int, BaseRefHash>();
+  // add all free variable nodes
+  for (auto &iter : fg->free_variables()) {
+    fv_total[iter.first] = iter.second;
   }
 
-  for (auto &fg : manager->func_graphs()) {
-    // add all free variable nodes
-    AnfNodeCounterMap items = fg->free_variables();
-    for (auto &iter : items) {
-      auto curr = fg;
-      while (curr != nullptr) {
-        fv_total_analysis_[curr][iter.first] = iter.second;
-        curr = manager->parent(curr);
-        if (curr != nullptr) {
-          const AnfNodeSet &all_nodes = curr->nodes();
-          if (all_nodes.contains(iter.first)) {
-            break;
-          }
-        }
-      }
+  // add all FGs of free variables
+  for (auto &iter : fg->func_graphs_used()) {
+    auto p = manager_->parent(iter.first);
+    if (p != nullptr && p != fg) {
+      fv_total[iter.first] = iter.second;
     }
+  }
 
-    // add all FGs of free variables
-    auto &used = fg->func_graphs_used();
-    for (auto &iter : used) {
-      auto p = manager->parent(iter.first);
-      if (p == nullptr) {
+  // add the free variables of children which are not in fg
+  auto children = manager_->children(fg);
+  for (auto &child : children) {
+    Recompute(child);
+    for (auto &iter : fv_total_analysis_[child]) {
+      auto &fv = iter.first;
+      if (utils::isa<AnfNodePtr>(fv)) {
+        if (fg->nodes().contains(utils::cast<AnfNodePtr>(fv))) {
+          continue;
+        }
+      } else if (utils::isa<FuncGraphPtr>(fv) && manager_->parent(utils::cast<FuncGraphPtr>(fv)) == fg) {
         continue;
       }
-      auto curr = fg;
-      while (curr != p) {
-        fv_total_analysis_[curr][iter.first] = iter.second;
-        curr = manager->parent(curr);
-      }
+      fv_total[fv] = iter.second;
     }
   }
+  fv_total_analysis_[fg] = fv_total;
 }
 
 void FuncGraphsUsedTotalComputer::RealRecompute(FuncGraphPtr fg) {
@@ -810,6 +913,7 @@ void FuncGraphsUsedTotalComputer::RealRecompute(FuncGraphPtr fg) {
   while (!todo.empty()) {
     todo_new.clear();
     for (auto &gt : todo) {
+      ReadFuncGraph(gt);
       for (auto &item : gt->func_graphs_used()) {
         auto used_fg = item.first;
         if (used_fg == fg) {
@@ -827,8 +931,7 @@ void FuncGraphsUsedTotalComputer::RealRecompute(FuncGraphPtr fg) {
   }
 }
 
-bool CheckRecursive(const FuncGraphManager *const manager, const FuncGraphPtr &fg) {
-  MS_EXCEPTION_IF_NULL(manager);
+bool RecursiveComputer::CheckRecursive(const FuncGraphPtr &fg) {
   std::vector<FuncGraphPtr> todo;
   std::vector<FuncGraphPtr> todo_new;
   todo.push_back(fg);
@@ -836,6 +939,7 @@ bool CheckRecursive(const FuncGraphManager *const manager, const FuncGraphPtr &f
   while (!todo.empty()) {
     todo_new.clear();
     for (auto &gt : todo) {
+      ReadFuncGraph(gt);
       for (auto &item : gt->func_graphs_used()) {
         auto used_g = item.first;
         if (used_g == fg) {
@@ -853,7 +957,7 @@ bool CheckRecursive(const FuncGraphManager *const manager, const FuncGraphPtr &f
 }
 
 void RecursiveComputer::RealRecompute(FuncGraphPtr fg) {
-  this->recursive_analysis_[fg] = CheckRecursive(this->manager_, fg);
+  this->recursive_analysis_[fg] = CheckRecursive(fg);
 }
 
 void RecursiveComputer::CheckRecursiveGraphs(const FuncGraphPtr &fg, std::list<FuncGraphPtr> *trace) {
@@ -884,6 +988,7 @@ bool FuncGraphJTotalComputer::SeekJ(const FuncGraphPtr &fg, size_t seen_num) {
     MS_LOG(DEBUG) << fg->ToString() << " had been checked";
     return false;
   }
+  ReadFuncGraph(fg);
   auto &j_fgs = fg->j_func_graphs();
   if (!j_fgs.empty()) {
     // check g1->J(fg)->g2->g cycle;
@@ -88,7 +88,10 @@ FuncGraphManagerPtr Manage(const std::vector<FuncGraphPtr> &func_graphs, bool ma
 FuncGraphManagerPtr MakeManager(const std::vector<FuncGraphPtr> &func_graphs = {}, bool manage = true);
 
 struct Signals {
-  Signal<void()> InvalidateComputer;
+  // emitted with the graph whose free variables, used graphs or J graphs changed, with nullptr if all graphs changed
+  Signal<void(const FuncGraphPtr &)> InvalidateComputer;
+  // emitted with the graphs dropped from the manager
+  Signal<void(const std::set<FuncGraphPtr> &)> DropFuncGraphs;
 };
 
 enum EdgeProcessDirection { kDecEdge = -1, kIncEdge = 1 };
@@ -97,9 +100,15 @@ using CNodeIndexPair = std::pair<AnfNodePtr, int>;
 using CNodeIndexPairPtr = std::shared_ptr<CNodeIndexPair>;
 using FuncGraphToFuncGraphSetMap = OrderedMap<FuncGraphPtr, FuncGraphSet>;
 
-// analysis base class, graphs analysis which need dynamic compute by DepCollector in each read
+// analysis base class, graphs analysis which need dynamic compute by DepCollector in each read.
+// The analysis of a graph is kept until a graph it was computed from changes: while computing it, the computer records
+// the graphs whose free variables, used graphs or J graphs are read, and the analysis of the graphs read from the
+// computers, so that a changed graph only drops the analysis depending on it.
 class DepComputer {
  public:
+  // the analysis of a graph by a computer
+  using AnalysisEntry = std::pair<DepComputer *, FuncGraphPtr>;
+
   explicit DepComputer(const FuncGraphManager *manager);
   virtual ~DepComputer() { manager_ = nullptr; }
 
@@ -109,9 +118,18 @@ class DepComputer {
     ExtraReset();
     validate_ = false;
     func_graphs_validate_.clear();
+    analysis_readers_.clear();
+    func_graph_readers_.clear();
   }
 
-  void OnInvalidateComputer() { Reset(); }
+  // fg is the changed graph, nullptr if all graphs changed
+  virtual void OnInvalidateComputer(const FuncGraphPtr &fg);
+
+  // forget the dropped graphs, their analysis and the analysis which read them
+  void OnDropFuncGraphs(const std::set<FuncGraphPtr> &func_graphs);
+
+  // drop the analysis of fg and the analysis which read it
+  void Invalidate(const FuncGraphPtr &fg);
 
   void Recompute();
 
@@ -124,9 +142,13 @@ class DepComputer {
  protected:
   // subclass can reset their own member;
   virtual void ExtraReset() {}
+  // subclass can drop their own analysis of fg;
+  virtual void ExtraInvalidate(const FuncGraphPtr &) {}
   // subclass do the real compute
   virtual void RealRecompute() {}
   virtual void RealRecompute(FuncGraphPtr) {}
+  // record the free variables, used graphs or J graphs of fg are read by the analysis being computed
+  static void ReadFuncGraph(const FuncGraphPtr &fg);
 
   const FuncGraphManager *manager_;
   bool validate_;
@@ -134,6 +156,11 @@ class DepComputer {
 
  private:
   friend FuncGraphManager;
+
+  // the analysis which read the analysis of a graph
+  OrderedMap<FuncGraphPtr, std::set<AnalysisEntry>> analysis_readers_;
+  // the graphs whose analysis read the free variables, used graphs or J graphs of a graph
+  OrderedMap<FuncGraphPtr, FuncGraphSet> func_graph_readers_;
 };
 
 // graph g's all direct or proxy parents
@@ -150,6 +177,7 @@ class FuncGraphParentsTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_parents_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)func_graph_parents_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 
@@ -173,6 +201,7 @@ class ParentComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { parent_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)parent_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -191,6 +220,7 @@ class ChildrenComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { children_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)children_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -209,6 +239,7 @@ class ScopeComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { scope_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)scope_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -228,8 +259,10 @@ class FVTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { fv_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)fv_total_analysis_.erase(fg); }
 
-  void RealRecompute() override;
+  // fg's free variables total are the free variables of fg and the ones of its children which are not in fg.
+  void RealRecompute(FuncGraphPtr fg) override;
 };
 
 class FuncGraphsUsedTotalComputer final : public DepComputer {
@@ -245,6 +278,7 @@ class FuncGraphsUsedTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_used_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)func_graph_used_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -262,6 +296,12 @@ class RecursiveComputer final : public DepComputer {
 
   void CheckRecursiveGraphs(const FuncGraphPtr &fg, std::list<FuncGraphPtr> *trace);
 
+  // recursive_map_ is filled by the walks of CheckRecursiveGraphs, it's dropped on any change.
+  void OnInvalidateComputer(const FuncGraphPtr &fg) override {
+    recursive_map_.clear();
+    DepComputer::OnInvalidateComputer(fg);
+  }
+
   size_t size() const override { return recursive_analysis_.size(); }
 
   RecursiveMap recursive_map_;
@@ -272,8 +312,10 @@ class RecursiveComputer final : public DepComputer {
     recursive_analysis_.clear();
     recursive_map_.clear();
   }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)recursive_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
+  bool CheckRecursive(const FuncGraphPtr &fg);
 };
 
 class FuncGraphJTotalComputer final : public DepComputer {
@@ -289,6 +331,7 @@ class FuncGraphJTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { j_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)j_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
   bool SeekJ(const FuncGraphPtr &fg, size_t seen_num);
@@ -331,6 +374,8 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
 
   FVTotalMap &free_variables_total() const;
 
+  OrderedMap<BaseRef, int, BaseRefHash> &free_variables_total(const FuncGraphPtr &fg) const;
+
   FuncGraphSet &func_graph_parents_total(const FuncGraphPtr &fg) const;
 
   FuncGraphSet &scopes(const FuncGraphPtr &fg) const;
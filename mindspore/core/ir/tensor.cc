@@ -161,6 +161,36 @@ std::unique_ptr<T[]> CopyData(const ShapeVector &shape, void *const data, size_t
   return NewData<T>(buf, size);
 }
 
+// Storage of the tensor data, either allocated by the tensor data or adopted from an external buffer.
+template <typename T>
+using TensorStorage = std::unique_ptr<T[], std::function<void(T *)>>;
+
+template <typename T>
+TensorStorage<T> AdoptData(const ShapeVector &shape, void *const data, size_t data_len,
+                           const TensorDataDeleter &deleter) {
+  if (data == nullptr) {
+    MS_LOG(EXCEPTION) << "The external data of a tensor is null.";
+  }
+  if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0) {
+    // Elements can't be accessed in place, copy them.
+    MS_LOG(DEBUG) << "External data " << data << " is not aligned to " << alignof(T) << " bytes, copy it.";
+    TensorStorage<T> copy = CopyData<T>(shape, data, data_len);
+    if (deleter) {
+      deleter(data);
+    }
+    return copy;
+  }
+  size_t size = SizeOf(shape);
+  if (size * sizeof(T) != data_len) {
+    MS_LOG(EXCEPTION) << "Incorrect tensor input data length  " << data_len << ", expect " << size * sizeof(T)
+                      << " item size " << sizeof(T);
+  }
+  if (!deleter) {
+    return TensorStorage<T>(static_cast<T *>(data), [](T *) {});
+  }
+  return TensorStorage<T>(static_cast<T *>(data), [deleter](T *ptr) { deleter(ptr); });
+}
+
 // Tensor data implementation.
 template <typename T>
 class TensorDataImpl : public TensorData {
@@ -174,6 +204,9 @@ class TensorDataImpl : public TensorData {
   TensorDataImpl(const ShapeVector &shape, void *data, TypeId data_type)
       : ndim_(shape.size()), data_size_(SizeOf(shape)), data_(CopyData<T>(shape, data, data_type)) {}
 
+  TensorDataImpl(const ShapeVector &shape, void *data, size_t data_len, const TensorDataDeleter &deleter)
+      : ndim_(shape.size()), data_size_(SizeOf(shape)), data_(AdoptData<T>(shape, data, data_len, deleter)) {}
+
   template <typename U>
   TensorDataImpl(const ShapeVector &shape, const U *input, size_t size)
       : ndim_(shape.size()), data_size_(SizeOf(shape)), data_(NewData<T>(input, size)) {}
@@ -402,7 +435,7 @@ class TensorDataImpl : public TensorData {
 
   size_t ndim_{0};
   size_t data_size_{0};
-  std::unique_ptr<T[]> data_;
+  TensorStorage<T> data_;
 };
 
 template <typename... Args>
@@ -467,6 +500,10 @@ Tensor::Tensor(TypeId data_type, const ShapeVector &shape)
 Tensor::Tensor(TypeId data_type, const ShapeVector &shape, void *data, size_t data_len)
     : Tensor(data_type, shape, MakeTensorData(data_type, shape, data, data_len)) {}
 
+Tensor::Tensor(TypeId data_type, const ShapeVector &shape, void *data, size_t data_len,
+               const TensorDataDeleter &deleter)
+    : Tensor(data_type, shape, MakeTensorData(data_type, shape, data, data_len, deleter)) {}
+
 Tensor::Tensor(TypeId data_type, const ShapeVector &shape, void *data, TypeId src_data_type)
     : Tensor(data_type, shape, MakeTensorData(data_type, shape, data, src_data_type)) {}
 
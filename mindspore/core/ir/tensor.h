@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_IR_TENSOR_H_
 #define MINDSPORE_CORE_IR_TENSOR_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -78,6 +79,9 @@ class TensorData {
 
 using TensorDataPtr = std::shared_ptr<TensorData>;
 
+// Releases an external buffer adopted by a tensor, called with the buffer when the last tensor using it is gone.
+using TensorDataDeleter = std::function<void(void *)>;
+
 struct WaitEvent {
   bool need_wait_{false};
   mutable std::mutex mutex_;
@@ -140,6 +144,18 @@ class Tensor : public MetaTensor {
   // param data_len The length of data in bytes.
   Tensor(TypeId data_type, const ShapeVector &shape, void *data, size_t data_len);
 
+  // brief Create a tensor which adopts an external data buffer without copy.
+  //
+  // The buffer is used in place if it is aligned for the element type, otherwise it is copied and released at once.
+  // The tensor owns the buffer once constructed, it is not released if the constructor throws.
+  //
+  // param data_type [TypeId] Data type of the tensor.
+  // param shape The shape represented by ShapeVector of the tensor.
+  // param data The input data adopted by the tensor.
+  // param data_len The length of data in bytes.
+  // param deleter Called to release data, or null if data outlives the tensor.
+  Tensor(TypeId data_type, const ShapeVector &shape, void *data, size_t data_len, const TensorDataDeleter &deleter);
+
   // brief Create a tensor with input data buffer and given source data type.
   //
   // param data_type [TypeId] Data type of the tensor.
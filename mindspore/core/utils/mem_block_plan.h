@@ -0,0 +1,86 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_UTILS_MEM_BLOCK_PLAN_H_
+#define MINDSPORE_CORE_UTILS_MEM_BLOCK_PLAN_H_
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace mindspore {
+// Assign an offset to every block so that blocks whose lifetimes overlap never share bytes, and return the total size.
+// Block needs the members size_, def_step_, last_step_ (lifetime is [def_step_, last_step_]) and offset_, every
+// block occupies size_ rounded up to align_size bytes.
+template <typename Block>
+size_t AssignMemBlockOffsets(std::vector<Block> *blocks, size_t align_size) {
+  if (blocks == nullptr || align_size == 0) {
+    return 0;
+  }
+  auto align = [align_size](size_t size) { return (size + align_size - 1) / align_size * align_size; };
+  std::vector<size_t> order(blocks->size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  // Place the largest blocks first, the small ones fill the gaps left between them.
+  std::stable_sort(order.begin(), order.end(), [blocks](size_t a, size_t b) {
+    auto &block_a = (*blocks)[a];
+    auto &block_b = (*blocks)[b];
+    if (block_a.size_ != block_b.size_) {
+      return block_a.size_ > block_b.size_;
+    }
+    return block_a.def_step_ < block_b.def_step_;
+  });
+
+  size_t total_size = 0;
+  std::vector<const Block *> placed;
+  std::vector<const Block *> conflicts;
+  for (auto index : order) {
+    auto &block = (*blocks)[index];
+    size_t block_size = align(block.size_);
+    conflicts.clear();
+    for (auto other : placed) {
+      if (other->def_step_ <= block.last_step_ && block.def_step_ <= other->last_step_) {
+        conflicts.push_back(other);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end(),
+              [](const Block *a, const Block *b) { return a->offset_ < b->offset_; });
+    // Best fit: take the smallest gap between live blocks that can hold this one, otherwise append on top.
+    size_t best_offset = 0;
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    size_t gap_begin = 0;
+    for (auto other : conflicts) {
+      if (other->offset_ > gap_begin) {
+        size_t gap = other->offset_ - gap_begin;
+        if (gap >= block_size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = gap_begin;
+        }
+      }
+      gap_begin = std::max(gap_begin, other->offset_ + align(other->size_));
+    }
+    if (best_gap == std::numeric_limits<size_t>::max()) {
+      best_offset = gap_begin;
+    }
+    block.offset_ = best_offset;
+    total_size = std::max(total_size, best_offset + block_size);
+    placed.push_back(&block);
+  }
+  return total_size;
+}
+}  // namespace mindspore
+#endif  // MINDSPORE_CORE_UTILS_MEM_BLOCK_PLAN_H_
@@ -36,6 +36,7 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
   set_param<std::string>(MS_CTX_SAVE_GRAPHS_PATH, ".");
   set_param<bool>(MS_CTX_ENABLE_DUMP, false);
   set_param<std::string>(MS_CTX_SAVE_DUMP_PATH, ".");
+  set_param<std::string>(MS_CTX_COMPILE_CACHE_PATH, "");
   set_param<uint32_t>(MS_CTX_TSD_REF, 0);
   set_param<uint32_t>(MS_CTX_GE_REF, 0);
   set_param<bool>(MS_CTX_IS_MULTI_GRAPH_SINK, false);
@@ -71,6 +72,8 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
   set_param<std::string>(MS_CTX_PRINT_FILE_PATH, "");
   set_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL, false);
   set_param<bool>(MS_CTX_ENABLE_SPARSE, false);
+  set_param<bool>(MS_CTX_ENABLE_CPU_PARALLEL_EXECUTE, false);
+  set_param<bool>(MS_CTX_ENABLE_PYNATIVE_ASYNC, false);
 
   backend_policy_ = policy_map_[policy];
 }
@@ -55,6 +55,7 @@ enum MsCtxParam : unsigned {
   MS_CTX_TYPE_BOOL_BEGIN,
   MS_CTX_ENABLE_AUTO_MIXED_PRECISION = MS_CTX_TYPE_BOOL_BEGIN,
   MS_CTX_CHECK_BPROP_FLAG,
+  MS_CTX_ENABLE_CPU_PARALLEL_EXECUTE,
   MS_CTX_ENABLE_DUMP,
   MS_CTX_ENABLE_DYNAMIC_MEM_POOL,
   MS_CTX_ENABLE_GPU_SUMMARY,
@@ -62,6 +63,7 @@ enum MsCtxParam : unsigned {
   MS_CTX_ENABLE_HCCL,
   MS_CTX_ENABLE_LOOP_SINK,
   MS_CTX_ENABLE_MEM_REUSE,
+  MS_CTX_ENABLE_PYNATIVE_ASYNC,
   MS_CTX_ENABLE_PYNATIVE_HOOK,
   MS_CTX_ENABLE_PYNATIVE_INFER,
   MS_CTX_ENABLE_REDUCE_PRECISION,
@@ -96,6 +98,7 @@ enum MsCtxParam : unsigned {
   // paramater of type string
   MS_CTX_TYPE_STRING_BEGIN = MS_CTX_TYPE_FLOAT_END,
   MS_CTX_DEVICE_TARGET = MS_CTX_TYPE_STRING_BEGIN,
+  MS_CTX_COMPILE_CACHE_PATH,
   MS_CTX_GRAPH_MEMORY_MAX_SIZE,
   MS_CTX_PRINT_FILE_PATH,
   MS_CTX_PROFILING_OPTIONS,
@@ -128,6 +131,14 @@ class MsContext {
   static void device_seter(DeviceSeter device) { seter_ = device; }
   static void device_type_seter(DeviceTypeSeter device_type) { device_type_seter_ = device_type; }
 
+  // Override MS_CTX_ENABLE_PYNATIVE_INFER for the calling thread only. A backend worker runs queued pynative ops with
+  // it while the frontend thread keeps seeing the global value.
+  static void set_thread_pynative_infer(bool enable) {
+    thread_pynative_infer_set_ = true;
+    thread_pynative_infer_ = enable;
+  }
+  static void reset_thread_pynative_infer() { thread_pynative_infer_set_ = false; }
+
   std::thread tdt_print_;
 
   template <typename T>
@@ -153,6 +164,8 @@ class MsContext {
  private:
   inline static DeviceSeter seter_ = nullptr;
   inline static DeviceTypeSeter device_type_seter_ = nullptr;
+  inline static thread_local bool thread_pynative_infer_set_ = false;
+  inline static thread_local bool thread_pynative_infer_ = false;
   static std::shared_ptr<MsContext> inst_context_;
   static std::map<std::string, MsBackendPolicy> policy_map_;
 
@@ -198,6 +211,9 @@ inline void MsContext::set_param<std::string>(MsCtxParam param, const std::strin
 // get method implementation for type bool/int/uint32_t/float/std::string
 template <>
 inline const bool &MsContext::get_param<bool>(MsCtxParam param) const {
+  if (param == MS_CTX_ENABLE_PYNATIVE_INFER && thread_pynative_infer_set_) {
+    return thread_pynative_infer_;
+  }
   return bool_params_[param - MS_CTX_TYPE_BOOL_BEGIN];
 }
 
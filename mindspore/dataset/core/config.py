@@ -197,6 +197,39 @@ def get_callback_timeout():
     return _config.get_callback_timeout()
 
 
+def set_lock_free_connector(lock_free):
+    """
+    Set whether the connectors between operators are built over lock free queues.
+    Lock free queues spin for a short while before blocking, which cuts the hand-off latency between
+    operators at the cost of some CPU time. It takes effect for pipelines created afterwards.
+
+    Args:
+        lock_free (bool): Whether to use lock free connectors.
+
+    Raises:
+        TypeError: If lock_free is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Build the connectors of the following pipelines over lock free queues.
+        >>> ds.config.set_lock_free_connector(True)
+    """
+    if not isinstance(lock_free, bool):
+        raise TypeError("lock_free must be a boolean.")
+    _config.set_lock_free_connector(lock_free)
+
+
+def get_lock_free_connector():
+    """
+    Get whether the connectors between operators are built over lock free queues.
+
+    Returns:
+        Bool, whether lock free connectors are used.
+    """
+    return _config.get_lock_free_connector()
+
+
 def __str__():
     """
     String representation of the configurations.
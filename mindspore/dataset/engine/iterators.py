@@ -341,7 +341,7 @@ class DictIterator(Iterator):
 
         if self.output_numpy:
             return {k: v.as_array() for k, v in self.depipeline.GetNextAsMap().items()}
-        return {k: Tensor(v.as_array()) for k, v in self.depipeline.GetNextAsMap().items()}
+        return {k: Tensor.from_numpy(v.as_array()) for k, v in self.depipeline.GetNextAsMap().items()}
 
 
 class TupleIterator(Iterator):
@@ -372,7 +372,7 @@ class TupleIterator(Iterator):
 
         if self.output_numpy:
             return [t.as_array() for t in self.depipeline.GetNextAsList()]
-        return [Tensor(t.as_array()) for t in self.depipeline.GetNextAsList()]
+        return [Tensor.from_numpy(t.as_array()) for t in self.depipeline.GetNextAsList()]
 
 
 class DummyIterator():
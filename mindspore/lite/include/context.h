@@ -66,6 +66,7 @@ struct Context {
   int thread_num_ = 2; /**< thread number config for thread pool */
   AllocatorPtr allocator = nullptr;
   DeviceContextVector device_list_ = {{DT_CPU, {false, MID_CPU}}};
+  bool enable_static_memory_ = false; /**< plan activation tensors into one arena when compiling graph */
 };
 }  // namespace mindspore::lite
 #endif  // MINDSPORE_LITE_INCLUDE_CONTEXT_H_
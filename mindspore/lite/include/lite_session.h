@@ -118,6 +118,13 @@ class MS_API LiteSession {
   ///
   /// \return STATUS as an error code of resize inputs, STATUS is defined in errorcode.h.
   virtual int Resize(const std::vector<tensor::MSTensor *> &inputs, const std::vector<std::vector<int>> &dims) = 0;
+
+  /// \brief Get the size of the arena holding activation tensors.
+  ///
+  /// \note The arena is planned by CompileGraph and Resize when enable_static_memory_ of the context is true.
+  ///
+  /// \return Bytes of the arena, 0 if activation tensors are allocated dynamically.
+  virtual size_t GetStaticMemorySize() const { return 0; }
 };
 }  // namespace session
 }  // namespace mindspore
@@ -57,6 +57,12 @@ void PostFuncBiasReluC4(float *dst, const float *src, const float *bias, size_t
                         size_t plane_size, size_t plane_stride, size_t relu_type);
 #endif
 
+#ifdef ENABLE_SSE
+void ConvDwFp32Center(float *dst, const float *src, const float *weight, const float *bias, size_t height, size_t width,
+                      size_t kernel_h, size_t kernel_w, size_t out_h_step, size_t block_channel, size_t in_sh_step,
+                      size_t in_sw_step, size_t in_kh_step, size_t in_kw_step, size_t relu, size_t relu6);
+#endif
+
 #ifdef ENABLE_ARM64
 void BiasAdd(const float *bias, float *data, size_t oc4, size_t plan_size);
 void BiasAddRelu6(const float *bias, float *data, size_t oc4, size_t plan_size);
@@ -15,6 +15,10 @@
  */
 
 #include "nnacl/fp32/matmul.h"
+#ifdef ENABLE_SSE
+#include <immintrin.h>
+#include "nnacl/nnacl_utils.h"
+#endif
 
 void RowMajor2ColMajor(float *src_ptr, float *dst_ptr, int row, int col) {
   for (int r = 0; r < row; ++r) {
@@ -60,6 +64,20 @@ void RowMajor2Row12Major(float *src_ptr, float *dst_ptr, int row, int col) {
   return;
 }
 
+#ifdef ENABLE_SSE
+static inline void Transpose4x4Sse(const float *src, size_t src_stride, float *dst, size_t dst_stride) {
+  __m128 row0 = _mm_loadu_ps(src);
+  __m128 row1 = _mm_loadu_ps(src + src_stride);
+  __m128 row2 = _mm_loadu_ps(src + 2 * src_stride);
+  __m128 row3 = _mm_loadu_ps(src + 3 * src_stride);
+  _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+  _mm_storeu_ps(dst, row0);
+  _mm_storeu_ps(dst + dst_stride, row1);
+  _mm_storeu_ps(dst + 2 * dst_stride, row2);
+  _mm_storeu_ps(dst + 3 * dst_stride, row3);
+}
+#endif
+
 void RowMajor2Col12Major(float *src_ptr, float *dst_ptr, size_t row, size_t col) {
   size_t row_up_12 = UP_ROUND(row, C12NUM);
   size_t row12 = row / C12NUM * C12NUM;
@@ -190,6 +208,10 @@ void RowMajor2Col12Major(float *src_ptr, float *dst_ptr, size_t row, size_t col)
         :
         : [ dst_c ] "r"(dst_c), [ src_c ] "r"(src_c), [ stride ] "r"(stride)
         : "r10", "r12", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12", "q13", "q14", "q15");
+#elif defined(ENABLE_SSE)
+      Transpose4x4Sse(src_c, col, dst_c, C12NUM);
+      Transpose4x4Sse(src_c + C4NUM * col, col, dst_c + C4NUM, C12NUM);
+      Transpose4x4Sse(src_c + C8NUM * col, col, dst_c + C8NUM, C12NUM);
 #else
       for (int tr = 0; tr < C12NUM; tr++) {
         for (int tc = 0; tc < C4NUM; tc++) {
@@ -365,6 +387,9 @@ void RowMajor2Col8Major(float *src_ptr, float *dst_ptr, size_t row, size_t col)
         :
         : [ dst_c ] "r"(dst_c), [ src_c ] "r"(src_c), [ stride ] "r"(stride)
         : "r10", "r11", "q0", "q1", "q2", "q3", "q4", "q5", "q6", "q7");
+#elif defined(ENABLE_SSE)
+      Transpose4x4Sse(src_c, col, dst_c, C8NUM);
+      Transpose4x4Sse(src_c + C4NUM * col, col, dst_c + C4NUM, C8NUM);
 #else
       for (int tr = 0; tr < 8; tr++) {
         for (int tc = 0; tc < 4; tc++) {
@@ -565,6 +590,12 @@ void MatMulOpt(const float *a, const float *b, float *c, const float *bias, ActT
   } else {
     MatmulFloatNeon32Opt(a, b, c, bias, (int)act_type, deep, row, col, stride, (int)(out_type));
   }
+#elif defined(ENABLE_SSE)
+  if (X86SupportAvx2Fma()) {
+    MatmulFloatAvx2Opt(a, b, c, bias, (int)act_type, deep, row, col, stride, out_type);
+  } else {
+    MatMul12x8(a, b, c, bias, act_type, deep, row, col, stride, out_type);
+  }
 #else
   MatMul12x8(a, b, c, bias, act_type, deep, row, col, stride, out_type);
 #endif
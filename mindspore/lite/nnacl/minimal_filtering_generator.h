@@ -19,6 +19,8 @@
 
 #ifdef ENABLE_ARM
 #include <arm_neon.h>
+#elif defined(ENABLE_SSE)
+#include "nnacl/x86_64/neon_compat_sse.h"
 #endif
 #include <stdbool.h>
 #include "nnacl/pack.h"
@@ -52,7 +54,7 @@ void MatrixMultiplyWinograd(const float *matix_a, const float *matrix_b, float *
 int WinogradWeightTransform(const float *weight_data, float *winograd_data, float *matrix_g, float *matrix_gt,
                             int oc_block, int input_unit_, int kernel_unit_, int channel, int batch, bool pack);
 
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
 void MatrixMultiplyVec(const float32x4_t *matrix_a, const float32x4_t *matrix_b, float32x4_t *matrix_c,
                        const float *bias, int m, int k, int n);
 #endif
@@ -25,3 +25,10 @@ uint32_t getHwCap(int hwcap_type) {
   return ret;
 }
 #endif
+
+#ifdef ENABLE_SSE
+bool X86SupportAvx2Fma(void) {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+#endif
@@ -18,12 +18,16 @@
 #define MINDSPORE_LITE_NNACL_NNACL_UTILS_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #ifdef __cplusplus
 extern "C" {
 #endif
 #if defined(__arm__) || defined(__aarch64__)
 uint32_t getHwCap(int hwcap_type);
 #endif
+#ifdef ENABLE_SSE
+bool X86SupportAvx2Fma(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -79,7 +79,7 @@ void GeneralInputTransformUnit(const float *src_data, float *dst_data, float *ma
                                int dst_step, int in_unit) {
   int len = in_unit * in_unit;
   if (len > MAX_LEN) return;
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[MAX_LEN];
   float32x4_t t[MAX_LEN];
   float32x4_t m[MAX_LEN];
@@ -118,7 +118,7 @@ void GeneralOutputTransformUnit(const float *src_data, float *dst_data, const fl
   if (src_len > MAX_LEN) {
     return;
   }
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[MAX_LEN];
   float32x4_t t[MAX_LEN];
   float32x4_t m[MAX_LEN];
@@ -172,7 +172,7 @@ void GeneralOutputTransformUnit(const float *src_data, float *dst_data, const fl
 InputTransFunc GetInputTransFunc(int input_unit) { return InputTransFuncList[input_unit]; }
 
 void InputTransform4x4Unit(const float *src_data, float *dst_data, int src_step, int dst_step, int real_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   if (real_c == 4) {
     float32x4_t src[16];
     float32x4_t t[16];
@@ -222,13 +222,13 @@ void InputTransform4x4Unit(const float *src_data, float *dst_data, int src_step,
         dst_data[i + k * dst_step] = m[k];
       }
     }
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   }
 #endif
 }
 
 void InputTransform6x6Unit(const float *src_data, float *dst_data, int src_step, int dst_step, int real_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   if (real_c == 4) {
     float32x4_t src[36];
     float32x4_t t[36];
@@ -299,13 +299,13 @@ void InputTransform6x6Unit(const float *src_data, float *dst_data, int src_step,
         dst_data[i + k * dst_step] = m[k];
       }
     }
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   }
 #endif
 }
 
 void InputTransform8x8Unit(const float *src_data, float *dst_data, int src_step, int dst_step, int real_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   if (real_c == 4) {
     float32x4_t src[64];
     float32x4_t t[64];
@@ -405,7 +405,7 @@ void InputTransform8x8Unit(const float *src_data, float *dst_data, int src_step,
         dst_data[i + k * dst_step] = m[k];
       }
     }
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   }
 #endif
 }
@@ -442,7 +442,7 @@ OutputTransFunc GetOutputTransFunc(int input_unit, int output_unit, ActType act_
 
 void OutputTransform4x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[8];
   float32x4_t m[4];
@@ -504,7 +504,7 @@ void OutputTransform4x2Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform4x2ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[8];
   float32x4_t m[4];
@@ -571,7 +571,7 @@ void OutputTransform4x2ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform4x2Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[8];
   float32x4_t m[4];
@@ -642,7 +642,7 @@ void OutputTransform4x2Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform4x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[12];
   float32x4_t m[9];
@@ -710,7 +710,7 @@ void OutputTransform4x3Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform4x3ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[12];
   float32x4_t m[9];
@@ -784,7 +784,7 @@ void OutputTransform4x3ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform4x3Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[12];
   float32x4_t m[9];
@@ -863,7 +863,7 @@ void OutputTransform4x3Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform6x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[12];
   float32x4_t m[4];
@@ -933,7 +933,7 @@ void OutputTransform6x2Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform6x2ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[12];
   float32x4_t m[4];
@@ -1008,7 +1008,7 @@ void OutputTransform6x2ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform6x2Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[12];
   float32x4_t m[4];
@@ -1087,7 +1087,7 @@ void OutputTransform6x2Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform6x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[18];
   float32x4_t m[9];
@@ -1160,7 +1160,7 @@ void OutputTransform6x3Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform6x3ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[18];
   float32x4_t m[9];
@@ -1239,7 +1239,7 @@ void OutputTransform6x3ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform6x3Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[18];
   float32x4_t m[9];
@@ -1323,7 +1323,7 @@ void OutputTransform6x3Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform6x4Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[24];
   float32x4_t m[16];
@@ -1401,7 +1401,7 @@ void OutputTransform6x4Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform6x4ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[24];
   float32x4_t m[16];
@@ -1486,7 +1486,7 @@ void OutputTransform6x4ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform6x4Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[24];
   float32x4_t m[16];
@@ -1577,7 +1577,7 @@ void OutputTransform6x4Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform6x5Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[30];
   float32x4_t m[25];
@@ -1659,7 +1659,7 @@ void OutputTransform6x5Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform6x5ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[30];
   float32x4_t m[25];
@@ -1749,7 +1749,7 @@ void OutputTransform6x5ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform6x5Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[30];
   float32x4_t m[25];
@@ -1846,7 +1846,7 @@ void OutputTransform6x5Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[16];
   float32x4_t m[4];
@@ -1924,7 +1924,7 @@ void OutputTransform8x2Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x2ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[16];
   float32x4_t m[4];
@@ -2007,7 +2007,7 @@ void OutputTransform8x2ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x2Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[16];
   float32x4_t m[4];
@@ -2094,7 +2094,7 @@ void OutputTransform8x2Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[24];
   float32x4_t m[9];
@@ -2179,7 +2179,7 @@ void OutputTransform8x3Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x3ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[24];
   float32x4_t m[9];
@@ -2270,7 +2270,7 @@ void OutputTransform8x3ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x3Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[24];
   float32x4_t m[9];
@@ -2366,7 +2366,7 @@ void OutputTransform8x3Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x4Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[32];
   float32x4_t m[16];
@@ -2458,7 +2458,7 @@ void OutputTransform8x4Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x4ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[32];
   float32x4_t m[16];
@@ -2557,7 +2557,7 @@ void OutputTransform8x4ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x4Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[32];
   float32x4_t m[16];
@@ -2662,7 +2662,7 @@ void OutputTransform8x4Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x5Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[40];
   float32x4_t m[25];
@@ -2760,7 +2760,7 @@ void OutputTransform8x5Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x5ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[40];
   float32x4_t m[25];
@@ -2866,7 +2866,7 @@ void OutputTransform8x5ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x5Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[40];
   float32x4_t m[25];
@@ -2979,7 +2979,7 @@ void OutputTransform8x5Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[48];
   float32x4_t m[36];
@@ -3092,7 +3092,7 @@ void OutputTransform8x6Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x6ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[48];
   float32x4_t m[36];
@@ -3214,7 +3214,7 @@ void OutputTransform8x6ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x6Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[48];
   float32x4_t m[36];
@@ -3344,7 +3344,7 @@ void OutputTransform8x6Relu6Unit(const float *src_data, float *dst_data, const f
 
 void OutputTransform8x7Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step, int dst_step,
                             int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[56];
   float32x4_t m[49];
@@ -3464,7 +3464,7 @@ void OutputTransform8x7Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x7ReluUnit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                 int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[56];
   float32x4_t m[49];
@@ -3594,7 +3594,7 @@ void OutputTransform8x7ReluUnit(const float *src_data, float *dst_data, const fl
 
 void OutputTransform8x7Relu6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                                  int dst_step, int out_c, int r_w, int r_h, int r_c) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[56];
   float32x4_t m[49];
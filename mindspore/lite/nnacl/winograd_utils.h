@@ -19,6 +19,8 @@
 
 #ifdef ENABLE_ARM
 #include <arm_neon.h>
+#elif defined(ENABLE_SSE)
+#include "nnacl/x86_64/neon_compat_sse.h"
 #endif
 #include "nnacl/conv_parameter.h"
 #include "nnacl/op_base.h"
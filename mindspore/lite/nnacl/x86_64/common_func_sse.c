@@ -0,0 +1,148 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_SSE
+#include <immintrin.h>
+#include "nnacl/fp32/common_func.h"
+
+static inline __m128 ActivateSse(__m128 value, size_t relu, size_t relu6) {
+  if (relu6) {
+    value = _mm_min_ps(value, _mm_set1_ps(6.0f));
+  }
+  if (relu || relu6) {
+    value = _mm_max_ps(value, _mm_setzero_ps());
+  }
+  return value;
+}
+
+// Same contract as the arm assembly: the steps are in bytes and every output pixel holds one block of C4NUM channels.
+void ConvDwFp32Center(float *dst, const float *src, const float *weight, const float *bias, size_t height, size_t width,
+                      size_t kernel_h, size_t kernel_w, size_t out_h_step, size_t block_channel, size_t in_sh_step,
+                      size_t in_sw_step, size_t in_kh_step, size_t in_kw_step, size_t relu, size_t relu6) {
+  out_h_step /= sizeof(float);
+  block_channel /= sizeof(float);
+  in_sh_step /= sizeof(float);
+  in_sw_step /= sizeof(float);
+  in_kh_step /= sizeof(float);
+  in_kw_step /= sizeof(float);
+  __m128 bias_v = _mm_loadu_ps(bias);
+  float *dst_h = dst;
+  const float *src_h = src;
+  for (size_t oh = 0; oh < height; oh++) {
+    float *dst_w = dst_h;
+    const float *src_w = src_h;
+    size_t ow = 0;
+    // four output pixels at a time to hide the latency of the accumulation
+    for (; ow + C4NUM <= width; ow += C4NUM) {
+      __m128 acc0 = bias_v;
+      __m128 acc1 = bias_v;
+      __m128 acc2 = bias_v;
+      __m128 acc3 = bias_v;
+      const float *src_kh = src_w;
+      const float *weight_kh = weight;
+      for (size_t kh = 0; kh < kernel_h; kh++) {
+        const float *src_kw = src_kh;
+        const float *weight_kw = weight_kh;
+        for (size_t kw = 0; kw < kernel_w; kw++) {
+          __m128 weight_v = _mm_loadu_ps(weight_kw);
+          acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(src_kw), weight_v));
+          acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(src_kw + in_sw_step), weight_v));
+          acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(src_kw + 2 * in_sw_step), weight_v));
+          acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(src_kw + 3 * in_sw_step), weight_v));
+          src_kw += in_kw_step;
+          weight_kw += C4NUM;
+        }
+        src_kh += in_kh_step;
+        weight_kh += kernel_w * C4NUM;
+      }
+      _mm_storeu_ps(dst_w, ActivateSse(acc0, relu, relu6));
+      _mm_storeu_ps(dst_w + block_channel, ActivateSse(acc1, relu, relu6));
+      _mm_storeu_ps(dst_w + 2 * block_channel, ActivateSse(acc2, relu, relu6));
+      _mm_storeu_ps(dst_w + 3 * block_channel, ActivateSse(acc3, relu, relu6));
+      dst_w += C4NUM * block_channel;
+      src_w += C4NUM * in_sw_step;
+    }
+    for (; ow < width; ow++) {
+      __m128 acc = bias_v;
+      const float *src_kh = src_w;
+      const float *weight_kh = weight;
+      for (size_t kh = 0; kh < kernel_h; kh++) {
+        const float *src_kw = src_kh;
+        const float *weight_kw = weight_kh;
+        for (size_t kw = 0; kw < kernel_w; kw++) {
+          acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(src_kw), _mm_loadu_ps(weight_kw)));
+          src_kw += in_kw_step;
+          weight_kw += C4NUM;
+        }
+        src_kh += in_kh_step;
+        weight_kh += kernel_w * C4NUM;
+      }
+      _mm_storeu_ps(dst_w, ActivateSse(acc, relu, relu6));
+      dst_w += block_channel;
+      src_w += in_sw_step;
+    }
+    dst_h += out_h_step;
+    src_h += in_sh_step;
+  }
+}
+
+static inline void MultiplyAddSse(float *dst, const float *src, float b, int len) {
+  __m128 b_v = _mm_set1_ps(b);
+  for (int j = 0; j < len; j += C4NUM) {
+    _mm_storeu_ps(dst + j, _mm_add_ps(_mm_loadu_ps(dst + j), _mm_mul_ps(_mm_loadu_ps(src + j), b_v)));
+  }
+}
+
+// M = B * S, the unit step is always a multiple of C4NUM.
+void WinogradTransLeft(const float *S, const float *B, float *M, size_t w, size_t h, size_t k, size_t length) {
+  int unit_step = C4NUM * length;
+  for (int y = 0; y < h; ++y) {
+    float *dst_y = M + y * w * unit_step;
+    for (int x = 0; x < w; ++x) {
+      float *dst_x = dst_y + x * unit_step;
+      const float *src_x = S + x * unit_step;
+      memset(dst_x, 0, unit_step * sizeof(float));
+      for (int i = 0; i < k; ++i) {
+        float b = B[i * h + y];
+        if (0.0f == b) {
+          continue;
+        }
+        MultiplyAddSse(dst_x, src_x + i * w * unit_step, b, unit_step);
+      }
+    }
+  }
+}
+
+// M = S * B
+void WinogradTransRight(const float *S, const float *B, float *M, size_t w, size_t h, size_t k, size_t length) {
+  int unit_step = C4NUM * length;
+  for (int y = 0; y < h; ++y) {
+    float *dst_y = M + y * w * unit_step;
+    const float *src_y = S + y * k * unit_step;
+    for (int x = 0; x < w; ++x) {
+      float *dst_x = dst_y + x * unit_step;
+      memset(dst_x, 0, unit_step * sizeof(float));
+      for (int i = 0; i < k; ++i) {
+        float b = B[i * h + x];
+        if (0.0f == b) {
+          continue;
+        }
+        MultiplyAddSse(dst_x, src_y + i * unit_step, b, unit_step);
+      }
+    }
+  }
+}
+#endif
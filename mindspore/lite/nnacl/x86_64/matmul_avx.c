@@ -0,0 +1,104 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_SSE
+#include <immintrin.h>
+#include "nnacl/fp32/matmul.h"
+
+#define AVX2_FMA_TARGET __attribute__((target("avx2,fma")))
+
+AVX2_FMA_TARGET static void StoreTile12x8(const __m256 *dst_tile, float *c, int row_start, int row_cnt, int col_start,
+                                          int col_cnt, int col, int row_12, size_t stride, int out_type) {
+  float tmp[C8NUM];
+  for (int i = 0; i < row_cnt; ++i) {
+    int r = row_start + i;
+    float *dst = NULL;
+    if (out_type == OutType_C8) {
+      dst = c + col_start * row_12 + r * C8NUM;
+    } else if (out_type == OutType_Nhwc) {
+      dst = c + r * stride + col_start;
+    } else {
+      dst = c + r * col * stride + col_start * stride;
+    }
+    if (col_cnt == C8NUM) {
+      _mm256_storeu_ps(dst, dst_tile[i]);
+    } else {
+      _mm256_storeu_ps(tmp, dst_tile[i]);
+      for (int j = 0; j < col_cnt; ++j) {
+        dst[j] = tmp[j];
+      }
+    }
+  }
+}
+
+// a is packed by RowMajor2Col12Major and b by RowMajor2Col8Major, a 12x8 tile of c is kept in 12 ymm registers.
+AVX2_FMA_TARGET void MatmulFloatAvx2Opt(const float *a, const float *b, float *c, const float *bias, int act_type,
+                                        int depth, int row, int col, size_t stride, int out_type) {
+  int row_12 = UP_ROUND(row, C12NUM);
+  int col_8 = UP_ROUND(col, C8NUM);
+  __m256 zero = _mm256_setzero_ps();
+  __m256 six = _mm256_set1_ps(6.0f);
+  for (int rs = 0; rs < row_12; rs += C12NUM) {
+    const float *a_block = a + rs * depth;
+    int row_cnt = out_type == OutType_C8 ? C12NUM : MSMIN(row - rs, C12NUM);
+    for (int cs = 0; cs < col_8; cs += C8NUM) {
+      const float *b_block = b + cs * depth;
+      __m256 dst0 = zero, dst1 = zero, dst2 = zero, dst3 = zero, dst4 = zero, dst5 = zero;
+      __m256 dst6 = zero, dst7 = zero, dst8 = zero, dst9 = zero, dst10 = zero, dst11 = zero;
+      for (int d = 0; d < depth; ++d) {
+        const float *a_d = a_block + d * C12NUM;
+        __m256 b_d = _mm256_loadu_ps(b_block + d * C8NUM);
+        dst0 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d), b_d, dst0);
+        dst1 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 1), b_d, dst1);
+        dst2 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 2), b_d, dst2);
+        dst3 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 3), b_d, dst3);
+        dst4 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 4), b_d, dst4);
+        dst5 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 5), b_d, dst5);
+        dst6 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 6), b_d, dst6);
+        dst7 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 7), b_d, dst7);
+        dst8 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 8), b_d, dst8);
+        dst9 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 9), b_d, dst9);
+        dst10 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 10), b_d, dst10);
+        dst11 = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + 11), b_d, dst11);
+      }
+      __m256 dst_tile[C12NUM] = {dst0, dst1, dst2, dst3, dst4, dst5, dst6, dst7, dst8, dst9, dst10, dst11};
+
+      int col_cnt = out_type == OutType_C8 ? C8NUM : MSMIN(col - cs, C8NUM);
+      if (bias != NULL) {
+        float bias_tmp[C8NUM] = {0};
+        for (int j = 0; j < col_cnt; ++j) {
+          bias_tmp[j] = bias[cs + j];
+        }
+        __m256 bias_v = _mm256_loadu_ps(bias_tmp);
+        for (int i = 0; i < C12NUM; ++i) {
+          dst_tile[i] = _mm256_add_ps(dst_tile[i], bias_v);
+        }
+      }
+      if (act_type == ActType_Relu6) {
+        for (int i = 0; i < C12NUM; ++i) {
+          dst_tile[i] = _mm256_min_ps(dst_tile[i], six);
+        }
+      }
+      if (act_type != ActType_No) {
+        for (int i = 0; i < C12NUM; ++i) {
+          dst_tile[i] = _mm256_max_ps(dst_tile[i], zero);
+        }
+      }
+      StoreTile12x8(dst_tile, c, rs, row_cnt, cs, col_cnt, col, row_12, stride, out_type);
+    }
+  }
+}
+#endif
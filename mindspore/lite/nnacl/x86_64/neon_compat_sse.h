@@ -0,0 +1,51 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_NNACL_X86_64_NEON_COMPAT_SSE_H_
+#define MINDSPORE_LITE_NNACL_X86_64_NEON_COMPAT_SSE_H_
+
+#ifdef ENABLE_SSE
+#include <immintrin.h>
+
+// The 128-bit neon intrinsics used by the winograd transforms, mapped to sse so x86 shares the same vector code.
+typedef __m128 float32x4_t;
+
+static inline float32x4_t vld1q_f32(const float *ptr) { return _mm_loadu_ps(ptr); }
+
+static inline void vst1q_f32(float *ptr, float32x4_t val) { _mm_storeu_ps(ptr, val); }
+
+static inline float32x4_t vdupq_n_f32(float val) { return _mm_set1_ps(val); }
+
+static inline float32x4_t vmovq_n_f32(float val) { return _mm_set1_ps(val); }
+
+static inline float32x4_t vaddq_f32(float32x4_t a, float32x4_t b) { return _mm_add_ps(a, b); }
+
+static inline float32x4_t vsubq_f32(float32x4_t a, float32x4_t b) { return _mm_sub_ps(a, b); }
+
+static inline float32x4_t vmulq_f32(float32x4_t a, float32x4_t b) { return _mm_mul_ps(a, b); }
+
+static inline float32x4_t vmulq_n_f32(float32x4_t a, float b) { return _mm_mul_ps(a, _mm_set1_ps(b)); }
+
+static inline float32x4_t vmlaq_f32(float32x4_t a, float32x4_t b, float32x4_t c) {
+  return _mm_add_ps(a, _mm_mul_ps(b, c));
+}
+
+static inline float32x4_t vmaxq_f32(float32x4_t a, float32x4_t b) { return _mm_max_ps(a, b); }
+
+static inline float32x4_t vminq_f32(float32x4_t a, float32x4_t b) { return _mm_min_ps(a, b); }
+#endif
+
+#endif  // MINDSPORE_LITE_NNACL_X86_64_NEON_COMPAT_SSE_H_
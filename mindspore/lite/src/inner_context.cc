@@ -22,6 +22,7 @@ namespace mindspore::lite {
 InnerContext::InnerContext(const Context *context) {
   this->allocator = context->allocator;
   this->thread_num_ = context->thread_num_;
+  this->enable_static_memory_ = context->enable_static_memory_;
   this->device_list_.clear();
   for (auto &device_ctx : context->device_list_) {
     this->device_list_.push_back(device_ctx);
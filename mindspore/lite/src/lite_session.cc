@@ -299,6 +299,7 @@ int LiteSession::CompileGraph(Model *model) {
     is_running_.store(false);
     return ret;
   }
+  PlanStaticMemory();
   is_running_.store(false);
   return RET_OK;
 }
@@ -314,6 +315,17 @@ int LiteSession::PrepareKernels() {
   return RET_OK;
 }
 
+void LiteSession::PlanStaticMemory() {
+  if (!context_->enable_static_memory_) {
+    return;
+  }
+  auto ret = static_memory_planner_.Plan(this->kernels_, this->outputs_);
+  if (ret != RET_OK) {
+    MS_LOG(WARNING) << "Plan static memory failed: " << ret << ", activation tensors are allocated dynamically.";
+    static_memory_planner_.Release();
+  }
+}
+
 std::vector<mindspore::tensor::MSTensor *> LiteSession::GetInputs() const { return this->input_vec_; }
 
 int LiteSession::RunGraph(const KernelCallBack &before, const KernelCallBack &after) {
@@ -407,6 +419,7 @@ LiteSession::~LiteSession() {
     MS_LOG(ERROR) << "Not support multi-threading";
     return;
   }
+  static_memory_planner_.Release();
   for (size_t i = 0; i < tensors_.size(); i++) {
     auto *tensor = tensors_.at(i);
     MS_ASSERT(tensor != nullptr);
@@ -512,6 +525,8 @@ int LiteSession::Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs
     return ret;
   }
 
+  // the planned offsets depend on the old shapes, unbind the tensors before they are reshaped
+  static_memory_planner_.Release();
   Scheduler scheduler(context_);
   ret = scheduler.ReSizeKernels(kernels_);
   if (ret != RET_OK) {
@@ -520,9 +535,11 @@ int LiteSession::Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs
     if (resize_ret != RET_OK) {
       MS_LOG(ERROR) << "restore kernel size fail!ret: " << resize_ret;
     }
+    PlanStaticMemory();
     is_running_.store(false);
     return ret;
   }
+  PlanStaticMemory();
   is_running_.store(false);
   return RET_OK;
 }
@@ -29,6 +29,7 @@
 #include "src/inner_context.h"
 #include "schema/model_generated.h"
 #include "src/executor.h"
+#include "src/static_memory_planner.h"
 #include "src/tensor.h"
 #if SUPPORT_GPU
 #include "src/runtime/opencl/opencl_runtime.h"
@@ -65,6 +66,8 @@ class LiteSession : public session::LiteSession {
   int Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs,
              const std::vector<std::vector<int>> &dims) override;
 
+  size_t GetStaticMemorySize() const override { return static_memory_planner_.arena_size(); }
+
  protected:
   int ConvertTensors(const lite::Model *model);
 
@@ -88,6 +91,8 @@ class LiteSession : public session::LiteSession {
 
   int PrepareKernels();
 
+  void PlanStaticMemory();
+
  private:
   void ResetInputsShape(const std::vector<std::vector<int>> &dims);
 
@@ -111,6 +116,7 @@ class LiteSession : public session::LiteSession {
   // graph output tensor name -- output tensor
   std::unordered_map<std::string, mindspore::tensor::MSTensor *> output_tensor_map_;
   Executor *executor = nullptr;
+  StaticMemoryPlanner static_memory_planner_;
   std::atomic<bool> is_running_ = false;
 #if SUPPORT_GPU
   opencl::OpenCLRuntimeWrapper ocl_runtime_wrap_;
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/static_memory_planner.h"
+#include <algorithm>
+#include <unordered_map>
+#include "src/sub_graph_kernel.h"
+#include "src/common/log_adapter.h"
+#include "include/errorcode.h"
+#include "utils/mem_block_plan.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr size_t kArenaAlignSize = 64;
+size_t AlignSize(size_t size) { return (size + kArenaAlignSize - 1) / kArenaAlignSize * kArenaAlignSize; }
+}  // namespace
+
+int StaticMemoryPlanner::CollectNodes(const std::vector<kernel::LiteKernel *> &kernels,
+                                      std::vector<kernel::LiteKernel *> *nodes,
+                                      std::vector<Tensor *> *excluded_tensors) {
+  MS_ASSERT(nodes != nullptr);
+  MS_ASSERT(excluded_tensors != nullptr);
+  for (auto kernel : kernels) {
+    MS_ASSERT(kernel != nullptr);
+    auto subgraph_type = kernel->subgraph_type();
+    if (subgraph_type == kernel::kNotSubGraph) {
+      nodes->emplace_back(kernel);
+      continue;
+    }
+    if (subgraph_type != kernel::kCpuFP32SubGraph && subgraph_type != kernel::kCpuFP16SubGraph) {
+      MS_LOG(INFO) << "Static memory plan only supports cpu subgraph, subgraph type: " << subgraph_type;
+      return RET_NOT_SUPPORT;
+    }
+    if (subgraph_type == kernel::kCpuFP16SubGraph) {
+      // outputs of fp16 subgraph are reallocated as fp32 after run, their size is unknown to the plan
+      auto out_tensors = kernel->out_tensors();
+      excluded_tensors->insert(excluded_tensors->end(), out_tensors.begin(), out_tensors.end());
+    }
+    auto sub_nodes = reinterpret_cast<kernel::SubGraphKernel *>(kernel)->nodes();
+    nodes->insert(nodes->end(), sub_nodes.begin(), sub_nodes.end());
+  }
+  for (auto node : *nodes) {
+    if (!node->InferShapeDone()) {
+      MS_LOG(INFO) << "Output shape of " << node->name() << " is unknown until runtime, can not plan static memory";
+      return RET_NOT_SUPPORT;
+    }
+  }
+  return RET_OK;
+}
+
+int StaticMemoryPlanner::Plan(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<Tensor *> &outputs) {
+  Release();
+  std::vector<kernel::LiteKernel *> nodes;
+  std::vector<Tensor *> excluded_tensors;
+  auto ret = CollectNodes(kernels, &nodes, &excluded_tensors);
+  if (ret != RET_OK) {
+    return ret;
+  }
+
+  std::vector<MemBlock> blocks;
+  std::unordered_map<Tensor *, size_t> block_index;
+  for (size_t step = 0; step < nodes.size(); ++step) {
+    auto node = nodes[step];
+    for (auto tensor : node->in_tensors()) {
+      auto iter = block_index.find(tensor);
+      if (iter != block_index.end()) {
+        blocks[iter->second].last_step_ = step;
+      }
+    }
+    for (auto tensor : node->out_tensors()) {
+      MS_ASSERT(tensor != nullptr);
+      if (tensor->category() != Tensor::VAR || tensor->data_c() != nullptr || tensor->Size() == 0 ||
+          block_index.find(tensor) != block_index.end() || IsContain(excluded_tensors, tensor)) {
+        continue;
+      }
+      MemBlock block;
+      block.tensor_ = tensor;
+      block.size_ = AlignSize(tensor->Size());
+      block.def_step_ = step;
+      block.last_step_ = step;
+      block_index[tensor] = blocks.size();
+      blocks.emplace_back(block);
+    }
+  }
+  // graph outputs are read after the graph finishes, they must never be reused
+  for (auto tensor : outputs) {
+    auto iter = block_index.find(tensor);
+    if (iter != block_index.end()) {
+      blocks[iter->second].last_step_ = nodes.size();
+    }
+  }
+  if (blocks.empty()) {
+    return RET_OK;
+  }
+
+  size_t naive_size = 0;
+  for (auto &block : blocks) {
+    naive_size += block.size_;
+  }
+  auto arena_size = AssignMemBlockOffsets(&blocks, kArenaAlignSize);
+  arena_ = malloc(arena_size);
+  if (arena_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc static memory arena failed, size: " << arena_size;
+    return RET_MEMORY_FAILED;
+  }
+  arena_size_ = arena_size;
+  for (auto &block : blocks) {
+    block.tensor_->set_data(reinterpret_cast<uint8_t *>(arena_) + block.offset_);
+    block.tensor_->set_own_data(false);
+    planned_tensors_.emplace_back(block.tensor_);
+  }
+  MS_LOG(INFO) << "Static memory plan: " << blocks.size() << " tensors, arena " << arena_size_ << " bytes, naive "
+               << naive_size << " bytes.";
+  return RET_OK;
+}
+
+void StaticMemoryPlanner::Release() {
+  for (auto tensor : planned_tensors_) {
+    tensor->set_data(nullptr);
+    tensor->set_own_data(true);
+  }
+  planned_tensors_.clear();
+  free(arena_);
+  arena_ = nullptr;
+  arena_size_ = 0;
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_STATIC_MEMORY_PLANNER_H_
+#define MINDSPORE_LITE_SRC_STATIC_MEMORY_PLANNER_H_
+
+#include <vector>
+#include "src/lite_kernel.h"
+#include "src/tensor.h"
+
+namespace mindspore::lite {
+// Lays the activation tensors of a compiled graph into one arena with fixed offsets. Tensors whose lifetimes do not
+// overlap in the execution order share memory, and running the graph then needs no Malloc/Free for them.
+class StaticMemoryPlanner {
+ public:
+  StaticMemoryPlanner() = default;
+  ~StaticMemoryPlanner() { Release(); }
+
+  // kernels are the scheduled kernels in execution order, outputs are read after the graph finishes.
+  int Plan(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<Tensor *> &outputs);
+
+  // unbind the planned tensors and free the arena, tensors fall back to dynamic allocation.
+  void Release();
+
+  bool planned() const { return this->arena_ != nullptr; }
+
+  size_t arena_size() const { return this->arena_size_; }
+
+ private:
+  struct MemBlock {
+    Tensor *tensor_ = nullptr;
+    size_t size_ = 0;
+    size_t def_step_ = 0;
+    size_t last_step_ = 0;
+    size_t offset_ = 0;
+  };
+
+  static int CollectNodes(const std::vector<kernel::LiteKernel *> &kernels, std::vector<kernel::LiteKernel *> *nodes,
+                          std::vector<Tensor *> *excluded_tensors);
+
+  void *arena_ = nullptr;
+  size_t arena_size_ = 0;
+  std::vector<Tensor *> planned_tensors_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_STATIC_MEMORY_PLANNER_H_
@@ -73,7 +73,7 @@ int Tensor::CopyTensor(const Tensor &srcTensor, bool copyData) {
 }
 
 Tensor::~Tensor() {
-  if (nullptr != this->data_) {
+  if (nullptr != this->data_ && this->own_data_) {
     if (this->allocator_ != nullptr) {
       this->allocator_->Free(this->data_);
     } else {
@@ -333,7 +333,7 @@ int Tensor::MallocData(mindspore::lite::Allocator *allocator) {
 }
 
 int Tensor::FreeData() {
-  if (nullptr == this->data_) {
+  if (nullptr == this->data_ || !this->own_data_) {
     return RET_OK;
   }
   if (nullptr == allocator_) {
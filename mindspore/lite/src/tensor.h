@@ -99,6 +99,11 @@ class Tensor : public mindspore::tensor::MSTensor {
 
   void set_data(void *data) { this->data_ = data; }
 
+  // data bound from outside, e.g. a statically planned arena, is neither freed nor reallocated by the tensor
+  bool own_data() const { return this->own_data_; }
+
+  void set_own_data(bool own_data) { this->own_data_ = own_data; }
+
   Category category() { return this->category_; }
 
   void SetFormat(schema::Format format) { this->format_ = format; }
@@ -135,6 +140,7 @@ class Tensor : public mindspore::tensor::MSTensor {
   schema::Format format_;
   Category category_;
   size_t ref_count_ = 0;
+  bool own_data_ = true;
   std::vector<QuantArg> quant_params_;
   mindspore::lite::Allocator *allocator_ = nullptr;
 };
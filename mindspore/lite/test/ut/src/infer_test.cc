@@ -16,6 +16,8 @@
 
 #include <cmath>
 #include <memory>
+#include <string>
+#include <vector>
 #include "schema/inner/model_generated.h"
 #include "mindspore/lite/include/model.h"
 #include "common/common_test.h"
@@ -356,4 +358,91 @@ TEST_F(InferTest, TestModel) {
   auto outputs = session->GetOutputs();
   MS_LOG(INFO) << "Passed";
 }
+
+TEST_F(InferTest, TestStaticMemoryPlan) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  // out = ((in0 + in1) + in1) + in1, the first and the last intermediate can share memory
+  for (uint32_t i = 0; i < 3; ++i) {
+    auto node = std::make_unique<schema::CNodeT>();
+    node->inputIndex = {i == 0 ? 0 : i + 1, 1};
+    node->outputIndex = {i + 2};
+    node->primitive = std::make_unique<schema::PrimitiveT>();
+    node->primitive->value.type = schema::PrimitiveType_Add;
+    node->primitive->value.value = new schema::AddT;
+    node->name = "Add" + std::to_string(i);
+    meta_graph->nodes.emplace_back(std::move(node));
+  }
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {4};
+
+  for (int i = 0; i < 2; ++i) {
+    auto input = std::make_unique<schema::TensorT>();
+    input->nodeType = schema::NodeType::NodeType_ValueNode;
+    input->format = schema::Format_NHWC;
+    input->dataType = TypeId::kNumberTypeFloat32;
+    input->dims = {1, 28, 28, 3};
+    input->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(input));
+  }
+  for (int i = 0; i < 3; ++i) {
+    auto output = std::make_unique<schema::TensorT>();
+    output->nodeType = schema::NodeType::NodeType_Parameter;
+    output->format = schema::Format_NHWC;
+    output->dataType = TypeId::kNumberTypeFloat32;
+    output->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(output));
+  }
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+
+  auto model = lite::Model::Import(content, size);
+  ASSERT_NE(nullptr, model);
+  meta_graph.reset();
+  content = nullptr;
+  auto context = new lite::InnerContext;
+  context->device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_ = lite::NO_BIND;
+  context->thread_num_ = 2;
+  context->enable_static_memory_ = true;
+  ASSERT_EQ(lite::RET_OK, context->Init());
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  auto ret = session->CompileGraph(model);
+  ASSERT_EQ(lite::RET_OK, ret);
+  size_t tensor_size = 28 * 28 * 3 * sizeof(float);
+  ASSERT_EQ(2 * tensor_size, session->GetStaticMemorySize());
+
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 2);
+  auto outputs = session->GetOutputs();
+  ASSERT_EQ(outputs.size(), 1);
+  auto out_tensor = outputs.begin()->second;
+  auto *out_data = out_tensor->MutableData();
+  for (int loop = 1; loop <= 2; ++loop) {
+    auto in_data0 = reinterpret_cast<float *>(inputs.front()->MutableData());
+    auto in_data1 = reinterpret_cast<float *>(inputs.back()->MutableData());
+    for (int i = 0; i < inputs.front()->ElementsNum(); ++i) {
+      in_data0[i] = loop;
+      in_data1[i] = 2;
+    }
+    ret = session->RunGraph();
+    ASSERT_EQ(lite::RET_OK, ret);
+    // output stays at its planned address between runs
+    ASSERT_EQ(out_data, out_tensor->MutableData());
+    std::vector<float> expect(out_tensor->ElementsNum(), loop + 6);
+    CompareOutputData(reinterpret_cast<float *>(out_data), expect.data(), out_tensor->ElementsNum(), 0.0001);
+  }
+
+  ret = session->Resize(inputs, {{1, 14, 14, 3}, {1, 14, 14, 3}});
+  ASSERT_EQ(lite::RET_OK, ret);
+  tensor_size = 14 * 14 * 3 * sizeof(float);
+  size_t align_size = 64;
+  ASSERT_EQ(2 * ((tensor_size + align_size - 1) / align_size * align_size), session->GetStaticMemorySize());
+  delete session;
+  MS_LOG(INFO) << "Passed";
+}
 }  // namespace mindspore
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <vector>
+#include "common/common_test.h"
+#include "src/common/utils.h"
+#include "nnacl/nnacl_utils.h"
+#include "nnacl/fp32/matmul.h"
+#include "nnacl/fp32/common_func.h"
+
+#ifdef ENABLE_SSE
+namespace mindspore {
+class TestX86SimdFp32 : public mindspore::CommonTest {
+ public:
+  TestX86SimdFp32() {}
+};
+
+namespace {
+void InitData(std::vector<float> *data) {
+  for (size_t i = 0; i < data->size(); ++i) {
+    data->at(i) = static_cast<float>(static_cast<int>(i * 7919 % 2000) - 1000) / 1000.0f;
+  }
+}
+
+void PackMatmulInput(int row, int deep, int col, std::vector<float> *pack_a, std::vector<float> *pack_b) {
+  std::vector<float> a(row * deep);
+  std::vector<float> b(col * deep);
+  InitData(&a);
+  InitData(&b);
+  pack_a->assign(UP_ROUND(row, C12NUM) * deep, 0);
+  pack_b->assign(UP_ROUND(col, C8NUM) * deep, 0);
+  RowMajor2Col12Major(a.data(), pack_a->data(), row, deep);
+  RowMajor2Col8Major(b.data(), pack_b->data(), col, deep);
+}
+}  // namespace
+
+TEST_F(TestX86SimdFp32, PackTest) {
+  int row = 29;
+  int col = 13;
+  std::vector<float> src(row * col);
+  InitData(&src);
+  std::vector<float> col12(UP_ROUND(row, C12NUM) * col, 0);
+  std::vector<float> col12_expect(UP_ROUND(row, C12NUM) * col, 0);
+  RowMajor2Col12Major(src.data(), col12.data(), row, col);
+  for (int r = 0; r < row; ++r) {
+    for (int c = 0; c < col; ++c) {
+      col12_expect[r / C12NUM * C12NUM * col + c * C12NUM + r % C12NUM] = src[r * col + c];
+    }
+  }
+  CompareOutputData(col12.data(), col12_expect.data(), col12.size(), 0);
+
+  std::vector<float> col8(UP_ROUND(row, C8NUM) * col, 0);
+  std::vector<float> col8_expect(UP_ROUND(row, C8NUM) * col, 0);
+  RowMajor2Col8Major(src.data(), col8.data(), row, col);
+  for (int r = 0; r < row; ++r) {
+    for (int c = 0; c < col; ++c) {
+      col8_expect[r / C8NUM * C8NUM * col + c * C8NUM + r % C8NUM] = src[r * col + c];
+    }
+  }
+  CompareOutputData(col8.data(), col8_expect.data(), col8.size(), 0);
+}
+
+TEST_F(TestX86SimdFp32, MatmulAvx2Test) {
+  if (!X86SupportAvx2Fma()) {
+    std::cout << "avx2 is not supported, skip" << std::endl;
+    return;
+  }
+  int row = 37;
+  int deep = 50;
+  int col = 19;
+  std::vector<float> pack_a;
+  std::vector<float> pack_b;
+  PackMatmulInput(row, deep, col, &pack_a, &pack_b);
+  std::vector<float> bias(UP_ROUND(col, C8NUM), 0);
+  InitData(&bias);
+  size_t out_size = UP_ROUND(row, C12NUM) * UP_ROUND(col, C8NUM);
+  for (auto act_type : {ActType_No, ActType_Relu, ActType_Relu6}) {
+    for (auto out_type : {OutType_C8, OutType_Nhwc}) {
+      std::vector<float> out(out_size, 0);
+      std::vector<float> expect(out_size, 0);
+      MatmulFloatAvx2Opt(pack_a.data(), pack_b.data(), out.data(), bias.data(), act_type, deep, row, col, col,
+                         out_type);
+      MatMul12x8(pack_a.data(), pack_b.data(), expect.data(), bias.data(), act_type, deep, row, col, col, out_type);
+      CompareOutputData(out.data(), expect.data(), out_size, 0.0001);
+    }
+  }
+
+  // the winograd tile output, one block of rows scattered with a stride
+  int tile_row = 10;
+  int stride = 3;
+  std::vector<float> out(tile_row * UP_ROUND(col, C8NUM) * stride, 0);
+  std::vector<float> expect(out.size(), 0);
+  MatmulFloatAvx2Opt(pack_a.data(), pack_b.data(), out.data(), nullptr, ActType_No, deep, tile_row,
+                     UP_ROUND(col, C8NUM), stride, OutType_TileC8);
+  MatMul12x8(pack_a.data(), pack_b.data(), expect.data(), nullptr, ActType_No, deep, tile_row, UP_ROUND(col, C8NUM),
+             stride, OutType_TileC8);
+  CompareOutputData(out.data(), expect.data(), out.size(), 0.0001);
+}
+
+TEST_F(TestX86SimdFp32, ConvDwCenterTest) {
+  int height = 5;
+  int width = 11;
+  int kernel = 3;
+  int block_channel = 8;
+  int in_w = width + kernel - 1;
+  std::vector<float> src((height + kernel - 1) * in_w * block_channel);
+  std::vector<float> weight(kernel * kernel * C4NUM);
+  std::vector<float> bias(C4NUM);
+  InitData(&src);
+  InitData(&weight);
+  InitData(&bias);
+  std::vector<float> out(height * width * block_channel, 0);
+  std::vector<float> expect(height * width * block_channel, 0);
+  size_t float_size = sizeof(float);
+  ConvDwFp32Center(out.data(), src.data(), weight.data(), bias.data(), height, width, kernel, kernel,
+                   width * block_channel * float_size, block_channel * float_size, in_w * block_channel * float_size,
+                   block_channel * float_size, in_w * block_channel * float_size, block_channel * float_size, 0, 1);
+  for (int oh = 0; oh < height; ++oh) {
+    for (int ow = 0; ow < width; ++ow) {
+      // the center kernel computes one C4 block, the rest of block_channel stays untouched
+      for (int c = 0; c < C4NUM; ++c) {
+        float sum = bias[c];
+        for (int kh = 0; kh < kernel; ++kh) {
+          for (int kw = 0; kw < kernel; ++kw) {
+            sum += src[((oh + kh) * in_w + ow + kw) * block_channel + c] * weight[(kh * kernel + kw) * C4NUM + c];
+          }
+        }
+        sum = sum > 0 ? sum : 0;
+        expect[(oh * width + ow) * block_channel + c] = sum < 6 ? sum : 6;
+      }
+    }
+  }
+  CompareOutputData(out.data(), expect.data(), out.size(), 0.0001);
+}
+
+TEST_F(TestX86SimdFp32, WinogradTransTest) {
+  size_t w = 3;
+  size_t h = 4;
+  size_t k = 5;
+  size_t length = 6;
+  size_t unit_step = C4NUM * length;
+  std::vector<float> src(w * k * unit_step * h);
+  std::vector<float> matrix_b(k * h);
+  InitData(&src);
+  InitData(&matrix_b);
+  std::vector<float> out(w * h * unit_step, 0);
+  std::vector<float> expect(w * h * unit_step, 0);
+  WinogradTransLeft(src.data(), matrix_b.data(), out.data(), w, h, k, length);
+  for (size_t y = 0; y < h; ++y) {
+    for (size_t x = 0; x < w; ++x) {
+      for (size_t i = 0; i < k; ++i) {
+        for (size_t j = 0; j < unit_step; ++j) {
+          expect[(y * w + x) * unit_step + j] += src[(i * w + x) * unit_step + j] * matrix_b[i * h + y];
+        }
+      }
+    }
+  }
+  CompareOutputData(out.data(), expect.data(), out.size(), 0.0001);
+}
+
+TEST_F(TestX86SimdFp32, MatmulBenchmark) {
+  if (!X86SupportAvx2Fma()) {
+    std::cout << "avx2 is not supported, skip" << std::endl;
+    return;
+  }
+  int row = 144;
+  int deep = 256;
+  int col = 256;
+  std::vector<float> pack_a;
+  std::vector<float> pack_b;
+  PackMatmulInput(row, deep, col, &pack_a, &pack_b);
+  std::vector<float> out(row * col, 0);
+  std::vector<float> expect(row * col, 0);
+  int loop_count = 10;
+  auto time_start = lite::GetTimeUs();
+  for (int i = 0; i < loop_count; ++i) {
+    MatmulFloatAvx2Opt(pack_a.data(), pack_b.data(), out.data(), nullptr, ActType_No, deep, row, col, col,
+                       OutType_Nhwc);
+  }
+  auto avx_time = lite::GetTimeUs() - time_start;
+  time_start = lite::GetTimeUs();
+  for (int i = 0; i < loop_count; ++i) {
+    MatMul12x8(pack_a.data(), pack_b.data(), expect.data(), nullptr, ActType_No, deep, row, col, col, OutType_Nhwc);
+  }
+  auto c_time = lite::GetTimeUs() - time_start;
+  printf("matmul %dx%dx%d average time: avx2 %f ms, c %f ms\n", row, deep, col, avx_time / loop_count / 1000.0f,
+         c_time / loop_count / 1000.0f);
+  CompareOutputData(out.data(), expect.data(), out.size(), 0.001);
+}
+}  // namespace mindspore
+#endif
@@ -32,11 +32,29 @@ def ps_context():
     return _ps_context
 
 _set_ps_context_func_map = {
-    "enable_ps": ps_context().set_ps_enable
+    "enable_ps": ps_context().set_ps_enable,
+    "ps_mode": ps_context().set_ps_mode,
+    "staleness_threshold": ps_context().set_staleness_threshold,
+    "embedding_cache_size": ps_context().set_embedding_cache_size,
+    "embedding_cache_policy": ps_context().set_embedding_cache_policy,
+    "embedding_cache_staleness": ps_context().set_embedding_cache_staleness,
+    "grad_compression": ps_context().set_grad_compression,
+    "param_grad_compression": ps_context().set_param_grad_compression,
+    "grad_compression_min_size": ps_context().set_grad_compression_min_size,
+    "grad_compression_topk_ratio": ps_context().set_grad_compression_topk_ratio
 }
 
 _get_ps_context_func_map = {
-    "enable_ps": ps_context().is_ps_enabled
+    "enable_ps": ps_context().is_ps_enabled,
+    "ps_mode": ps_context().ps_mode,
+    "staleness_threshold": ps_context().staleness_threshold,
+    "embedding_cache_size": ps_context().embedding_cache_size,
+    "embedding_cache_policy": ps_context().embedding_cache_policy,
+    "embedding_cache_staleness": ps_context().embedding_cache_staleness,
+    "grad_compression": ps_context().grad_compression,
+    "param_grad_compression": ps_context().param_grad_compression,
+    "grad_compression_min_size": ps_context().grad_compression_min_size,
+    "grad_compression_topk_ratio": ps_context().grad_compression_topk_ratio
 }
 
 def _get_ps_mode_rank():
@@ -69,12 +87,41 @@ def _set_ps_context(**kwargs):
         enable_ps (bool): Whether to enable parameter server training mode.
                           Only after enable_ps is set True, the environment variables will be effective.
                           Default: False.
+        ps_mode (str): How the servers apply the gradients of the workers, one of "sync", "async" and "ssp".
+                       "sync" averages the gradients of all workers once per step, "async" applies every
+                       gradient at once without waiting for the other workers, "ssp" applies every gradient
+                       at once but keeps the fastest worker at most staleness_threshold steps ahead of the
+                       slowest one. Default: "sync".
+        staleness_threshold (int): The number of steps a worker may run ahead of the slowest one in "ssp" mode.
+                                   Default: 1.
+        embedding_cache_size (int): The number of rows of every embedding table a worker caches, so ids which
+                                    repeat across steps are not fetched from the servers again. 0 disables
+                                    the cache. Default: 0.
+        embedding_cache_policy (str): Which rows the embedding cache keeps, "lru" or "lfu". "lru" keeps the
+                                      recently used rows, "lfu" only admits a row used more often than the row
+                                      it would evict. Default: "lru".
+        embedding_cache_staleness (int): The number of steps a cached row is used before it is fetched again.
+                                         In "async" mode the sparse gradients of the cached rows are summed up
+                                         on the worker and pushed once per this many steps too. Default: 1.
+        grad_compression (str): How the workers compress the dense gradients they push, one of "none", "fp16",
+                                "bf16", "topk" and "int8". "fp16" and "bf16" cast every element to 16 bits,
+                                "topk" only sends the largest grad_compression_topk_ratio of the elements and
+                                adds the others to the next gradient, "int8" quantizes every block of 256
+                                elements to 8 bits. Default: "none".
+        param_grad_compression (dict): The compression of the gradients of some parameters, by parameter name.
+                                       It overrides grad_compression and grad_compression_min_size.
+                                       Default: {}.
+        grad_compression_min_size (int): Gradients of fewer elements are pushed uncompressed. Default: 1024.
+        grad_compression_topk_ratio (float): The ratio of the elements "topk" sends, in (0, 1]. Default: 0.01.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
 
     Examples:
         >>> context.set_ps_context(enable_ps=True)
+        >>> context.set_ps_context(enable_ps=True, ps_mode="ssp", staleness_threshold=2)
+        >>> context.set_ps_context(enable_ps=True, grad_compression="fp16",
+        ...                        param_grad_compression={"fc3.weight": "topk"})
     """
     for key, value in kwargs.items():
         if key not in _set_ps_context_func_map:
@@ -106,6 +153,15 @@ def _reset_ps_context():
     Reset parameter server training mode context attributes to the default values:
 
     - enable_ps: False.
+    - ps_mode: "sync".
+    - staleness_threshold: 1.
+    - embedding_cache_size: 0.
+    - embedding_cache_policy: "lru".
+    - embedding_cache_staleness: 1.
+    - grad_compression: "none".
+    - param_grad_compression: {}.
+    - grad_compression_min_size: 1024.
+    - grad_compression_topk_ratio: 0.01.
     """
     ps_context().reset()
 
@@ -0,0 +1,286 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "core/batch_scheduler.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+#include "include/infer_log.h"
+
+namespace mindspore {
+namespace serving {
+BatchScheduler::BatchScheduler(int32_t max_batch_size, int32_t batch_timeout_ms, PredictFunc predict_func)
+    : max_batch_size_(std::max(max_batch_size, 1)),
+      batch_timeout_(std::max(batch_timeout_ms, 0)),
+      predict_func_(std::move(predict_func)) {}
+
+BatchScheduler::~BatchScheduler() { Stop(); }
+
+void BatchScheduler::Start() {
+  if (max_batch_size_ <= 1 || worker_.joinable()) {
+    return;
+  }
+  stop_ = false;
+  worker_ = std::thread(&BatchScheduler::WorkerLoop, this);
+  MSI_LOG(INFO) << "Batch scheduler started, max batch size " << max_batch_size_ << ", batch timeout "
+                << batch_timeout_.count() << " ms";
+}
+
+void BatchScheduler::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_var_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+Status BatchScheduler::Predict(const PredictRequest &request, PredictReply &reply) {
+  if (!worker_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      metrics_.request_num++;
+      metrics_.batch_num++;
+      metrics_.max_batch_size = std::max<size_t>(metrics_.max_batch_size, 1);
+    }
+    return predict_func_(request, reply);
+  }
+  auto task = std::make_shared<PredictTask>();
+  task->request = &request;
+  task->reply = &reply;
+  task->batch_size = GetBatchSize(request);
+  auto future = task->promise.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_) {
+      return Status(FAILED, "Serving is exiting");
+    }
+    task->enqueue_time = std::chrono::steady_clock::now();
+    task_queue_.push_back(task);
+    metrics_.queue_depth = task_queue_.size();
+    metrics_.max_queue_depth = std::max(metrics_.max_queue_depth, metrics_.queue_depth);
+  }
+  cond_var_.notify_one();
+  return future.get();
+}
+
+BatchMetrics BatchScheduler::GetMetrics() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return metrics_;
+}
+
+int64_t BatchScheduler::GetBatchSize(const PredictRequest &request) {
+  if (request.images_size() > 0 || request.data_size() == 0) {
+    return 0;
+  }
+  int64_t batch_size = 0;
+  for (auto &tensor : request.data()) {
+    auto &dims = tensor.tensor_shape().dims();
+    if (dims.size() == 0 || dims[0] <= 0) {
+      return 0;
+    }
+    if (batch_size != 0 && dims[0] != batch_size) {
+      return 0;
+    }
+    batch_size = dims[0];
+    if (tensor.data().size() % static_cast<size_t>(batch_size) != 0) {
+      return 0;
+    }
+  }
+  return batch_size;
+}
+
+bool BatchScheduler::IsCompatible(const PredictRequest &lhs, const PredictRequest &rhs) {
+  if (lhs.data_size() != rhs.data_size()) {
+    return false;
+  }
+  for (int i = 0; i < lhs.data_size(); i++) {
+    auto &lhs_tensor = lhs.data(i);
+    auto &rhs_tensor = rhs.data(i);
+    if (lhs_tensor.tensor_type() != rhs_tensor.tensor_type()) {
+      return false;
+    }
+    auto &lhs_dims = lhs_tensor.tensor_shape().dims();
+    auto &rhs_dims = rhs_tensor.tensor_shape().dims();
+    if (lhs_dims.size() != rhs_dims.size() || !std::equal(lhs_dims.begin() + 1, lhs_dims.end(), rhs_dims.begin() + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<BatchScheduler::PredictTaskPtr> BatchScheduler::CollectBatch(std::unique_lock<std::mutex> *lock) {
+  std::vector<PredictTaskPtr> batch;
+  auto first = task_queue_.front();
+  task_queue_.pop_front();
+  batch.push_back(first);
+  if (first->batch_size == 0) {
+    return batch;
+  }
+  int64_t rows = first->batch_size;
+  auto deadline = first->enqueue_time + batch_timeout_;
+  while (rows < max_batch_size_) {
+    if (task_queue_.empty()) {
+      // keep waiting for more requests until the first one has waited long enough
+      if (stop_ || !cond_var_.wait_until(*lock, deadline, [this] { return stop_ || !task_queue_.empty(); })) {
+        break;
+      }
+      if (task_queue_.empty()) {
+        break;
+      }
+    }
+    // the queue is served in order, an incompatible request closes the batch
+    auto &next = task_queue_.front();
+    if (next->batch_size == 0 || rows + next->batch_size > max_batch_size_ ||
+        !IsCompatible(*first->request, *next->request)) {
+      break;
+    }
+    rows += next->batch_size;
+    batch.push_back(next);
+    task_queue_.pop_front();
+  }
+  return batch;
+}
+
+void BatchScheduler::WorkerLoop() {
+  while (true) {
+    std::vector<PredictTaskPtr> batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_var_.wait(lock, [this] { return stop_ || !task_queue_.empty(); });
+      if (task_queue_.empty()) {
+        return;
+      }
+      batch = CollectBatch(&lock);
+      metrics_.request_num += batch.size();
+      metrics_.batch_num++;
+      metrics_.max_batch_size = std::max(metrics_.max_batch_size, batch.size());
+      metrics_.queue_depth = task_queue_.size();
+    }
+    RunBatch(batch);
+  }
+}
+
+void BatchScheduler::MergeRequests(const std::vector<PredictTaskPtr> &batch, PredictRequest *merged) {
+  auto &first = *batch[0]->request;
+  int64_t total_batch_size = 0;
+  for (auto &task : batch) {
+    total_batch_size += task->batch_size;
+  }
+  for (int i = 0; i < first.data_size(); i++) {
+    auto tensor = merged->add_data();
+    tensor->set_tensor_type(first.data(i).tensor_type());
+    *tensor->mutable_tensor_shape() = first.data(i).tensor_shape();
+    tensor->mutable_tensor_shape()->set_dims(0, total_batch_size);
+    size_t data_size = 0;
+    for (auto &task : batch) {
+      data_size += task->request->data(i).data().size();
+    }
+    auto data = tensor->mutable_data();
+    data->reserve(data_size);
+    for (auto &task : batch) {
+      data->append(task->request->data(i).data());
+    }
+  }
+}
+
+Status BatchScheduler::SplitReply(const PredictReply &merged, int64_t total_batch_size,
+                                  const std::vector<PredictTaskPtr> &batch) {
+  for (auto &output : merged.result()) {
+    auto &dims = output.tensor_shape().dims();
+    if (dims.size() == 0 || dims[0] != total_batch_size) {
+      return Status(FAILED, "Output dim 0 does not match the merged batch size " + std::to_string(total_batch_size));
+    }
+    if (output.data().size() % static_cast<size_t>(total_batch_size) != 0) {
+      return Status(FAILED, "Output data size can not be split by the merged batch size");
+    }
+  }
+  size_t row_offset = 0;
+  for (auto &task : batch) {
+    task->reply->clear_result();
+    for (auto &output : merged.result()) {
+      size_t row_size = output.data().size() / static_cast<size_t>(total_batch_size);
+      auto result = task->reply->add_result();
+      result->set_tensor_type(output.tensor_type());
+      *result->mutable_tensor_shape() = output.tensor_shape();
+      result->mutable_tensor_shape()->set_dims(0, task->batch_size);
+      result->set_data(output.data().substr(row_offset * row_size, task->batch_size * row_size));
+    }
+    row_offset += task->batch_size;
+  }
+  return SUCCESS;
+}
+
+Status BatchScheduler::SafePredict(const PredictRequest &request, PredictReply &reply) {
+  // an exception escaping the worker would leave the waiting clients blocked forever
+  try {
+    return predict_func_(request, reply);
+  } catch (const std::bad_alloc &ex) {
+    MSI_LOG(ERROR) << "Serving Error: malloc memory failed";
+    return Status(FAILED, "Serving Error: malloc memory failed");
+  } catch (const std::exception &ex) {
+    MSI_LOG(ERROR) << "Serving Error: exception occurred: " << ex.what();
+    return Status(FAILED, std::string("Serving Error: exception occurred: ") + ex.what());
+  } catch (...) {
+    MSI_LOG(ERROR) << "Serving Error: exception occurred";
+    return Status(FAILED, "Serving Error: exception occurred");
+  }
+}
+
+void BatchScheduler::RunAlone(const std::vector<PredictTaskPtr> &batch) {
+  for (auto &task : batch) {
+    task->reply->clear_result();
+    task->promise.set_value(SafePredict(*task->request, *task->reply));
+  }
+}
+
+void BatchScheduler::RunBatch(const std::vector<PredictTaskPtr> &batch) {
+  if (batch.size() == 1) {
+    RunAlone(batch);
+    return;
+  }
+  int64_t total_batch_size = 0;
+  for (auto &task : batch) {
+    total_batch_size += task->batch_size;
+  }
+  MSI_LOG(INFO) << "Run merged batch of " << batch.size() << " requests, batch size " << total_batch_size;
+  PredictRequest merged_request;
+  PredictReply merged_reply;
+  Status status(SUCCESS);
+  try {
+    MergeRequests(batch, &merged_request);
+  } catch (const std::bad_alloc &ex) {
+    status = Status(FAILED, "malloc memory failed");
+  }
+  if (status == SUCCESS) {
+    status = SafePredict(merged_request, merged_reply);
+  }
+  if (status == SUCCESS) {
+    status = SplitReply(merged_reply, total_batch_size, batch);
+  }
+  if (status != SUCCESS) {
+    // e.g. the model has a fixed batch size, the requests still get their own results
+    MSI_LOG(WARNING) << "Run merged batch failed: " << status.StatusMessage() << ", run the requests one by one";
+    RunAlone(batch);
+    return;
+  }
+  for (auto &task : batch) {
+    task->promise.set_value(SUCCESS);
+  }
+}
+}  // namespace serving
+}  // namespace mindspore
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_SERVING_BATCH_SCHEDULER_H
+#define MINDSPORE_SERVING_BATCH_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "util/status.h"
+#include "serving/ms_service.pb.h"
+
+namespace mindspore {
+namespace serving {
+using ms_serving::PredictReply;
+using ms_serving::PredictRequest;
+using PredictFunc = std::function<Status(const PredictRequest &, PredictReply &)>;
+
+struct BatchMetrics {
+  uint64_t request_num = 0;
+  uint64_t batch_num = 0;
+  // requests waiting in the queue now, and the most ever seen
+  size_t queue_depth = 0;
+  size_t max_queue_depth = 0;
+  // requests merged into one execution
+  size_t max_batch_size = 0;
+  double AverageBatchSize() const { return batch_num == 0 ? 0 : static_cast<double>(request_num) / batch_num; }
+};
+
+// Merges concurrent PredictRequests along the batch dimension (dim 0 of every input) and runs them with one call of
+// the predict function, then splits the reply back. A batch is sent when it reaches max_batch_size rows or when its
+// first request has waited batch_timeout_ms. Requests with images, scalars or unequal dim 0 among inputs run alone.
+class BatchScheduler {
+ public:
+  BatchScheduler(int32_t max_batch_size, int32_t batch_timeout_ms, PredictFunc predict_func);
+  ~BatchScheduler();
+  BatchScheduler(const BatchScheduler &) = delete;
+  BatchScheduler &operator=(const BatchScheduler &) = delete;
+
+  void Start();
+  // requests already queued are still executed before the worker exits
+  void Stop();
+  // thread safe, blocks until the batch containing this request finishes
+  Status Predict(const PredictRequest &request, PredictReply &reply);
+  BatchMetrics GetMetrics();
+
+  // rows along the batch dimension, 0 if the request can not be merged with others
+  static int64_t GetBatchSize(const PredictRequest &request);
+  static bool IsCompatible(const PredictRequest &lhs, const PredictRequest &rhs);
+
+ private:
+  struct PredictTask {
+    const PredictRequest *request = nullptr;
+    PredictReply *reply = nullptr;
+    int64_t batch_size = 0;
+    std::chrono::steady_clock::time_point enqueue_time;
+    std::promise<Status> promise;
+  };
+  using PredictTaskPtr = std::shared_ptr<PredictTask>;
+
+  void WorkerLoop();
+  std::vector<PredictTaskPtr> CollectBatch(std::unique_lock<std::mutex> *lock);
+  void RunBatch(const std::vector<PredictTaskPtr> &batch);
+  void RunAlone(const std::vector<PredictTaskPtr> &batch);
+  // calls predict_func_, an exception it throws is returned as a FAILED status
+  Status SafePredict(const PredictRequest &request, PredictReply &reply);
+  static void MergeRequests(const std::vector<PredictTaskPtr> &batch, PredictRequest *merged);
+  static Status SplitReply(const PredictReply &merged, int64_t total_batch_size,
+                           const std::vector<PredictTaskPtr> &batch);
+
+  int64_t max_batch_size_;
+  std::chrono::milliseconds batch_timeout_;
+  PredictFunc predict_func_;
+  std::deque<PredictTaskPtr> task_queue_;
+  std::mutex mutex_;
+  std::condition_variable cond_var_;
+  bool stop_ = false;
+  std::thread worker_;
+  BatchMetrics metrics_;
+};
+}  // namespace serving
+}  // namespace mindspore
+#endif  // MINDSPORE_SERVING_BATCH_SCHEDULER_H
@@ -22,6 +22,7 @@
 #include "serving/ms_service.pb.h"
 #include "util/status.h"
 #include "core/session.h"
+#include "core/batch_scheduler.h"
 #include "core/http_process.h"
 #include "core/serving_tensor.h"
 
@@ -522,7 +523,12 @@ Status HttpHandleMsgDetail(struct evhttp_request *const req, void *const arg, st
     return status;
   }
   MSI_TIME_STAMP_START(Predict)
-  status = Session::Instance().Predict(request, reply);
+  auto batch_scheduler = static_cast<BatchScheduler *>(arg);
+  if (batch_scheduler != nullptr) {
+    status = batch_scheduler->Predict(request, reply);
+  } else {
+    status = Session::Instance().Predict(request, reply);
+  }
   MSI_TIME_STAMP_END(Predict)
   if (status != SUCCESS) {
     MSI_LOG(ERROR) << "restful predict failed";
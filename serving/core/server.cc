@@ -32,6 +32,7 @@
 #include "core/util/option_parser.h"
 #include "core/version_control/version_controller.h"
 #include "core/session.h"
+#include "core/batch_scheduler.h"
 #include "core/serving_tensor.h"
 #include "core/http_process.h"
 
@@ -76,10 +77,12 @@ grpc::Status CreatGRPCStatus(const Status &status) {
 
 // Service Implement
 class MSServiceImpl final : public MSService::Service {
+ public:
+  explicit MSServiceImpl(BatchScheduler *batch_scheduler) : batch_scheduler_(batch_scheduler) {}
+
   grpc::Status Predict(grpc::ServerContext *context, const PredictRequest *request, PredictReply *reply) override {
-    std::lock_guard<std::mutex> lock(mutex_);
     MSI_TIME_STAMP_START(Predict)
-    auto res = Session::Instance().Predict(*request, *reply);
+    auto res = batch_scheduler_->Predict(*request, *reply);
     MSI_TIME_STAMP_END(Predict)
     if (res != inference::SUCCESS) {
       return CreatGRPCStatus(res);
@@ -92,7 +95,9 @@ class MSServiceImpl final : public MSService::Service {
     MSI_LOG(INFO) << "TestService call";
     return grpc::Status::OK;
   }
-  std::mutex mutex_;
+
+ private:
+  BatchScheduler *batch_scheduler_;
 };
 
 static std::pair<struct evhttp *, struct event_base *> NewHttpServer() {
@@ -218,11 +223,18 @@ Status Server::BuildAndStart() {
   int32_t http_port = option_args->rest_api_port;
   std::string http_addr = kServerHttpIp;
 
+  // both gRPC and RESTful requests go through the scheduler, concurrent requests are merged into one execution
+  BatchScheduler batch_scheduler(option_args->max_batch_size, option_args->batch_timeout_ms,
+                                 [](const PredictRequest &request, PredictReply &reply) {
+                                   return Session::Instance().Predict(request, reply);
+                                 });
+  batch_scheduler.Start();
+
   evhttp_set_timeout(http_server, 60);
-  evhttp_set_gencb(http_server, http_handler_msg, nullptr);
+  evhttp_set_gencb(http_server, http_handler_msg, &batch_scheduler);
 
   // grpc server
-  MSServiceImpl ms_service;
+  MSServiceImpl ms_service(&batch_scheduler);
   grpc::EnableDefaultHealthCheckService(true);
   grpc::reflection::InitProtoReflectionServerBuilderPlugin();
   // Set the port is not reuseable
@@ -242,6 +254,7 @@ Status Server::BuildAndStart() {
               << http_addr << ":" << http_port << ", model directory " << option_args->model_path << " model name "
               << option_args->model_name << ", device type " << option_args->device_type << ", device id "
               << option_args->device_id << std::endl;
+    batch_scheduler.Stop();
     ClearEnv();
     exit_http();
     return FAILED;
@@ -261,6 +274,11 @@ Status Server::BuildAndStart() {
   std::thread restful_thread(http_server_run);
   auto exit_future = exit_requested.get_future();
   exit_future.wait();
+  batch_scheduler.Stop();
+  auto metrics = batch_scheduler.GetMetrics();
+  MSI_LOG(INFO) << "Serving handled " << metrics.request_num << " requests in " << metrics.batch_num
+                << " executions, average batch " << metrics.AverageBatchSize() << ", max queue depth "
+                << metrics.max_queue_depth;
   ClearEnv();
   server->Shutdown();
   event_base_loopexit(eb, nullptr);
@@ -164,6 +164,10 @@ void Options::CreateOptions() {
     Option("model_name", &args_->model_name, "[Required] model name "),
     Option("model_path", &args_->model_path, "[Required] the path of the model files"),
     Option("device_id", &args_->device_id, "[Optional] the device id, default is 0, range from 0 to 7"),
+    Option("max_batch_size", &args_->max_batch_size,
+           "[Optional] max rows merged along the batch dimension of concurrent requests, default is 1 (no merging)"),
+    Option("batch_timeout_ms", &args_->batch_timeout_ms,
+           "[Optional] max milliseconds a request waits for others to be merged with, default is 2"),
   };
   options_ = options;
 }
@@ -189,6 +193,14 @@ bool Options::CheckOptions() {
     std::cout << "Serving Error: the rest_api_port should be in [1~65535]" << std::endl;
     return false;
   }
+  if (args_->max_batch_size < 1) {
+    std::cout << "Serving Error: the max_batch_size should be at least 1" << std::endl;
+    return false;
+  }
+  if (args_->batch_timeout_ms < 0) {
+    std::cout << "Serving Error: the batch_timeout_ms should not be negative" << std::endl;
+    return false;
+  }
   if (args_->rest_api_port == args_->grpc_port) {
     std::cout << "Serving Error: the rest_api_port and grpc port should not be same" << std::endl;
     return false;
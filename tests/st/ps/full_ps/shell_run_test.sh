@@ -24,6 +24,9 @@ export MS_WORKER_NUM=$3
 export MS_SERVER_NUM=$4
 export MS_SCHED_HOST=$5
 export MS_SCHED_PORT=$6
+PS_MODE=${7:-sync}
+STALENESS_THRESHOLD=${8:-1}
+GRAD_COMPRESSION=${9:-none}
 
 export MS_ROLE=MS_SCHED
 for((i=0;i<1;i++));
@@ -31,7 +34,8 @@ do
   rm -rf ${execute_path}/sched_$i/
   mkdir ${execute_path}/sched_$i/
   cd ${execute_path}/sched_$i/ || exit
-  python ${self_path}/../test_full_ps_lenet.py --device_target=$DEVICE_TARGET --dataset_path=$DATASET_PATH &
+  python ${self_path}/../test_full_ps_lenet.py --device_target=$DEVICE_TARGET --dataset_path=$DATASET_PATH \
+    --ps_mode=$PS_MODE --staleness_threshold=$STALENESS_THRESHOLD --grad_compression=$GRAD_COMPRESSION &
 done
 
 export MS_ROLE=MS_PSERVER
@@ -40,7 +44,8 @@ do
   rm -rf ${execute_path}/server_$i/
   mkdir ${execute_path}/server_$i/
   cd ${execute_path}/server_$i/ || exit
-  python ${self_path}/../test_full_ps_lenet.py --device_target=$DEVICE_TARGET --dataset_path=$DATASET_PATH &
+  python ${self_path}/../test_full_ps_lenet.py --device_target=$DEVICE_TARGET --dataset_path=$DATASET_PATH \
+    --ps_mode=$PS_MODE --staleness_threshold=$STALENESS_THRESHOLD --grad_compression=$GRAD_COMPRESSION &
 done
 
 export MS_ROLE=MS_WORKER
@@ -49,7 +54,8 @@ do
   rm -rf ${execute_path}/worker_$i/
   mkdir ${execute_path}/worker_$i/
   cd ${execute_path}/worker_$i/ || exit
-  python ${self_path}/../test_full_ps_lenet.py --device_target=$DEVICE_TARGET --dataset_path=$DATASET_PATH &
+  python ${self_path}/../test_full_ps_lenet.py --device_target=$DEVICE_TARGET --dataset_path=$DATASET_PATH \
+    --ps_mode=$PS_MODE --staleness_threshold=$STALENESS_THRESHOLD --grad_compression=$GRAD_COMPRESSION &
 done
 
 wait $!
@@ -31,11 +31,15 @@ from mindspore.common.initializer import TruncatedNormal
 parser = argparse.ArgumentParser(description='test_ps_lenet')
 parser.add_argument("--device_target", type=str, default="Ascend")
 parser.add_argument("--dataset_path", type=str, default="/home/workspace/mindspore_dataset/mnist")
+parser.add_argument("--ps_mode", type=str, default="sync")
+parser.add_argument("--staleness_threshold", type=int, default=1)
+parser.add_argument("--grad_compression", type=str, default="none")
 args, _ = parser.parse_known_args()
 device_target = args.device_target
 dataset_path = args.dataset_path
 context.set_context(mode=context.GRAPH_MODE, device_target=device_target)
-context.set_ps_context(enable_ps=True)
+context.set_ps_context(enable_ps=True, ps_mode=args.ps_mode, staleness_threshold=args.staleness_threshold,
+                       grad_compression=args.grad_compression)
 
 def conv(in_channels, out_channels, kernel_size, stride=1, padding=0):
     """weight initial for conv layer"""
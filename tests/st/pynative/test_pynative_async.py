@@ -0,0 +1,83 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+""" test asynchronous op dispatch of pynative mode """
+import time
+import numpy as np
+import pytest
+
+import mindspore.nn as nn
+from mindspore import context, Tensor
+from mindspore.ops import operations as P
+
+
+class MLP(nn.Cell):
+    """ small mlp, so that dispatching the ops dominates the step time """
+    def __init__(self, width, depth):
+        super(MLP, self).__init__()
+        self.layers = nn.CellList([nn.Dense(width, width, activation='relu') for _ in range(depth)])
+
+    def construct(self, x):
+        for layer in self.layers:
+            x = layer(x)
+        return x
+
+
+def run_mlp(enable_async, steps):
+    """ run the mlp, return the output of the last step and the ops dispatched per second """
+    context.set_context(enable_pynative_async=enable_async)
+    np.random.seed(0)
+    net = MLP(64, 8)
+    x = Tensor(np.random.randn(32, 64).astype(np.float32))
+    out = net(x)
+    out.asnumpy()
+    start = time.time()
+    for _ in range(steps):
+        out = net(x)
+    # reading the output waits for the ops queued before
+    result = out.asnumpy()
+    elapsed = time.time() - start
+    # matmul, bias add and relu for each layer
+    ops_per_second = steps * 8 * 3 / elapsed
+    return result, ops_per_second
+
+
+def async_dispatch(device_target):
+    context.set_context(mode=context.PYNATIVE_MODE, device_target=device_target)
+    expect, sync_ops = run_mlp(False, 200)
+    output, async_ops = run_mlp(True, 200)
+    print("pynative mlp on {}: {:.0f} ops/s sync, {:.0f} ops/s async".format(device_target, sync_ops, async_ops))
+    assert np.allclose(output, expect)
+
+    # the value of an output is waited for by conditions and printing too
+    x = Tensor(np.ones((2, 2), np.float32))
+    y = P.TensorAdd()(x, x)
+    assert bool(P.ReduceAll()(P.Equal()(y, Tensor(np.full((2, 2), 2, np.float32)))))
+    assert "2" in repr(y)
+    context.set_context(enable_pynative_async=False)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_arm_ascend_training
+@pytest.mark.platform_x86_ascend_training
+@pytest.mark.env_onecard
+def test_ascend_pynative_async_dispatch():
+    async_dispatch("Ascend")
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_gpu_pynative_async_dispatch():
+    async_dispatch("GPU")
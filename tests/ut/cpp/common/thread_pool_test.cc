@@ -0,0 +1,107 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "common/thread_pool.h"
+
+namespace mindspore {
+class TestThreadPool : public UT::Common {
+ public:
+  TestThreadPool() = default;
+};
+
+TEST_F(TestThreadPool, test_parallel_for) {
+  std::vector<int> data(100000, 1);
+  std::atomic<size_t> sum{0};
+  auto task = [&data, &sum](size_t start, size_t end) {
+    size_t local_sum = 0;
+    for (size_t i = start; i < end; ++i) {
+      local_sum += data[i];
+    }
+    sum += local_sum;
+  };
+  EXPECT_TRUE(ThreadPool::GetInstance()->ParallelFor(data.size(), task, 16));
+  EXPECT_EQ(sum, data.size());
+}
+
+TEST_F(TestThreadPool, test_small_work_runs_inline) {
+  size_t call_num = 0;
+  auto task = [&call_num](size_t start, size_t end) {
+    EXPECT_EQ(start, 0);
+    EXPECT_EQ(end, 10);
+    ++call_num;
+  };
+  EXPECT_TRUE(ThreadPool::GetInstance()->ParallelFor(10, task));
+  EXPECT_EQ(call_num, 1);
+}
+
+TEST_F(TestThreadPool, test_nested_launch) {
+  std::atomic<size_t> count{0};
+  std::vector<Task> tasks;
+  for (size_t i = 0; i < 8; ++i) {
+    tasks.emplace_back([&count]() {
+      ThreadPool::GetInstance()->ParallelFor(
+        100, [&count](size_t start, size_t end) { count += end - start; }, 1);
+      return SUCCESS;
+    });
+  }
+  EXPECT_TRUE(ThreadPool::GetInstance()->LaunchMultipleTask(tasks));
+  EXPECT_EQ(count, 800);
+}
+
+TEST_F(TestThreadPool, test_task_failed) {
+  std::vector<Task> tasks = {[]() { return SUCCESS; }, []() { return FAIL; }};
+  EXPECT_FALSE(ThreadPool::GetInstance()->LaunchMultipleTask(tasks));
+  auto task = [](size_t start, size_t) {
+    if (start != 0) {
+      throw std::runtime_error("task failed");
+    }
+  };
+  if (ThreadPool::GetInstance()->GetThreadNum() > 1) {
+    EXPECT_THROW(ThreadPool::GetInstance()->ParallelFor(100, task, 1), std::runtime_error);
+  }
+}
+
+TEST_F(TestThreadPool, test_launch_task_graph) {
+  // 0 -> {1, 2} -> 3
+  std::vector<std::atomic<size_t>> finish_order(4);
+  std::atomic<size_t> finish_count{0};
+  std::vector<Task> tasks;
+  for (size_t i = 0; i < 4; ++i) {
+    tasks.emplace_back([&finish_order, &finish_count, i]() {
+      finish_order[i] = finish_count++;
+      return SUCCESS;
+    });
+  }
+  std::vector<std::vector<size_t>> successors = {{1, 2}, {3}, {3}, {}};
+  std::vector<size_t> dependency_num = {0, 1, 1, 2};
+  EXPECT_TRUE(ThreadPool::GetInstance()->LaunchTaskGraph(tasks, successors, dependency_num));
+  EXPECT_EQ(finish_count, 4);
+  EXPECT_EQ(finish_order[0], 0);
+  EXPECT_EQ(finish_order[3], 3);
+
+  // The successors of a failed task are skipped.
+  std::atomic<size_t> run_count{0};
+  std::vector<Task> failed_tasks = {[]() { return FAIL; }, [&run_count]() {
+                                      run_count++;
+                                      return SUCCESS;
+                                    }};
+  EXPECT_FALSE(ThreadPool::GetInstance()->LaunchTaskGraph(failed_tasks, {{1}, {}}, {0, 1}));
+  EXPECT_EQ(run_count, 0);
+}
+}  // namespace mindspore
@@ -80,6 +80,7 @@ TEST_F(MindDataTestPipeline, TestSaveCifar10AndLoad) {
   // This will trigger the creation of the Execution Tree and launch it.
   std::string temp_file = datasets_root_path_ + "/testCifar10Data/mind.mind";
   std::string temp_file_db = datasets_root_path_ + "/testCifar10Data/mind.mind.db";
+  std::string temp_file_idx = datasets_root_path_ + "/testCifar10Data/mind.mind.idx";
   bool rc = ds->Save(temp_file);
   EXPECT_EQ(rc, true);
 
@@ -127,6 +128,7 @@ TEST_F(MindDataTestPipeline, TestSaveCifar10AndLoad) {
   // Delete temp file
   EXPECT_EQ(remove(temp_file.c_str()), 0);
   EXPECT_EQ(remove(temp_file_db.c_str()), 0);
+  EXPECT_EQ(remove(temp_file_idx.c_str()), 0);
 }
 
 TEST_F(MindDataTestPipeline, TestSaveFail) {
@@ -15,11 +15,13 @@
  */
 
 #include <fcntl.h>
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <utility>
 
 
 #include "common/common.h"
@@ -48,12 +50,19 @@ public:
   // A random sleep/delay can be introduced for each thread. See run().
   Status Run_test_1();
 
+  // Microbenchmark: push num_elements through a connector with the given number of producers
+  // and consumers and report the throughput in elements per second.
+  Status RunThroughput(int num_producers, int num_consumers, int num_elements, double *throughput);
+
   void SetSleepMilliSec(uint32_t ms) { sleep_ms_ = ms; }
 
+  void SetLockFree(bool lock_free) { lock_free_ = lock_free; }
+
 private:
   std::unique_ptr<TaskGroup> tg_;
   uint32_t last_input_;
   uint32_t sleep_ms_ = 0;
+  bool lock_free_ = false;
   std::vector<uint32_t> input_;
   WaitPost wp;
 
@@ -122,7 +131,56 @@ TEST_F(MindDataTestConnector, Test2) {
   ASSERT_TRUE(rc.IsOk());
 }
 
+// Test3: same as Test0 over lock free queues
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3: single producer, single consumer, lock free.";
+  this->SetLockFree(true);
+  Status rc = this->Run_test_0();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
 
+// Test4: same as Test1 over lock free queues
+TEST_F(MindDataTestConnector, Test4) {
+  MS_LOG(INFO) << "MindDataTestConnector Test4.";
+  this->SetLockFree(true);
+  Status rc = this->Run_test_1();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
+
+// Test5: same as Test2 over lock free queues
+TEST_F(MindDataTestConnector, Test5) {
+  MS_LOG(INFO) << "MindDataTestConnector Test5.";
+  this->SetLockFree(true);
+  this->SetSleepMilliSec(30);
+  Status rc = this->Run_test_1();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
+
+// Benchmark: connector throughput with mutex guarded and lock free queues under varying
+// numbers of producers and consumers.
+TEST_F(MindDataTestConnector, Benchmark) {
+  const int num_elements = 100000;
+  std::vector<std::pair<int, int>> configs = {{1, 1}, {4, 1}, {1, 4}, {4, 4}, {8, 8}};
+  for (auto &config : configs) {
+    double mutex_tput = 0.0;
+    double lock_free_tput = 0.0;
+    this->SetLockFree(false);
+    Status rc = this->RunThroughput(config.first, config.second, num_elements, &mutex_tput);
+    ASSERT_TRUE(rc.IsOk());
+    this->SetLockFree(true);
+    rc = this->RunThroughput(config.first, config.second, num_elements, &lock_free_tput);
+    ASSERT_TRUE(rc.IsOk());
+    MS_LOG(INFO) << "Connector " << config.first << " producers x " << config.second
+                 << " consumers: mutex queue " << mutex_tput << " elements/s, lock free queue " << lock_free_tput
+                 << " elements/s.";
+  }
+}
 
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
@@ -139,7 +197,8 @@ Status MindDataTestConnector::Run_test_0() {
   wp.Clear();
   auto my_conn = std::make_shared<Connector<uint32_t>>(1,  // num of producers
                                                       1,  // num of consumers
-                                                      10);  // capacity of each queue
+                                                      10,  // capacity of each queue
+                                                      lock_free_);
   MS_ASSERT(my_conn != nullptr);
 
   rc = my_conn->Register(tg_.get());
@@ -188,11 +247,13 @@ Status MindDataTestConnector::Run_test_1() {
 
   auto conn1 = std::make_shared<Connector<uint32_t>>(l1_threads,  // num of producers
                                                      l2_threads,  // num of consumers
-                                                     conn1_qcap);  // the cap of each queue
+                                                     conn1_qcap,  // the cap of each queue
+                                                     lock_free_);
 
   auto conn2 = std::make_shared<Connector<uint32_t>>(l2_threads,
                                                      l3_threads,
-                                                     conn2_qcap);
+                                                     conn2_qcap,
+                                                     lock_free_);
 
   rc = conn1->Register(tg_.get());
   RETURN_IF_NOT_OK(rc);
@@ -241,6 +302,55 @@ Status MindDataTestConnector::Run_test_1() {
   return ValidateOutput(output);
 }
 
+Status MindDataTestConnector::RunThroughput(int num_producers, int num_consumers, int num_elements,
+                                            double *throughput) {
+  // The task group outlives the connector whose condition variables are registered with it
+  TaskGroup vg;
+  auto conn = std::make_unique<Connector<uint32_t>>(num_producers, num_consumers, 16, lock_free_);
+  Connector<uint32_t> *c = conn.get();
+  RETURN_IF_NOT_OK(conn->Register(&vg));
+  std::atomic<int> num_bad(0);
+  Status rc;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_producers && rc.IsOk(); i++) {
+    // Round robin distribution, producer i pushes i, i + num_producers, ...
+    rc = vg.CreateAsyncTask("Benchmark Push", [c, i, num_producers, num_elements]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int el = i; el < num_elements; el += num_producers) {
+        RETURN_IF_NOT_OK(c->Push(i, static_cast<uint32_t>(el)));
+      }
+      return Status::OK();
+    });
+  }
+  for (int i = 0; i < num_consumers && rc.IsOk(); i++) {
+    // Consumers take turns, consumer i gets i, i + num_consumers, ...
+    rc = vg.CreateAsyncTask("Benchmark Pop", [c, i, num_consumers, num_elements, &num_bad]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int expected = i; expected < num_elements; expected += num_consumers) {
+        uint32_t el = 0;
+        RETURN_IF_NOT_OK(c->Pop(i, &el));
+        if (el != expected) {
+          num_bad++;
+        }
+      }
+      return Status::OK();
+    });
+  }
+  if (rc.IsError()) {
+    vg.interrupt_all();
+  }
+  Status join_rc = vg.join_all(Task::WaitFlag::kBlocking);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  RETURN_IF_NOT_OK(rc);
+  RETURN_IF_NOT_OK(join_rc);
+  RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
+  if (num_bad > 0) {
+    return Status(StatusCode::kUnexpectedError, "Output of the benchmark is not in-order.");
+  }
+  *throughput = num_elements / elapsed.count();
+  return Status::OK();
+}
+
 Status MindDataTestConnector::SerialWorkerPull(
                                                int tid,
                                                std::shared_ptr<Connector<uint32_t>> my_conn,
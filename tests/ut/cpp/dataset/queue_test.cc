@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/lock_free_queue.h"
 #include <atomic>
 #include <chrono>
 #include <random>
@@ -177,3 +178,112 @@ TEST_F(MindDataTestQueue, Test6) {
   MS_LOG(INFO) << "Popped value " << *pepped_value << " from queue index " << chosen_queue_index;
   ASSERT_EQ(*pepped_value, 99);
 }
+
+TEST_F(MindDataTestQueue, TestLockFree1) {
+  // Same as Test1 with the lock free queue
+  LockFreeQueue<std::shared_ptr<int>> que(3);
+  std::shared_ptr<int> a = std::make_shared<int>(20);
+  Status rc = que.Add(a);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(a.use_count(), 2);
+  std::shared_ptr<int> b;
+  rc = que.PopFront(&b);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*b, 20);
+  ASSERT_EQ(a.use_count(), 2);
+  a.reset(new int(5));
+  rc = que.Add(std::move(a));
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(a.use_count(), 0);
+  rc = que.PopFront(&b);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*b, 5);
+  ASSERT_EQ(b.use_count(), 1);
+  rc = que.EmplaceBack(std::make_shared<int>(100));
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(que.size(), 1);
+  rc = que.PopFront(&b);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*b, 100);
+  ASSERT_TRUE(que.empty());
+  // Leave an element behind for the destructor
+  rc = que.EmplaceBack(std::make_shared<int>(2000));
+  ASSERT_TRUE(rc.IsOk());
+}
+
+TEST_F(MindDataTestQueue, TestLockFree2) {
+  gRefCountDestructorCalled = 0;
+  {
+    // Wrap around the ring a few times, capacity not a power of 2
+    LockFreeQueue<RefCount> que(3);
+    for (int i = 0; i < 10; ++i) {
+      Status rc = que.EmplaceBack(i);
+      ASSERT_TRUE(rc.IsOk());
+      RefCount b;
+      rc = que.PopFront(&b);
+      ASSERT_TRUE(rc.IsOk());
+      ASSERT_EQ(*(b.v_.get()), i);
+    }
+    ASSERT_EQ(que.capacity(), 3);
+    Status rc = que.EmplaceBack(10);
+    ASSERT_TRUE(rc.IsOk());
+    gRefCountDestructorCalled = 0;
+  }
+  // The element left in the queue, plus the temporary used to drain it
+  ASSERT_EQ(gRefCountDestructorCalled, 2);
+}
+
+TEST_F(MindDataTestQueue, TestLockFree3) {
+  // Several producers and consumers racing on a small queue, which forces both sides to park.
+  const int num_producers = 4;
+  const int num_consumers = 3;
+  const int num_per_producer = 20000;
+  TaskGroup vg;
+  auto que = std::make_unique<LockFreeQueue<int>>(4);
+  LockFreeQueue<int> *q = que.get();
+  Status rc = que->Register(&vg);
+  ASSERT_TRUE(rc.IsOk());
+  std::atomic<int64_t> sum(0);
+  std::atomic<int> popped(0);
+  for (int p = 0; p < num_producers; ++p) {
+    rc = vg.CreateAsyncTask("Producer", [q, p]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int i = 0; i < num_per_producer; ++i) {
+        RETURN_IF_NOT_OK(q->Add(p * num_per_producer + i));
+      }
+      return Status::OK();
+    });
+    ASSERT_TRUE(rc.IsOk());
+  }
+  for (int c = 0; c < num_consumers; ++c) {
+    rc = vg.CreateAsyncTask("Consumer", [q, &sum, &popped]() -> Status {
+      TaskManager::FindMe()->Post();
+      while (popped.fetch_add(1) < num_producers * num_per_producer) {
+        int v = 0;
+        RETURN_IF_NOT_OK(q->PopFront(&v));
+        sum += v;
+      }
+      return Status::OK();
+    });
+    ASSERT_TRUE(rc.IsOk());
+  }
+  rc = vg.join_all(Task::WaitFlag::kBlocking);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_TRUE(vg.GetTaskErrorIfAny().IsOk());
+  int64_t n = num_producers * num_per_producer;
+  ASSERT_EQ(sum.load(), n * (n - 1) / 2);
+  ASSERT_TRUE(que->empty());
+  que.reset();
+}
+
+TEST_F(MindDataTestQueue, TestLockFree4) {
+  // QueueList over lock free queues
+  QueueList<std::unique_ptr<int>, LockFreeQueue<std::unique_ptr<int>>> my_list_of_queues;
+  my_list_of_queues.Init(4, 3);
+  Status rc = my_list_of_queues[2]->Add(std::make_unique<int>(99));
+  ASSERT_TRUE(rc.IsOk());
+  std::unique_ptr<int> popped_value;
+  rc = my_list_of_queues[2]->PopFront(&popped_value);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*popped_value, 99);
+}
@@ -14,15 +14,24 @@
  * limitations under the License.
  */
 
+#include <chrono>
+#include <cmath>
 #include <memory>
 #include <string>
+#include <vector>
 #include "minddata/dataset/core/client.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
 #include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
 
 using namespace mindspore::dataset;
@@ -102,4 +111,126 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResize_fusion_enabled) {
   auto func_it = tfuncs.begin();
   EXPECT_EQ((*func_it)->Name(), kRandomCropDecodeResizeOp);
   EXPECT_EQ(++func_it, tfuncs.end());
-}
\ No newline at end of file
+}
+
+// Builds a tree with a map op running func_list, optimizes it and returns the names of the resulting tensor ops
+static std::vector<std::string> OptimizedTFuncNames(const std::vector<std::shared_ptr<TensorOp>> &func_list) {
+  std::shared_ptr<ImageFolderOp> ImageFolder(int64_t num_works, int64_t rows, int64_t conns, std::string path,
+                                             bool shuf = false, std::shared_ptr<Sampler> sampler = nullptr,
+                                             std::map<std::string, int32_t> map = {}, bool decode = false);
+  std::shared_ptr<ExecutionTree> Build(std::vector<std::shared_ptr<DatasetOp>> ops);
+  std::shared_ptr<MapOp> map_op;
+  MapOp::Builder map_builder;
+  map_builder.SetInColNames({}).SetOutColNames({}).SetTensorFuncs(func_list).SetNumWorkers(4);
+  EXPECT_TRUE(map_builder.Build(&map_op).IsOk());
+  auto tree = Build({ImageFolder(16, 2, 32, "./", false), map_op});
+  EXPECT_TRUE(tree->SetOptimize(true));
+  EXPECT_TRUE(tree->Prepare().IsOk());
+  std::vector<std::string> names;
+  for (const auto &op : map_op->TFuncs()) {
+    names.push_back(op->Name());
+  }
+  return names;
+}
+
+// Runs the ops one after another, adding up the bytes of every intermediate tensor
+static Status RunChain(const std::vector<std::shared_ptr<TensorOp>> &ops, const std::shared_ptr<Tensor> &input,
+                       std::shared_ptr<Tensor> *output, int64_t *intermediate_bytes) {
+  std::shared_ptr<Tensor> current = input;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    std::shared_ptr<Tensor> next;
+    RETURN_IF_NOT_OK(ops[i]->Compute(current, &next));
+    if (i + 1 < ops.size()) {
+      *intermediate_bytes += next->SizeInBytes();
+    }
+    current = next;
+  }
+  *output = current;
+  return Status::OK();
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, ImagePipeline_fusion_enabled) {
+  MS_LOG(INFO) << "Doing ImagePipeline_fusion";
+  auto names = OptimizedTFuncNames({std::make_shared<DecodeOp>(), std::make_shared<ResizeOp>(224, 224),
+                                    std::make_shared<NormalizeOp>(121.0, 115.0, 100.0, 70.0, 68.0, 71.0),
+                                    std::make_shared<HwcToChwOp>()});
+  EXPECT_EQ(names, std::vector<std::string>({kDecodeResizeOp, kNormalizeHwcToChwOp}));
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, TypeCastRescale_fusion_enabled) {
+  MS_LOG(INFO) << "Doing TypeCastRescale_fusion";
+  auto names = OptimizedTFuncNames({std::make_shared<TypeCastOp>("float32"), std::make_shared<RescaleOp>(1.0 / 255, 0),
+                                    std::make_shared<TypeCastOp>("float32")});
+  EXPECT_EQ(names, std::vector<std::string>({kTypeCastRescaleOp}));
+
+  // casting to other types changes the values, so it is kept
+  names = OptimizedTFuncNames({std::make_shared<TypeCastOp>("int8"), std::make_shared<RescaleOp>(1.0 / 255, 0),
+                               std::make_shared<TypeCastOp>("int32")});
+  EXPECT_EQ(names, std::vector<std::string>({kTypeCastOp, kRescaleOp, kTypeCastOp}));
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, ImagePipeline_fusion_benchmark) {
+  MS_LOG(INFO) << "Doing ImagePipeline_fusion_benchmark";
+  std::shared_ptr<Tensor> jpeg;
+  ASSERT_TRUE(Tensor::CreateFromFile("data/dataset/apple.jpg", &jpeg).IsOk());
+  auto decode = std::make_shared<DecodeOp>();
+  auto resize = std::make_shared<ResizeOp>(224, 224);
+  auto normalize = std::make_shared<NormalizeOp>(121.0, 115.0, 100.0, 70.0, 68.0, 71.0);
+  auto hwc_to_chw = std::make_shared<HwcToChwOp>();
+  std::vector<std::shared_ptr<TensorOp>> unfused = {decode, resize, normalize, hwc_to_chw};
+  std::vector<std::shared_ptr<TensorOp>> fused;
+  for (const auto &rule : TensorOpFusionPass::Rules()) {
+    if (rule.pattern == std::vector<std::string>({kDecodeOp, kResizeOp})) {
+      fused.push_back(rule.fuse({decode, resize}));
+    } else if (rule.pattern == std::vector<std::string>({kNormalizeOp, kHwcToChwOp})) {
+      fused.push_back(rule.fuse({normalize, hwc_to_chw}));
+    }
+  }
+  ASSERT_EQ(fused.size(), 2);
+
+  const int kSamples = 20;
+  auto run = [&jpeg](const std::vector<std::shared_ptr<TensorOp>> &ops, std::shared_ptr<Tensor> *output,
+                     double *ms_per_sample, double *bytes_per_sample) {
+    int64_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kSamples; ++i) {
+      ASSERT_TRUE(RunChain(ops, jpeg, output, &bytes).IsOk());
+    }
+    auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    *ms_per_sample = cost / kSamples;
+    *bytes_per_sample = static_cast<double>(bytes) / kSamples;
+  };
+  std::shared_ptr<Tensor> expected;
+  std::shared_ptr<Tensor> actual;
+  double unfused_ms = 0, unfused_bytes = 0, fused_ms = 0, fused_bytes = 0;
+  run(unfused, &expected, &unfused_ms, &unfused_bytes);
+  run(fused, &actual, &fused_ms, &fused_bytes);
+  MS_LOG(INFO) << "unfused: " << unfused_ms << " ms, " << unfused_bytes << " intermediate bytes per sample.";
+  MS_LOG(INFO) << "fused: " << fused_ms << " ms, " << fused_bytes << " intermediate bytes per sample.";
+  ASSERT_EQ(expected->shape(), actual->shape());
+  ASSERT_EQ(actual->shape(), TensorShape({3, 224, 224}));
+  ASSERT_LT(fused_bytes, unfused_bytes);
+
+  // decoding at a reduced scale filters the image differently, but stays close to the full decode
+  double diff = 0;
+  auto expected_it = expected->begin<float>();
+  for (auto it = actual->begin<float>(); it != actual->end<float>(); ++it, ++expected_it) {
+    diff += std::abs(*it - *expected_it);
+  }
+  EXPECT_LT(diff / actual->Size(), 0.1);
+
+  // normalize and layout transpose give the same values in one pass
+  std::shared_ptr<Tensor> resized;
+  std::shared_ptr<Tensor> normalized;
+  std::shared_ptr<Tensor> transposed;
+  std::shared_ptr<Tensor> fused_output;
+  int64_t bytes = 0;
+  ASSERT_TRUE(RunChain({decode, resize}, jpeg, &resized, &bytes).IsOk());
+  ASSERT_TRUE(RunChain({normalize, hwc_to_chw}, resized, &transposed, &bytes).IsOk());
+  ASSERT_TRUE(fused[1]->Compute(resized, &fused_output).IsOk());
+  ASSERT_EQ(transposed->shape(), fused_output->shape());
+  auto transposed_it = transposed->begin<float>();
+  for (auto it = fused_output->begin<float>(); it != fused_output->end<float>(); ++it, ++transposed_it) {
+    ASSERT_NEAR(*it, *transposed_it, 1e-4);
+  }
+}
@@ -15,6 +15,7 @@
  */
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
@@ -658,6 +659,68 @@ TEST_F(MindDataTestTFReaderOp, TestTFReaderBasicNoSchema) {
   ASSERT_EQ(row_count, 12);
 }
 
+TEST_F(MindDataTestTFReaderOp, TestTFReaderShardEqualRows) {
+  std::string dataset_path = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+  std::string schema_path = datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json";
+
+  // Reads the rows of the file with the given sharding and prints each of them to a string.
+  auto read_rows = [&](int32_t num_devices, int32_t device_id, bool equal_rows, std::vector<std::string> *rows) {
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<TFReaderOp> my_tfreader_op;
+    TFReaderOp::Builder builder;
+    builder.SetDatasetFilesList({dataset_path})
+        .SetRowsPerBuffer(2)
+        .SetNumWorkers(2)
+        .SetNumDevices(num_devices)
+        .SetDeviceId(device_id)
+        .SetShardEqualRows(equal_rows);
+    std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+    schema->LoadSchemaFile(schema_path, {});
+    builder.SetDataSchema(std::move(schema));
+    Status rc = builder.Build(&my_tfreader_op);
+    ASSERT_TRUE(rc.IsOk());
+
+    rc = my_tree->AssociateNode(my_tfreader_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = my_tree->AssignRoot(my_tfreader_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = my_tree->Prepare();
+    ASSERT_TRUE(rc.IsOk());
+    rc = my_tree->Launch();
+    ASSERT_TRUE(rc.IsOk());
+
+    DatasetIterator di(my_tree);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+
+    while (!tensor_list.empty()) {
+      std::ostringstream row;
+      for (auto &tensor : tensor_list) {
+        row << *tensor << ";";
+      }
+      rows->push_back(row.str());
+      rc = di.FetchNextTensorRow(&tensor_list);
+      ASSERT_TRUE(rc.IsOk());
+    }
+  };
+
+  std::vector<std::string> all_rows;
+  read_rows(1, 0, false, &all_rows);
+  ASSERT_EQ(all_rows.size(), 12);
+
+  // Each device seeks to its own slice of the 12 rows of the file and reads the same rows as a full read.
+  const int32_t num_devices = 4;
+  for (int32_t device_id = 0; device_id < num_devices; device_id++) {
+    std::vector<std::string> rows;
+    read_rows(num_devices, device_id, true, &rows);
+    ASSERT_EQ(rows.size(), 3);
+    for (size_t i = 0; i < rows.size(); i++) {
+      EXPECT_EQ(rows[i], all_rows[device_id * 3 + i]);
+    }
+  }
+}
+
 TEST_F(MindDataTestTFReaderOp, TestTotalRowsBasic) {
   std::string tf_file = datasets_root_path_ + "/testTFTestAllTypes/test.data";
 
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/core/client.h"
+#include "minddata/dataset/engine/data_schema.h"
+#include "proto/example.pb.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestTFExampleDecodeBenchmark : public UT::DatasetOpTesting {
+ public:
+  void TearDown() override { (void)std::remove(kFile); }
+
+  static constexpr const char *kFile = "./wide_example.data";
+};
+
+namespace {
+constexpr int kFeatures = 240;
+constexpr int kValues = 16;
+constexpr int kRows = 2000;
+
+// A wide Example: float, int and bytes lists of kValues values in turn, feature i is named "f<i>".
+std::string WideExample(int row) {
+  dataengine::Example example;
+  auto feature_map = example.mutable_features()->mutable_feature();
+  for (int i = 0; i < kFeatures; i++) {
+    auto &feature = (*feature_map)["f" + std::to_string(i)];
+    for (int j = 0; j < kValues; j++) {
+      if (i % 3 == 0) {
+        feature.mutable_float_list()->add_value(row + i * 0.5f + j);
+      } else if (i % 3 == 1) {
+        feature.mutable_int64_list()->add_value(static_cast<int64_t>(row) * kFeatures + i - j);
+      }
+    }
+    if (i % 3 == 2) {
+      feature.mutable_bytes_list()->add_value(std::string(kValues, static_cast<char>('a' + i % 26)));
+    }
+  }
+  return example.SerializeAsString();
+}
+
+// Writes a tf_file file, the crc of the records are left to 0 as the reader doesn't check them.
+void WriteWideFile(const std::string &filename) {
+  std::ofstream writer(filename, std::ios::binary);
+  uint32_t crc = 0;
+  for (int row = 0; row < kRows; row++) {
+    std::string record = WideExample(row);
+    int64_t length = record.size();
+    writer.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    writer.write(reinterpret_cast<const char *>(&crc), sizeof(crc));
+    writer.write(record.data(), record.size());
+    writer.write(reinterpret_cast<const char *>(&crc), sizeof(crc));
+  }
+}
+
+double ElapsedMs(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Reads all the rows of the file with the given columns and returns the elapsed ms.
+double ReadColumns(const std::vector<std::string> &columns, int *row_count, TensorRow *first_row) {
+  auto start = std::chrono::steady_clock::now();
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<TFReaderOp> my_tfreader_op;
+  TFReaderOp::Builder builder;
+  builder.SetDatasetFilesList({MindDataTestTFExampleDecodeBenchmark::kFile})
+    .SetColumnsToLoad(columns)
+    .SetRowsPerBuffer(32)
+    .SetNumWorkers(1);
+  EXPECT_TRUE(builder.Build(&my_tfreader_op).IsOk());
+  EXPECT_TRUE(my_tree->AssociateNode(my_tfreader_op).IsOk());
+  EXPECT_TRUE(my_tree->AssignRoot(my_tfreader_op).IsOk());
+  EXPECT_TRUE(my_tree->Prepare().IsOk());
+  EXPECT_TRUE(my_tree->Launch().IsOk());
+
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  EXPECT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+  *first_row = tensor_list;
+  *row_count = 0;
+  while (!tensor_list.empty()) {
+    (*row_count)++;
+    EXPECT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+  }
+  return ElapsedMs(start);
+}
+}  // namespace
+
+// Compares the reader loading a few columns of wide Examples against loading all of them, and logs the cost of
+// fully parsing the Examples with protobuf for reference.
+TEST_F(MindDataTestTFExampleDecodeBenchmark, WideExampleBenchmark) {
+  WriteWideFile(kFile);
+
+  std::vector<std::string> records;
+  for (int row = 0; row < kRows; row++) {
+    records.push_back(WideExample(row));
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &record : records) {
+    dataengine::Example example;
+    ASSERT_TRUE(example.ParseFromString(record));
+  }
+  double parse_ms = ElapsedMs(start);
+
+  int row_count = 0;
+  TensorRow first_row;
+  std::vector<std::string> projected = {"f0", "f1", "f2", "f120"};
+  double projected_ms = ReadColumns(projected, &row_count, &first_row);
+  ASSERT_EQ(row_count, kRows);
+  ASSERT_EQ(first_row.size(), projected.size());
+  float float_value = 0;
+  ASSERT_TRUE(first_row[0]->GetItemAt(&float_value, {kValues - 1}).IsOk());
+  EXPECT_EQ(float_value, static_cast<float>(kValues - 1));
+  int64_t int_value = 0;
+  ASSERT_TRUE(first_row[1]->GetItemAt(&int_value, {kValues - 1}).IsOk());
+  EXPECT_EQ(int_value, 1 - (kValues - 1));
+  EXPECT_EQ(first_row[2]->shape(), TensorShape({kValues}));
+  ASSERT_TRUE(first_row[3]->GetItemAt(&float_value, {0}).IsOk());
+  EXPECT_EQ(float_value, 60.0f);
+
+  std::vector<std::string> all_columns;
+  for (int i = 0; i < kFeatures; i++) {
+    all_columns.push_back("f" + std::to_string(i));
+  }
+  double all_ms = ReadColumns(all_columns, &row_count, &first_row);
+  ASSERT_EQ(row_count, kRows);
+  ASSERT_EQ(first_row.size(), kFeatures);
+
+  MS_LOG(INFO) << kRows << " Examples of " << kFeatures << " features: protobuf parse " << parse_ms << " ms, read "
+               << projected.size() << " columns " << projected_ms << " ms (" << kRows * 1000.0 / projected_ms
+               << " rows/s), read all columns " << all_ms << " ms (" << kRows * 1000.0 / all_ms << " rows/s).";
+}
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "runtime/device/cpu/cpu_kernel_runtime.h"
+#include "common/thread_pool.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+namespace {
+constexpr size_t kElementNum = 4;
+constexpr size_t kTensorSize = kElementNum * sizeof(float);
+std::atomic_bool state_written{false};
+
+// Element-wise sum of all the inputs plus a bias.
+class AddKernelMod : public kernel::KernelMod {
+ public:
+  AddKernelMod(size_t input_num, float bias) : input_size_list_(input_num, kTensorSize), bias_(bias) {}
+  ~AddKernelMod() override = default;
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+  bool Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &outputs, void *) override {
+    auto output = reinterpret_cast<float *>(outputs[0]->addr);
+    for (size_t i = 0; i < kElementNum; ++i) {
+      output[i] = bias_;
+      for (auto &input : inputs) {
+        output[i] += reinterpret_cast<float *>(input->addr)[i];
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_{kTensorSize};
+  std::vector<size_t> workspace_size_list_;
+  float bias_;
+};
+
+// Writes a state outside the graph, or reads it into the output. No data flows from the writer to the readers.
+class StateKernelMod : public kernel::KernelMod {
+ public:
+  explicit StateKernelMod(bool writer) : writer_(writer) {}
+  ~StateKernelMod() override = default;
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+  bool Launch(const std::vector<kernel::AddressPtr> &, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &outputs, void *) override {
+    if (writer_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      state_written = true;
+    }
+    auto output = reinterpret_cast<float *>(outputs[0]->addr);
+    for (size_t i = 0; i < kElementNum; ++i) {
+      output[i] = state_written ? 1 : 0;
+    }
+    return true;
+  }
+
+ private:
+  std::vector<size_t> input_size_list_{kTensorSize};
+  std::vector<size_t> output_size_list_{kTensorSize};
+  std::vector<size_t> workspace_size_list_;
+  bool writer_;
+};
+
+CNodePtr NewKernel(const std::shared_ptr<session::KernelGraph> &graph, const std::vector<AnfNodePtr> &inputs,
+                   const kernel::KernelModPtr &kernel_mod) {
+  std::vector<AnfNodePtr> node_inputs{NewValueNode(prim::kPrimTensorAdd)};
+  node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+  auto kernel = graph->NewCNode(node_inputs);
+  MS_EXCEPTION_IF_NULL(kernel);
+  kernel->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{kElementNum}));
+  KernelBuildInfoBuilder builder;
+  builder.SetInputsFormat(std::vector<std::string>(inputs.size(), kOpFormat_DEFAULT));
+  builder.SetInputsDeviceType(std::vector<TypeId>(inputs.size(), kNumberTypeFloat32));
+  builder.SetOutputsFormat({kOpFormat_DEFAULT});
+  builder.SetOutputsDeviceType({kNumberTypeFloat32});
+  AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), kernel.get());
+  AnfAlgo::SetKernelMod(kernel_mod, kernel.get());
+  return kernel;
+}
+}  // namespace
+
+class TestCPUKernelRuntime : public UT::Common {
+ public:
+  TestCPUKernelRuntime() {}
+  void SetUp() override {
+    auto context = MsContext::GetInstance();
+    MS_EXCEPTION_IF_NULL(context);
+    parallel_execute_ = context->get_param<bool>(MS_CTX_ENABLE_CPU_PARALLEL_EXECUTE);
+    context->set_param<bool>(MS_CTX_ENABLE_CPU_PARALLEL_EXECUTE, true);
+  }
+  void TearDown() override {
+    MsContext::GetInstance()->set_param<bool>(MS_CTX_ENABLE_CPU_PARALLEL_EXECUTE, parallel_execute_);
+  }
+
+ private:
+  bool parallel_execute_{false};
+};
+
+// x -> a = x + 1, b = x + 2, c = a + b; w writes a state which r and s read. ControlDepend(w, r) orders r, s takes
+// Depend(x, w) as input. The outputs must be the same as a serial run whatever the number of threads is.
+TEST_F(TestCPUKernelRuntime, test_parallel_run) {
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto x = graph->NewParameter(std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{kElementNum}));
+  graph->MutableInputs()->push_back(x);
+  auto a = NewKernel(graph, {x}, std::make_shared<AddKernelMod>(1, 1));
+  auto b = NewKernel(graph, {x}, std::make_shared<AddKernelMod>(1, 2));
+  auto c = NewKernel(graph, {a, b}, std::make_shared<AddKernelMod>(2, 0));
+  auto w = NewKernel(graph, {x}, std::make_shared<StateKernelMod>(true));
+  auto r = NewKernel(graph, {x}, std::make_shared<StateKernelMod>(false));
+  auto s = NewKernel(graph, {graph->NewCNode({NewValueNode(prim::kPrimDepend), x, w})},
+                     std::make_shared<StateKernelMod>(false));
+  auto control_depend = graph->NewCNode({NewValueNode(prim::kPrimControlDepend), w, r});
+  auto depend = graph->NewCNode({NewValueNode(prim::kPrimDepend), r, control_depend});
+  graph->set_output(graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), c, depend, s, w}));
+  graph->set_execution_order({w, a, b, r, s, c});
+
+  CPUKernelRuntime runtime;
+  runtime.AssignKernelAddress(graph.get());
+  auto input = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{kElementNum});
+  auto input_data = reinterpret_cast<float *>(input->data_c());
+  for (size_t i = 0; i < kElementNum; ++i) {
+    input_data[i] = static_cast<float>(i);
+  }
+  std::vector<tensor::TensorPtr> inputs = {input};
+  VectorRef outputs;
+  runtime.CreateOutputTensors(graph.get(), inputs, &outputs);
+  runtime.BindInputOutput(graph.get(), inputs, &outputs);
+  state_written = false;
+  ASSERT_TRUE(runtime.Run(graph.get(), false));
+
+  ASSERT_EQ(outputs.size(), 4);
+  auto c_output = reinterpret_cast<float *>(utils::cast<tensor::TensorPtr>(outputs[0])->data_c());
+  auto r_output = reinterpret_cast<float *>(utils::cast<tensor::TensorPtr>(outputs[1])->data_c());
+  auto s_output = reinterpret_cast<float *>(utils::cast<tensor::TensorPtr>(outputs[2])->data_c());
+  for (size_t i = 0; i < kElementNum; ++i) {
+    EXPECT_EQ(c_output[i], 2 * input_data[i] + 3);
+    EXPECT_EQ(r_output[i], 1);
+    EXPECT_EQ(s_output[i], 1);
+  }
+  if (ThreadPool::GetInstance()->GetThreadNum() > 1) {
+    EXPECT_EQ(runtime.parallel_execute_stats().kernel_num_, 6);
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
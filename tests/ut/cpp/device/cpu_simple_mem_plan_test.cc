@@ -0,0 +1,177 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() {}
+};
+
+MemBlock NewMemBlock(size_t size, size_t def_step, size_t last_step) {
+  MemBlock block;
+  block.size_ = size;
+  block.def_step_ = def_step;
+  block.last_step_ = last_step;
+  return block;
+}
+
+bool IsOverlapped(const MemBlock &a, const MemBlock &b) {
+  bool time_overlapped = a.def_step_ <= b.last_step_ && b.def_step_ <= a.last_step_;
+  bool space_overlapped = a.offset_ < b.offset_ + b.size_ && b.offset_ < a.offset_ + a.size_;
+  return time_overlapped && space_overlapped;
+}
+
+class TestDeviceAddress : public DeviceAddress {
+ public:
+  explicit TestDeviceAddress(size_t size) : DeviceAddress(nullptr, size) {}
+  ~TestDeviceAddress() override = default;
+  bool SyncDeviceToHost(const ShapeVector &, size_t, TypeId, void *) const override { return true; }
+  bool SyncHostToDevice(const ShapeVector &, size_t, TypeId, const void *) const override { return true; }
+};
+
+class TestKernelMod : public kernel::KernelMod {
+ public:
+  TestKernelMod(size_t output_size, const std::vector<size_t> &workspace_sizes)
+      : output_size_list_({output_size}), workspace_size_list_(workspace_sizes) {}
+  ~TestKernelMod() override = default;
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+  bool Launch(const std::vector<kernel::AddressPtr> &, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &, void *) override {
+    return true;
+  }
+
+ private:
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+
+// A planned buffer together with the steps of the execution order it is alive in.
+struct PlannedBuffer {
+  const DeviceAddress *address;
+  size_t def_step;
+  size_t last_step;
+};
+
+CNodePtr NewKernel(const std::shared_ptr<session::KernelGraph> &graph, const std::vector<AnfNodePtr> &inputs,
+                   size_t output_size, const std::vector<size_t> &workspace_sizes) {
+  std::vector<AnfNodePtr> node_inputs{NewValueNode(prim::kPrimTensorAdd)};
+  node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+  auto kernel = graph->NewCNode(node_inputs);
+  MS_EXCEPTION_IF_NULL(kernel);
+  kernel->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{1}));
+  AnfAlgo::SetKernelMod(std::make_shared<TestKernelMod>(output_size, workspace_sizes), kernel.get());
+  AnfAlgo::SetOutputAddr(std::make_shared<TestDeviceAddress>(output_size), 0, kernel.get());
+  for (size_t i = 0; i < workspace_sizes.size(); ++i) {
+    AnfAlgo::SetWorkspaceAddr(std::make_shared<TestDeviceAddress>(workspace_sizes[i]), i, kernel.get());
+  }
+  return kernel;
+}
+
+// Each output is only consumed by the next kernel, two buffers are enough for the whole chain.
+TEST_F(TestCPUSimpleMemPlan, test_chain_reuse) {
+  std::vector<MemBlock> blocks;
+  for (size_t step = 0; step < 8; ++step) {
+    blocks.push_back(NewMemBlock(1024, step, step + 1));
+  }
+  size_t total_size = CPUSimpleMemPlan::AssignBlockOffsets(&blocks);
+  EXPECT_EQ(total_size, 2048);
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    for (size_t j = i + 1; j < blocks.size(); ++j) {
+      EXPECT_FALSE(IsOverlapped(blocks[i], blocks[j]));
+    }
+  }
+}
+
+// All blocks are alive at the same time, no memory can be shared.
+TEST_F(TestCPUSimpleMemPlan, test_no_reuse) {
+  std::vector<MemBlock> blocks = {NewMemBlock(64, 0, 3), NewMemBlock(128, 1, 3), NewMemBlock(32, 2, 3)};
+  size_t total_size = CPUSimpleMemPlan::AssignBlockOffsets(&blocks);
+  EXPECT_EQ(total_size, 224);
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    for (size_t j = i + 1; j < blocks.size(); ++j) {
+      EXPECT_FALSE(IsOverlapped(blocks[i], blocks[j]));
+    }
+  }
+}
+
+// A small block created after the largest one dies is placed into the gap it leaves.
+TEST_F(TestCPUSimpleMemPlan, test_fill_gap) {
+  std::vector<MemBlock> blocks = {NewMemBlock(100, 0, 4), NewMemBlock(200, 0, 1), NewMemBlock(20, 2, 3)};
+  size_t total_size = CPUSimpleMemPlan::AssignBlockOffsets(&blocks);
+  EXPECT_EQ(total_size, 352);
+  EXPECT_EQ(blocks[2].offset_ % 32, 0);
+  EXPECT_FALSE(IsOverlapped(blocks[0], blocks[2]));
+  EXPECT_FALSE(IsOverlapped(blocks[0], blocks[1]));
+}
+
+// Plan a whole graph: buffers alive at the same step must never share bytes of the planned memory.
+//   a = op(x); b = op(a) with a workspace; c = op(b); d = op(a, c); return d
+TEST_F(TestCPUSimpleMemPlan, test_graph_plan_no_overlap) {
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto x = graph->NewParameter(std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{1}));
+  auto a = NewKernel(graph, {x}, 1024, {});
+  auto b = NewKernel(graph, {a}, 1024, {256});
+  auto c = NewKernel(graph, {b}, 512, {});
+  auto d = NewKernel(graph, {a, c}, 1024, {});
+  graph->set_execution_order({a, b, c, d});
+  graph->set_output(d);
+
+  CPUSimpleMemPlan mem_plan;
+  mem_plan.set_mem_reuse(true);
+  size_t planned_size = mem_plan.MemPlan(graph.get());
+  EXPECT_LT(planned_size, mem_plan.naive_mem_size());
+  std::vector<uint8_t> memory(planned_size);
+  mem_plan.MemAssign(graph.get(), memory.data());
+
+  std::vector<PlannedBuffer> buffers = {{AnfAlgo::GetOutputAddr(a, 0), 0, 3},
+                                        {AnfAlgo::GetOutputAddr(b, 0), 1, 2},
+                                        {AnfAlgo::GetWorkspaceAddr(b, 0), 1, 1},
+                                        {AnfAlgo::GetOutputAddr(c, 0), 2, 3},
+                                        {AnfAlgo::GetOutputAddr(d, 0), 3, 4}};
+  for (auto &buffer : buffers) {
+    auto begin = static_cast<const uint8_t *>(buffer.address->GetPtr());
+    ASSERT_NE(begin, nullptr);
+    EXPECT_GE(begin, memory.data());
+    EXPECT_LE(begin + buffer.address->GetSize(), memory.data() + memory.size());
+  }
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    for (size_t j = i + 1; j < buffers.size(); ++j) {
+      auto &x_buf = buffers[i];
+      auto &y_buf = buffers[j];
+      if (x_buf.def_step > y_buf.last_step || y_buf.def_step > x_buf.last_step) {
+        continue;
+      }
+      auto x_begin = static_cast<const uint8_t *>(x_buf.address->GetPtr());
+      auto y_begin = static_cast<const uint8_t *>(y_buf.address->GetPtr());
+      EXPECT_TRUE(x_begin + x_buf.address->GetSize() <= y_begin || y_begin + y_buf.address->GetSize() <= x_begin)
+        << "buffer " << i << " and buffer " << j << " are alive together but share memory";
+    }
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
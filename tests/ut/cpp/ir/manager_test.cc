@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
+#include <set>
 #include "common/common_test.h"
 #include "common/py_func_graph_fetcher.h"
 #include "ir/dtype.h"
@@ -621,4 +623,208 @@ TEST_F(TestManager, test_keep_roots_recursion) {
   ASSERT_EQ(mng->func_graphs().size(), 1);
 }
 
+namespace {
+/*
+ * def f0(x0):
+ *   def f1(x1):
+ *     ...
+ *         def fn(xn):
+ *           return xn + x(n-1)
+ *     ...
+ *     return f2(x1) + x0
+ *   return f1(x0)
+ */
+struct DeepClosures {
+  std::vector<FuncGraphPtr> graphs;
+  std::vector<ParameterPtr> params;
+  // the call of f(i+1) in fi
+  std::vector<CNodePtr> calls;
+  // the output of fi, whose input 2 is the free variable x(i-1)
+  std::vector<CNodePtr> adds;
+};
+
+DeepClosures MakeDeepClosures(size_t depth) {
+  DeepClosures closures;
+  for (size_t i = 0; i <= depth; i++) {
+    auto fg = std::make_shared<FuncGraph>();
+    closures.graphs.push_back(fg);
+    closures.params.push_back(fg->add_parameter());
+  }
+  for (size_t i = 0; i <= depth; i++) {
+    auto &fg = closures.graphs[i];
+    AnfNodePtr result = closures.params[i];
+    if (i < depth) {
+      auto call = fg->NewCNode({NewValueNode(closures.graphs[i + 1]), closures.params[i]});
+      closures.calls.push_back(call);
+      result = call;
+    }
+    if (i > 0) {
+      auto add = fg->NewCNode({NewValueNode(prim::kPrimScalarAdd), result, closures.params[i - 1]});
+      closures.adds.push_back(add);
+      result = add;
+    } else {
+      closures.adds.push_back(nullptr);
+    }
+    fg->set_output(result);
+  }
+  return closures;
+}
+
+std::set<FuncGraphPtr> ToSet(const FuncGraphSet &func_graphs) {
+  return std::set<FuncGraphPtr>(func_graphs.begin(), func_graphs.end());
+}
+
+std::set<const void *> FreeVariables(const OrderedMap<BaseRef, int, BaseRefHash> &fv_total) {
+  std::set<const void *> fvs;
+  for (auto &fv : fv_total) {
+    if (utils::isa<AnfNodePtr>(fv.first)) {
+      fvs.insert(utils::cast<AnfNodePtr>(fv.first).get());
+    } else if (utils::isa<FuncGraphPtr>(fv.first)) {
+      fvs.insert(utils::cast<FuncGraphPtr>(fv.first).get());
+    }
+  }
+  return fvs;
+}
+
+struct Analysis {
+  FuncGraphPtr parent;
+  std::set<FuncGraphPtr> parents_total;
+  std::set<FuncGraphPtr> children;
+  std::set<FuncGraphPtr> scopes;
+  std::set<FuncGraphPtr> used_total;
+  std::set<const void *> fv_total;
+  bool recursive;
+  bool j_total;
+};
+
+std::vector<Analysis> GetAnalysis(const FuncGraphManagerPtr &mng) {
+  std::vector<Analysis> analysis;
+  for (auto &fg : mng->func_graphs()) {
+    analysis.push_back({mng->parent(fg), ToSet(mng->func_graph_parents_total(fg)), ToSet(mng->children(fg)),
+                        ToSet(mng->scopes(fg)), ToSet(mng->func_graphs_used_total(fg)),
+                        FreeVariables(mng->free_variables_total(fg)), mng->recursive(fg), mng->func_graph_j_total(fg)});
+  }
+  return analysis;
+}
+
+// Check the analysis kept by mng are the ones computed again from scratch.
+void CheckAnalysis(const FuncGraphManagerPtr &mng) {
+  auto kept = GetAnalysis(mng);
+  mng->signals()->InvalidateComputer(nullptr);
+  auto expected = GetAnalysis(mng);
+  ASSERT_EQ(kept.size(), expected.size());
+  for (size_t i = 0; i < kept.size(); i++) {
+    ASSERT_EQ(kept[i].parent, expected[i].parent);
+    ASSERT_EQ(kept[i].parents_total, expected[i].parents_total);
+    ASSERT_EQ(kept[i].children, expected[i].children);
+    ASSERT_EQ(kept[i].scopes, expected[i].scopes);
+    ASSERT_EQ(kept[i].used_total, expected[i].used_total);
+    ASSERT_EQ(kept[i].fv_total, expected[i].fv_total);
+    ASSERT_EQ(kept[i].recursive, expected[i].recursive);
+    ASSERT_EQ(kept[i].j_total, expected[i].j_total);
+  }
+}
+
+// Query the analysis an optimization pass reads around fi.
+void QueryAround(const FuncGraphManagerPtr &mng, const DeepClosures &closures, size_t i) {
+  for (size_t j = i - 1; j <= i + 1; j++) {
+    auto &fg = closures.graphs[j];
+    (void)mng->parent(fg);
+    (void)mng->scopes(fg);
+    (void)mng->free_variables_total(fg);
+    (void)mng->func_graph_j_total(fg);
+  }
+}
+}  // namespace
+
+// The analysis of the graphs are updated as the free variables and the used graphs change.
+TEST_F(TestManager, test_incremental_analysis) {
+  constexpr size_t kDepth = 16;
+  auto closures = MakeDeepClosures(kDepth);
+  auto &graphs = closures.graphs;
+  auto &params = closures.params;
+  auto mng = Manage(graphs[0]);
+  CheckAnalysis(mng);
+  ASSERT_EQ(mng->parent(graphs[5]), graphs[4]);
+
+  // f5 only uses x0, its parent is f0.
+  mng->SetEdge(closures.adds[5], 2, params[0]);
+  CheckAnalysis(mng);
+  ASSERT_EQ(mng->parent(graphs[5]), graphs[0]);
+  ASSERT_TRUE(mng->children(graphs[0]).contains(graphs[5]));
+  ASSERT_EQ(mng->free_variables_total(graphs[4]).count(graphs[5]), 1);
+
+  // f1 takes J(f2), the graphs using f1 contain J.
+  ASSERT_FALSE(mng->func_graph_j_total(graphs[0]));
+  mng->SetEdge(closures.adds[1], 1, graphs[1]->NewCNode({NewValueNode(prim::kPrimJ), NewValueNode(graphs[2])}));
+  CheckAnalysis(mng);
+  ASSERT_TRUE(mng->func_graph_j_total(graphs[0]));
+
+  // f9 uses no free variable, it's a top graph.
+  mng->SetEdge(closures.adds[9], 2, params[9]);
+  CheckAnalysis(mng);
+  ASSERT_EQ(mng->parent(graphs[9]), nullptr);
+
+  // f12 doesn't call f13 any more, the graphs from f13 are dropped.
+  mng->Replace(closures.calls[12], params[12]);
+  CheckAnalysis(mng);
+  ASSERT_EQ(mng->func_graphs().size(), 13);
+
+  // f3 uses x1 and f14 is called in f2 again.
+  mng->SetEdge(closures.adds[3], 2, params[1]);
+  mng->SetEdge(closures.calls[2], 0, NewValueNode(graphs[14]));
+  CheckAnalysis(mng);
+  ASSERT_EQ(mng->parent(graphs[14]), graphs[13]);
+  ASSERT_TRUE(mng->func_graph_parents_total(graphs[2]).contains(graphs[13]));
+}
+
+// Log the time of the analysis read by a pass changing each graph of a deep network, when the analysis are kept
+// incrementally and when they are computed again on each change as before.
+TEST_F(TestManager, test_deep_closures_compile_time) {
+  constexpr size_t kDepth = 150;
+  std::vector<double> times;
+  std::vector<std::vector<FuncGraphPtr>> parents;
+  for (bool reset : {false, true}) {
+    auto closures = MakeDeepClosures(kDepth);
+    auto mng = Manage(closures.graphs[0]);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 2; i < kDepth; i++) {
+      mng->SetEdge(closures.adds[i], 2, closures.params[i - 2]);
+      if (reset) {
+        mng->signals()->InvalidateComputer(nullptr);
+      }
+      QueryAround(mng, closures, i);
+    }
+    times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    parents.emplace_back();
+    for (auto &fg : closures.graphs) {
+      auto parent = mng->parent(fg);
+      parents.back().push_back(parent);
+    }
+  }
+  ASSERT_EQ(parents[0].size(), parents[1].size());
+  for (size_t i = 0; i < parents[0].size(); i++) {
+    ASSERT_EQ(parents[0][i] == nullptr, parents[1][i] == nullptr);
+  }
+  MS_LOG(INFO) << "Analysis of " << kDepth << " nested graphs changed one by one: incremental " << times[0]
+               << " ms, computed again on each change " << times[1] << " ms.";
+}
+
+// The dropped graphs are not held by the analysis of the manager.
+TEST_F(TestManager, test_drop_analysis) {
+  constexpr size_t kDepth = 16;
+  auto closures = MakeDeepClosures(kDepth);
+  auto root = closures.graphs[0];
+  std::weak_ptr<FuncGraph> dropped = closures.graphs[13];
+  auto mng = Manage(root);
+  CheckAnalysis(mng);
+
+  // f12 doesn't call f13 any more, the graphs from f13 are dropped.
+  mng->Replace(closures.calls[12], closures.params[12]);
+  ASSERT_EQ(mng->func_graphs().size(), 13);
+  closures = DeepClosures();
+  ASSERT_TRUE(dropped.expired());
+  CheckAnalysis(mng);
+}
+
 }  // namespace mindspore
@@ -362,6 +362,40 @@ TEST_F(TestTensor, TensorDataTest) {
   }
 }
 
+TEST_F(TestTensor, ExternalDataTest) {
+  float *buf = new float[6]{1.1, 2.2, 3.3, 4.4, 5.5, 6.6};
+  int released = 0;
+  auto deleter = [&released](void *data) {
+    released++;
+    delete[] static_cast<float *>(data);
+  };
+  auto tensor = std::make_shared<Tensor>(kNumberTypeFloat32, std::vector<int>({2, 3}), buf, 6 * sizeof(float), deleter);
+  // The buffer is used in place and released with the last tensor sharing it.
+  ASSERT_EQ(tensor->data_c(), buf);
+  auto shared = std::make_shared<Tensor>(*tensor);
+  tensor = nullptr;
+  ASSERT_EQ(released, 0);
+  ASSERT_EQ(static_cast<float *>(shared->data_c())[5], static_cast<float>(6.6));
+  shared = nullptr;
+  ASSERT_EQ(released, 1);
+
+  // A buffer not aligned for the element type is copied and released at once.
+  alignas(float) char unaligned[sizeof(float) * 2 + 1];
+  float values[] = {7.7, 8.8};
+  ASSERT_EQ(memcpy_s(unaligned + 1, sizeof(values), values, sizeof(values)), 0);
+  int unaligned_released = 0;
+  Tensor copied(kNumberTypeFloat32, std::vector<int>({2}), unaligned + 1, sizeof(values),
+                [&unaligned_released](void *) { unaligned_released++; });
+  ASSERT_EQ(unaligned_released, 1);
+  ASSERT_NE(copied.data_c(), unaligned + 1);
+  ASSERT_EQ(static_cast<float *>(copied.data_c())[1], values[1]);
+
+  // A buffer without deleter outlives the tensor.
+  float outer[] = {1.0, 2.0};
+  Tensor borrowed(kNumberTypeFloat32, std::vector<int>({2}), outer, sizeof(outer), nullptr);
+  ASSERT_EQ(borrowed.data_c(), outer);
+}
+
 TEST_F(TestTensor, TensorPyCast) {
   std::vector<int> shape{2, 3, 4, 5};
   py::tuple py_tuple = py::make_tuple(std::make_shared<Tensor>(kNumberTypeFloat32, shape));
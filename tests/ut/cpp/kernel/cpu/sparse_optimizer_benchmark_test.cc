@@ -0,0 +1,228 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/common_utils.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/sparse_apply_ftrl_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/sparse_apply_lazy_adam_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class SparseOptimizerBenchmarkTest : public UT::Common {
+ public:
+  SparseOptimizerBenchmarkTest() = default;
+};
+
+namespace {
+constexpr size_t kVocabSize = 20000;
+constexpr size_t kBatchSize = 8192;
+constexpr size_t kSteps = 5;
+constexpr float kLr = 0.01;
+constexpr float kL1 = 0.001;
+constexpr float kL2 = 0.001;
+constexpr float kBeta1 = 0.9;
+constexpr float kBeta2 = 0.999;
+constexpr float kEpsilon = 1e-8;
+
+// Ids drawn with probability proportional to 1 / (rank + 1) ^ exponent, an exponent of 0 is uniform.
+std::vector<int> ZipfIds(size_t ids_num, size_t vocab_size, double exponent, std::mt19937 *engine) {
+  std::vector<double> weights(vocab_size);
+  for (size_t i = 0; i < vocab_size; i++) {
+    weights[i] = 1.0 / std::pow(i + 1, exponent);
+  }
+  std::discrete_distribution<int> distribution(weights.begin(), weights.end());
+  std::vector<int> ids(ids_num);
+  for (auto &id : ids) {
+    id = distribution(*engine);
+  }
+  return ids;
+}
+
+AddressPtr CreateKernelAddress(void *addr) {
+  auto kernel_addr = std::make_shared<Address>();
+  kernel_addr->addr = addr;
+  return kernel_addr;
+}
+
+// The summed gradient of every distinct id, computed the straightforward way as reference.
+std::map<int, std::vector<float>> ReduceGrad(const std::vector<int> &ids, const std::vector<float> &grad, size_t dim) {
+  std::map<int, std::vector<float>> reduced;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    auto &row = reduced[ids[i]];
+    row.resize(dim, 0);
+    for (size_t j = 0; j < dim; ++j) {
+      row[j] += grad[i * dim + j];
+    }
+  }
+  return reduced;
+}
+
+void ReferenceFtrl(const std::vector<int> &ids, const std::vector<float> &grad, size_t dim, std::vector<float> *var,
+                   std::vector<float> *accum, std::vector<float> *linear) {
+  for (auto &iter : ReduceGrad(ids, grad, dim)) {
+    for (size_t j = 0; j < dim; ++j) {
+      size_t k = iter.first * dim + j;
+      auto g = iter.second[j];
+      auto accum_new = (*accum)[k] + g * g;
+      auto y = std::sqrt(accum_new);
+      (*linear)[k] += g - (y - std::sqrt((*accum)[k])) / kLr * (*var)[k];
+      (*accum)[k] = accum_new;
+      auto x = Sign((*linear)[k]) * kL1 - (*linear)[k];
+      y = y / kLr + 2 * kL2;
+      (*var)[k] = std::fabs((*linear)[k]) > kL1 ? x / y : 0;
+    }
+  }
+}
+
+void ReferenceLazyAdam(const std::vector<int> &ids, const std::vector<float> &grad, size_t dim,
+                       std::vector<float> *var, std::vector<float> *m, std::vector<float> *v) {
+  for (auto &iter : ReduceGrad(ids, grad, dim)) {
+    for (size_t j = 0; j < dim; ++j) {
+      size_t k = iter.first * dim + j;
+      auto g = iter.second[j];
+      (*m)[k] = kBeta1 * (*m)[k] + (1 - kBeta1) * g;
+      (*v)[k] = kBeta2 * (*v)[k] + (1 - kBeta2) * g * g;
+      (*var)[k] -= kLr * (*m)[k] / (std::sqrt((*v)[k]) + kEpsilon);
+    }
+  }
+}
+
+void ExpectNear(const std::vector<float> &actual, const std::vector<float> &expect) {
+  ASSERT_EQ(actual.size(), expect.size());
+  size_t mismatch = 0;
+  for (size_t i = 0; i < actual.size(); ++i) {
+    // The duplicated rows are summed in another order than the reference does.
+    if (std::fabs(actual[i] - expect[i]) > 1e-4 * (1 + std::fabs(expect[i]))) {
+      mismatch++;
+    }
+  }
+  EXPECT_EQ(mismatch, 0);
+}
+
+double ElapsedMs(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+// Step time of the sparse FTRL and LazyAdam kernels for embedding sized rows and skewed ids, checked against the
+// scalar reference update.
+TEST_F(SparseOptimizerBenchmarkTest, ZipfEmbeddingBenchmark) {
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> grad_distribution(-1, 1);
+  for (size_t dim : {16, 64, 256}) {
+    for (double exponent : {0.0, 1.0, 1.2}) {
+      std::vector<std::vector<int>> batches;
+      std::vector<std::vector<float>> grads;
+      for (size_t step = 0; step < kSteps; ++step) {
+        batches.push_back(ZipfIds(kBatchSize, kVocabSize, exponent, &engine));
+        std::vector<float> grad(kBatchSize * dim);
+        for (auto &value : grad) {
+          value = grad_distribution(engine);
+        }
+        grads.push_back(grad);
+      }
+      std::vector<float> new_grad(kBatchSize * dim);
+      std::vector<int> new_indices(kBatchSize);
+      std::vector<float> tmp_grad(kBatchSize * dim);
+      std::vector<int> tmp_indices(kBatchSize);
+      std::vector<AddressPtr> workspace{CreateKernelAddress(new_grad.data()), CreateKernelAddress(new_indices.data()),
+                                        CreateKernelAddress(tmp_grad.data()), CreateKernelAddress(tmp_indices.data())};
+      std::vector<AddressPtr> outputs;
+
+      auto ftrl = std::make_shared<SparseApplyFtrlCPUKernel>();
+      ftrl->lr_ = kLr;
+      ftrl->l1_ = kL1;
+      ftrl->l2_ = kL2;
+      ftrl->lr_power_ = -0.5;
+      ftrl->indices_size_ = kBatchSize;
+      ftrl->var_first_dim_size_ = kVocabSize;
+      ftrl->var_outer_dim_size_ = dim;
+      std::vector<float> var(kVocabSize * dim, 1.0);
+      std::vector<float> accum(kVocabSize * dim, 0.1);
+      std::vector<float> linear(kVocabSize * dim, 0.0);
+      auto expect_var = var;
+      auto expect_accum = accum;
+      auto expect_linear = linear;
+      double ftrl_ms = 0;
+      double ftrl_reference_ms = 0;
+      for (size_t step = 0; step < kSteps; ++step) {
+        std::vector<AddressPtr> inputs{CreateKernelAddress(var.data()), CreateKernelAddress(accum.data()),
+                                       CreateKernelAddress(linear.data()), CreateKernelAddress(grads[step].data()),
+                                       CreateKernelAddress(batches[step].data())};
+        auto start = std::chrono::steady_clock::now();
+        ftrl->Launch(inputs, workspace, outputs);
+        ftrl_ms += ElapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        ReferenceFtrl(batches[step], grads[step], dim, &expect_var, &expect_accum, &expect_linear);
+        ftrl_reference_ms += ElapsedMs(start);
+      }
+      ExpectNear(var, expect_var);
+      ExpectNear(linear, expect_linear);
+
+      auto lazy_adam = std::make_shared<SparseApplyLazyAdamCPUKernel>();
+      lazy_adam->indices_size_ = kBatchSize;
+      lazy_adam->var_first_dim_size_ = kVocabSize;
+      lazy_adam->var_outer_dim_size_ = dim;
+      std::fill(var.begin(), var.end(), 1.0);
+      std::vector<float> m(kVocabSize * dim, 0.0);
+      std::vector<float> v(kVocabSize * dim, 0.0);
+      expect_var = var;
+      auto expect_m = m;
+      auto expect_v = v;
+      // The kernel folds the bias correction into lr, 1 - beta1_power == sqrt(1 - beta2_power) keeps it at kLr.
+      float beta1_power = kBeta1;
+      float beta2_power = 1 - (1 - beta1_power) * (1 - beta1_power);
+      float lr = kLr;
+      float beta1 = kBeta1;
+      float beta2 = kBeta2;
+      float epsilon = kEpsilon;
+      double adam_ms = 0;
+      double adam_reference_ms = 0;
+      for (size_t step = 0; step < kSteps; ++step) {
+        std::vector<AddressPtr> inputs{
+          CreateKernelAddress(var.data()),          CreateKernelAddress(m.data()),
+          CreateKernelAddress(v.data()),            CreateKernelAddress(&beta1_power),
+          CreateKernelAddress(&beta2_power),        CreateKernelAddress(&lr),
+          CreateKernelAddress(&beta1),              CreateKernelAddress(&beta2),
+          CreateKernelAddress(&epsilon),            CreateKernelAddress(grads[step].data()),
+          CreateKernelAddress(batches[step].data())};
+        auto start = std::chrono::steady_clock::now();
+        lazy_adam->Launch(inputs, workspace, outputs);
+        adam_ms += ElapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        ReferenceLazyAdam(batches[step], grads[step], dim, &expect_var, &expect_m, &expect_v);
+        adam_reference_ms += ElapsedMs(start);
+      }
+      ExpectNear(var, expect_var);
+      ExpectNear(m, expect_m);
+
+      MS_LOG(INFO) << "dim " << dim << ", zipf " << exponent << ": ftrl " << ftrl_ms / kSteps << " ms/step (reference "
+                   << ftrl_reference_ms / kSteps << "), lazy adam " << adam_ms / kSteps << " ms/step (reference "
+                   << adam_reference_ms / kSteps << ")";
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -130,5 +130,61 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient2) {
     EXPECT_EQ(unique_grad.value_[i], expect_value[i]);
   }
 }
+
+TEST_F(CommonUtilTest, SortReduceSparseGradient) {
+  // The indices is a vector and the grad is a tensor with shape (6, 2), with 6 buckets 0 goes to bucket 0 while 5 and
+  // 11 go to the last bucket
+  /* 5
+   * 0
+   * 11
+   * 5
+   * 0
+   * 11
+   */
+  std::vector<int> indices{5, 0, 11, 5, 0, 11};
+  /* 0 1
+   * 2 3
+   * 4 5
+   * 6 7
+   * 8 9
+   * 10 11
+   */
+  std::vector<float> grad;
+  for (int i = 0; i < 6 * 2; i++) {
+    grad.push_back(i);
+  }
+  std::vector<int> unique_indices(6);
+  std::vector<float> summed_grad(12);
+  std::vector<int> tmp_indices(6);
+  std::vector<float> tmp_grad(12);
+  SparseGradient<int> unique_grad({summed_grad.data(), unique_indices.data(), 6});
+  SparseGradient<int> workspace_grad({tmp_grad.data(), tmp_indices.data(), 6});
+  SparseGradient<int> input_grad({grad.data(), indices.data(), 6});
+
+  ReduceSparseGradientParam<int> param;
+  param.input_grad_ = &input_grad;
+  param.workspace_grad_ = &workspace_grad;
+  param.output_grad_ = &unique_grad;
+  param.max_index_ = 12;
+  param.value_stride_ = 2;
+  param.use_sort_reduce_ = true;
+  SparseOptimizerCPUKernel::BucketReduceSparseGradient(param);
+
+  EXPECT_EQ(unique_grad.indices_size_, 3);
+
+  std::vector<int> expect_indices({0, 5, 11});
+  for (size_t i = 0; i < unique_grad.indices_size_; ++i) {
+    EXPECT_EQ(unique_grad.indices_[i], expect_indices[i]);
+  }
+
+  /* 10 12
+   * 6 8
+   * 14 16
+   */
+  std::vector<int> expect_value({10, 12, 6, 8, 14, 16});
+  for (size_t i = 0; i < unique_grad.indices_size_ * 2; ++i) {
+    EXPECT_EQ(unique_grad.value_[i], expect_value[i]);
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -59,6 +59,7 @@ TEST_F(TestShard, TestShardSchemaPart) {
     string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(filename + ".idx"));
   }
 }
 
@@ -14,18 +14,24 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <cstring>
 #include <functional>
 #include <iostream>
+#include <fstream>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_category.h"
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
+#include "minddata/mindrecord/include/shard_shuffle.h"
 #include "ut_common.h"
 
 using mindspore::LogStream;
@@ -43,8 +49,10 @@ class TestShardReader : public UT::Common {
     for (int i = 1; i <= 4; i++) {
       string filename = std::string("./imagenet.shard0") + std::to_string(i);
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
+      string idx_name = filename + kColumnarIndexSuffix;
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(idx_name));
     }
   }
 };
@@ -194,5 +202,169 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+
+TEST_F(TestShardReader, TestShardReaderMmapView) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet through mmap views");
+  std::string file_name = "./imagenet.shard01";
+  // operators keep state across epochs, so each reader gets its own shuffle with the same seed
+  std::vector<std::shared_ptr<ShardOperator>> stream_ops = {std::make_shared<ShardShuffle>(1)};
+  std::vector<std::shared_ptr<ShardOperator>> mmap_ops = {std::make_shared<ShardShuffle>(1)};
+
+  ShardReader stream_reader;
+  ASSERT_EQ(stream_reader.Open({file_name}, true, 4, {}, stream_ops), SUCCESS);
+  ASSERT_FALSE(stream_reader.IsMapped());
+  ASSERT_EQ(stream_reader.Launch(true), SUCCESS);
+
+  ShardReader mmap_reader;
+  mmap_reader.SetUseMmap(true);
+  ASSERT_EQ(mmap_reader.Open({file_name}, true, 4, {}, mmap_ops), SUCCESS);
+  ASSERT_TRUE(mmap_reader.IsMapped());
+  ASSERT_EQ(mmap_reader.Launch(true), SUCCESS);
+
+  ASSERT_EQ(stream_reader.GetNumRows(), mmap_reader.GetNumRows());
+  ASSERT_GT(mmap_reader.GetNumRows(), 0);
+  for (int row_id = 0; row_id < mmap_reader.GetNumRows(); ++row_id) {
+    auto expected = stream_reader.GetNextById(row_id, 0);
+    auto actual = mmap_reader.GetNextViewById(row_id);
+    ASSERT_EQ(expected.first, actual.first);
+    ASSERT_EQ(expected.second.size(), 1);
+    ASSERT_EQ(actual.second.size(), 1);
+    const auto &blob = std::get<0>(expected.second[0]);
+    ASSERT_EQ(std::get<1>(actual.second[0]), blob.size());
+    ASSERT_EQ(memcmp(std::get<0>(actual.second[0]), blob.data(), blob.size()), 0);
+    ASSERT_EQ(std::get<2>(actual.second[0]), std::get<1>(expected.second[0]));
+
+    // the copying accessor reads from the mapping as well
+    auto copied = mmap_reader.GetNextById(row_id, 0);
+    ASSERT_EQ(std::get<0>(copied.second[0]), blob);
+  }
+  ASSERT_TRUE(mmap_reader.GetNextViewById(mmap_reader.GetNumRows()).second.empty());
+  stream_reader.Close();
+  mmap_reader.Close();
+  ASSERT_FALSE(mmap_reader.IsMapped());
+}
+
+TEST_F(TestShardReader, TestShardReaderMmapBenchmark) {
+  MS_LOG(INFO) << FormatInfo("Compare stream and mmap reading");
+  std::string file_name = "./imagenet.shard01";
+  const int kRounds = 200;
+
+  auto run = [&file_name, kRounds](bool use_mmap, double *samples_per_sec, uint64_t *checksum) {
+    ShardReader dataset;
+    dataset.SetUseMmap(use_mmap);
+    ASSERT_EQ(dataset.Open({file_name}, true, 1), SUCCESS);
+    ASSERT_EQ(dataset.Launch(true), SUCCESS);
+    ASSERT_EQ(dataset.IsMapped(), use_mmap);
+    uint64_t bytes_copied = 0;
+    int64_t samples = 0;
+    *checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kRounds; ++round) {
+      for (int row_id = 0; row_id < dataset.GetNumRows(); ++row_id, ++samples) {
+        if (use_mmap) {
+          auto row = dataset.GetNextViewById(row_id);
+          *checksum += std::get<0>(row.second[0])[std::get<1>(row.second[0]) - 1];
+        } else {
+          auto row = dataset.GetNextById(row_id, 0);
+          const auto &blob = std::get<0>(row.second[0]);
+          bytes_copied += blob.size();
+          *checksum += blob.back();
+        }
+      }
+    }
+    auto cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    *samples_per_sec = samples / cost;
+    MS_LOG(INFO) << (use_mmap ? "mmap" : "stream") << ": " << *samples_per_sec << " samples/sec, "
+                 << static_cast<double>(bytes_copied) / samples << " bytes copied per sample.";
+    dataset.Close();
+  };
+
+  double stream_speed = 0;
+  uint64_t stream_checksum = 0;
+  double mmap_speed = 0;
+  uint64_t mmap_checksum = 0;
+  run(false, &stream_speed, &stream_checksum);
+  run(true, &mmap_speed, &mmap_checksum);
+  // the views read through the mapping see the same blob bytes as the stream copies
+  ASSERT_GT(stream_checksum, 0);
+  ASSERT_EQ(mmap_checksum, stream_checksum);
+}
+
+TEST_F(TestShardReader, TestShardReaderColumnarIndex) {
+  MS_LOG(INFO) << FormatInfo("Compare reading through columnar index and sqlite");
+  std::string file_name = "./imagenet.shard01";
+  for (int i = 1; i <= 4; i++) {
+    std::ifstream idx_file(file_name.substr(0, file_name.size() - 1) + std::to_string(i) + kColumnarIndexSuffix);
+    ASSERT_TRUE(idx_file.good());
+  }
+
+  auto compare = [&file_name](const std::vector<std::string> &columns,
+                              std::function<std::vector<std::shared_ptr<ShardOperator>>()> make_ops) {
+    ShardReader sqlite_reader;
+    sqlite_reader.SetUseColumnarIndex(false);
+    ASSERT_EQ(sqlite_reader.Open({file_name}, true, 4, columns, make_ops()), SUCCESS);
+    ASSERT_EQ(sqlite_reader.Launch(true), SUCCESS);
+
+    ShardReader columnar_reader;
+    ASSERT_EQ(columnar_reader.Open({file_name}, true, 4, columns, make_ops()), SUCCESS);
+    ASSERT_EQ(columnar_reader.Launch(true), SUCCESS);
+
+    ASSERT_EQ(sqlite_reader.GetNumRows(), columnar_reader.GetNumRows());
+    ASSERT_GT(columnar_reader.GetNumRows(), 0);
+    auto expected_summary = sqlite_reader.ReadRowGroupSummary();
+    ASSERT_EQ(expected_summary, columnar_reader.ReadRowGroupSummary());
+    const std::pair<std::string, std::string> criteria = {"label", "490"};
+    for (const auto &group : expected_summary) {
+      auto expected = sqlite_reader.ReadRowGroupCriteria(std::get<1>(group), std::get<0>(group), criteria, columns);
+      auto actual = columnar_reader.ReadRowGroupCriteria(std::get<1>(group), std::get<0>(group), criteria, columns);
+      ASSERT_EQ(std::get<0>(expected), SUCCESS);
+      ASSERT_EQ(std::get<4>(expected), std::get<4>(actual));
+      ASSERT_EQ(std::get<5>(expected), std::get<5>(actual));
+    }
+    for (int row_id = 0; row_id < columnar_reader.GetNumRows(); ++row_id) {
+      auto expected = sqlite_reader.GetNextById(row_id, 0);
+      auto actual = columnar_reader.GetNextById(row_id, 0);
+      ASSERT_EQ(expected.first, actual.first);
+      ASSERT_EQ(expected.second.size(), actual.second.size());
+      for (size_t i = 0; i < expected.second.size(); ++i) {
+        ASSERT_EQ(std::get<0>(expected.second[i]), std::get<0>(actual.second[i]));
+        ASSERT_EQ(std::get<1>(expected.second[i]), std::get<1>(actual.second[i]));
+      }
+    }
+    std::set<std::string> expected_classes;
+    std::set<std::string> actual_classes;
+    ASSERT_EQ(sqlite_reader.GetAllClasses("label", expected_classes), SUCCESS);
+    ASSERT_EQ(columnar_reader.GetAllClasses("label", actual_classes), SUCCESS);
+    ASSERT_EQ(expected_classes, actual_classes);
+    sqlite_reader.Close();
+    columnar_reader.Close();
+  };
+
+  auto no_ops = []() { return std::vector<std::shared_ptr<ShardOperator>>{}; };
+  auto category_ops = []() {
+    std::vector<std::pair<std::string, std::string>> categories = {{"label", "490"}, {"label", "361"}};
+    return std::vector<std::shared_ptr<ShardOperator>>{std::make_shared<ShardCategory>(categories)};
+  };
+  // labels from the index, and from raw pages when a column is not indexed
+  compare({"file_name", "label"}, no_ops);
+  compare({}, no_ops);
+  compare({"file_name", "label"}, category_ops);
+  compare({}, category_ops);
+
+  ShardColumnarIndex index;
+  ASSERT_EQ(index.Open(file_name), SUCCESS);
+  ASSERT_GT(index.GetNumRows(), 0);
+  ASSERT_GE(index.GetFieldId("label_0"), 0);
+  ASSERT_EQ(index.GetFieldId("not_indexed"), -1);
+
+  // a stale index is ignored and the shard falls back to sqlite
+  {
+    std::ofstream stale(file_name + kColumnarIndexSuffix, std::ios::binary | std::ios::trunc);
+    stale << "stale";
+  }
+  ShardColumnarIndex stale_index;
+  ASSERT_EQ(stale_index.Open(file_name), FAILED);
+  compare({"file_name", "label"}, no_ops);
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -51,6 +51,7 @@ TEST_F(TestShardWriter, TestShardWriterBench) {
     string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(filename + ".idx"));
   }
 }
 
@@ -80,6 +81,7 @@ TEST_F(TestShardWriter, TestShardWriterOneSample) {
     string db_name = std::string("./OneSample.shard0") + std::to_string(i) + ".db";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(filename + ".idx"));
   }
 }
 
@@ -350,6 +352,7 @@ TEST_F(TestShardWriter, TestShardWriterTrial) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + ".idx"));
     remove(common::SafeCStr(filename));
   }
 }
@@ -486,6 +489,7 @@ TEST_F(TestShardWriter, TestShardWriterTrialNoFields) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + ".idx"));
     remove(common::SafeCStr(filename));
   }
 }
@@ -587,6 +591,7 @@ TEST_F(TestShardWriter, DataCheck) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + ".idx"));
     remove(common::SafeCStr(filename));
   }
 }
@@ -680,6 +685,7 @@ TEST_F(TestShardWriter, AllRawDataWrong) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + ".idx"));
     remove(common::SafeCStr(filename));
   }
 }
@@ -780,6 +786,7 @@ TEST_F(TestShardWriter, TestShardReaderStringAndNumberColumnInIndex) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + ".idx"));
     remove(common::SafeCStr(filename));
   }
 }
@@ -862,6 +869,7 @@ TEST_F(TestShardWriter, TestShardNoBlob) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + ".idx"));
     remove(common::SafeCStr(filename));
   }
 }
@@ -956,6 +964,7 @@ TEST_F(TestShardWriter, TestShardReaderStringAndNumberNotColumnInIndex) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + ".idx"));
     remove(common::SafeCStr(filename));
   }
 }
@@ -1064,6 +1073,7 @@ TEST_F(TestShardWriter, TestShardWriter10Sample40Shard) {
   for (const auto &filename : file_names) {
     auto filename_db = filename + ".db";
     remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + ".idx"));
     remove(common::SafeCStr(filename));
   }
 }
@@ -1133,6 +1143,7 @@ TEST_F(TestShardWriter, TestOpenForAppend) {
     string db_name = std::string("./OpenForAppendSample.shard0") + std::to_string(i) + ".db";
     remove(common::SafeCStr(filename));
     remove(common::SafeCStr(db_name));
+    remove(common::SafeCStr(filename + ".idx"));
   }
 }
 
@@ -177,6 +177,23 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+// The substitutions of a list are applied in one traversal, a replaced node is matched again by all of them.
+TEST_F(TestOptOpt, SubstitutionListInOneTraversal) {
+  // before: P(P(R(Q(1)))), after: P(1)
+  FuncGraphPtr before = std::make_shared<FuncGraph>();
+  auto q_node = before->NewCNode({NewValueNode(Q), NewValueNode(MakeValue(1))});
+  auto r_node = before->NewCNode({NewValueNode(R), q_node});
+  auto p_node = before->NewCNode({NewValueNode(P), r_node});
+  before->set_output(before->NewCNode({NewValueNode(P), p_node}));
+
+  FuncGraphPtr after = std::make_shared<FuncGraph>();
+  after->set_output(after->NewCNode({NewValueNode(P), NewValueNode(MakeValue(1))}));
+
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({idempotent_P, elim_R, Qct_to_P})));
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P, elim_R, idempotent_P})));
+  ASSERT_FALSE(CheckOpt(before, after, std::vector<SubstitutionPtr>({idempotent_P, Qct_to_P})));
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
@@ -21,6 +21,7 @@
 #include "frontend/parallel/ops_info/activation_info.h"
 #include "frontend/parallel/ops_info/tmp_identity_info.h"
 #include "frontend/parallel/auto_parallel/dp_algo_costmodel.h"
+#include "frontend/parallel/auto_parallel/strategy_search_cache.h"
 
 namespace mindspore {
 namespace parallel {
@@ -1301,6 +1302,79 @@ TEST_F(TestDPAlgo, test_ConstructTwoSeparateGraphs) {
   ASSERT_EQ(GetStrategy(cost_graph), SUCCESS);
 }
 
+TEST_F(TestDPAlgo, test_GetStrategy_for_SeparateGraphs_in_parallel) {
+  ConstructThreeSeparateGraphs();
+  ASSERT_EQ(GetStrategy(cost_graph), SUCCESS);
+  for (auto &op : cost_graph->GetOperators()) {
+    ASSERT_NE(op->selected_strategy(), nullptr);
+  }
+}
+
+TEST_F(TestDPAlgo, test_StrategySearchCache) {
+  auto &search_cache = StrategySearchCache::GetInstance();
+  search_cache.Clear();
+  ConstructDiamondGraph();
+  auto snapshot = search_cache.TakeSnapshot(cost_graph);
+  ASSERT_EQ(search_cache.Restore(cost_graph, snapshot), FAILED);
+  ASSERT_EQ(GetStrategy(cost_graph), SUCCESS);
+  search_cache.Save(cost_graph, snapshot);
+  std::vector<StrategyPtr> searched_strategies;
+  std::vector<CostPtr> searched_costs;
+  for (auto &op : cost_graph->GetOperators()) {
+    searched_strategies.push_back(op->selected_strategy());
+    searched_costs.push_back(op->selected_cost());
+  }
+  std::vector<CostPtr> searched_edge_costs;
+  for (auto &edge : snapshot.edges) {
+    ASSERT_NE(edge->selected_cost(), nullptr);
+    searched_edge_costs.push_back(edge->selected_cost());
+  }
+  auto same_cost = [](const CostPtr &searched, const CostPtr &restored) {
+    if (searched == nullptr || restored == nullptr) {
+      return searched == restored;
+    }
+    return searched->computation_cost_ == restored->computation_cost_ &&
+           searched->communication_cost_ == restored->communication_cost_ &&
+           searched->memory_with_reuse_ == restored->memory_with_reuse_;
+  };
+
+  // Compile the same graph again
+  SetUp();
+  ConstructDiamondGraph();
+  auto new_snapshot = search_cache.TakeSnapshot(cost_graph);
+  ASSERT_EQ(new_snapshot.key, snapshot.key);
+  ASSERT_EQ(search_cache.Restore(cost_graph, new_snapshot), SUCCESS);
+  auto ops = cost_graph->GetOperators();
+  ASSERT_EQ(ops.size(), searched_strategies.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    ASSERT_TRUE(ops[i]->selected_strategy()->IsEqual(searched_strategies[i]));
+    ASSERT_TRUE(same_cost(searched_costs[i], ops[i]->selected_cost()));
+  }
+  ASSERT_EQ(new_snapshot.edges.size(), searched_edge_costs.size());
+  for (size_t i = 0; i < new_snapshot.edges.size(); ++i) {
+    ASSERT_TRUE(same_cost(searched_edge_costs[i], new_snapshot.edges[i]->selected_cost()));
+  }
+
+  // The cost model parameters are part of the key
+  auto device_memory = CostModelContext::GetInstance()->device_memory_capacity();
+  CostModelContext::GetInstance()->set_device_memory_capacity(device_memory / 2);
+  ASSERT_NE(search_cache.TakeSnapshot(cost_graph).key, snapshot.key);
+  CostModelContext::GetInstance()->set_device_memory_capacity(device_memory);
+
+  // Another graph under the same key is not given the cached strategies
+  SetUp();
+  ConstructTriangleGraph();
+  auto other_snapshot = search_cache.TakeSnapshot(cost_graph);
+  other_snapshot.key = snapshot.key;
+  ASSERT_EQ(search_cache.Restore(cost_graph, other_snapshot), FAILED);
+  for (auto &op : cost_graph->GetOperators()) {
+    ASSERT_EQ(op->selected_strategy(), nullptr);
+  }
+
+  search_cache.Clear();
+  ASSERT_EQ(search_cache.Restore(cost_graph, snapshot), FAILED);
+}
+
 TEST_F(TestDPAlgo, test_GetStrategy) {
   ConstructDiamondGraph();
   ASSERT_EQ(GetStrategy(cost_graph), SUCCESS);
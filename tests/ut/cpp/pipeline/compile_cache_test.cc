@@ -0,0 +1,159 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/tensor.h"
+#include "frontend/operator/ops.h"
+#include "pipeline/jit/compile_cache.h"
+#include "frontend/parallel/context.h"
+
+namespace mindspore {
+namespace pipeline {
+class TestCompileCache : public UT::Common {
+ public:
+  TestCompileCache() = default;
+  void TearDown() override {
+    for (auto &key : keys_) {
+      (void)std::remove(("./" + key + ".mindir").c_str());
+      (void)std::remove(("./" + key + ".params").c_str());
+    }
+  }
+
+  std::vector<std::string> keys_;
+};
+
+namespace {
+// y = TensorAdd(x, weight)
+FuncGraphPtr AddWeightGraph(const tensor::TensorPtr &weight) {
+  auto func_graph = std::make_shared<FuncGraph>();
+  auto abstract = weight->ToAbstract();
+  auto x = func_graph->add_parameter();
+  x->set_name("x");
+  x->set_abstract(abstract);
+  auto param = func_graph->add_parameter();
+  param->set_name("weight");
+  param->set_default_param(weight);
+  param->set_abstract(abstract);
+  auto add = func_graph->NewCNode({NewValueNode(prim::kPrimTensorAdd), x, param});
+  add->set_abstract(abstract);
+  func_graph->set_output(add);
+  return func_graph;
+}
+}  // namespace
+
+TEST_F(TestCompileCache, GraphKey) {
+  auto weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  auto args_spec = abstract::AbstractBasePtrList{weight->ToAbstract()};
+  auto key = CompileCache::GraphKey(AddWeightGraph(weight), args_spec);
+  // The same network built again has the same key, whatever the values of its weights.
+  auto other_weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  EXPECT_EQ(CompileCache::GraphKey(AddWeightGraph(other_weight), args_spec), key);
+  auto other_input = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{4, 3});
+  auto other_args_spec = abstract::AbstractBasePtrList{other_input->ToAbstract()};
+  EXPECT_NE(CompileCache::GraphKey(AddWeightGraph(weight), other_args_spec), key);
+  auto other_shape_weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{3, 2});
+  EXPECT_NE(CompileCache::GraphKey(AddWeightGraph(other_shape_weight), args_spec), key);
+}
+
+// The parallel context options which change the optimized graph are in the key, and only the stand_alone and
+// data_parallel modes are cached.
+TEST_F(TestCompileCache, ParallelContext) {
+  auto weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  auto args_spec = abstract::AbstractBasePtrList{weight->ToAbstract()};
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  EXPECT_TRUE(CompileCache::IsContextSupported());
+  auto key = CompileCache::GraphKey(AddWeightGraph(weight), args_spec);
+  parallel_context->set_gradients_mean(!parallel_context->gradients_mean());
+  auto mean_key = CompileCache::GraphKey(AddWeightGraph(weight), args_spec);
+  parallel_context->set_gradients_mean(!parallel_context->gradients_mean());
+  EXPECT_NE(mean_key, key);
+  parallel_context->set_full_batch(!parallel_context->full_batch());
+  auto full_batch_key = CompileCache::GraphKey(AddWeightGraph(weight), args_spec);
+  parallel_context->set_full_batch(!parallel_context->full_batch());
+  EXPECT_NE(full_batch_key, key);
+  EXPECT_EQ(CompileCache::GraphKey(AddWeightGraph(weight), args_spec), key);
+
+  auto parallel_mode = parallel_context->parallel_mode();
+  EXPECT_TRUE(parallel_context->set_parallel_mode(parallel::SEMI_AUTO_PARALLEL));
+  EXPECT_FALSE(CompileCache::IsContextSupported());
+  EXPECT_TRUE(parallel_context->set_parallel_mode(parallel_mode));
+}
+
+// A stored graph is loaded with its weights bound to the ones of the network compiling it.
+TEST_F(TestCompileCache, StoreAndLoad) {
+  auto weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  auto func_graph = AddWeightGraph(weight);
+  auto key = CompileCache::GraphKey(func_graph, {weight->ToAbstract()});
+  keys_.push_back(key);
+  CompileCache cache(".");
+  EXPECT_EQ(cache.Load(key, func_graph), nullptr);
+  ASSERT_TRUE(cache.Store(key, func_graph));
+
+  auto network_weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  auto loaded_graph = cache.Load(key, AddWeightGraph(network_weight));
+  ASSERT_NE(loaded_graph, nullptr);
+  auto &params = loaded_graph->parameters();
+  ASSERT_EQ(params.size(), 2);
+  EXPECT_FALSE(params[0]->cast<ParameterPtr>()->has_default());
+  auto loaded_weight = params[1]->cast<ParameterPtr>();
+  EXPECT_EQ(loaded_weight->name(), "weight");
+  EXPECT_EQ(loaded_weight->default_param(), network_weight);
+  EXPECT_TRUE(IsPrimitiveCNode(loaded_graph->output(), prim::kPrimTensorAdd));
+
+  // A network without the weight doesn't load the graph.
+  auto other_graph = AddWeightGraph(network_weight);
+  other_graph->parameters()[1]->cast<ParameterPtr>()->set_name("other_weight");
+  EXPECT_EQ(cache.Load(key, other_graph), nullptr);
+}
+
+// The graph is only stored when it is imported back node by node the same, including the attrs of its primitives.
+TEST_F(TestCompileCache, StorePrimitiveAttrs) {
+  auto weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  auto func_graph = AddWeightGraph(weight);
+  auto prim = std::make_shared<Primitive>(prim::kPrimTensorAdd->name());
+  prim->AddAttr("keep_dims", MakeValue(true));
+  func_graph->output()->cast<CNodePtr>()->set_input(0, NewValueNode(prim));
+  auto key = CompileCache::GraphKey(func_graph, {weight->ToAbstract()});
+  keys_.push_back(key);
+  EXPECT_NE(CompileCache::GraphKey(AddWeightGraph(weight), {weight->ToAbstract()}), key);
+  CompileCache cache(".");
+  ASSERT_TRUE(cache.Store(key, func_graph));
+  auto loaded_graph = cache.Load(key, AddWeightGraph(weight));
+  ASSERT_NE(loaded_graph, nullptr);
+  auto loaded_prim = GetCNodePrimitive(loaded_graph->output());
+  ASSERT_NE(loaded_prim, nullptr);
+  ASSERT_NE(loaded_prim->GetAttr("keep_dims"), nullptr);
+  EXPECT_TRUE(GetValue<bool>(loaded_prim->GetAttr("keep_dims")));
+}
+
+// MindIR drops an int8 attr, the graph would come back changed so it isn't stored.
+TEST_F(TestCompileCache, StoreChangedGraph) {
+  auto weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  auto func_graph = AddWeightGraph(weight);
+  auto prim = std::make_shared<Primitive>(prim::kPrimTensorAdd->name());
+  prim->AddAttr("axis", MakeValue(static_cast<int8_t>(1)));
+  func_graph->output()->cast<CNodePtr>()->set_input(0, NewValueNode(prim));
+  auto key = CompileCache::GraphKey(func_graph, {weight->ToAbstract()});
+  keys_.push_back(key);
+  CompileCache cache(".");
+  EXPECT_FALSE(cache.Store(key, func_graph));
+  EXPECT_EQ(cache.Load(key, AddWeightGraph(weight)), nullptr);
+}
+}  // namespace pipeline
+}  // namespace mindspore
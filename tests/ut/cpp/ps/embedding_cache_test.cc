@@ -0,0 +1,186 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <random>
+#include <unordered_set>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/embedding_cache.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+class TestEmbeddingCache : public UT::Common {
+ public:
+  TestEmbeddingCache() = default;
+};
+
+namespace {
+constexpr size_t kRowDim = 4;
+
+// The value of every column of a row is its id.
+std::vector<float> Rows(const std::vector<int> &ids) {
+  std::vector<float> rows;
+  for (auto id : ids) {
+    rows.insert(rows.end(), kRowDim, static_cast<float>(id));
+  }
+  return rows;
+}
+
+// Look the ids up through the cache like the worker does, and return the ids which were fetched.
+std::vector<int> LookupThrough(EmbeddingCache *cache, const std::vector<int> &ids) {
+  std::vector<float> output(ids.size() * kRowDim, -1);
+  std::vector<int> missed = cache->Lookup(ids.data(), ids.size(), output.data());
+  std::vector<float> rows = Rows(missed);
+  cache->Fill(ids.data(), ids.size(), missed, rows.data(), output.data());
+  EXPECT_EQ(output, Rows(ids));
+  return missed;
+}
+}  // namespace
+
+TEST_F(TestEmbeddingCache, LRU) {
+  EmbeddingCache cache(2, kRowDim, kCachePolicyLRU, 100, false);
+  EXPECT_EQ(LookupThrough(&cache, {1, 2, 1}), std::vector<int>({1, 2}));
+  EXPECT_EQ(LookupThrough(&cache, {1, 2}), std::vector<int>());
+  // 1 is used more recently than 2
+  EXPECT_EQ(LookupThrough(&cache, {1}), std::vector<int>());
+  EXPECT_EQ(LookupThrough(&cache, {3}), std::vector<int>({3}));
+  EXPECT_EQ(LookupThrough(&cache, {1, 2}), std::vector<int>({2}));
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.hits, 4);
+  EXPECT_EQ(stats.misses, 5);
+  EXPECT_EQ(stats.fetched_rows, 4);
+  EXPECT_EQ(stats.evictions, 2);
+  EXPECT_DOUBLE_EQ(cache.hit_rate(), 4.0 / 9);
+}
+
+TEST_F(TestEmbeddingCache, LFU) {
+  EmbeddingCache cache(2, kRowDim, kCachePolicyLFU, 100, false);
+  EXPECT_EQ(LookupThrough(&cache, {1, 1, 1, 2, 2}), std::vector<int>({1, 2}));
+  // 3 was looked up less often than both cached rows and is not admitted
+  EXPECT_EQ(LookupThrough(&cache, {3}), std::vector<int>({3}));
+  EXPECT_EQ(LookupThrough(&cache, {3}), std::vector<int>({3}));
+  EXPECT_EQ(cache.stats().rejections, 2);
+  // now 3 was looked up more often than 2, which it replaces
+  EXPECT_EQ(LookupThrough(&cache, {3}), std::vector<int>({3}));
+  EXPECT_EQ(LookupThrough(&cache, {1, 3}), std::vector<int>());
+  EXPECT_EQ(LookupThrough(&cache, {2}), std::vector<int>({2}));
+  EXPECT_EQ(cache.stats().evictions, 1);
+}
+
+TEST_F(TestEmbeddingCache, Staleness) {
+  EmbeddingCache cache(8, kRowDim, kCachePolicyLRU, 2, false);
+  EXPECT_EQ(LookupThrough(&cache, {1}), std::vector<int>({1}));
+  EXPECT_EQ(LookupThrough(&cache, {1}), std::vector<int>());
+  // fetched two steps ago
+  EXPECT_EQ(LookupThrough(&cache, {1}), std::vector<int>({1}));
+  EXPECT_EQ(cache.stats().stale_rows, 1);
+}
+
+TEST_F(TestEmbeddingCache, WriteBack) {
+  EmbeddingCache cache(1, kRowDim, kCachePolicyLRU, 2, true);
+  std::vector<int> indices;
+  std::vector<float> grads;
+  (void)LookupThrough(&cache, {1});
+  std::vector<int> push_indices = {1, 1};
+  std::vector<float> push_grads(2 * kRowDim, 1);
+  cache.AccumulateGrad(push_indices.data(), push_indices.size(), push_grads.data());
+  cache.TakeDueGrads(false, &indices, &grads);
+  EXPECT_TRUE(indices.empty());
+
+  (void)LookupThrough(&cache, {1});
+  cache.AccumulateGrad(push_indices.data(), 1, push_grads.data());
+  cache.TakeDueGrads(false, &indices, &grads);
+  EXPECT_EQ(indices, std::vector<int>({1}));
+  EXPECT_EQ(grads, std::vector<float>(kRowDim, 3));
+  // the pushed row is fetched again
+  EXPECT_EQ(LookupThrough(&cache, {1}), std::vector<int>({1}));
+
+  // the gradients of an evicted row are due at once
+  cache.AccumulateGrad(push_indices.data(), 1, push_grads.data());
+  (void)LookupThrough(&cache, {2});
+  cache.TakeDueGrads(false, &indices, &grads);
+  EXPECT_EQ(indices, std::vector<int>({1}));
+  cache.AccumulateGrad(push_indices.data(), 1, push_grads.data());
+  cache.TakeDueGrads(true, &indices, &grads);
+  EXPECT_EQ(indices, std::vector<int>({1}));
+  EXPECT_EQ(cache.stats().flushed_rows, 3);
+}
+
+namespace {
+// Bytes a lookup of the ids costs on the wire: the request carries a key and a value per id, the response a key and
+// a row per id.
+size_t LookupBytes(size_t ids_num, size_t row_dim) {
+  return ids_num * (sizeof(uint64_t) + sizeof(float)) + ids_num * (sizeof(uint64_t) + row_dim * sizeof(float));
+}
+
+std::vector<int> ZipfIds(size_t ids_num, size_t vocab_size, double exponent, std::mt19937 *engine) {
+  std::vector<double> weights(vocab_size);
+  for (size_t i = 0; i < vocab_size; i++) {
+    weights[i] = 1.0 / std::pow(i + 1, exponent);
+  }
+  std::discrete_distribution<int> distribution(weights.begin(), weights.end());
+  std::vector<int> ids(ids_num);
+  for (auto &id : ids) {
+    id = distribution(*engine);
+  }
+  return ids;
+}
+}  // namespace
+
+// Bytes on the wire per step of lookups with skewed ids, without and with the cache.
+TEST_F(TestEmbeddingCache, WireBytesBenchmark) {
+  const size_t vocab_size = 100000;
+  const size_t batch_size = 4096;
+  const size_t steps = 50;
+  const size_t row_dim = 16;
+  const size_t capacity = 10000;
+  for (double exponent : {0.8, 1.0, 1.2}) {
+    std::mt19937 engine(0);
+    std::vector<std::vector<int>> batches;
+    for (size_t step = 0; step < steps; step++) {
+      batches.push_back(ZipfIds(batch_size, vocab_size, exponent, &engine));
+    }
+    size_t uncached_bytes = 0;
+    for (const auto &ids : batches) {
+      uncached_bytes += LookupBytes(std::unordered_set<int>(ids.begin(), ids.end()).size(), row_dim);
+    }
+    for (auto policy : {kCachePolicyLRU, kCachePolicyLFU}) {
+      for (size_t staleness : {1, 4, 16}) {
+        EmbeddingCache cache(capacity, row_dim, policy, staleness, false);
+        size_t cached_bytes = 0;
+        std::vector<float> output(batch_size * row_dim);
+        for (const auto &ids : batches) {
+          std::vector<int> missed = cache.Lookup(ids.data(), ids.size(), output.data());
+          std::vector<float> rows(missed.size() * row_dim);
+          cache.Fill(ids.data(), ids.size(), missed, rows.data(), output.data());
+          cached_bytes += LookupBytes(missed.size(), row_dim);
+        }
+        if (staleness == 1) {
+          EXPECT_EQ(cached_bytes, uncached_bytes);
+        } else {
+          EXPECT_LT(cached_bytes, uncached_bytes);
+        }
+        MS_LOG(INFO) << "zipf " << exponent << ", policy " << policy << ", staleness " << staleness << ": "
+                     << uncached_bytes / steps << " bytes/step uncached, " << cached_bytes / steps
+                     << " bytes/step cached, " << cache.StatsString();
+      }
+    }
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,249 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/gradient_compressor.h"
+#include "ps/worker_proxy.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+class TestGradientCompressor : public UT::Common {
+ public:
+  TestGradientCompressor() = default;
+};
+
+namespace {
+std::vector<float> RandomGrad(size_t size, std::mt19937 *engine) {
+  std::normal_distribution<float> distribution(0, 1);
+  std::vector<float> grad(size);
+  for (auto &value : grad) {
+    value = distribution(*engine);
+  }
+  return grad;
+}
+
+std::vector<float> RoundTrip(GradientCompressor *compressor, const std::vector<float> &grad, size_t *words) {
+  std::vector<float> encoded;
+  compressor->Compress(grad.data(), grad.size(), &encoded);
+  *words = encoded.size();
+  std::vector<float> decoded;
+  GradientCompressor::Decompress(encoded.data(), encoded.size(), &decoded);
+  return decoded;
+}
+
+float MaxError(const std::vector<float> &lhs, const std::vector<float> &rhs) {
+  float error = 0;
+  for (size_t i = 0; i < lhs.size(); i++) {
+    error = std::max(error, std::fabs(lhs[i] - rhs[i]));
+  }
+  return error;
+}
+}  // namespace
+
+TEST_F(TestGradientCompressor, TypeNames) {
+  GradCompressType type = kGradCompressNone;
+  for (auto name : {kGradCompressNameNone, kGradCompressNameFP16, kGradCompressNameBF16, kGradCompressNameTopK,
+                    kGradCompressNameInt8}) {
+    EXPECT_TRUE(GradCompressTypeOf(name, &type));
+    EXPECT_EQ(GradCompressTypeName(type), name);
+  }
+  EXPECT_FALSE(GradCompressTypeOf("fp8", &type));
+  EXPECT_EQ(GradientCompressor::Create(kGradCompressNone, 0.01), nullptr);
+}
+
+TEST_F(TestGradientCompressor, Cast) {
+  std::mt19937 engine(0);
+  std::vector<float> grad = RandomGrad(1001, &engine);
+  size_t words = 0;
+  auto fp16 = GradientCompressor::Create(kGradCompressFP16, 0);
+  EXPECT_LT(MaxError(RoundTrip(fp16.get(), grad, &words), grad), 4e-3);
+  EXPECT_EQ(words, 2 + 501);
+  auto bf16 = GradientCompressor::Create(kGradCompressBF16, 0);
+  EXPECT_LT(MaxError(RoundTrip(bf16.get(), grad, &words), grad), 3e-2);
+  EXPECT_EQ(words, 2 + 501);
+}
+
+TEST_F(TestGradientCompressor, Int8) {
+  std::mt19937 engine(0);
+  std::vector<float> grad = RandomGrad(1000, &engine);
+  grad[0] = 0;
+  size_t words = 0;
+  auto int8 = GradientCompressor::Create(kGradCompressInt8, 0);
+  std::vector<float> decoded = RoundTrip(int8.get(), grad, &words);
+  // 4 scales and 1000 bytes
+  EXPECT_EQ(words, 2 + 4 + 250);
+  EXPECT_EQ(decoded[0], 0);
+  EXPECT_LT(MaxError(decoded, grad), 5.0 / 127);
+  std::vector<float> zeros(10, 0);
+  EXPECT_EQ(RoundTrip(int8.get(), zeros, &words), zeros);
+}
+
+TEST_F(TestGradientCompressor, TopKErrorFeedback) {
+  auto topk = GradientCompressor::Create(kGradCompressTopK, 0.25);
+  std::vector<float> grad = {0.1, -4, 0.2, 1, 0.3, 0.5, -0.4, 3};
+  size_t words = 0;
+  EXPECT_EQ(RoundTrip(topk.get(), grad, &words), std::vector<float>({0, -4, 0, 0, 0, 0, 0, 3}));
+  EXPECT_EQ(words, 2 + 1 + 2 * 2);
+  // the elements left out are added to the next gradient
+  std::vector<float> zeros(grad.size(), 0);
+  EXPECT_EQ(RoundTrip(topk.get(), zeros, &words), std::vector<float>({0, 0, 0, 1, 0, 0.5, 0, 0}));
+  std::vector<float> sum(grad.size(), 0);
+  for (size_t step = 0; step < 3; step++) {
+    std::vector<float> decoded = RoundTrip(topk.get(), zeros, &words);
+    for (size_t i = 0; i < sum.size(); i++) {
+      sum[i] += decoded[i];
+    }
+  }
+  EXPECT_EQ(sum, std::vector<float>({0.1, 0, 0.2, 0, 0.3, 0, -0.4, 0}));
+}
+
+TEST_F(TestGradientCompressor, InvalidEncoding) {
+  std::vector<float> decoded;
+  std::vector<float> no_header(1, 0);
+  EXPECT_ANY_THROW(GradientCompressor::Decompress(no_header.data(), no_header.size(), &decoded));
+
+  auto fp16 = GradientCompressor::Create(kGradCompressFP16, 0);
+  std::vector<float> grad(8, 1);
+  std::vector<float> encoded;
+  fp16->Compress(grad.data(), grad.size(), &encoded);
+  EXPECT_ANY_THROW(GradientCompressor::Decompress(encoded.data(), encoded.size() - 1, &decoded));
+  reinterpret_cast<uint32_t *>(encoded.data())[0] = 100;
+  EXPECT_ANY_THROW(GradientCompressor::Decompress(encoded.data(), encoded.size(), &decoded));
+}
+
+// A compressed Momentum push goes through the worker slicer to its server, which gets the inputs back.
+TEST_F(TestGradientCompressor, CompressedPushEndToEnd) {
+  const ::ps::Key key = 3;
+  const size_t grad_index = 1;
+  std::vector<float> lr = {0.01};
+  std::vector<float> grad = {1, -2, 0.5, 4, -0.25, 8, 16, -32};
+  std::vector<float> momentum = {0.9};
+  auto fp16 = GradientCompressor::Create(kGradCompressFP16, 0);
+  std::vector<float> encoded;
+  fp16->Compress(grad.data(), grad.size(), &encoded);
+
+  // Like Worker::SendPush, one key and one length per input, with the leading word counted in the first length.
+  ::ps::KVPairs<float> send;
+  send.keys = ::ps::SArray<::ps::Key>(std::vector<::ps::Key>(3, key));
+  send.lens = ::ps::SArray<int>(std::vector<int>(
+    {SizeToInt(kCompressedPushLeadSize + lr.size()), SizeToInt(encoded.size()), SizeToInt(momentum.size())}));
+  std::vector<float> vals(kCompressedPushLeadSize);
+  GradientCompressor::WritePushLead(grad_index, vals.data());
+  vals.insert(vals.end(), lr.begin(), lr.end());
+  vals.insert(vals.end(), encoded.begin(), encoded.end());
+  vals.insert(vals.end(), momentum.begin(), momentum.end());
+  send.vals = ::ps::SArray<float>(vals);
+
+  std::vector<std::pair<bool, ::ps::KVPairs<float>>> sliced(2);
+  std::unordered_map<::ps::Key, int> key_to_server_id = {{key, 1}};
+  WorkerProxy<float>::SliceByServer(send, key_to_server_id, &sliced);
+  ASSERT_FALSE(sliced[0].first);
+  ASSERT_TRUE(sliced[1].first);
+  const auto &received = sliced[1].second;
+  ASSERT_EQ(received.lens.size(), received.keys.size());
+
+  std::vector<float> values;
+  std::vector<int> lengths;
+  GradientCompressor::DecompressPush(received.vals.data(), received.vals.size(), received.lens.data(),
+                                     received.lens.size(), &values, &lengths);
+  std::vector<float> expected = lr;
+  expected.insert(expected.end(), grad.begin(), grad.end());
+  expected.insert(expected.end(), momentum.begin(), momentum.end());
+  EXPECT_EQ(values, expected);
+  EXPECT_EQ(lengths, std::vector<int>({1, SizeToInt(grad.size()), 1}));
+
+  // A push without its leading word or whose lengths don't match its values is rejected.
+  EXPECT_ANY_THROW(GradientCompressor::DecompressPush(received.vals.data() + 1, received.vals.size() - 1,
+                                                      received.lens.data(), received.lens.size(), &values, &lengths));
+  std::vector<int> no_lead_lens = {0, SizeToInt(encoded.size()), 1};
+  EXPECT_ANY_THROW(GradientCompressor::DecompressPush(received.vals.data(), received.vals.size(), no_lead_lens.data(),
+                                                      no_lead_lens.size(), &values, &lengths));
+}
+
+namespace {
+constexpr float kLabelNoise = 0.1;
+
+// Train a linear regression model by pushing its gradients through the compressor like a worker, and return the
+// loss of the last step. A null compressor pushes them as they are.
+float TrainLinearRegression(GradientCompressor *compressor, size_t *raw_bytes, size_t *pushed_bytes) {
+  const size_t dim = 256;
+  const size_t batch_size = 64;
+  const size_t steps = 300;
+  const float learning_rate = 0.1;
+  std::mt19937 engine(0);
+  std::normal_distribution<float> noise(0, 1);
+  std::vector<float> target = RandomGrad(dim, &engine);
+  std::vector<float> weight(dim, 0);
+  std::vector<float> grad(dim);
+  float loss = 0;
+  for (size_t step = 0; step < steps; step++) {
+    std::fill(grad.begin(), grad.end(), 0);
+    loss = 0;
+    for (size_t sample = 0; sample < batch_size; sample++) {
+      std::vector<float> x = RandomGrad(dim, &engine);
+      float error = -kLabelNoise * noise(engine);
+      for (size_t i = 0; i < dim; i++) {
+        error += x[i] * (weight[i] - target[i]);
+      }
+      loss += error * error / (2 * batch_size);
+      for (size_t i = 0; i < dim; i++) {
+        grad[i] += error * x[i] / batch_size;
+      }
+    }
+    *raw_bytes += dim * sizeof(float);
+    if (compressor != nullptr) {
+      std::vector<float> encoded;
+      compressor->Compress(grad.data(), grad.size(), &encoded);
+      *pushed_bytes += encoded.size() * sizeof(float);
+      GradientCompressor::Decompress(encoded.data(), encoded.size(), &grad);
+    } else {
+      *pushed_bytes += dim * sizeof(float);
+    }
+    for (size_t i = 0; i < dim; i++) {
+      weight[i] -= learning_rate * grad[i];
+    }
+  }
+  return loss;
+}
+}  // namespace
+
+// Bytes pushed and convergence of a small model with every compressor.
+TEST_F(TestGradientCompressor, ConvergenceBenchmark) {
+  size_t raw_bytes = 0;
+  size_t pushed_bytes = 0;
+  float baseline_loss = TrainLinearRegression(nullptr, &raw_bytes, &pushed_bytes);
+  MS_LOG(INFO) << "uncompressed: loss " << baseline_loss;
+  // the loss of the untrained model is about dim / 2, the one of the best model kLabelNoise^2 / 2
+  EXPECT_LT(baseline_loss, kLabelNoise * kLabelNoise);
+  for (auto type : {kGradCompressFP16, kGradCompressBF16, kGradCompressTopK, kGradCompressInt8}) {
+    auto compressor = GradientCompressor::Create(type, 0.1);
+    raw_bytes = 0;
+    pushed_bytes = 0;
+    float loss = TrainLinearRegression(compressor.get(), &raw_bytes, &pushed_bytes);
+    MS_LOG(INFO) << GradCompressTypeName(type) << ": loss " << loss << ", pushed " << pushed_bytes
+                 << " bytes instead of " << raw_bytes;
+    EXPECT_LT(pushed_bytes, raw_bytes);
+    EXPECT_LT(loss, kLabelNoise * kLabelNoise);
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/keyed_executor.h"
+#include "ps/striped_lock.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+class TestServerConcurrency : public UT::Common {
+ public:
+  TestServerConcurrency() = default;
+};
+
+TEST_F(TestServerConcurrency, StripedLockMany) {
+  StripedLock locks(4);
+  EXPECT_EQ(locks.stripe_num(), 4);
+  EXPECT_EQ(&locks.Get(1), &locks.Get(5));
+  EXPECT_NE(&locks.Get(1), &locks.Get(2));
+  // Ids 1, 5 and 9 share a stripe, which is locked only once.
+  auto held = locks.LockMany({9, 1, 5, 2});
+  EXPECT_EQ(held.size(), 2);
+  std::thread other([&locks]() {
+    EXPECT_FALSE(locks.Get(1).try_lock());
+    EXPECT_TRUE(locks.Get(3).try_lock());
+    locks.Get(3).unlock();
+  });
+  other.join();
+  held.clear();
+  EXPECT_EQ(locks.LockAll().size(), 4);
+}
+
+TEST_F(TestServerConcurrency, KeyedExecutorOrder) {
+  KeyedExecutor executor(4);
+  const size_t key_num = 8;
+  const size_t task_num = 1000;
+  std::vector<std::vector<size_t>> seen(key_num);
+  for (size_t i = 0; i < task_num; ++i) {
+    for (size_t key = 0; key < key_num; ++key) {
+      executor.Submit(key, [&seen, key, i]() { seen[key].push_back(i); });
+    }
+  }
+  executor.Stop();
+  for (size_t key = 0; key < key_num; ++key) {
+    ASSERT_EQ(seen[key].size(), task_num);
+    for (size_t i = 0; i < task_num; ++i) {
+      EXPECT_EQ(seen[key][i], i);
+    }
+  }
+}
+
+TEST_F(TestServerConcurrency, KeyedExecutorRunAndWait) {
+  KeyedExecutor executor(3);
+  std::vector<uint64_t> keys = {0, 1, 2, 3, 4, 5, 6};
+  std::atomic<uint64_t> sum(0);
+  executor.RunAndWait(keys, [&sum](uint64_t key) { sum += key; });
+  EXPECT_EQ(sum.load(), 21);
+  EXPECT_THROW(executor.RunAndWait(keys,
+                                   [](uint64_t key) {
+                                     if (key == 3) {
+                                       throw std::runtime_error("update failed");
+                                     }
+                                   }),
+               std::runtime_error);
+}
+
+namespace {
+// Simulate the server side of sparse pushes: every push adds into some rows of one of the tables.
+double RunPushes(size_t worker_num, size_t push_num, bool striped) {
+  const size_t key_num = 16;
+  const size_t row_num = 4096;
+  const size_t dim = 16;
+  const size_t rows_per_push = 32;
+  std::vector<std::vector<float>> tables(key_num, std::vector<float>(row_num * dim, 0));
+  std::mutex global_mutex;
+  StripedLock key_locks;
+  KeyedExecutor executor(striped ? worker_num : 1);
+  std::atomic<size_t> done(0);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (size_t w = 0; w < worker_num; ++w) {
+    workers.emplace_back([&, w]() {
+      for (size_t i = 0; i < push_num; ++i) {
+        uint64_t key = (w + i) % key_num;
+        auto push = [&, key, i]() {
+          std::unique_lock<std::mutex> lock(striped ? key_locks.Get(key) : global_mutex);
+          float *table = tables[key].data();
+          for (size_t r = 0; r < rows_per_push; ++r) {
+            size_t row = (i * 131 + r * 17) % row_num;
+            for (size_t d = 0; d < dim; ++d) {
+              table[row * dim + d] += 0.5f;
+            }
+          }
+          done++;
+        };
+        executor.Submit(key, push);
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  executor.Stop();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(done.load(), worker_num * push_num);
+  return done.load() / elapsed.count();
+}
+}  // namespace
+
+// Benchmark of concurrent pushes against one server, with a single lock and thread as before and with lock
+// striping and a lane per worker.
+TEST_F(TestServerConcurrency, PushBenchmark) {
+  const size_t push_num = 2000;
+  for (size_t worker_num : {1, 4, 16}) {
+    double single = RunPushes(worker_num, push_num, false);
+    double striped = RunPushes(worker_num, push_num, true);
+    MS_LOG(INFO) << worker_num << " workers: single lock " << single << " pushes/sec, striped locks " << striped
+                 << " pushes/sec.";
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
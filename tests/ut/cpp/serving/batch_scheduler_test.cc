@@ -0,0 +1,198 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "serving/core/batch_scheduler.h"
+
+namespace mindspore {
+namespace serving {
+namespace {
+constexpr int64_t kFeatureSize = 4;
+
+void CreateRequest(PredictRequest *request, int64_t batch_size, float value) {
+  auto tensor = request->add_data();
+  tensor->set_tensor_type(ms_serving::MS_FLOAT32);
+  tensor->mutable_tensor_shape()->add_dims(batch_size);
+  tensor->mutable_tensor_shape()->add_dims(kFeatureSize);
+  std::vector<float> data(batch_size * kFeatureSize);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = value + i;
+  }
+  tensor->set_data(data.data(), data.size() * sizeof(float));
+}
+
+void CheckReply(const PredictReply &reply, int64_t batch_size, float value) {
+  ASSERT_EQ(reply.result_size(), 1);
+  auto &result = reply.result(0);
+  ASSERT_EQ(result.tensor_shape().dims_size(), 2);
+  EXPECT_EQ(result.tensor_shape().dims(0), batch_size);
+  EXPECT_EQ(result.tensor_shape().dims(1), kFeatureSize);
+  ASSERT_EQ(result.data().size(), batch_size * kFeatureSize * sizeof(float));
+  auto data = reinterpret_cast<const float *>(result.data().data());
+  for (int64_t i = 0; i < batch_size * kFeatureSize; i++) {
+    EXPECT_EQ(data[i], 2 * (value + i));
+  }
+}
+
+// stub of the inference session: doubles the input, optionally only accepts a fixed batch size
+class StubSession {
+ public:
+  explicit StubSession(int64_t fixed_batch_size = 0) : fixed_batch_size_(fixed_batch_size) {}
+  Status Predict(const PredictRequest &request, PredictReply &reply) {
+    auto &input = request.data(0);
+    if (fixed_batch_size_ != 0 && input.tensor_shape().dims(0) != fixed_batch_size_) {
+      return INVALID_INPUTS;
+    }
+    call_num_++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    auto output = reply.add_result();
+    output->set_tensor_type(input.tensor_type());
+    *output->mutable_tensor_shape() = input.tensor_shape();
+    std::string data = input.data();
+    auto float_data = reinterpret_cast<float *>(&data[0]);
+    for (size_t i = 0; i < data.size() / sizeof(float); i++) {
+      float_data[i] *= 2;
+    }
+    output->set_data(data);
+    return SUCCESS;
+  }
+  PredictFunc Func() {
+    return [this](const PredictRequest &request, PredictReply &reply) { return Predict(request, reply); };
+  }
+  std::atomic<int> call_num_{0};
+
+ private:
+  int64_t fixed_batch_size_;
+};
+
+void RunConcurrently(BatchScheduler *scheduler, int request_num, int64_t batch_size) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < request_num; i++) {
+    threads.emplace_back([scheduler, i, batch_size]() {
+      PredictRequest request;
+      PredictReply reply;
+      CreateRequest(&request, batch_size, i * 100.0f);
+      ASSERT_TRUE(scheduler->Predict(request, reply) == SUCCESS);
+      CheckReply(reply, batch_size, i * 100.0f);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+}  // namespace
+
+class BatchSchedulerTest : public UT::Common {
+ public:
+  BatchSchedulerTest() = default;
+};
+
+TEST_F(BatchSchedulerTest, test_batch_size_and_compatible) {
+  PredictRequest request0;
+  CreateRequest(&request0, 2, 0);
+  EXPECT_EQ(BatchScheduler::GetBatchSize(request0), 2);
+  PredictRequest request1;
+  CreateRequest(&request1, 3, 0);
+  EXPECT_TRUE(BatchScheduler::IsCompatible(request0, request1));
+
+  // inputs with different batch dims can not be split back
+  auto tensor = request1.add_data();
+  *tensor = request0.data(0);
+  EXPECT_EQ(BatchScheduler::GetBatchSize(request1), 0);
+  EXPECT_FALSE(BatchScheduler::IsCompatible(request0, request1));
+
+  PredictRequest request2;
+  CreateRequest(&request2, 1, 0);
+  request2.mutable_data(0)->mutable_tensor_shape()->set_dims(1, kFeatureSize / 2);
+  EXPECT_FALSE(BatchScheduler::IsCompatible(request0, request2));
+
+  PredictRequest images_request;
+  images_request.add_images()->add_images("jpeg");
+  EXPECT_EQ(BatchScheduler::GetBatchSize(images_request), 0);
+}
+
+TEST_F(BatchSchedulerTest, test_merge_concurrent_requests) {
+  StubSession session;
+  const int request_num = 8;
+  BatchScheduler scheduler(request_num, 1000, session.Func());
+  scheduler.Start();
+  RunConcurrently(&scheduler, request_num, 1);
+  scheduler.Stop();
+  auto metrics = scheduler.GetMetrics();
+  EXPECT_EQ(metrics.request_num, request_num);
+  EXPECT_EQ(metrics.batch_num, session.call_num_);
+  EXPECT_LT(metrics.batch_num, request_num);
+  EXPECT_GT(metrics.max_batch_size, 1);
+  EXPECT_GT(metrics.max_queue_depth, 0);
+  EXPECT_EQ(metrics.queue_depth, 0);
+}
+
+TEST_F(BatchSchedulerTest, test_fixed_batch_model_fallback) {
+  StubSession session(2);
+  const int request_num = 4;
+  BatchScheduler scheduler(8, 1000, session.Func());
+  scheduler.Start();
+  RunConcurrently(&scheduler, request_num, 2);
+  scheduler.Stop();
+  EXPECT_EQ(session.call_num_, request_num);
+}
+
+TEST_F(BatchSchedulerTest, test_no_batching) {
+  StubSession session;
+  const int request_num = 4;
+  BatchScheduler scheduler(1, 1000, session.Func());
+  scheduler.Start();
+  RunConcurrently(&scheduler, request_num, 3);
+  scheduler.Stop();
+  auto metrics = scheduler.GetMetrics();
+  EXPECT_EQ(metrics.request_num, request_num);
+  EXPECT_EQ(metrics.batch_num, request_num);
+  EXPECT_EQ(session.call_num_, request_num);
+}
+
+// an exception thrown by the session fails the requests instead of blocking the clients
+TEST_F(BatchSchedulerTest, test_predict_exception) {
+  std::atomic<int> call_num{0};
+  auto predict_func = [&call_num](const PredictRequest &, PredictReply &) -> Status {
+    call_num++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    throw std::runtime_error("predict failed");
+  };
+  const int request_num = 4;
+  BatchScheduler scheduler(request_num, 1000, predict_func);
+  scheduler.Start();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < request_num; i++) {
+    threads.emplace_back([&scheduler]() {
+      PredictRequest request;
+      PredictReply reply;
+      CreateRequest(&request, 1, 0);
+      EXPECT_TRUE(scheduler.Predict(request, reply) == FAILED);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  scheduler.Stop();
+  EXPECT_GE(call_num, request_num);
+}
+}  // namespace serving
+}  // namespace mindspore
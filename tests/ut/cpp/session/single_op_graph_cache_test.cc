@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/session/session_basic.h"
+#include "backend/session/single_op_graph_cache.h"
+
+namespace mindspore {
+namespace session {
+class SingleOpGraphCacheTest : public UT::Common {
+ public:
+  SingleOpGraphCacheTest() = default;
+};
+
+TEST_F(SingleOpGraphCacheTest, EvictLeastRecentlyUsed) {
+  SingleOpGraphCache cache(2);
+  auto graph1 = std::make_shared<KernelGraph>();
+  auto graph2 = std::make_shared<KernelGraph>();
+  auto graph3 = std::make_shared<KernelGraph>();
+  EXPECT_EQ(cache.Lookup(1), nullptr);
+  cache.Put(1, graph1);
+  cache.Put(2, graph2);
+  // 1 becomes the most recently used graph, so 2 is dropped for 3
+  EXPECT_EQ(cache.Lookup(1), graph1);
+  cache.Put(3, graph3);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.Get(2), nullptr);
+  EXPECT_EQ(cache.Get(1), graph1);
+  EXPECT_EQ(cache.Get(3), graph3);
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(cache.misses(), 1);
+  EXPECT_EQ(cache.evictions(), 1);
+
+  cache.set_capacity(1);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.Get(3), graph3);
+  EXPECT_EQ(cache.evictions(), 2);
+}
+
+TEST_F(SingleOpGraphCacheTest, HashSingleOpInputs) {
+  auto x = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{2, 3});
+  auto same_x = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{2, 3});
+  auto half_x = std::make_shared<tensor::Tensor>(kNumberTypeFloat16, std::vector<int>{2, 3});
+  auto flat_x = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{6});
+  GraphInfo seed = 7;
+  EXPECT_EQ(HashSingleOpInputs({x, flat_x}, seed), HashSingleOpInputs({same_x, flat_x}, seed));
+  EXPECT_NE(HashSingleOpInputs({x}, seed), HashSingleOpInputs({half_x}, seed));
+  EXPECT_NE(HashSingleOpInputs({x}, seed), HashSingleOpInputs({flat_x}, seed));
+  EXPECT_NE(HashSingleOpInputs({x, flat_x}, seed), HashSingleOpInputs({flat_x, x}, seed));
+  EXPECT_NE(HashSingleOpInputs({x}, seed), HashSingleOpInputs({x}, seed + 1));
+}
+}  // namespace session
+}  // namespace mindspore
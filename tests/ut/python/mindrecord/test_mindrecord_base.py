@@ -77,6 +77,8 @@ def test_write_read_process():
 
     os.remove("{}".format(mindrecord_file_name))
     os.remove("{}.db".format(mindrecord_file_name))
+    if os.path.exists("{}.idx".format(mindrecord_file_name)):
+        os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_write_read_process_with_define_index_field():
@@ -128,6 +130,8 @@ def test_write_read_process_with_define_index_field():
 
     os.remove("{}".format(mindrecord_file_name))
     os.remove("{}.db".format(mindrecord_file_name))
+    if os.path.exists("{}.idx".format(mindrecord_file_name)):
+        os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_cv_file_writer_tutorial():
@@ -169,6 +173,8 @@ def test_cv_file_append_writer():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_cv_file_append_writer_absolute_path():
@@ -198,6 +204,8 @@ def test_cv_file_append_writer_absolute_path():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_cv_file_writer_loop_and_read():
@@ -226,6 +234,8 @@ def test_cv_file_writer_loop_and_read():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_cv_file_reader_tutorial():
@@ -339,6 +349,8 @@ def test_cv_page_reader_tutorial_new_api():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_nlp_file_writer_tutorial():
@@ -402,6 +414,8 @@ def test_nlp_page_reader_tutorial():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_cv_file_writer_shard_num_10():
@@ -420,6 +434,8 @@ def test_cv_file_writer_shard_num_10():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_cv_file_writer_absolute_path():
@@ -439,6 +455,8 @@ def test_cv_file_writer_absolute_path():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_cv_file_writer_without_data():
@@ -458,6 +476,8 @@ def test_cv_file_writer_without_data():
     reader.close()
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_file_writer_no_blob():
@@ -480,6 +500,8 @@ def test_cv_file_writer_no_blob():
     reader.close()
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_file_writer_no_raw():
@@ -508,6 +530,8 @@ def test_cv_file_writer_no_raw():
     reader.close()
     os.remove(NLP_FILE_NAME)
     os.remove("{}.db".format(NLP_FILE_NAME))
+    if os.path.exists("{}.idx".format(NLP_FILE_NAME)):
+        os.remove("{}.idx".format(NLP_FILE_NAME))
 
 
 def test_write_read_process_with_multi_bytes():
@@ -633,6 +657,8 @@ def test_write_read_process_with_multi_bytes():
 
     os.remove("{}".format(mindrecord_file_name))
     os.remove("{}.db".format(mindrecord_file_name))
+    if os.path.exists("{}.idx".format(mindrecord_file_name)):
+        os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_write_read_process_with_multi_array():
@@ -777,6 +803,8 @@ def test_write_read_process_with_multi_array():
 
     os.remove("{}".format(mindrecord_file_name))
     os.remove("{}.db".format(mindrecord_file_name))
+    if os.path.exists("{}.idx".format(mindrecord_file_name)):
+        os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_write_read_process_with_multi_bytes_and_array():
@@ -964,3 +992,5 @@ def test_write_read_process_with_multi_bytes_and_array():
 
     os.remove("{}".format(mindrecord_file_name))
     os.remove("{}.db".format(mindrecord_file_name))
+    if os.path.exists("{}.idx".format(mindrecord_file_name)):
+        os.remove("{}.idx".format(mindrecord_file_name))
@@ -39,19 +39,27 @@ def fixture_file():
         remove_one_file(x)
         x = "mnist_train.mindrecord.db"
         remove_one_file(x)
+        x = "mnist_train.mindrecord.idx"
+        remove_one_file(x)
         x = "mnist_test.mindrecord"
         remove_one_file(x)
         x = "mnist_test.mindrecord.db"
         remove_one_file(x)
+        x = "mnist_test.mindrecord.idx"
+        remove_one_file(x)
         for i in range(PARTITION_NUM):
             x = "mnist_train.mindrecord" + str(i)
             remove_one_file(x)
             x = "mnist_train.mindrecord" + str(i) + ".db"
             remove_one_file(x)
+            x = "mnist_train.mindrecord" + str(i) + ".idx"
+            remove_one_file(x)
             x = "mnist_test.mindrecord" + str(i)
             remove_one_file(x)
             x = "mnist_test.mindrecord" + str(i) + ".db"
             remove_one_file(x)
+            x = "mnist_test.mindrecord" + str(i) + ".idx"
+            remove_one_file(x)
 
     remove_file()
     yield "yield_fixture_data"